@@ -8,6 +8,7 @@
  * The functions prototypes defined in this file include:
  *    - APP_Init: function to initialize the app.
  *    - APP_Start: function to start the functionality of the app.
+ *    - APP_FailSafe: function to put the lights in the fail-safe flashing state.
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -21,10 +22,39 @@
 
 #include "../ECUAL/LED/LED_Interface.h"
 #include "../ECUAL/BUTTON/BUTTON_Interface.h"
+#include "../ECUAL/SHIFT/SHIFT_Interface.h"
+#include "../ECUAL/DET/DET_Interface.h"
+#include "../ECUAL/DISP/DISP_Interface.h"
+#include "../ECUAL/LMON/LMON_Interface.h"
+#include "../MCAL/WDT/WDT_Interface.h"
+#include "../SERVICES/STATS/STATS_Interface.h"
+#include "../SERVICES/PROF/PROF_Interface.h"
+#include "../SERVICES/LAT/LAT_Interface.h"
+#include "../SERVICES/STACK/STACK_Interface.h"
+#include "../SERVICES/PLAN/PLAN_Interface.h"
+#include "../SERVICES/ELOG/ELOG_Interface.h"
+#include "../SERVICES/CORR/CORR_Interface.h"
+#include "../SERVICES/TICK/TICK_Interface.h"
+#include "../SERVICES/SCHED/SCHED_Interface.h"
+#include "../SERVICES/PFAIL/PFAIL_Interface.h"
+#include "../MCAL/UART/UART_Interface.h"
+#include "../MCAL/TWI/TWI_Interface.h"
+#include "../BOOT/BOOT_Interface.h"
+
+// The countdown display and the profiler both need Timer2
+#if DISP_ENABLE && PROF_ENABLE
+#error "DISP_ENABLE and PROF_ENABLE can not be set together (Timer2)"
+#endif
+
+// The countdown display takes the TWI pins
+#if DISP_ENABLE && TWI_ENABLE
+#error "DISP_ENABLE and TWI_ENABLE can not be set together (PORTC)"
+#endif
 
 typedef enum mode{
 	NORMAL,
-	PEDESTRIAN
+	PEDESTRIAN,
+	FAIL_SAFE
 } EN_AppMode_t;
 
 typedef enum color{
@@ -33,7 +63,109 @@ typedef enum color{
 	GREEN	
 } EN_LEDColor_t;
 
+// Signal tables (APP_Signals.h), generated by sigc from the intersection description APP_Signals.txt
+typedef struct {
+	uint8_t port;
+	uint8_t pin;
+	uint8_t flash;  // bit of the lamp in the flash bits of the aspects, 0 for a steady lamp
+} ST_AppLamp_t;
+
+typedef struct {
+	uint8_t port;
+	uint8_t mask;   // pins of the steady lamps
+} ST_AppPort_t;
+
+typedef struct {
+	uint8_t aspect; // lamps lit, index in the aspects of the site
+	uint8_t phase;  // EN_PlanPhase_t: duration and coordination phase
+	uint8_t stats;  // EN_StatsPhase_t
+	uint8_t flags;
+	uint8_t walk;   // steps of the crossing's green starting with this one (countdown), 0 if it does not start here
+} ST_AppStep_t;
+
+#define APP_STEP_GREEN 0x01 // green of the main approach: actuated and coordinated
+
+// Actuated car's green (vehicle detector), standalone controller only by default:
+// on a corridor the green time is kept for the coordination. Pass -DAPP_ACTUATED=0 for the fixed green.
+#ifndef APP_ACTUATED
+#define APP_ACTUATED (CORR_NONE == CORR_MASTER_ID)
+#endif
+#define APP_GAP_HALF_SECS       6U  // green ended after 3 seconds without a vehicle (after the minimum green)
+#define APP_HEADWAY_HALF_SECS   4U  // a queued vehicle leaves every 2 seconds (saturation flow 1800 vehicles per hour)
+#define APP_MAX_GREEN_HALF_SECS 40U // green ended after 20 seconds (unless the plan green is longer)
+
+// Pins of one intersection (APP_Sites, generated by sigc)
+typedef struct {
+	const ST_AppLamp_t* lamps;   // APP_LAMP_NUM lamps
+	const ST_AppPort_t* ports;   // ports of the steady lamps
+	const uint8_t* aspects;      // APP_ASPECT_NUM aspects of portNum + 1 bytes (pins lit in each port, flash bits)
+	uint8_t portNum;
+	uint8_t button;              // external interrupt of the button (INT0, INT1 or INT2)
+	uint8_t buttonPort;
+	uint8_t buttonPin;
+	uint8_t output;              // shift register output of the first lamp
+	uint8_t softFlash;           // the flash lamps are not on the Timer1 compare outputs, the application flashes them
+} ST_AppSite_t;
+
+// State of one intersection (context), the functions of the application take the context of the intersection
+typedef struct {
+	const ST_AppSite_t* site;
+	EN_AppMode_t mode;
+	EN_LEDColor_t carLEDColor;   // car's lamp at the last press
+	uint8_t aspect;              // aspect shown, index in the aspects of the site
+	uint8_t flash;               // lamps flashed (flash bits)
+	uint16_t walkLeft;           // half seconds left until the pedestrian's green LED turns off, 0 when it is off
+	uint8_t walkShown;           // seconds shown on the countdown display, 0 when blank
+#if APP_ACTUATED
+	uint8_t waiting;             // vehicles waiting for the car's green (estimate)
+	uint16_t clear;              // half seconds of the green until the queue is cleared
+	uint8_t gap;                 // half seconds since the last vehicle
+	uint8_t max;                 // maximum green in half seconds
+#endif
+	const ST_AppStep_t* steps;   // sequence running, 0 between two sequences
+	uint8_t stepNum;
+	uint8_t step;                // step running, index in steps
+	uint8_t elapsed;             // half seconds of the step ended
+	uint8_t duration;            // half seconds of the step (minimum green of the actuated green)
+	const uint8_t* halfSecs;     // plan of the sequence
+	EN_AppMode_t sequenceMode;   // mode at the start of the sequence
+	uint8_t vehicles;            // vehicles detected during the last half second
+} ST_AppContext_t;
+
+// Register map read by the cabinet master over the TWI (TWI build), 16 and 32-bit registers are little endian.
+// The main intersection is described, the snapshot is taken at the start of each half second.
+#define APP_MAP_LAYOUT 1 // value of APP_REG_LAYOUT, changed with the layout
+typedef enum appRegister{
+	APP_REG_LAYOUT   = 0x00, // APP_MAP_LAYOUT
+	APP_REG_SNAPSHOT = 0x01, // incremented by each snapshot, a master reading the same value twice sees a stopped controller
+	APP_REG_MODE     = 0x02, // EN_AppMode_t
+	APP_REG_ASPECT   = 0x03, // aspect shown (APP_ASPECT_ of APP_Signals.h)
+	APP_REG_STEP     = 0x04, // step of the sequence, 0xFF between two sequences
+	APP_REG_ELAPSED  = 0x05, // half seconds of the step ended
+	APP_REG_FAULTS   = 0x06, // APP_FAULT_ bits
+	APP_REG_LAMPS    = 0x07, // sensed lamps out (monitor build, bit n: sensed lamp n)
+	APP_REG_TIME     = 0x08, // 32 bits: half seconds since the boot
+	APP_REG_PRESSES  = 0x0C, // 16 bits: button presses (saturating, STATS)
+	APP_REG_CYCLES   = 0x0E, // 16 bits: normal cycles completed (saturating, STATS)
+	APP_REG_VEHICLES = 0x10, // 16 bits: vehicles detected (saturating, STATS)
+	APP_REG_PLAN     = 0x12, // 16 bits: revision of the active plan
+	APP_REG_STACK    = 0x14, // 16 bits: stack high-water mark in bytes
+	APP_REG_WALK     = 0x16, // intersections in the pedestrian mode (bit k: intersection k)
+	APP_REG_NUM
+} EN_AppRegister_t;
+
+// Fault bits of APP_REG_FAULTS
+#define APP_FAULT_FAIL_SAFE 0x01 // fail-safe state (a red lamp out), the snapshots stop
+#define APP_FAULT_LAMP_OUT  0x02 // a sensed lamp is out
+#define APP_FAULT_STACK     0x04 // the stack reached the variables, the watchdog will reset the controller
+#define APP_FAULT_LOG       0x08 // event log records lost (queue full)
+#define APP_FAULT_SLIP      0x10 // half seconds dropped by the timebase (main loop blocked)
+
+// Contexts of the intersections, in the order of APP_Sites: the first one is the main intersection
+extern ST_AppContext_t APP_Contexts[];
+
 void APP_Init(void);
 void APP_Start(void);
+void APP_FailSafe(void);
 
 #endif 
@@ -9,6 +9,8 @@
  * The program also has a button that allows the user to switch between normal mode, 
  * where the traffic light follows a normal sequence, and pedestrian mode, 
  * where the traffic light sequence is adjusted to allow pedestrians to cross.
+ * The timebase, the signal tables, the intersections and the optional builds are described in the README,
+ * and each function below documents its part.
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -17,143 +19,812 @@
  */
 
 #include "APP_Interface.h"
+#include "APP_Signals.h"
 
-ST_TimerConfig_t timerConfig_Halfsec = {INIT_VALUE_HALF_SEC, OVERFLOW_NUM_HALF_SEC, TMR_NORMAL, TMR_PRESCALER};
-EN_AppMode_t appMode;
-EN_LEDColor_t carLEDColor;
+ST_AppContext_t APP_Contexts[APP_SITE_NUM];
+static uint8_t appStarting; // the start task is posted, it commits the shift registers
+#if LMON_ENABLE
+static uint8_t appLampsOut;  // sensed lamps out at the previous check
+#endif
+#if TWI_ENABLE
+static uint32_t appHalfSecs; // half seconds since the boot
+static uint8_t appSnapshot;  // snapshots published
+#endif
+#if PFAIL_ENABLE
+// Power-fail state of an intersection: flags, step, half seconds elapsed, vehicles waiting
+#define APP_STATE_BYTES 4
+#define APP_STATE_MODE  0x01 // mode pedestrian (button pressed)
+#define APP_STATE_PED   0x02 // pedestrian sequence
+#define APP_STATE_RUN   0x04 // in a sequence
+static uint8_t appState[APP_SITE_NUM * APP_STATE_BYTES];
+#endif
 
+#if TWI_ENABLE && APP_REG_NUM > TWI_MAP_SIZE
+#error "the register map (APP_REG_NUM) does not fit in TWI_MAP_SIZE"
+#endif
+#if APP_SITE_NUM > 1
+static uint16_t appFlashCount; // fail-safe: Timer1 count at the previous pass of the main loop
+static uint8_t appFlashOn;     // fail-safe: the flash lamps are on
+#endif
+
+// The main intersection has the detector, the countdown display, the statistics and the coordination
+#define APP_IS_MAIN(LOC_PtrCtx) (&APP_Contexts[0] == (LOC_PtrCtx))
+
+#if PFAIL_ENABLE && APP_SITE_NUM * APP_STATE_BYTES > PFAIL_STATE_MAX
+#error "the power-fail state of the intersections does not fit in PFAIL_STATE_MAX"
+#endif
+#if LMON_ENABLE && !APP_SENSE_NUM
+#error "LMON_ENABLE needs sensed lamps (sense lines of APP_Signals.txt)"
+#endif
+
+#if defined(APP_SITE_INT1) && TICK_PPS_ENABLE
+#error "the button of an intersection is on INT1, TICK_PPS_ENABLE can not be set"
+#endif
+
+static void APP_Button0(void);
+#if APP_SITE_NUM > 1
+static void APP_Button1(void);
+#endif
+#if APP_SITE_NUM > 2
+static void APP_Button2(void);
+#endif
+static void APP_SerialReceive(uint8_t LOC_U8Byte);
+static void APP_TaskTick(void);
+static void APP_TaskStart(void);
+static void APP_TaskSignals0(void);
+#if BOOT_ENABLE
+static void APP_EnterBoot(void);
+#endif
+#if APP_SITE_NUM > 1
+static void APP_TaskSignals1(void);
+#endif
+#if APP_SITE_NUM > 2
+static void APP_TaskSignals2(void);
+#endif
+
+// Button callbacks, in the order of APP_Sites
+static const EXTI_Callback_t APP_Buttons[APP_SITE_NUM] = {
+	APP_Button0,
+#if APP_SITE_NUM > 1
+	APP_Button1,
+#endif
+#if APP_SITE_NUM > 2
+	APP_Button2,
+#endif
+};
+
+// Tasks in priority order, the index is the task number
+#define APP_TASK_START 4
+#define APP_TASK_NUM   (5 + APP_SITE_NUM)
+#if APP_TASK_NUM > SCHED_MAX_TASKS
+#error "more tasks than SCHED_MAX_TASKS"
+#endif
+static const ST_SchedTask_t APP_Tasks[APP_TASK_NUM] = {
+	{APP_TaskTick,     1, 0}, // watchdog, detector and statistics
+	{ELOG_Tick,        1, 0}, // event log time
+	{CORR_Tick,        1, 0}, // coordination frames received
+	{PLAN_Poll,        1, 0}, // plans received
+	{APP_TaskStart,    0, 0}, // start of the sequences, posted at the end of a sequence
+	{APP_TaskSignals0, 1, 0}, // steps of the sequence of each intersection
+#if APP_SITE_NUM > 1
+	{APP_TaskSignals1, 1, 0},
+#endif
+#if APP_SITE_NUM > 2
+	{APP_TaskSignals2, 1, 0},
+#endif
+};
+
+/*
+ * Function: APP_SetAspect()
+ * This function changes the lamps lit of an intersection: the lamps that stop flashing are turned off first,
+ * then the steady lamps are set with one write per port, and the lamps that start flashing are turned on.
+ * The lamps flashing in both aspects keep flashing.
+ * Return value: void
+ */
+static void APP_SetAspect(ST_AppContext_t* LOC_PtrCtx, uint8_t LOC_U8Aspect){
+	const ST_AppSite_t* LOC_PtrSite = LOC_PtrCtx->site;
+	const ST_AppLamp_t* LOC_PtrLamps = LOC_PtrSite->lamps;
+	const uint8_t* LOC_PtrOld = &LOC_PtrSite->aspects[LOC_PtrCtx->aspect * (LOC_PtrSite->portNum + 1)];
+	const uint8_t* LOC_PtrNew = &LOC_PtrSite->aspects[LOC_U8Aspect * (LOC_PtrSite->portNum + 1)];
+	uint8_t LOC_U8Flash = LOC_PtrNew[LOC_PtrSite->portNum];
+	
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++){
+		if(!(LOC_PtrLamps[i].flash & LOC_PtrCtx->flash & ~LOC_U8Flash)) continue;
+		if(LOC_PtrSite->softFlash) LED_Off(LOC_PtrLamps[i].port, LOC_PtrLamps[i].pin);
+		else LED_FlashStop(LOC_PtrLamps[i].port, LOC_PtrLamps[i].pin);
+	}
+	for(uint8_t i=0; i<LOC_PtrSite->portNum; i++){
+		if(LOC_PtrNew[i] != LOC_PtrOld[i]) LED_SetGroup(LOC_PtrSite->ports[i].port, LOC_PtrSite->ports[i].mask, LOC_PtrNew[i]);
+	}
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++){
+		if(!(LOC_PtrLamps[i].flash & LOC_U8Flash & ~LOC_PtrCtx->flash)) continue;
+		if(LOC_PtrSite->softFlash) LED_On(LOC_PtrLamps[i].port, LOC_PtrLamps[i].pin);
+		else LED_FlashStart(LOC_PtrLamps[i].port, LOC_PtrLamps[i].pin);
+	}
+	LOC_PtrCtx->aspect = LOC_U8Aspect;
+	LOC_PtrCtx->flash = LOC_U8Flash;
+	if(APP_IS_MAIN(LOC_PtrCtx)) LAT_Aspect(); // first lamp change after a press
+}
+
+/*
+ * Function: APP_SoftFlash()
+ * This function turns the flash lamps of an intersection flashed in software on or off, once per half second.
+ * Return value: void
+ */
+static void APP_SoftFlash(const ST_AppContext_t* LOC_PtrCtx, uint8_t LOC_U8FlashOn){
+	const ST_AppLamp_t* LOC_PtrLamps = LOC_PtrCtx->site->lamps;
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++){
+		if(!(LOC_PtrLamps[i].flash & LOC_PtrCtx->flash)) continue;
+		if(LOC_U8FlashOn) LED_On(LOC_PtrLamps[i].port, LOC_PtrLamps[i].pin);
+		else LED_Off(LOC_PtrLamps[i].port, LOC_PtrLamps[i].pin);
+	}
+}
+
+/*
+ * Function: APP_Outputs()
+ * This function copies the lamps of an intersection into the shift register image, from its first output.
+ * The flashing lamps are on in the first half second of each second (LOC_U8FlashOn): the flasher turns them on
+ * at the start of the aspect and toggles them every half second.
+ * The image is committed once per half second, after the last intersection (APP_Signals) or by APP_TaskStart.
+ * Return value: void
+ */
+static void APP_Outputs(const ST_AppContext_t* LOC_PtrCtx, uint8_t LOC_U8FlashOn){
+	const ST_AppSite_t* LOC_PtrSite = LOC_PtrCtx->site;
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++){
+		const ST_AppLamp_t* LOC_PtrLamp = &LOC_PtrSite->lamps[i];
+		uint8_t LOC_U8Lit = LOC_PtrLamp->flash ? ((LOC_PtrCtx->flash & LOC_PtrLamp->flash) && LOC_U8FlashOn) : LED_IsOn(LOC_PtrLamp->port, LOC_PtrLamp->pin);
+		SHIFT_Write(LOC_PtrSite->output + i, LOC_U8Lit);
+	}
+}
+
+/*
+ * Function: APP_Countdown()
+ * This function shows the seconds left of the pedestrian's green on the countdown display, rounded up,
+ * and counts the half second starting now. The display is only written when the number changes (once per second),
+ * and blanked when the pedestrian's green is over.
+ * Return value: void
+ */
+static void APP_Countdown(ST_AppContext_t* LOC_PtrCtx){
+	uint8_t LOC_U8Secs = (uint8_t)((LOC_PtrCtx->walkLeft + 1U) / 2);
+	if(LOC_U8Secs != LOC_PtrCtx->walkShown){
+		LOC_PtrCtx->walkShown = LOC_U8Secs;
+		DISP_Show(LOC_U8Secs ? LOC_U8Secs : DISP_BLANK);
+	}
+	if(LOC_PtrCtx->walkLeft) LOC_PtrCtx->walkLeft--;
+}
+
+/*
+ * Function: APP_GreenTime()
+ * This function starts a normal cycle for the corridor coordination and gets its green time:
+ * the green time of the plan, changed by the coordination correction, but not under the plan minimum.
+ * Return value: the green time in half seconds
+ */
+static uint8_t APP_GreenTime(const uint8_t* LOC_PtrHalfSecs, uint8_t LOC_U8Phase){
+	uint16_t LOC_U16Cycle = 0;
+	for(uint8_t i=0; i<APP_NORMAL_STEPS; i++) LOC_U16Cycle += LOC_PtrHalfSecs[APP_Normal[i].phase];
+	int16_t LOC_S16Green = LOC_PtrHalfSecs[LOC_U8Phase] + CORR_CycleStart(LOC_U16Cycle);
+	if(LOC_S16Green < (int16_t)PLAN_MIN_HALF_SECS) LOC_S16Green = PLAN_MIN_HALF_SECS;
+	return (uint8_t)LOC_S16Green;
+}
+
+/*
+ * Function: APP_HalfSecond()
+ * This function starts a half second of the step: the lamps are copied to the shift register image,
+ * the software flash lamps are toggled and the countdown is shown (main intersection).
+ * Return value: void
+ */
+static void APP_HalfSecond(ST_AppContext_t* LOC_PtrCtx){
+	uint8_t LOC_U8FlashOn = !(LOC_PtrCtx->elapsed & 1);
+	if(LOC_PtrCtx->site->softFlash) APP_SoftFlash(LOC_PtrCtx, LOC_U8FlashOn);
+	APP_Outputs(LOC_PtrCtx, LOC_U8FlashOn);
+	if(APP_IS_MAIN(LOC_PtrCtx)) APP_Countdown(LOC_PtrCtx);
+}
+
+/*
+ * Function: APP_StepStart()
+ * This function starts the current step of the sequence: it shows its aspect for the duration of its plan phase.
+ * The green of the main approach gets the green time of the coordination, it is the minimum green in the actuated build.
+ * Return value: void
+ */
+static void APP_StepStart(ST_AppContext_t* LOC_PtrCtx){
+	const ST_AppStep_t* LOC_PtrStep = &LOC_PtrCtx->steps[LOC_PtrCtx->step];
+	uint8_t LOC_U8Main = APP_IS_MAIN(LOC_PtrCtx);
+	if(LOC_U8Main){
+		STATS_Phase(LOC_PtrStep->stats);
+		CORR_Phase(LOC_PtrStep->phase);
+	}
+	APP_SetAspect(LOC_PtrCtx, LOC_PtrStep->aspect);
+	
+	/* The countdown of the crossing's green, to the end of its last step */
+	if(LOC_PtrStep->walk){
+		LOC_PtrCtx->walkLeft = 0;
+		for(uint8_t k=0; k<LOC_PtrStep->walk; k++) LOC_PtrCtx->walkLeft += LOC_PtrCtx->halfSecs[LOC_PtrStep[k].phase];
+	}
+	
+	LOC_PtrCtx->elapsed = 0;
+	if(APP_STEP_GREEN & LOC_PtrStep->flags){
+		LOC_PtrCtx->duration = LOC_U8Main ? APP_GreenTime(LOC_PtrCtx->halfSecs, LOC_PtrStep->phase) : LOC_PtrCtx->halfSecs[LOC_PtrStep->phase];
+#if APP_ACTUATED
+		LOC_PtrCtx->max = (LOC_PtrCtx->duration > APP_MAX_GREEN_HALF_SECS) ? LOC_PtrCtx->duration : APP_MAX_GREEN_HALF_SECS;
+		LOC_PtrCtx->clear = (uint16_t)LOC_PtrCtx->waiting * APP_HEADWAY_HALF_SECS;
+		LOC_PtrCtx->gap = APP_GAP_HALF_SECS; // the gap is open at the start
+#endif
+	}
+	else LOC_PtrCtx->duration = LOC_PtrCtx->halfSecs[LOC_PtrStep->phase];
+}
+
+#if APP_ACTUATED
+/*
+ * Function: APP_GreenEnd()
+ * This function decides, at the end of each half second of the car's green, whether the actuated green is over.
+ * The green goes on after the minimum green until the queue is cleared and no vehicle was detected
+ * for APP_GAP_HALF_SECS (gap-out), but not after APP_MAX_GREEN_HALF_SECS (max-out),
+ * and it ends at once when the button is pressed and the mode changed to pedestrian.
+ * The queue is estimated from the counts: the vehicles detected since the previous green are waiting at the start,
+ * and one vehicle leaves every APP_HEADWAY_HALF_SECS. The vehicles still waiting at the end are kept for the next green.
+ * Without vehicles the green lasts exactly the minimum, as in the fixed build (intersections without a detector).
+ * Return value: 1 when the green is over, 0 otherwise
+ */
+static uint8_t APP_GreenEnd(ST_AppContext_t* LOC_PtrCtx){
+	uint8_t LOC_U8End = 0;
+	if(LOC_PtrCtx->vehicles){
+		if(LOC_PtrCtx->clear < LOC_PtrCtx->elapsed) LOC_PtrCtx->clear = LOC_PtrCtx->elapsed;
+		LOC_PtrCtx->clear += (uint16_t)LOC_PtrCtx->vehicles * APP_HEADWAY_HALF_SECS;
+		LOC_PtrCtx->gap = 0;
+	}
+	else if(LOC_PtrCtx->gap < APP_GAP_HALF_SECS) LOC_PtrCtx->gap++;
+	
+	/* Check if button pressed and mode changed */
+	if(PEDESTRIAN == LOC_PtrCtx->mode) LOC_U8End = 1;
+	
+	/* Gap-out after the minimum green, once the queue is cleared */
+	else if(LOC_PtrCtx->elapsed >= LOC_PtrCtx->duration && LOC_PtrCtx->elapsed >= LOC_PtrCtx->clear && LOC_PtrCtx->gap >= APP_GAP_HALF_SECS){
+		if(APP_IS_MAIN(LOC_PtrCtx)) STATS_GreenEnd(0);
+		LOC_U8End = 1;
+	}
+	else if(LOC_PtrCtx->max == LOC_PtrCtx->elapsed){
+		if(APP_IS_MAIN(LOC_PtrCtx)) STATS_GreenEnd(1);
+		LOC_U8End = 1;
+	}
+	
+	/* The vehicles not cleared wait for the next green */
+	if(LOC_U8End){
+		uint16_t LOC_U16Left = LOC_PtrCtx->clear;
+		LOC_U16Left = (LOC_U16Left > LOC_PtrCtx->elapsed) ? (LOC_U16Left - LOC_PtrCtx->elapsed + APP_HEADWAY_HALF_SECS - 1) / APP_HEADWAY_HALF_SECS : 0;
+		LOC_PtrCtx->clear = LOC_U16Left;
+		LOC_PtrCtx->waiting = (LOC_U16Left > 0xFF) ? 0xFF : (uint8_t)LOC_U16Left;
+	}
+	return LOC_U8End;
+}
+#endif
+
+#if PFAIL_ENABLE
+/*
+ * Function: APP_PackState()
+ * This function packs the state of the intersections for the power-fail save (APP_STATE_BYTES each).
+ * Return value: void
+ */
+static void APP_PackState(void){
+	for(uint8_t k=0; k<APP_SITE_NUM; k++){
+		const ST_AppContext_t* LOC_PtrCtx = &APP_Contexts[k];
+		uint8_t* LOC_PtrState = &appState[k * APP_STATE_BYTES];
+		uint8_t LOC_U8Flags = 0;
+		if(PEDESTRIAN == LOC_PtrCtx->mode) LOC_U8Flags |= APP_STATE_MODE;
+		if(PEDESTRIAN == LOC_PtrCtx->sequenceMode) LOC_U8Flags |= APP_STATE_PED;
+		if(LOC_PtrCtx->steps) LOC_U8Flags |= APP_STATE_RUN;
+		LOC_PtrState[0] = LOC_U8Flags;
+		LOC_PtrState[1] = LOC_PtrCtx->step;
+		LOC_PtrState[2] = LOC_PtrCtx->elapsed;
+#if APP_ACTUATED
+		LOC_PtrState[3] = LOC_PtrCtx->waiting;
+#else
+		LOC_PtrState[3] = 0;
+#endif
+	}
+}
+
+/*
+ * Function: APP_RestoreState()
+ * This function resumes the mode and the sequence of an intersection from its power-fail state: the step is started again
+ * (aspect, duration, coordination), with its half seconds elapsed, and the half second it was in is shown again.
+ * The countdown goes on from the start of the steps of the crossing's green. A state out of the sequence is ignored,
+ * and the elapsed time is kept under the end of the step, so a shorter plan or green ends it at the next half second.
+ * Return value: void
+ */
+static void APP_RestoreState(ST_AppContext_t* LOC_PtrCtx, const uint8_t* LOC_PtrState){
+	LOC_PtrCtx->mode = (APP_STATE_MODE & LOC_PtrState[0]) ? PEDESTRIAN : NORMAL; // a press between two sequences
+	if(!(APP_STATE_RUN & LOC_PtrState[0])) return;
+	uint8_t LOC_U8Pedestrian = APP_STATE_PED & LOC_PtrState[0];
+	uint8_t LOC_U8StepNum = LOC_U8Pedestrian ? APP_PEDESTRIAN_STEPS : APP_NORMAL_STEPS;
+	if(LOC_PtrState[1] >= LOC_U8StepNum) return;
+	LOC_PtrCtx->sequenceMode = LOC_U8Pedestrian ? PEDESTRIAN : NORMAL;
+	LOC_PtrCtx->steps = LOC_U8Pedestrian ? APP_Pedestrian : APP_Normal;
+	LOC_PtrCtx->stepNum = LOC_U8StepNum;
+	LOC_PtrCtx->step = LOC_PtrState[1];
+	LOC_PtrCtx->halfSecs = PLAN_Get()->halfSecs;
+#if APP_ACTUATED
+	LOC_PtrCtx->waiting = LOC_PtrState[3];
+#endif
+	APP_StepStart(LOC_PtrCtx);
+	
+	uint8_t LOC_U8Limit = LOC_PtrCtx->duration;
+#if APP_ACTUATED
+	if(APP_STEP_GREEN & LOC_PtrCtx->steps[LOC_PtrCtx->step].flags) LOC_U8Limit = LOC_PtrCtx->max;
+#endif
+	uint8_t LOC_U8Elapsed = LOC_PtrState[2];
+	if(LOC_U8Elapsed >= LOC_U8Limit) LOC_U8Elapsed = LOC_U8Limit - 1;
+	LOC_PtrCtx->elapsed = LOC_U8Elapsed;
+	
+	/* The countdown of the crossing's green started by an earlier step of the sequence */
+	LOC_PtrCtx->walkLeft = 0;
+	for(uint8_t j=0; j<=LOC_PtrCtx->step; j++){
+		const ST_AppStep_t* LOC_PtrFirst = &LOC_PtrCtx->steps[j];
+		if(LOC_PtrFirst->walk <= LOC_PtrCtx->step - j) continue;
+		uint16_t LOC_U16Left = 0;
+		for(uint8_t k=LOC_PtrCtx->step; k<j+LOC_PtrFirst->walk; k++) LOC_U16Left += LOC_PtrCtx->halfSecs[LOC_PtrCtx->steps[k].phase];
+		LOC_PtrCtx->walkLeft = (LOC_U16Left > LOC_U8Elapsed) ? LOC_U16Left - LOC_U8Elapsed : 0;
+	}
+	APP_HalfSecond(LOC_PtrCtx);
+}
+#endif
+
+#if TWI_ENABLE
+/*
+ * Function: APP_Put16()
+ * This function writes a 16-bit register of the map, little endian.
+ * Return value: void
+ */
+static void APP_Put16(uint8_t* LOC_PtrMap, uint8_t LOC_U8Reg, uint16_t LOC_U16Value){
+	LOC_PtrMap[LOC_U8Reg] = (uint8_t)LOC_U16Value;
+	LOC_PtrMap[LOC_U8Reg + 1] = (uint8_t)(LOC_U16Value >> 8);
+}
+
+/*
+ * Function: APP_Status()
+ * This function takes the snapshot of the register map read by the cabinet master and publishes it.
+ * It fills the back buffer of the map, unless the master is still reading it (a read longer than a half second):
+ * the previous snapshot is then kept for one more half second.
+ * Return value: void
+ */
+static void APP_Status(uint8_t LOC_U8StackOk){
+	const ST_AppContext_t* LOC_PtrMain = &APP_Contexts[0];
+	uint8_t* LOC_PtrMap = TWI_Back();
+	if(!LOC_PtrMap) return;
+	ST_TickStats_t LOC_Tick;
+	TICK_GetStats(&LOC_Tick);
+	uint8_t LOC_U8Faults = 0;
+	if(FAIL_SAFE == LOC_PtrMain->mode) LOC_U8Faults |= APP_FAULT_FAIL_SAFE;
+#if LMON_ENABLE
+	if(appLampsOut) LOC_U8Faults |= APP_FAULT_LAMP_OUT;
+	LOC_PtrMap[APP_REG_LAMPS] = appLampsOut;
+#else
+	LOC_PtrMap[APP_REG_LAMPS] = 0;
+#endif
+	if(!LOC_U8StackOk) LOC_U8Faults |= APP_FAULT_STACK;
+	if(ELOG_Dropped()) LOC_U8Faults |= APP_FAULT_LOG;
+	if(LOC_Tick.slips) LOC_U8Faults |= APP_FAULT_SLIP;
+	uint8_t LOC_U8Walk = 0;
+	for(uint8_t k=0; k<APP_SITE_NUM; k++){
+		if(PEDESTRIAN == APP_Contexts[k].mode) LOC_U8Walk |= (uint8_t)(1<<k);
+	}
+	
+	LOC_PtrMap[APP_REG_LAYOUT] = APP_MAP_LAYOUT;
+	LOC_PtrMap[APP_REG_SNAPSHOT] = ++appSnapshot;
+	LOC_PtrMap[APP_REG_MODE] = LOC_PtrMain->mode;
+	LOC_PtrMap[APP_REG_ASPECT] = LOC_PtrMain->aspect;
+	LOC_PtrMap[APP_REG_STEP] = LOC_PtrMain->steps ? LOC_PtrMain->step : 0xFF;
+	LOC_PtrMap[APP_REG_ELAPSED] = LOC_PtrMain->elapsed;
+	LOC_PtrMap[APP_REG_FAULTS] = LOC_U8Faults;
+	APP_Put16(LOC_PtrMap, APP_REG_TIME, (uint16_t)appHalfSecs);
+	APP_Put16(LOC_PtrMap, APP_REG_TIME + 2, (uint16_t)(appHalfSecs >> 16));
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI(); // the presses are counted by the button interrupt
+	uint16_t LOC_U16Presses = STATS_Data.counter[STATS_PRESSES];
+	if(LOC_U8Interrupts) CPU_SEI();
+	APP_Put16(LOC_PtrMap, APP_REG_PRESSES, LOC_U16Presses);
+	APP_Put16(LOC_PtrMap, APP_REG_CYCLES, STATS_Data.counter[STATS_CYCLES]);
+	APP_Put16(LOC_PtrMap, APP_REG_VEHICLES, STATS_Data.counter[STATS_VEHICLES]);
+	APP_Put16(LOC_PtrMap, APP_REG_PLAN, PLAN_Get()->revision);
+	APP_Put16(LOC_PtrMap, APP_REG_STACK, STATS_Data.stackPeak);
+	LOC_PtrMap[APP_REG_WALK] = LOC_U8Walk;
+	TWI_Publish();
+}
+#endif
+
+/*
+ * Function: APP_TaskTick()
+ * This task runs first at each half second: it refreshes the watchdog and accounts the half second that ended.
+ * The stack guard is checked every half second: if the stack reached the variables the watchdog is not refreshed
+ * anymore, and the controller resets into the fail-safe state. If the scheduler stops, the watchdog resets it too.
+ * The vehicles are counted for the main intersection.
+ * In the monitor build the lamps of the main intersection are checked against the aspect shown for the last half second:
+ * a lamp out is logged once, a red lamp out puts all the intersections in the fail-safe state at once. The steps tasks
+ * of this round are skipped then, and the shift registers show the fail-safe aspect (flash lamps steady).
+ * In the TWI build the snapshot of the register map is taken last.
+ * In the bootloader build the bootloader is entered first when the update command was received in the last round.
+ * Return value: void
+ */
+static void APP_TaskTick(void){
+	ST_AppContext_t* LOC_PtrMain = &APP_Contexts[0];
+#if BOOT_ENABLE
+	if(PLAN_BootRequested()) APP_EnterBoot();
+#endif
+	uint8_t LOC_U8StackOk = STACK_Check();
+	if(LOC_U8StackOk) WDT_Refresh();
+	LOC_PtrMain->vehicles = DET_Read();
+	STATS_Tick();
+	STATS_Stack(STACK_Peak());
+	STATS_Vehicles(LOC_PtrMain->vehicles);
+#if APP_ACTUATED
+	LOC_PtrMain->waiting = (LOC_PtrMain->vehicles > 0xFF - LOC_PtrMain->waiting) ? 0xFF : LOC_PtrMain->waiting + LOC_PtrMain->vehicles;
+#endif
+#if LMON_ENABLE
+	uint8_t LOC_U8Out = LMON_Check(APP_SenseLit[LOC_PtrMain->aspect]);
+	if(LOC_U8Out & ~appLampsOut) ELOG_Event(ELOG_LAMP_OUT);
+	appLampsOut = LOC_U8Out;
+	if(LOC_U8Out & APP_SENSE_REDS){
+		APP_FailSafe();
+		for(uint8_t k=0; k<APP_SITE_NUM; k++) APP_Outputs(&APP_Contexts[k], 1);
+		SHIFT_Commit();
+	}
+#endif
+#if TWI_ENABLE
+	APP_Status(LOC_U8StackOk); // the first task runs at the boot: time 0
+	appHalfSecs++;
+#endif
+}
+
+/*
+ * Function: APP_SequenceStart()
+ * This function starts a sequence of an intersection: the normal sequence, or the pedestrian sequence when the button was pressed.
+ * It is the cycle boundary: the plan received during the last cycle of the main intersection is taken into account.
+ * Return value: void
+ */
+static void APP_SequenceStart(ST_AppContext_t* LOC_PtrCtx){
+	uint8_t LOC_U8Main = APP_IS_MAIN(LOC_PtrCtx);
+	LOC_PtrCtx->sequenceMode = LOC_PtrCtx->mode;
+	if(LOC_U8Main && PLAN_Swap()) ELOG_Event(ELOG_PLAN);
+	LOC_PtrCtx->halfSecs = PLAN_Get()->halfSecs;
+	if(PEDESTRIAN == LOC_PtrCtx->mode){
+		if(LOC_U8Main) ELOG_Event(ELOG_PEDESTRIAN);
+		LOC_PtrCtx->steps = APP_Pedestrian;
+		LOC_PtrCtx->stepNum = APP_PEDESTRIAN_STEPS;
+	}
+	else{
+		LOC_PtrCtx->steps = APP_Normal;
+		LOC_PtrCtx->stepNum = APP_NORMAL_STEPS;
+	}
+	LOC_PtrCtx->step = 0;
+	APP_StepStart(LOC_PtrCtx);
+	APP_HalfSecond(LOC_PtrCtx);
+}
+
+/*
+ * Function: APP_TaskStart()
+ * This task starts the sequences of the intersections between two sequences, it is posted at the end of a sequence
+ * (and by APP_Init), and commits the shift registers (and hands the state to PFAIL in the power-fail build).
+ * Return value: void
+ */
+static void APP_TaskStart(void){
+	appStarting = 0;
+	if(FAIL_SAFE == APP_Contexts[0].mode) return; // a lamp out in this round
+	for(uint8_t i=0; i<APP_SITE_NUM; i++){
+		if(!APP_Contexts[i].steps) APP_SequenceStart(&APP_Contexts[i]);
+	}
+	SHIFT_Commit(); // one frame per half second at most
+#if PFAIL_ENABLE
+	APP_PackState();
+	PFAIL_Update(appState);
+#endif
+}
+
+/*
+ * Function: APP_Advance()
+ * This function ends the half second of an intersection: it ends the step when its duration is over
+ * (or the actuated green decided so), and starts the next step or ends the sequence.
+ * The normal sequence is left at the end of any half second when the button is pressed and the mode changed
+ * to pedestrian, the pedestrian sequence always runs to its end. All the lamps are off at the end of a sequence,
+ * and the next one is started by APP_TaskStart in the next round.
+ * Return value: 1 when the sequence ended, 0 otherwise
+ */
+static uint8_t APP_Advance(ST_AppContext_t* LOC_PtrCtx){
+	if(!LOC_PtrCtx->steps) return 0; // the next sequence is not started yet
+	LOC_PtrCtx->elapsed++;
+	uint8_t LOC_U8Interruptible = (NORMAL == LOC_PtrCtx->sequenceMode);
+	uint8_t LOC_U8End;
+#if APP_ACTUATED
+	if(APP_STEP_GREEN & LOC_PtrCtx->steps[LOC_PtrCtx->step].flags) LOC_U8End = APP_GreenEnd(LOC_PtrCtx);
+	else
+#endif
+	LOC_U8End = (LOC_PtrCtx->elapsed >= LOC_PtrCtx->duration);
+	
+	/* Check if button pressed and mode changed */
+	uint8_t LOC_U8Cut = LOC_U8Interruptible && PEDESTRIAN == LOC_PtrCtx->mode;
+	if(!LOC_U8End && !LOC_U8Cut){
+		APP_HalfSecond(LOC_PtrCtx);
+		return 0;
+	}
+	if(!LOC_U8Cut && ++LOC_PtrCtx->step < LOC_PtrCtx->stepNum){
+		APP_StepStart(LOC_PtrCtx);
+		APP_HalfSecond(LOC_PtrCtx);
+		return 0;
+	}
+	
+	APP_SetAspect(LOC_PtrCtx, APP_ASPECT_DARK);
+	LOC_PtrCtx->steps = 0;
+	
+	/* A normal cycle left early for the pedestrian mode was cut short, after the pedestrian sequence back to normal mode */
+	if(!LOC_U8Interruptible) LOC_PtrCtx->mode = NORMAL;
+	else if(APP_IS_MAIN(LOC_PtrCtx)) STATS_Cycle(PEDESTRIAN == LOC_PtrCtx->mode);
+	return 1;
+}
+
+/*
+ * Function: APP_Signals()
+ * This function is the steps task of an intersection, it runs at each half second after the services.
+ * The end of a sequence posts APP_TaskStart, the shift registers are committed after the last intersection
+ * unless APP_TaskStart follows in this half second. Nothing changes after a fail-safe in this round (lamp out).
+ * In the power-fail build the state of the intersections is handed to PFAIL with the commit, as shown from now on:
+ * a resumed sequence never goes back to an aspect it already left.
+ * Return value: void
+ */
+static void APP_Signals(uint8_t LOC_U8Site){
+	if(FAIL_SAFE == APP_Contexts[LOC_U8Site].mode) return;
+	if(APP_Advance(&APP_Contexts[LOC_U8Site])){
+		appStarting = 1;
+		SCHED_Post(APP_TASK_START);
+	}
+	if(APP_SITE_NUM - 1 == LOC_U8Site && !appStarting){
+		SHIFT_Commit(); // one frame per half second at most
+#if PFAIL_ENABLE
+		APP_PackState();
+		PFAIL_Update(appState);
+#endif
+	}
+}
+
+static void APP_TaskSignals0(void){
+	APP_Signals(0);
+}
+
+#if APP_SITE_NUM > 1
+static void APP_TaskSignals1(void){
+	APP_Signals(1);
+}
+#endif
+
+#if APP_SITE_NUM > 2
+static void APP_TaskSignals2(void){
+	APP_Signals(2);
+}
+#endif
+
+/*
+ * Function: APP_Init()
+ * This function initializes the lamps and the buttons of the intersections and the modules used by the application.
+ * The half seconds are the periods of the flasher timer (TICK), which never restarts and does not drift.
+ * After a watchdog reset the firmware got stuck: the reset is logged and the lights stay in the fail-safe state.
+ * Otherwise the boot is logged, the phase plan is loaded from the EEPROM (PLAN) and the serial port accepts new plans
+ * and coordination frames (CORR). In the power-fail build the sequences are resumed where the power failure left them.
+ * The first sequences start at the first round of the tasks.
+ * Return value: void
+ */
 void APP_Init(void){
-	// Initialize LEDs for cars 
-	LED_Init(PORTA, PIN0);
-	LED_Init(PORTA, PIN1);
-	LED_Init(PORTA, PIN2);
+	// Initialize the LEDs of the signals (the outputs are off after a reset)
+	for(uint8_t k=0; k<APP_SITE_NUM; k++){
+		ST_AppContext_t* LOC_PtrCtx = &APP_Contexts[k];
+		LOC_PtrCtx->site = &APP_Sites[k];
+		LOC_PtrCtx->aspect = APP_ASPECT_DARK;
+		LOC_PtrCtx->flash = 0;
+		LOC_PtrCtx->steps = 0;
+		for(uint8_t i=0; i<APP_LAMP_NUM; i++) LED_Init(APP_Sites[k].lamps[i].port, APP_Sites[k].lamps[i].pin);
+		
+		// Initialize Button
+		BUTTON_Init(APP_Sites[k].buttonPort, APP_Sites[k].buttonPin);
+	}
+	
+	// Initialize the hardware flasher (Timer1 CTC mode)
+	LED_FlashInit();
+	
+	// Count the half seconds on the flasher period (Timer1 compare A interrupt)
+	TICK_Init();
+	
+	// Clear the statistics and start the stack high-water mark
+	STATS_Init();
+	STACK_Init();
 	
-	// Initialize LEDs for pedestrians 
-	LED_Init(PORTB, PIN0);
-	LED_Init(PORTB, PIN1);
-	LED_Init(PORTB, PIN2);
+	// Start the PC-sampling profiler (profiling build only)
+	PROF_Init();
+	
+	// Start the latency measurement on ICP1 (latency build only)
+	LAT_Init();
+	
+	// A watchdog reset means the firmware got stuck, stay in the fail-safe state
+	if(WDT_IsResetCause()){
+		ELOG_Init();
+		ELOG_Event(ELOG_WATCHDOG);
+		ELOG_Flush(); // the interrupts stay disabled
+		APP_FailSafe();
+		return;
+	}
+	
+	// Initialize the buttons to sense a rising edge and call APP_ButtonPressed, the application modes to normal
+	for(uint8_t k=0; k<APP_SITE_NUM; k++){
+		EXTI_SetCallback(APP_Sites[k].button, APP_Buttons[k]);
+		EXTI_Init(APP_Sites[k].button, RISING_EDGE);
+		APP_Contexts[k].mode = NORMAL;
+	}
 	
-	// Initialize Button
-	BUTTON_Init(PORTD, PIN2);
+	// Reset the controller if the main loop stops for more than 2 seconds
+	WDT_Enable(WDT_2100MS);
 	
-	// Initialize Timer (Normal mode)
-	TMR0_Init(&timerConfig_Halfsec);
+	// Load the phase plan from EEPROM, accept new plans and coordination frames over the serial port
+	UART_Init();
+	PLAN_Init();
+	CORR_Init(CORR_NODE_ID, CORR_MASTER_ID, CORR_OFFSET);
+	UART_SetRxCallback(APP_SerialReceive);
 	
-	// Initialize INT0 to sense a rising edge 
-	EXTI_Init(INT0, RISING_EDGE);
+	// Initialize the shift register outputs (SPI), not driven in the fail-safe state
+	SHIFT_Init();
 	
-	// Initialize the application mode to normal
-	appMode = NORMAL;
+	// Count the vehicles on T0 (Timer0 external clock)
+	DET_Init();
+	
+	// Start the countdown display refresh (display build only)
+	DISP_Init();
+	
+	// Start the scan of the lamp currents (monitor build only)
+	LMON_Init(APP_SenseChannels, APP_SENSE_NUM);
+	
+	// Answer the cabinet master (TWI build only), the first snapshot is taken at the first half second
+	TWI_Init();
+	
+	// Find the head of the event log and log the boot
+	ELOG_Init();
+	ELOG_Event(ELOG_BOOT);
+	
+#if PFAIL_ENABLE
+	// Resume the sequences where a power failure left them, and save them at the next droop (power-fail build only)
+	APP_PackState();
+	if(PFAIL_Init(appState, sizeof(appState))){
+		ELOG_Event(ELOG_RESTORE);
+		for(uint8_t k=0; k<APP_SITE_NUM; k++) APP_RestoreState(&APP_Contexts[k], &appState[k * APP_STATE_BYTES]);
+	}
+#endif
+	
+	// Run the tasks on the half seconds, the first sequences start at once
+	SCHED_Init(APP_Tasks, APP_TASK_NUM);
+	appStarting = 1;
+	SCHED_Post(APP_TASK_START);
 }
 
+#if APP_SITE_NUM > 1
+/*
+ * Function: APP_FailSafeFlash()
+ * This function flashes the software flash lamps in the fail-safe state, when no task runs (the interrupts may be disabled):
+ * it toggles them at each Timer1 compare match, seen as the count going back, in phase with the hardware flasher.
+ * Return value: void
+ */
+static void APP_FailSafeFlash(void){
+	uint16_t LOC_U16Count = TMR1_GetCount();
+	if(LOC_U16Count < appFlashCount){
+		appFlashOn ^= 1;
+		for(uint8_t k=1; k<APP_SITE_NUM; k++) APP_SoftFlash(&APP_Contexts[k], appFlashOn);
+	}
+	appFlashCount = LOC_U16Count;
+}
+#endif
+
+/*
+ * Function: APP_Start()
+ * This function runs one round of the tasks, it is called by the main loop.
+ * The application runs as run-to-completion tasks of the scheduler (SCHED), released at each half second:
+ * the housekeeping task first, then the steps task of each intersection. A sequence is a state (step, half seconds
+ * elapsed) and not a blocking loop, its start is a task posted at the end of the previous sequence.
+ * Nothing runs in the fail-safe state, the yellow LEDs are flashed by the timer hardware
+ * (and by the main loop for the other intersections).
+ * Return value: void
+ */
 void APP_Start(void){
-	switch(appMode){
-		case NORMAL:
-			/* 1. Car's green LED on for 5 seconds */
-			LED_On(PORTA, PIN2); // turn car's green LED on
-			LED_On(PORTB, PIN0); // turn pedestrian's red LED on
-			for(uint8_t i=0; i<10; i++){ 
-				TMR0_Delay(&timerConfig_Halfsec); // delay 0.5 second
-				
-				/* Check if button pressed and mode changed */
-				if(PEDESTRIAN == appMode) break;
-			}
-			LED_Off(PORTA, PIN2); // turn car's green LED off
-			LED_Off(PORTB, PIN0); // turn pedestrian's red LED off
-			
-			
-			/* Check if button pressed and mode changed */
-			if(PEDESTRIAN == appMode) break;
-			
-			/* 2. Car's yellow LED blinks for 5 seconds */
-			for(uint8_t i=0; i<10; i++){
-				if(0 == i%2){
-					LED_Blink(PORTA, PIN1); // toggle car's yellow LED
-					LED_Blink(PORTB, PIN1); // toggle pedestrian's yellow LED
-				}
-				TMR0_Delay(&timerConfig_Halfsec); // delay 0.5 second
-				
-				/* Check if button pressed and mode changed */
-				if(PEDESTRIAN == appMode) break;
-			}
-			LED_Off(PORTA, PIN1); // turn car's yellow LED off
-			LED_Off(PORTB, PIN1); // turn pedestrian's yellow LED off
-			
-			/* Check if button pressed and mode changed */
-			if(PEDESTRIAN == appMode) break;
-			
-			/* 3. Car's red LED on for 5 seconds */
-			LED_On(PORTA, PIN0); // turn car's red LED on
-			LED_On(PORTB, PIN2); // turn pedestrian's green LED on
-			for(uint8_t i=0; i<10; i++){
-				TMR0_Delay(&timerConfig_Halfsec); // delay 0.5 second
-				
-				/* Check if button pressed and mode changed */
-				if(PEDESTRIAN == appMode) break;
-			}
-			LED_Off(PORTA, PIN0); // turn car's red LED off
-			LED_Off(PORTB, PIN2); // turn pedestrian's green LED off
-			
-			/* Check if button pressed and mode changed */
-			if(PEDESTRIAN == appMode) break;
-			
-			/* 4. Car's yellow LED blinks for 5 seconds */
-			for(uint8_t i=0; i<10; i++){
-				if(0 == i%2){
-					LED_Blink(PORTA, PIN1); // toggle car's yellow LED
-					LED_Blink(PORTB, PIN1); // toggle pedestrian's yellow LED
-				}
-				TMR0_Delay(&timerConfig_Halfsec); // delay 0.5 second
-							
-				/* Check if button pressed and mode changed */
-				if(PEDESTRIAN == appMode) break;
-			}
-			LED_Off(PORTA, PIN1); // turn car's yellow LED off
-			LED_Off(PORTB, PIN1); // turn pedestrian's yellow LED off
-		break;
-		
-		case PEDESTRIAN:
-			/* Car's and pedestrian's yellow LEDs blink for 5 seconds */
-			for(uint8_t i=0; i<10; i++){
-				if(0 == i%2){
-					LED_Blink(PORTA, PIN1); // toggle car's yellow LED
-					LED_Blink(PORTB, PIN1); // toggle pedestrian's yellow LED
-				}
-				TMR0_Delay(&timerConfig_Halfsec); // delay 0.5 second
-			}
-			LED_Off(PORTA, PIN1); // turn car's yellow LED off
-			LED_Off(PORTB, PIN1); // turn pedestrian's yellow LED off				
-			
-			/* Car's red and pedestrian's green LEDs are on for 5 seconds */
-			LED_On(PORTA, PIN0); // turn car's red LED on
-			LED_On(PORTB, PIN2); // turn pedestrian's green LED on
-			for(uint8_t i=0; i<10; i++) TMR0_Delay(&timerConfig_Halfsec); // delay 5 seconds
-			LED_Off(PORTA, PIN0); // turn car's red LED off
-			
-			/* Car's and pedestrian's yellow LEDs blink for 5 seconds */
-			for(uint8_t i=0; i<10; i++){
-				if(0 == i%2){
-					LED_Blink(PORTA, PIN1); // toggle car's yellow LED
-					LED_Blink(PORTB, PIN1); // toggle pedestrian's yellow LED
-				}
-				TMR0_Delay(&timerConfig_Halfsec); // delay 0.5 second
-			}
-			LED_Off(PORTA, PIN1); // turn car's yellow LED off
-			LED_Off(PORTB, PIN1); // turn pedestrian's yellow LED off
-			LED_Off(PORTB, PIN2); // turn pedestrian's green LED off
-			
-			/* Back to normal mode */
-			appMode = NORMAL;
-		break;
-	}
-}
-
-ISR(EXTI0){
+	if(FAIL_SAFE != APP_Contexts[0].mode) SCHED_Dispatch();
+#if APP_SITE_NUM > 1
+	else APP_FailSafeFlash();
+#endif
+}
+
+/*
+ * Function: APP_FailSafe()
+ * This function puts the lights of all the intersections in the fail-safe state: all LEDs off and the yellow LEDs flashing.
+ * The flashing is generated by Timer1 hardware, so it keeps running even if the CPU is stuck.
+ * The watchdog is stopped and the buttons are ignored, the controller stays in this state until the next reset.
+ * The power-fail save is stopped too.
+ * Return value: void
+ */
+void APP_FailSafe(void){
+	WDT_Disable();
+	PFAIL_Stop();
+	for(uint8_t k=0; k<APP_SITE_NUM; k++){
+		EXTI_Disable(APP_Sites[k].button);
+		APP_Contexts[k].mode = FAIL_SAFE;
+		APP_SetAspect(&APP_Contexts[k], APP_ASPECT_FAIL_SAFE); // yellow LEDs flashing, the others off
+	}
+#if APP_SITE_NUM > 1
+	appFlashOn = 1;
+	appFlashCount = TMR1_GetCount();
+#endif
+}
+
+#if BOOT_ENABLE
+/*
+ * Function: APP_EnterBoot()
+ * This function leaves the application for the bootloader: the update is logged, all the intersections go to
+ * the fail-safe state, shown on the shift registers, and the log queue is written before the interrupts are disabled.
+ * The flash lamps keep flashing in hardware until the new application starts.
+ * Return value: void, it does not return
+ */
+static void APP_EnterBoot(void){
+	ELOG_Event(ELOG_UPDATE);
+	APP_FailSafe();
+	for(uint8_t k=0; k<APP_SITE_NUM; k++) APP_Outputs(&APP_Contexts[k], 1);
+	SHIFT_Flush();
+	ELOG_Flush();
+	BOOT_ENTER();
+}
+#endif
+
+/*
+ * Function: APP_ButtonPressed()
+ * This function handles the rising edge of the button of an intersection, called by its EXTI callback.
+ * It switches to the pedestrian mode unless the car's red LED is on or the controller is in the fail-safe state.
+ * Return value: void
+ */
+static void APP_ButtonPressed(ST_AppContext_t* LOC_PtrCtx){
+	const ST_AppLamp_t* LOC_PtrLamps = LOC_PtrCtx->site->lamps;
+	uint8_t LOC_U8Main = APP_IS_MAIN(LOC_PtrCtx);
+	
 	// Get the color of car's LED when the button is pressed
-	if(LED_IsOn(PORTA, PIN0)) carLEDColor = RED;
-	else if(LED_IsOn(PORTA, PIN2)) carLEDColor = GREEN;
-	else carLEDColor = YELLOW;
+	if(LED_IsOn(LOC_PtrLamps[APP_MAIN_RED].port, LOC_PtrLamps[APP_MAIN_RED].pin)) LOC_PtrCtx->carLEDColor = RED;
+	else if(LED_IsOn(LOC_PtrLamps[APP_MAIN_GREEN].port, LOC_PtrLamps[APP_MAIN_GREEN].pin)) LOC_PtrCtx->carLEDColor = GREEN;
+	else LOC_PtrCtx->carLEDColor = YELLOW;
 	
 	// Change the mode to pedestrian when the button is pressed
-	if(RED != carLEDColor) appMode = PEDESTRIAN;
+	uint8_t LOC_U8Accepted = (FAIL_SAFE != LOC_PtrCtx->mode && RED != LOC_PtrCtx->carLEDColor);
+	if(LOC_U8Accepted){
+		if(LOC_U8Main && NORMAL == LOC_PtrCtx->mode) LAT_Arm(); // the next lamp change answers this press
+		LOC_PtrCtx->mode = PEDESTRIAN;
+	}
+	if(LOC_U8Main) STATS_Press(LOC_U8Accepted);
+}
+
+/*
+ * Function: APP_Button0()
+ * This function is the INT0 callback, called by the EXTI driver on the rising edge of the button of the main intersection.
+ * Return value: void
+ */
+static void APP_Button0(void){
+	// Timestamp the ISR entry against the captured edge (latency build only)
+	LAT_IsrEntry();
+	APP_ButtonPressed(&APP_Contexts[0]);
+}
+
+#if APP_SITE_NUM > 1
+static void APP_Button1(void){
+	APP_ButtonPressed(&APP_Contexts[1]);
+}
+#endif
+
+#if APP_SITE_NUM > 2
+static void APP_Button2(void){
+	APP_ButtonPressed(&APP_Contexts[2]);
+}
+#endif
+
+/*
+ * Function: APP_SerialReceive()
+ * This function is the UART receive callback: the bytes of the coordination frames go to CORR,
+ * the others to the text commands of PLAN (standalone controller only).
+ * Return value: void
+ */
+static void APP_SerialReceive(uint8_t LOC_U8Byte){
+	if(!CORR_Receive(LOC_U8Byte)) PLAN_Receive(LOC_U8Byte);
 }
@@ -0,0 +1,92 @@
+/*
+ * File: APP_Signals.h
+ *
+ * Description:
+ * This header file contains the signal tables of the application, generated by the sigc host tool (HOST/SIGC)
+ * from APP_Signals.txt: do not edit it, change the description and run sigc again.
+ * The description was checked by sigc (conflicts, clearance, pins), the application does not check the tables.
+ * It is only included by APP_Program.c (and the host tools).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef APP_SIGNALS_H
+#define APP_SIGNALS_H
+
+#include "APP_Interface.h"
+
+// Lamps, the index is also the shift register output
+#define APP_LAMP_CAR_RED      0
+#define APP_LAMP_CAR_YELLOW   1
+#define APP_LAMP_CAR_GREEN    2
+#define APP_LAMP_PED_RED      3
+#define APP_LAMP_PED_YELLOW   4
+#define APP_LAMP_PED_GREEN    5
+#define APP_LAMP_NUM          6
+#define APP_MAIN_RED          APP_LAMP_CAR_RED // main approach
+#define APP_MAIN_GREEN        APP_LAMP_CAR_GREEN
+
+static const ST_AppLamp_t APP_Lamps[APP_LAMP_NUM] = {
+	{PORTA, PIN0, 0x00}, // car_red
+	{PORTD, PIN5, 0x01}, // car_yellow
+	{PORTA, PIN2, 0x00}, // car_green
+	{PORTB, PIN1, 0x00}, // ped_red
+	{PORTD, PIN4, 0x02}, // ped_yellow
+	{PORTB, PIN2, 0x00}, // ped_green
+};
+
+// Ports of the steady lamps and their pins
+#define APP_PORT_NUM 2
+
+static const ST_AppPort_t APP_Ports[APP_PORT_NUM] = {{PORTA, 0x05}, {PORTB, 0x06}};
+
+// Aspects: the pins lit in each port (APP_Ports order), then the flash bits of the lamps flashing
+#define APP_ASPECT_DARK      0
+#define APP_ASPECT_FAIL_SAFE 2
+#define APP_ASPECT_NUM       5
+
+static const uint8_t APP_Aspects[APP_ASPECT_NUM][APP_PORT_NUM + 1] = {
+	{0x00, 0x00, 0x00}, // dark
+	{0x04, 0x02, 0x00}, // GREEN
+	{0x00, 0x00, 0x03}, // YELLOW YELLOW_2 PED_YELLOW fail-safe
+	{0x01, 0x04, 0x00}, // RED PED_WALK
+	{0x00, 0x04, 0x03}, // PED_CLEAR
+};
+
+// Sensed lamps of the first intersection (LMON): ADC channel and lamp of each one, the sensed lamps lit in each aspect
+// and the reds (bit n: the lamp sensed on channel n of the list)
+#define APP_SENSE_NUM  2
+#define APP_SENSE_REDS 0x03
+
+static const uint8_t APP_SenseChannels[APP_SENSE_NUM] = {1, 7};
+static const uint8_t APP_SenseLamps[APP_SENSE_NUM] = {APP_LAMP_CAR_RED, APP_LAMP_PED_RED};
+static const uint8_t APP_SenseLit[APP_ASPECT_NUM] = {0x00, 0x02, 0x00, 0x01, 0x00};
+
+// Intersections: tables, button (external interrupt and pin), first shift register output, flashed in software
+#define APP_SITE_NUM 1
+
+static const ST_AppSite_t APP_Sites[APP_SITE_NUM] = {
+	{APP_Lamps, APP_Ports, APP_Aspects[0], APP_PORT_NUM, INT0, PORTD, PIN2, 0, 0},
+};
+
+// Steps: aspect, plan phase, statistics phase, flags, steps of the crossing's green starting with the step
+#define APP_NORMAL_STEPS 4
+
+static const ST_AppStep_t APP_Normal[APP_NORMAL_STEPS] = {
+	{1, PLAN_GREEN, STATS_GREEN, APP_STEP_GREEN, 0},
+	{2, PLAN_YELLOW, STATS_YELLOW, 0, 0},
+	{3, PLAN_RED, STATS_RED, 0, 1},
+	{2, PLAN_YELLOW_2, STATS_YELLOW, 0, 0},
+};
+
+#define APP_PEDESTRIAN_STEPS 3
+
+static const ST_AppStep_t APP_Pedestrian[APP_PEDESTRIAN_STEPS] = {
+	{2, PLAN_PED_YELLOW, STATS_YELLOW, 0, 0},
+	{3, PLAN_PED_WALK, STATS_RED, 0, 2},
+	{4, PLAN_PED_CLEAR, STATS_YELLOW, 0, 0},
+};
+
+#endif
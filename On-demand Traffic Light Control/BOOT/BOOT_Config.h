@@ -0,0 +1,28 @@
+/*
+ * File: BOOT_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the serial bootloader.
+ * The application only enters the bootloader ("U" command of PLAN) when BOOT_ENABLE is 1 (set it here or pass
+ * -DBOOT_ENABLE=1 to the compiler), the bootloader must then be programmed in the boot section with the fuses
+ * of FLASH_Config.h. The bootloader itself is built on its own (see README.md).
+ * A frame is dropped when the line stays quiet for BOOT_GAP_OVERFLOWS Timer2 overflows (262 ms each at 1 MHz
+ * with the 1024 prescaler) before its last byte, and the bootloader then waits for the next command:
+ * the updater must wait longer than that before it sends a frame again.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef BOOT_CONFIG_H_
+#define BOOT_CONFIG_H_
+
+#ifndef BOOT_ENABLE
+#define BOOT_ENABLE 0
+#endif
+
+#define BOOT_MAGIC         0xB007U // first word of a valid update header
+#define BOOT_GAP_OVERFLOWS 2U      // quiet Timer2 overflows that drop a frame (262 to 524 ms)
+
+#endif
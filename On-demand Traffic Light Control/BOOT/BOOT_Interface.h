@@ -0,0 +1,81 @@
+/*
+ * File: BOOT_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the serial bootloader, which replaces the application in the field
+ * over the serial port (9600 baud, 8N1) without a programmer.
+ * The bootloader runs from the boot section (FLASH_BOOT_START) at each reset and starts the application at once,
+ * unless the application is missing or a copy was interrupted. The application enters it on the "U" command
+ * (BOOT_ENTER, BOOT_ENABLE build): the lamps are left in the fail-safe state, flashed by Timer1 during the update.
+ * The application section is split in three: the application pages (BOOT_APP_PAGES), the header page of a copy
+ * in progress, and a staging copy of each application page. An update only sends the pages that changed:
+ *   - the updater asks for the CRC-16 of each application page ('C') and compares them with the new image
+ *   - the pages that differ are written to their staging page and read back ('W'), the application is untouched
+ *   - the commit ('F') checks the CRC of the new image (the staged pages and the pages kept), writes the header
+ *     (the staged pages), copies the staged pages that differ over the application, and erases the header
+ * A reset before the header is written keeps the old application, a reset after it resumes the copy at the next boot.
+ * Frames: a command byte, its arguments and the CRC-16 (CRC module, little endian) of the bytes before it. The answer is
+ * BOOT_ACK or BOOT_NAK, its data and their CRC-16. A frame with a bad CRC or an unknown command is dropped without answer,
+ * and so is a frame with a gap in it (BOOT_Config.h): the updater sends it again when the answer does not come.
+ *   - 'I': answered with BOOT_LAYOUT, FLASH_PAGE_SIZE and BOOT_APP_PAGES
+ *   - 'C' n: answered with the CRC-16 of each of the first n application pages
+ *   - 'W' p data: writes the page p (FLASH_PAGE_SIZE bytes) to its staging page, answered BOOT_NAK if it does not read back
+ *   - 'F' n crc: commits the image of n pages with the given CRC-16 and starts it, answered BOOT_NAK
+ *     (application untouched) if the CRC does not match
+ *   - 'X': starts the application without a change, answered BOOT_NAK if there is none
+ * The functions prototypes defined in this file include:
+ *   - BOOT_Start: function to start the application, or prepare the update session
+ *   - BOOT_Poll: function to wait for a byte of the session and handle it
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef BOOT_INTERFACE_H
+#define BOOT_INTERFACE_H
+
+#include "../utils/STD_TYPES.h"
+#include "../MCAL/FLASH/FLASH_Config.h"
+#include "BOOT_Private.h"
+#include "BOOT_Config.h"
+
+// Layout of the protocol and of ST_BootHeader_t, answered to 'I'
+#define BOOT_LAYOUT 1U
+
+// Application section: the application pages, the header page, then the staging pages
+#define BOOT_APP_PAGES     ((FLASH_BOOT_START / FLASH_PAGE_SIZE - 1) / 2)
+#define BOOT_HEADER_ADDR   ((uint16_t)(BOOT_APP_PAGES * FLASH_PAGE_SIZE))
+#define BOOT_STAGE_ADDR(p) ((uint16_t)((BOOT_APP_PAGES + 1 + (p)) * FLASH_PAGE_SIZE))
+#define BOOT_MAP_BYTES     (((BOOT_APP_PAGES + 15) / 16) * 2) // even: no padding in the header
+
+// Commands and answers
+#define BOOT_CMD_INFO   'I'
+#define BOOT_CMD_CRC    'C'
+#define BOOT_CMD_WRITE  'W'
+#define BOOT_CMD_FINISH 'F'
+#define BOOT_CMD_EXIT   'X'
+#define BOOT_ACK        'K'
+#define BOOT_NAK        'N'
+
+// Reset flags of MCUCSR (power-on, external, brown-out, watchdog, JTAG), all cleared: entered by the application
+#define BOOT_RESET_FLAGS 0x1FU
+
+// Header of a copy in progress (no padding on the target or on the host), the check covers the bytes before it
+typedef struct {
+	uint16_t magic;                 // BOOT_MAGIC
+	uint16_t crc;                   // CRC-16 of the new image
+	uint8_t staged[BOOT_MAP_BYTES]; // bit p: the staging page p is copied to the application page p
+	uint8_t pages;                  // application pages of the new image
+	uint8_t layout;                 // BOOT_LAYOUT
+	uint16_t check;
+} ST_BootHeader_t;
+
+// Enters the bootloader from the application, with the outputs in a safe state: it does not return
+#define BOOT_ENTER() do{ CPU_CLI(); MCUCSR &= ~BOOT_RESET_FLAGS; CPU_JUMP(FLASH_BOOT_START); }while(0)
+
+// BOOT function prototypes
+void BOOT_Start(void);
+void BOOT_Poll(void);
+
+#endif
@@ -0,0 +1,21 @@
+/*
+ * File: BOOT_Private.h
+ *
+ * Description:
+ * This header file contains the address of the register read by the bootloader to tell a reset from a jump of the application.
+ * MCUCSR holds a flag for each reset source, set by the hardware and only cleared by writing it to zero:
+ * the application clears them all before it jumps to the bootloader, the bootloader never clears them.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef BOOT_PRIVATE_H
+#define BOOT_PRIVATE_H
+
+#include "../utils/IO_ACCESS.h"
+
+#define MCUCSR  IO_REG8(0x54)
+
+#endif
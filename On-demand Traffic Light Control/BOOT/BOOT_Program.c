@@ -0,0 +1,339 @@
+/*
+ * File: BOOT_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the serial bootloader declared in BOOT_Interface.h.
+ * It runs with the interrupts disabled: the bytes are polled (UART_ReceiveByte), and the gaps in a frame are measured
+ * with the Timer2 overflows. A frame is collected in BOOT_Frame, which also holds the page written to the flash.
+ * The CRCs of the pages are computed from the flash, a byte at a time (about 100 cycles per byte, 1.5 s for
+ * the whole application at 1 MHz), so the bootloader needs no page buffer of its own.
+ * A page is only written when its content changes, the page writes are the slow part of an update (9 ms)
+ * and the flash endurance is 10000 cycles.
+ * Timer2 is stopped before the application is started, the UART is left on: the application initializes it again.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "BOOT_Interface.h"
+#include "../MCAL/FLASH/FLASH_Interface.h"
+#include "../MCAL/UART/UART_Interface.h"
+#include "../MCAL/TMR2/TMR2_Interface.h"
+#include "../SERVICES/CRC/CRC_Interface.h"
+
+// Longest frame: 'W', the page number, the page and the CRC
+#define BOOT_FRAME_MAX (2 + FLASH_PAGE_SIZE + 2)
+
+#if BOOT_FRAME_MAX > 255
+#error "the frame length must fit in a byte"
+#endif
+
+static uint8_t BOOT_Frame[BOOT_FRAME_MAX];   // frame received, or page to write
+static uint8_t BOOT_Len;                     // bytes of the frame received
+static uint8_t BOOT_Need;                    // length of the frame
+static uint8_t BOOT_Drop;                    // bad frame: the bytes are dropped until the line is quiet
+static uint8_t BOOT_Quiet;                   // Timer2 overflows since the last byte
+static uint8_t BOOT_Staged[BOOT_MAP_BYTES];  // staging pages written in this session
+static uint16_t BOOT_TxCrc;                  // CRC of the answer being sent
+
+/*
+ * Function: BOOT_Length()
+ * Description: Gets the length of the frame of a command, its CRC included.
+ * Returns: the length, 0 for an unknown command
+ */
+static uint8_t BOOT_Length(uint8_t LOC_U8Command){
+	switch(LOC_U8Command){
+		case BOOT_CMD_INFO:
+		case BOOT_CMD_EXIT:   return 3;
+		case BOOT_CMD_CRC:    return 4;
+		case BOOT_CMD_WRITE:  return BOOT_FRAME_MAX;
+		case BOOT_CMD_FINISH: return 6;
+		default:              return 0;
+	}
+}
+
+/*
+ * Function: BOOT_Send()
+ * Description: Sends one byte of the answer and adds it to its CRC.
+ */
+static void BOOT_Send(uint8_t LOC_U8Byte){
+	BOOT_TxCrc = CRC_16Update(BOOT_TxCrc, LOC_U8Byte);
+	UART_SendByte(LOC_U8Byte);
+}
+
+static void BOOT_Begin(uint8_t LOC_U8Status){
+	BOOT_TxCrc = CRC_16_INIT;
+	BOOT_Send(LOC_U8Status);
+}
+
+static void BOOT_End(void){
+	uint16_t LOC_U16Crc = BOOT_TxCrc;
+	UART_SendByte((uint8_t)LOC_U16Crc);
+	UART_SendByte((uint8_t)(LOC_U16Crc >> 8));
+}
+
+/*
+ * Function: BOOT_Answer()
+ * Description: Sends an answer without data.
+ */
+static void BOOT_Answer(uint8_t LOC_U8Status){
+	BOOT_Begin(LOC_U8Status);
+	BOOT_End();
+}
+
+/*
+ * Function: BOOT_Overflow()
+ * Description: Tells whether Timer2 overflowed since the last call, and clears the flag.
+ */
+static uint8_t BOOT_Overflow(void){
+	if(!GET_BIT(TIFR, TOV2)) return 0;
+	TIFR = (1<<TOV2); // cleared by writing one
+	return 1;
+}
+
+/*
+ * Function: BOOT_PageCrc()
+ * Description: Adds the bytes of a page of the flash to a CRC-16.
+ */
+static uint16_t BOOT_PageCrc(uint16_t LOC_U16Crc, uint16_t LOC_U16Address){
+	for(uint8_t i=0; i<FLASH_PAGE_SIZE; i++) LOC_U16Crc = CRC_16Update(LOC_U16Crc, FLASH_ReadByte(LOC_U16Address + i));
+	return LOC_U16Crc;
+}
+
+/*
+ * Function: BOOT_SamePage()
+ * Description: Compares a page of the flash with another page, or with BOOT_Frame + 2 when the address of the other one is 0.
+ */
+static uint8_t BOOT_SamePage(uint16_t LOC_U16Address, uint16_t LOC_U16Other){
+	for(uint8_t i=0; i<FLASH_PAGE_SIZE; i++){
+		uint8_t LOC_U8Other = LOC_U16Other ? FLASH_ReadByte(LOC_U16Other + i) : BOOT_Frame[2 + i];
+		if(FLASH_ReadByte(LOC_U16Address + i) != LOC_U8Other) return 0;
+	}
+	return 1;
+}
+
+/*
+ * Function: BOOT_ImageCrc()
+ * Description: Gets the CRC-16 of the image made of the staged pages and of the application pages kept.
+ */
+static uint16_t BOOT_ImageCrc(const uint8_t* LOC_PtrStaged, uint8_t LOC_U8Pages){
+	uint16_t LOC_U16Crc = CRC_16_INIT;
+	for(uint8_t p=0; p<LOC_U8Pages; p++){
+		uint8_t LOC_U8Staged = GET_BIT(LOC_PtrStaged[p >> 3], p & 7);
+		LOC_U16Crc = BOOT_PageCrc(LOC_U16Crc, LOC_U8Staged ? BOOT_STAGE_ADDR(p) : (uint16_t)(p * FLASH_PAGE_SIZE));
+	}
+	return LOC_U16Crc;
+}
+
+/*
+ * Function: BOOT_Copy()
+ * Description: Copies the staged pages of a header over the application pages, the pages already equal are skipped.
+ * It is run again from the start after a reset, the staging pages do not change.
+ * Returns: 1 if all the pages read back, 0 otherwise
+ */
+static uint8_t BOOT_Copy(const ST_BootHeader_t* LOC_PtrHeader){
+	uint8_t LOC_U8Ok = 1;
+	for(uint8_t p=0; p<LOC_PtrHeader->pages; p++){
+		if(!GET_BIT(LOC_PtrHeader->staged[p >> 3], p & 7)) continue;
+		uint16_t LOC_U16Address = p * FLASH_PAGE_SIZE;
+		if(BOOT_SamePage(LOC_U16Address, BOOT_STAGE_ADDR(p))) continue;
+		for(uint8_t i=0; i<FLASH_PAGE_SIZE; i++) BOOT_Frame[2 + i] = FLASH_ReadByte(BOOT_STAGE_ADDR(p) + i);
+		FLASH_WritePage(LOC_U16Address, &BOOT_Frame[2]);
+		if(!BOOT_SamePage(LOC_U16Address, 0)) LOC_U8Ok = 0;
+	}
+	return LOC_U8Ok;
+}
+
+/*
+ * Function: BOOT_ReadHeader()
+ * Description: Reads the header page.
+ * Returns: 1 if it holds the header of a copy in progress, 0 otherwise (erased or half written)
+ */
+static uint8_t BOOT_ReadHeader(ST_BootHeader_t* LOC_PtrHeader){
+	uint8_t* LOC_PtrBytes = (uint8_t*)LOC_PtrHeader;
+	for(uint8_t i=0; i<sizeof(ST_BootHeader_t); i++) LOC_PtrBytes[i] = FLASH_ReadByte(BOOT_HEADER_ADDR + i);
+	return BOOT_MAGIC == LOC_PtrHeader->magic && BOOT_LAYOUT == LOC_PtrHeader->layout &&
+	       LOC_PtrHeader->pages <= BOOT_APP_PAGES &&
+	       CRC_16(LOC_PtrBytes, sizeof(ST_BootHeader_t) - sizeof(uint16_t)) == LOC_PtrHeader->check;
+}
+
+/*
+ * Function: BOOT_AppPresent()
+ * Description: Tells whether the application section holds a program (its reset vector is not erased).
+ */
+static uint8_t BOOT_AppPresent(void){
+	return 0xFF != FLASH_ReadByte(0) || 0xFF != FLASH_ReadByte(1);
+}
+
+/*
+ * Function: BOOT_StartApp()
+ * Description: Starts the application from its reset vector, after the answer has left the UART
+ * (two characters, 2.1 ms at 9600 baud, the Timer2 overflow at the 32 prescaler takes 8.2 ms).
+ */
+static void BOOT_StartApp(uint8_t LOC_U8Drain){
+	if(LOC_U8Drain){
+		TMR2_Start(TMR2_PRE_32);
+		TIFR = (1<<TOV2);
+		while(!BOOT_Overflow()) IO_POLL();
+		TMR2_Stop();
+	}
+	CPU_JUMP(0);
+}
+
+/*
+ * Function: BOOT_Finish()
+ * Description: Handles the commit: checks the image, writes the header, copies the staged pages and starts the new application.
+ * The header is erased once the application is complete.
+ */
+static void BOOT_Finish(void){
+	uint8_t LOC_U8Pages = BOOT_Frame[1];
+	uint16_t LOC_U16Crc = BOOT_Frame[2] | ((uint16_t)BOOT_Frame[3] << 8);
+	if(!LOC_U8Pages || LOC_U8Pages > BOOT_APP_PAGES){
+		BOOT_Answer(BOOT_NAK);
+		return;
+	}
+	for(uint8_t p=LOC_U8Pages; p<BOOT_MAP_BYTES * 8; p++) CLR_BIT(BOOT_Staged[p >> 3], p & 7); // pages outside the image
+	if(BOOT_ImageCrc(BOOT_Staged, LOC_U8Pages) != LOC_U16Crc){
+		BOOT_Answer(BOOT_NAK);
+		return;
+	}
+
+	// Header first: from now on a reset completes the copy
+	ST_BootHeader_t LOC_Header;
+	LOC_Header.magic = BOOT_MAGIC;
+	LOC_Header.crc = LOC_U16Crc;
+	for(uint8_t i=0; i<BOOT_MAP_BYTES; i++) LOC_Header.staged[i] = BOOT_Staged[i];
+	LOC_Header.pages = LOC_U8Pages;
+	LOC_Header.layout = BOOT_LAYOUT;
+	LOC_Header.check = CRC_16((const uint8_t*)&LOC_Header, sizeof(ST_BootHeader_t) - sizeof(uint16_t));
+	for(uint8_t i=0; i<FLASH_PAGE_SIZE; i++) BOOT_Frame[2 + i] = (i < sizeof(ST_BootHeader_t)) ? ((const uint8_t*)&LOC_Header)[i] : 0xFF;
+	FLASH_WritePage(BOOT_HEADER_ADDR, &BOOT_Frame[2]);
+
+	if(!BOOT_Copy(&LOC_Header)){
+		BOOT_Answer(BOOT_NAK); // the header stays, the next commit or reset copies again
+		return;
+	}
+	FLASH_ErasePage(BOOT_HEADER_ADDR);
+	BOOT_Answer(BOOT_ACK);
+	BOOT_StartApp(1);
+}
+
+/*
+ * Function: BOOT_Command()
+ * Description: Handles a frame received with a good CRC.
+ */
+static void BOOT_Command(void){
+	uint8_t LOC_U8Page = BOOT_Frame[1];
+	switch(BOOT_Frame[0]){
+		case BOOT_CMD_INFO:
+			BOOT_Begin(BOOT_ACK);
+			BOOT_Send(BOOT_LAYOUT);
+			BOOT_Send(FLASH_PAGE_SIZE);
+			BOOT_Send(BOOT_APP_PAGES);
+			BOOT_End();
+		break;
+		case BOOT_CMD_CRC:
+			if(LOC_U8Page > BOOT_APP_PAGES){
+				BOOT_Answer(BOOT_NAK);
+				break;
+			}
+			BOOT_Begin(BOOT_ACK);
+			for(uint8_t p=0; p<LOC_U8Page; p++){
+				uint16_t LOC_U16Crc = BOOT_PageCrc(CRC_16_INIT, p * FLASH_PAGE_SIZE);
+				BOOT_Send((uint8_t)LOC_U16Crc);
+				BOOT_Send((uint8_t)(LOC_U16Crc >> 8));
+			}
+			BOOT_End();
+		break;
+		case BOOT_CMD_WRITE:
+			if(LOC_U8Page >= BOOT_APP_PAGES){
+				BOOT_Answer(BOOT_NAK);
+				break;
+			}
+			CLR_BIT(BOOT_Staged[LOC_U8Page >> 3], LOC_U8Page & 7);
+			if(!BOOT_SamePage(BOOT_STAGE_ADDR(LOC_U8Page), 0)) FLASH_WritePage(BOOT_STAGE_ADDR(LOC_U8Page), &BOOT_Frame[2]);
+			if(!BOOT_SamePage(BOOT_STAGE_ADDR(LOC_U8Page), 0)){
+				BOOT_Answer(BOOT_NAK);
+				break;
+			}
+			SET_BIT(BOOT_Staged[LOC_U8Page >> 3], LOC_U8Page & 7);
+			BOOT_Answer(BOOT_ACK);
+		break;
+		case BOOT_CMD_FINISH:
+			BOOT_Finish();
+		break;
+		case BOOT_CMD_EXIT:
+			if(!BOOT_AppPresent()){
+				BOOT_Answer(BOOT_NAK);
+				break;
+			}
+			BOOT_Answer(BOOT_ACK);
+			BOOT_StartApp(1);
+		break;
+	}
+}
+
+/*
+ * Function: BOOT_Start()
+ * Description: This function is called first after a reset or a jump of the application.
+ * A copy in progress is completed, then the application is started if it is complete, or right away after a reset
+ * if there is one. Otherwise the session starts: UART at 9600 baud (interrupts disabled) and Timer2 for the gaps.
+ * Return value: void, it does not return when the application is started
+ */
+void BOOT_Start(void){
+	ST_BootHeader_t LOC_Header;
+	uint8_t LOC_U8Jumped = !(MCUCSR & BOOT_RESET_FLAGS);
+	if(BOOT_ReadHeader(&LOC_Header)){
+		uint8_t LOC_U8Done = BOOT_Copy(&LOC_Header) && BOOT_ImageCrc(LOC_Header.staged, LOC_Header.pages) == LOC_Header.crc;
+		FLASH_ErasePage(BOOT_HEADER_ADDR);
+		if(LOC_U8Done) BOOT_StartApp(0);
+		LOC_U8Jumped = 1; // the application is broken, wait for an update
+	}
+	if(!LOC_U8Jumped && BOOT_AppPresent()) BOOT_StartApp(0);
+
+	for(uint8_t i=0; i<BOOT_MAP_BYTES; i++) BOOT_Staged[i] = 0;
+	BOOT_Len = 0;
+	BOOT_Drop = 0;
+	BOOT_Quiet = 0;
+	UART_Init();
+	TMR2_Start(TMR2_PRE_1024);
+	TIFR = (1<<TOV2);
+}
+
+/*
+ * Function: BOOT_Poll()
+ * Description: This function waits for the next byte of the session and handles the frame it completes.
+ * A frame not complete when the line has been quiet for BOOT_GAP_OVERFLOWS overflows is dropped.
+ * Return value: void, it does not return when the application is started
+ */
+void BOOT_Poll(void){
+	uint8_t LOC_U8Byte;
+	while(!UART_ReceiveByte(&LOC_U8Byte)){
+		if(BOOT_Overflow() && ++BOOT_Quiet >= BOOT_GAP_OVERFLOWS){
+			BOOT_Quiet = 0;
+			BOOT_Len = 0;
+			BOOT_Drop = 0;
+		}
+		IO_POLL();
+	}
+	BOOT_Quiet = 0;
+	if(BOOT_Drop) return;
+	if(!BOOT_Len){
+		BOOT_Need = BOOT_Length(LOC_U8Byte);
+		if(!BOOT_Need){
+			BOOT_Drop = 1;
+			return;
+		}
+	}
+	BOOT_Frame[BOOT_Len++] = LOC_U8Byte;
+	if(BOOT_Len < BOOT_Need) return;
+
+	BOOT_Len = 0;
+	uint16_t LOC_U16Crc = BOOT_Frame[BOOT_Need - 2] | ((uint16_t)BOOT_Frame[BOOT_Need - 1] << 8);
+	if(CRC_16(BOOT_Frame, BOOT_Need - 2) != LOC_U16Crc){
+		BOOT_Drop = 1; // a command byte changed on the line could have a shorter frame
+		return;
+	}
+	BOOT_Command();
+}
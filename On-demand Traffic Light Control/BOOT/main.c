@@ -0,0 +1,24 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the main entry point of the serial bootloader, built on its own and placed at FLASH_BOOT_START
+ * (see the "Firmware Update" section of README.md). It starts the application or runs the update session
+ * until the application is started.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "BOOT_Interface.h"
+
+int main(void)
+{
+	BOOT_Start();
+	
+	while (1)
+	{
+		BOOT_Poll();
+	}
+}
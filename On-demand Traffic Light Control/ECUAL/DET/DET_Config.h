@@ -0,0 +1,21 @@
+/*
+ * File: DET_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the vehicle detector input.
+ * The loop detector output goes to T0 (PIN 0 in PORTB), the Timer0 external clock input,
+ * and each vehicle is counted on one edge of its pulse.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef DET_CONFIG_H
+#define DET_CONFIG_H
+
+#define DET_PORT PORTB
+#define DET_PIN  PIN0             // T0
+#define DET_EDGE TMR0_EXT_RISING  // TMR0_EXT_RISING: vehicle entering the loop, TMR0_EXT_FALLING: leaving it
+
+#endif
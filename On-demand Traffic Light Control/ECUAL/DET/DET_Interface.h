@@ -0,0 +1,29 @@
+/*
+ * File: DET_Interface.h
+ *
+ * Description:
+ * This header file contains the function prototypes for the vehicle detector driver.
+ * The pulses of the loop detector clock Timer0 (external clock on T0), so the vehicles are counted by the hardware
+ * without any interrupt or CPU time. The application reads the counter once per half second,
+ * the difference with the previous read is the number of vehicles in between (up to 255).
+ * Timer0 is not available for delays (LED_Blink, TMR0_Delay) while the detector is used.
+ * The functions provided by the driver include:
+ *  - Initializing the detector input and starting the counter
+ *  - Reading the vehicles detected since the previous read
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef DET_INTERFACE_H
+#define DET_INTERFACE_H
+
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+#include "../../MCAL/TMR0/TMR0_Interface.h"
+#include "DET_Config.h"
+
+void DET_Init(void);
+uint8_t DET_Read(void);
+
+#endif
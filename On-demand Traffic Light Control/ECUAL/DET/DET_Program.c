@@ -0,0 +1,41 @@
+/*
+ * File: DET_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the vehicle detector driver declared in DET_Interface.h.
+ * Timer0 runs in normal mode on the external clock and is never reloaded, the counter wraps from 255 to 0
+ * and the 8-bit difference between two reads stays right as long as less than 256 vehicles pass in between.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "DET_Interface.h"
+
+static uint8_t DET_Last; // counter at the previous read
+
+/*
+ * Function: DET_Init()
+ * Description: This function sets the detector pin as an input and starts Timer0 counting its edges from zero.
+ * Return value: void
+ */
+void DET_Init(void){
+	ST_TimerConfig_t LOC_Config = {0, 0, TMR_NORMAL, DET_EDGE};
+	GPIO_SetPinDir(DET_PORT, DET_PIN, INPUT);
+	TMR0_Init(&LOC_Config);
+	TMR0_Start(&LOC_Config);
+	DET_Last = 0;
+}
+
+/*
+ * Function: DET_Read()
+ * Description: This function gets the number of vehicles detected since the previous read (or DET_Init).
+ * Return value: the number of vehicles
+ */
+uint8_t DET_Read(void){
+	uint8_t LOC_U8Count = TMR0_GetCount();
+	uint8_t LOC_U8Vehicles = LOC_U8Count - DET_Last;
+	DET_Last = LOC_U8Count;
+	return LOC_U8Vehicles;
+}
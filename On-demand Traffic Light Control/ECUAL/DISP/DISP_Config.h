@@ -0,0 +1,30 @@
+/*
+ * File: DISP_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the pedestrian countdown display.
+ * The display is only built when DISP_ENABLE is 1 (set it here or pass -DDISP_ENABLE=1 to the compiler).
+ * It takes the whole of PORTC: the segments a to g on PIN 0 to PIN 6 (active high, common cathode digits)
+ * and the digit select on PIN 7, high for the tens digit and low for the units digit (through an inverter).
+ * The JTAG interface must be disabled (JTAGEN fuse) to use PIN 2 to PIN 5 of PORTC.
+ * The refresh interrupt is the Timer2 compare match: 1 MHz / 32 / (124 + 1) = 250 Hz, each digit is lit
+ * for 4 ms and refreshed 125 times per second.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef DISP_CONFIG_H
+#define DISP_CONFIG_H
+
+#ifndef DISP_ENABLE
+#define DISP_ENABLE 0
+#endif
+
+#define DISP_PORT       PORTC
+#define DISP_SELECT_PIN PIN7          // high: tens digit, low: units digit
+#define DISP_PRESCALER  TMR2_PRE_32
+#define DISP_TOP        124U          // Timer2 counts per refresh - 1
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * File: DISP_Interface.h
+ *
+ * Description:
+ * This header file contains the function prototypes for the 2-digit multiplexed 7-segment display driver,
+ * which shows the pedestrian countdown (display build only).
+ * The refresh interrupt lights one digit at a time: it writes the port once with the segments and the digit select
+ * of the next digit, taken from a frame prepared in advance, so each refresh costs the same few cycles
+ * whatever the main loop is doing.
+ * The frames are computed from the segment table by DISP_Show, in a second buffer which is swapped in with a single
+ * byte write: the refresh never shows the tens of one value with the units of the other.
+ * The functions provided by the driver include:
+ *  - Initializing the port and the refresh interrupt (display blank)
+ *  - Showing a number from 0 to 99 (larger numbers show 99), or blanking the display
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef DISP_INTERFACE_H
+#define DISP_INTERFACE_H
+
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+#include "DISP_Config.h"
+
+// Value of DISP_Show blanking the display
+#define DISP_BLANK 0xFF
+
+#if DISP_ENABLE
+
+void DISP_Init(void);
+void DISP_Show(uint8_t LOC_U8Value);
+
+#else
+
+#define DISP_Init()
+#define DISP_Show(value)
+
+#endif
+
+#endif
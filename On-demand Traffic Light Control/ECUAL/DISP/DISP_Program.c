@@ -0,0 +1,81 @@
+/*
+ * File: DISP_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the countdown display driver declared in DISP_Interface.h.
+ * A frame is the port value lighting one digit: its segments from DISP_Segments and the digit select.
+ * The frames of the value shown are in DISP_Frames[DISP_Front], DISP_Show fills the other pair and then changes
+ * DISP_Front. The refresh interrupt only toggles the digit and writes one frame to the port.
+ * The leading zero is not shown.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "DISP_Interface.h"
+
+#if DISP_ENABLE
+
+#include "../../MCAL/TMR2/TMR2_Interface.h"
+#include "../../MCAL/EXTI/EXTI_Interface.h"
+
+#define DISP_TENS  (1<<DISP_SELECT_PIN)
+#define DISP_UNITS 0
+
+// Segments of the digits 0 to 9 (bit 0 = a ... bit 6 = g), then the blank digit
+static const uint8_t DISP_Segments[11] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x00};
+
+static uint8_t DISP_Frames[2][2];  // two pairs of frames (units, tens)
+static volatile uint8_t DISP_Front; // pair shown by the refresh interrupt
+static uint8_t DISP_Digit;          // digit lit now (0: units, 1: tens)
+
+/*
+ * Function: DISP_Init()
+ * Description: This function sets the display port as an output, blanks the display and starts the refresh interrupt
+ * (Timer2 CTC mode). The interrupts are enabled later (EXTI_Init).
+ * Return value: void
+ */
+void DISP_Init(void){
+	GPIO_SetPortDir(DISP_PORT, 0xFF); // all the pins are outputs
+	GPIO_SetPortVal(DISP_PORT, 0);
+	for(uint8_t i=0; i<2; i++){
+		DISP_Frames[i][0] = DISP_Segments[10] | DISP_UNITS;
+		DISP_Frames[i][1] = DISP_Segments[10] | DISP_TENS;
+	}
+	DISP_Front = 0;
+	DISP_Digit = 0;
+	TMR2_StartCtc(DISP_PRESCALER, DISP_TOP);
+	TMR2_EnableInt(OCIE2);
+}
+
+/*
+ * Function: DISP_Show()
+ * Description: This function shows a number from the next refresh on, it is called from the main loop only.
+ * Arguments:
+ *   - LOC_U8Value: the number (0 to 99, larger numbers show 99), DISP_BLANK to blank the display
+ * Return value: void
+ */
+void DISP_Show(uint8_t LOC_U8Value){
+	uint8_t LOC_U8Tens = 10, LOC_U8Units = 10;
+	if(DISP_BLANK != LOC_U8Value){
+		if(LOC_U8Value > 99) LOC_U8Value = 99;
+		LOC_U8Tens = LOC_U8Value / 10;
+		LOC_U8Units = LOC_U8Value % 10;
+		if(0 == LOC_U8Tens) LOC_U8Tens = 10; // no leading zero
+	}
+	uint8_t LOC_U8Back = DISP_Front ^ 1;
+	DISP_Frames[LOC_U8Back][0] = DISP_Segments[LOC_U8Units] | DISP_UNITS;
+	DISP_Frames[LOC_U8Back][1] = DISP_Segments[LOC_U8Tens] | DISP_TENS;
+	DISP_Front = LOC_U8Back; // the refresh takes the new pair from now on
+}
+
+/*
+ * ISR: Timer2 compare match, lights the other digit.
+ */
+ISR(TMR2_COMP){
+	DISP_Digit ^= 1;
+	GPIO_SetPortVal(DISP_PORT, DISP_Frames[DISP_Front][DISP_Digit]);
+}
+
+#endif
@@ -8,9 +8,11 @@
  *  - Initializing an LED
  *  - Turning on an LED
  *  - Turning off an LED
+ *  - Setting a group of LEDs of one port at once (one port write)
  *  - Blinking an LED with a specific blink rate
  *  - Blinking two LEDs with a specific blink rate
  *  - Checking if an LED is currently on
+ *  - Flashing an LED at 1 Hz in hardware using Timer1 output compare toggle (only LEDs on OC1A/PD5 and OC1B/PD4)
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -23,12 +25,17 @@
 
 #include "../../MCAL/GPIO/GPIO_Interface.h"
 #include "../../MCAL/TMR0/TMR0_Interface.h"
+#include "../../MCAL/TMR1/TMR1_Interface.h"
 
 void LED_Init(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
 void LED_On(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
 void LED_Off(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
+void LED_SetGroup(uint8_t LOC_U8Port, uint8_t LOC_U8Mask, uint8_t LOC_U8Value);
 void LED_Blink(uint8_t LOC_U8Port, uint8_t LOC_U8Pin, ST_TimerConfig_t* config);
 void LED_TwoBlink(uint8_t LOC_U8CarPort, uint8_t LOC_U8CarPin, uint8_t LOC_U8PedPort, uint8_t LOC_U8PedPin, ST_TimerConfig_t* config);
 uint8_t LED_IsOn(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
+void LED_FlashInit(void);
+void LED_FlashStart(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
+void LED_FlashStop(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
 
 #endif
\ No newline at end of file
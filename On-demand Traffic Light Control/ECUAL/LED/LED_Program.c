@@ -7,9 +7,11 @@
  *   - Initialize an LED
  *   - Turn on an LED
  *   - Turn off an LED
+ *   - Set a group of LEDs of one port at once
  *   - Blink an LED with a specific blink rate
  *   - Blink two LEDs with a specific blink rate
  *   - Check if an LED is currently on
+ *   - Flash an LED in hardware using Timer1 output compare toggle
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -19,6 +21,20 @@
 
 #include "LED_Interface.h"
 
+// Timer1 toggles the flashing pins every 0.5 second (1 Hz flash)
+static ST_Timer1Config_t timerConfig_Flash = {TOP_VALUE_HALF_SEC, TMR1_CTC, TMR1_PRESCALER};
+
+/*
+ * Function: LED_FlashChannel()
+ * This function maps an LED port and pin to the Timer1 output compare channel driving it.
+ * Return value: TMR1_CH_A for PD5 (OC1A), TMR1_CH_B for PD4 (OC1B), 0xFF if the pin can not be flashed in hardware
+ */
+static uint8_t LED_FlashChannel(uint8_t LOC_U8Port, uint8_t LOC_U8Pin){
+	if(PORTD == LOC_U8Port && PIN5 == LOC_U8Pin) return TMR1_CH_A;
+	if(PORTD == LOC_U8Port && PIN4 == LOC_U8Pin) return TMR1_CH_B;
+	return 0xFF;
+}
+
 /*
  * Function: LED_Init()
  * This function is used to initialize an LED connected to a specified port and pin.
@@ -45,6 +61,20 @@ void LED_On(uint8_t LOC_U8Port, uint8_t LOC_U8Pin){
 	GPIO_SetPinVal(LOC_U8Port, LOC_U8Pin, HIGH);
 }
 
+/*
+ * Function: LED_SetGroup()
+ * This function is used to set the LEDs connected to some pins of a port in one port write:
+ * the LEDs of the mask are turned on if their bit is set in the value and off otherwise, the other pins are not changed.
+ * Arguments:
+ *   - LOC_U8Port: the port of the LEDs (e.g. PORTA, PORTB, etc.)
+ *   - LOC_U8Mask: the pins of the LEDs (bit i for pin i)
+ *   - LOC_U8Value: the LEDs to turn on (bit i for pin i)
+ * Return value: void
+ */
+void LED_SetGroup(uint8_t LOC_U8Port, uint8_t LOC_U8Mask, uint8_t LOC_U8Value){
+	GPIO_SetPortBits(LOC_U8Port, LOC_U8Mask, LOC_U8Value);
+}
+
 /*
  * Function: LED_Off()
  * This function is used to turn off an LED connected to a specified port and pin.
@@ -120,4 +150,52 @@ void LED_TwoBlink(uint8_t LOC_U8CarPort, uint8_t LOC_U8CarPin, uint8_t LOC_U8Ped
  */
 uint8_t LED_IsOn(uint8_t LOC_U8Port, uint8_t LOC_U8Pin){
 	return GPIO_GetPinVal(LOC_U8Port, LOC_U8Pin);
-}
\ No newline at end of file
+}
+
+/*
+ * Function: LED_FlashInit()
+ * This function is used to initialize the hardware flasher.
+ * It starts Timer1 in CTC mode so that a compare match happens every 0.5 second,
+ * the pins are not connected to the timer until LED_FlashStart is called.
+ * Return value: void
+ */
+void LED_FlashInit(void){
+	TMR1_Init(&timerConfig_Flash);
+	TMR1_Start(&timerConfig_Flash);
+}
+
+/*
+ * Function: LED_FlashStart()
+ * This function is used to start flashing an LED at 1 Hz without any CPU work.
+ * The LED is turned on immediately and then toggled by the timer hardware on every compare match,
+ * so the flash keeps its rate even if the main loop is busy or stalled.
+ * The timer is not restarted (its periods are also the half seconds of the application, TICK):
+ * LEDs started together toggle on the same compare matches and flash in phase.
+ * Arguments:
+ *   - LOC_U8Port: the port of the LED (only PORTD)
+ *   - LOC_U8Pin: the pin of the LED (only PIN5 (OC1A) or PIN4 (OC1B))
+ * Return value: void
+ */
+void LED_FlashStart(uint8_t LOC_U8Port, uint8_t LOC_U8Pin){
+	uint8_t LOC_U8Channel = LED_FlashChannel(LOC_U8Port, LOC_U8Pin);
+	if(0xFF == LOC_U8Channel) return; // not an output compare pin
+	TMR1_ForcePin(LOC_U8Channel, HIGH);
+	TMR1_SetCompareOutput(LOC_U8Channel, OC_TOGGLE);
+}
+
+/*
+ * Function: LED_FlashStop()
+ * This function is used to stop flashing an LED and leave it off.
+ * The pin is disconnected from the timer and driven again by its PORT register bit.
+ * Arguments:
+ *   - LOC_U8Port: the port of the LED (only PORTD)
+ *   - LOC_U8Pin: the pin of the LED (only PIN5 (OC1A) or PIN4 (OC1B))
+ * Return value: void
+ */
+void LED_FlashStop(uint8_t LOC_U8Port, uint8_t LOC_U8Pin){
+	uint8_t LOC_U8Channel = LED_FlashChannel(LOC_U8Port, LOC_U8Pin);
+	if(0xFF == LOC_U8Channel) return; // not an output compare pin
+	TMR1_ForcePin(LOC_U8Channel, LOW);
+	TMR1_SetCompareOutput(LOC_U8Channel, OC_DISCONNECTED);
+	LED_Off(LOC_U8Port, LOC_U8Pin);
+}
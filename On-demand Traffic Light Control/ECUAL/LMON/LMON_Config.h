@@ -0,0 +1,29 @@
+/*
+ * File: LMON_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the lamp current monitor.
+ * The monitor is only built when LMON_ENABLE is 1 (set it here or pass -DLMON_ENABLE=1 to the compiler).
+ * The current of each sensed lamp flows through a sense resistor, whose voltage goes to an ADC channel (PORTA),
+ * the channels are given by the intersection description (sense lines of APP_Signals.txt).
+ * A lit lamp is out when its average stays under LMON_LEVEL (8-bit ADC counts, 0.78 V with the 5 V AVCC reference)
+ * for LMON_CONFIRM checks in a row: the average of a lamp turned on settles in about 0.2 s (two channels), and each check comes
+ * about half a second after the lamps changed, so a lamp is never reported while its average rises.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef LMON_CONFIG_H
+#define LMON_CONFIG_H
+
+#ifndef LMON_ENABLE
+#define LMON_ENABLE 0
+#endif
+
+#define LMON_PORT    PORTA // ADC inputs
+#define LMON_LEVEL   40U   // ADC counts (8-bit) of the smallest current of a lit lamp
+#define LMON_CONFIRM 2U    // checks (half seconds) under the level before a lamp is out
+
+#endif
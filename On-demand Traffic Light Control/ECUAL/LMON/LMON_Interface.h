@@ -0,0 +1,38 @@
+/*
+ * File: LMON_Interface.h
+ *
+ * Description:
+ * This header file contains the function prototypes for the lamp current monitor (monitor build only).
+ * The ADC scans the sense channels of the lamps in free running mode and averages them in its interrupt (MCAL/ADC),
+ * so the monitor costs the CPU the same few cycles per conversion whatever the lamps and the main loop are doing,
+ * and the check never waits for a conversion.
+ * The application checks the lamps once per half second against the aspect it commanded:
+ * a lamp lit by the aspect without current is out (burnt out lamp, open wire or failed driver).
+ * The functions provided by the driver include:
+ *  - Initializing the sense inputs and starting the scan
+ *  - Checking the lamps lit against their currents
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef LMON_INTERFACE_H
+#define LMON_INTERFACE_H
+
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+#include "LMON_Config.h"
+
+#if LMON_ENABLE
+
+void LMON_Init(const uint8_t* LOC_PtrChannels, uint8_t LOC_U8Num);
+uint8_t LMON_Check(uint8_t LOC_U8Lit);
+
+#else
+
+#define LMON_Init(channels, num)
+#define LMON_Check(lit) 0
+
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * File: LMON_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the lamp current monitor declared in LMON_Interface.h.
+ * Bit n of the lamp masks is the lamp sensed on the channel n of the list given to LMON_Init.
+ * A lamp is reported after LMON_CONFIRM checks in a row lit and under LMON_LEVEL, and as long as it stays so:
+ * a lamp which is off or has its current back starts counting again.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "LMON_Interface.h"
+
+#if LMON_ENABLE
+
+#include "../../MCAL/ADC/ADC_Interface.h"
+
+#if LMON_CONFIRM < 1 || LMON_CONFIRM > 255
+#error "LMON_CONFIRM must be from 1 to 255"
+#endif
+
+static uint8_t LMON_Num;
+static uint8_t LMON_Count[ADC_MAX_CHANNELS]; // checks in a row lit without current
+
+/*
+ * Function: LMON_Init()
+ * Description: This function sets the sense pins as inputs without pull-up and starts the scan of their channels.
+ * Arguments:
+ *   - LOC_PtrChannels: the ADC channels of the sensed lamps (PIN 0 to PIN 7 in PORTA), the list must stay valid
+ *   - LOC_U8Num: the number of sensed lamps (1 to ADC_MAX_CHANNELS)
+ * Return value: void
+ */
+void LMON_Init(const uint8_t* LOC_PtrChannels, uint8_t LOC_U8Num){
+	LMON_Num = LOC_U8Num;
+	for(uint8_t i=0; i<LOC_U8Num; i++){
+		GPIO_SetPinDir(LMON_PORT, LOC_PtrChannels[i], INPUT);
+		GPIO_SetPinVal(LMON_PORT, LOC_PtrChannels[i], LOW);
+		LMON_Count[i] = 0;
+	}
+	ADC_StartScan(LOC_PtrChannels, LOC_U8Num);
+}
+
+/*
+ * Function: LMON_Check()
+ * Description: This function checks the sensed lamps against the lamps lit, it is called once per half second.
+ * Arguments:
+ *   - LOC_U8Lit: the sensed lamps lit by the aspect commanded (bit n: channel n of the list)
+ * Return value: the lamps out (bit n: channel n of the list)
+ */
+uint8_t LMON_Check(uint8_t LOC_U8Lit){
+	uint8_t LOC_U8Out = 0;
+	for(uint8_t i=0; i<LMON_Num; i++){
+		if((LOC_U8Lit & (1<<i)) && ADC_GetAverage(i) < (LMON_LEVEL << ADC_AVG_SHIFT)){
+			if(LMON_Count[i] < LMON_CONFIRM) LMON_Count[i]++;
+			if(LMON_CONFIRM == LMON_Count[i]) LOC_U8Out |= (uint8_t)(1<<i);
+		}
+		else LMON_Count[i] = 0;
+	}
+	return LOC_U8Out;
+}
+
+#endif
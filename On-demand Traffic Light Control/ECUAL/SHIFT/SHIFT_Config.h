@@ -0,0 +1,21 @@
+/*
+ * File: SHIFT_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the shift register output expansion.
+ * It defines the number of 74HC595 registers in the chain (8 outputs each) and the pin driving their latch clock (RCLK).
+ * The latch is on SS (PIN 4 in PORTB), which is an output anyway in SPI master mode.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef SHIFT_CONFIG_H
+#define SHIFT_CONFIG_H
+
+#define SHIFT_CHIPS      8U    // registers in the chain, 64 outputs
+#define SHIFT_LATCH_PORT PORTB
+#define SHIFT_LATCH_PIN  PIN4
+
+#endif
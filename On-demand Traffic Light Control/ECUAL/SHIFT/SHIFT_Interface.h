@@ -0,0 +1,50 @@
+/*
+ * File: SHIFT_Interface.h
+ *
+ * Description:
+ * This header file contains the function prototypes for the shift register output expansion driver.
+ * The outputs are a chain of 74HC595 registers on the SPI: MOSI to the serial input of the first register,
+ * the serial output of each register to the input of the next one, SCK to all the shift clocks (SRCLK)
+ * and the latch pin (SHIFT_Config.h) to all the latch clocks (RCLK).
+ * Output n is the pin Qa + n % 8 of register n / 8, register 0 being the one connected to MOSI.
+ * The application writes the outputs in a RAM image, then commits it once per half second:
+ * a frame is only shifted when the image changed, by the SPI interrupt one byte at a time, and a single latch pulse
+ * at the end of the frame changes all the outputs at the same instant.
+ * The driver measures the CPU time of each frame with the Timer1 counter (8 us per count).
+ * The functions provided by the driver include:
+ *  - Initializing the SPI and the image (all outputs off)
+ *  - Writing and reading an output in the image
+ *  - Committing the image (frame shifted and latched in the background), or waiting until it is latched
+ *  - Getting the frame counters and the CPU time
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef SHIFT_INTERFACE_H
+#define SHIFT_INTERFACE_H
+
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+#include "SHIFT_Config.h"
+
+// Number of outputs
+#define SHIFT_OUTPUTS (8U * SHIFT_CHIPS)
+
+// Frame counters (saturating) and CPU time
+typedef struct {
+	uint16_t frames;    // frames shifted and latched
+	uint16_t unchanged; // commits without a change since the last frame, nothing shifted
+	uint16_t deferred;  // commits while the previous frame was still shifted, sent at the next commit
+	uint16_t cpuLast;   // CPU time of the last frame (commit and interrupts) in Timer1 counts
+	uint16_t cpuMax;    // largest CPU time of a frame in Timer1 counts
+} ST_ShiftStats_t;
+
+void SHIFT_Init(void);
+void SHIFT_Write(uint8_t LOC_U8Output, uint8_t LOC_U8Value);
+uint8_t SHIFT_Read(uint8_t LOC_U8Output);
+void SHIFT_Commit(void);
+void SHIFT_Flush(void);
+void SHIFT_GetStats(ST_ShiftStats_t* LOC_PtrStats);
+
+#endif
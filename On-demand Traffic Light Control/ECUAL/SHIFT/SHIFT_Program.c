@@ -0,0 +1,185 @@
+/*
+ * File: SHIFT_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the shift register output expansion driver declared in SHIFT_Interface.h.
+ * The image is copied into the frame buffer when a frame starts, so the application can keep writing the image
+ * while the previous frame is shifted. The last register of the chain is sent first (MSB first, Qh first),
+ * the SPI interrupt loads the next byte, and after the last one it pulses the latch and stops.
+ * Nothing is shifted when the image did not change since the last frame.
+ * The CPU time of a frame is the sum of the Timer1 counts spent in the commit and in the callback of each interrupt,
+ * the entry and exit of the interrupts (about 30 cycles each) are not counted.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "SHIFT_Interface.h"
+#include "../../MCAL/SPI/SPI_Interface.h"
+#include "../../MCAL/TMR1/TMR1_Interface.h"
+#include "../../utils/IO_ACCESS.h"
+
+static uint8_t SHIFT_Image[SHIFT_CHIPS];  // outputs written by the application
+static uint8_t SHIFT_Dirty;               // the image changed since the last frame
+
+// Frame in progress, shared with the SPI interrupt
+static uint8_t SHIFT_Frame[SHIFT_CHIPS];
+static volatile uint8_t SHIFT_Busy;
+static uint8_t SHIFT_Index;               // register of the byte being sent
+static uint16_t SHIFT_Cpu;                // CPU time of the frame so far
+
+// Counters
+static uint16_t SHIFT_Unchanged;
+static uint16_t SHIFT_Deferred;
+static volatile uint16_t SHIFT_Frames;
+static volatile uint16_t SHIFT_CpuLast;
+static volatile uint16_t SHIFT_CpuMax;
+
+/*
+ * Function: SHIFT_Count()
+ * Description: Adds one to a saturating counter.
+ */
+static void SHIFT_Count(volatile uint16_t* LOC_PtrCounter){
+	if(0xFFFF != *LOC_PtrCounter) (*LOC_PtrCounter)++;
+}
+
+/*
+ * Function: SHIFT_Elapsed()
+ * Description: Gets the Timer1 counts since a counter value read in the current or the previous period.
+ */
+static uint16_t SHIFT_Elapsed(uint16_t LOC_U16Start){
+	uint16_t LOC_U16Now = TMR1_GetCount();
+	if(LOC_U16Now < LOC_U16Start) LOC_U16Now += TMR1_GetTop() + 1;
+	return LOC_U16Now - LOC_U16Start;
+}
+
+/*
+ * Function: SHIFT_Next()
+ * Description: The SPI callback, called when a byte has been sent: sends the next one,
+ * or latches the frame after the byte of register 0.
+ */
+static void SHIFT_Next(void){
+	uint16_t LOC_U16Start = TMR1_GetCount();
+	if(SHIFT_Index){
+		SPI_Send(SHIFT_Frame[--SHIFT_Index]);
+		SHIFT_Cpu += SHIFT_Elapsed(LOC_U16Start);
+		return;
+	}
+	SPI_Stop();
+	GPIO_SetPinVal(SHIFT_LATCH_PORT, SHIFT_LATCH_PIN, HIGH); // all the outputs change on this edge
+	GPIO_SetPinVal(SHIFT_LATCH_PORT, SHIFT_LATCH_PIN, LOW);
+	SHIFT_Count(&SHIFT_Frames);
+	SHIFT_Cpu += SHIFT_Elapsed(LOC_U16Start);
+	SHIFT_CpuLast = SHIFT_Cpu;
+	if(SHIFT_Cpu > SHIFT_CpuMax) SHIFT_CpuMax = SHIFT_Cpu;
+	SHIFT_Busy = 0;
+}
+
+/*
+ * Function: SHIFT_Init()
+ * This function initializes the SPI master and the latch pin, and clears the image.
+ * The image is marked changed, so the first commit clears the registers (their content is random at power-on).
+ * Timer1 must be running (LED_FlashInit) for the CPU time measurement.
+ * Return value: void
+ */
+void SHIFT_Init(void){
+	for(uint8_t i=0; i<SHIFT_CHIPS; i++) SHIFT_Image[i] = 0;
+	SHIFT_Dirty = 1;
+	SHIFT_Busy = 0;
+	SHIFT_Unchanged = 0;
+	SHIFT_Deferred = 0;
+	SHIFT_Frames = 0;
+	SHIFT_CpuLast = 0;
+	SHIFT_CpuMax = 0;
+	SPI_Init();
+	SPI_SetCallback(SHIFT_Next);
+	GPIO_SetPinVal(SHIFT_LATCH_PORT, SHIFT_LATCH_PIN, LOW);
+	GPIO_SetPinDir(SHIFT_LATCH_PORT, SHIFT_LATCH_PIN, OUTPUT);
+}
+
+/*
+ * Function: SHIFT_Write()
+ * This function turns an output on or off in the image, the output changes at the next commit.
+ * Arguments:
+ *   - LOC_U8Output: the output number (0 to SHIFT_OUTPUTS - 1)
+ *   - LOC_U8Value: HIGH or LOW
+ * Return value: void
+ */
+void SHIFT_Write(uint8_t LOC_U8Output, uint8_t LOC_U8Value){
+	if(LOC_U8Output >= SHIFT_OUTPUTS) return;
+	uint8_t* LOC_PtrByte = &SHIFT_Image[LOC_U8Output >> 3];
+	uint8_t LOC_U8Bit = LOC_U8Output & 0x07;
+	uint8_t LOC_U8Old = *LOC_PtrByte;
+	if(LOC_U8Value) SET_BIT(*LOC_PtrByte, LOC_U8Bit);
+	else CLR_BIT(*LOC_PtrByte, LOC_U8Bit);
+	if(*LOC_PtrByte != LOC_U8Old) SHIFT_Dirty = 1;
+}
+
+/*
+ * Function: SHIFT_Read()
+ * This function reads an output in the image (the value written last, latched or not yet).
+ * Arguments:
+ *   - LOC_U8Output: the output number (0 to SHIFT_OUTPUTS - 1)
+ * Return value: HIGH or LOW, LOW for an output outside the chain
+ */
+uint8_t SHIFT_Read(uint8_t LOC_U8Output){
+	if(LOC_U8Output >= SHIFT_OUTPUTS) return LOW;
+	uint8_t LOC_U8Bit = LOC_U8Output & 0x07;
+	return GET_BIT(SHIFT_Image[LOC_U8Output >> 3], LOC_U8Bit);
+}
+
+/*
+ * Function: SHIFT_Commit()
+ * This function starts shifting the image if it changed since the last frame, and returns at once:
+ * the interrupts send the frame (SHIFT_CHIPS bytes of 128 us) and latch it.
+ * If the previous frame is still being sent, the image is kept for the next commit.
+ * Return value: void
+ */
+void SHIFT_Commit(void){
+	if(!SHIFT_Dirty){
+		SHIFT_Count(&SHIFT_Unchanged);
+		return;
+	}
+	if(SHIFT_Busy){
+		SHIFT_Count(&SHIFT_Deferred);
+		return;
+	}
+	uint16_t LOC_U16Start = TMR1_GetCount();
+	for(uint8_t i=0; i<SHIFT_CHIPS; i++) SHIFT_Frame[i] = SHIFT_Image[i];
+	SHIFT_Dirty = 0;
+	SHIFT_Busy = 1;
+	SHIFT_Index = SHIFT_CHIPS - 1;
+	SHIFT_Cpu = SHIFT_Elapsed(LOC_U16Start);
+	SPI_Send(SHIFT_Frame[SHIFT_CHIPS - 1]); // the interrupts are served from here on
+}
+
+/*
+ * Function: SHIFT_Flush()
+ * This function commits the image and waits until it is latched, a frame still being sent is waited for first.
+ * It is used before the interrupts are disabled for good (bootloader entered), it takes about 2 ms.
+ * Return value: void
+ */
+void SHIFT_Flush(void){
+	while(SHIFT_Busy) IO_POLL();
+	SHIFT_Commit();
+	while(SHIFT_Busy) IO_POLL();
+}
+
+/*
+ * Function: SHIFT_GetStats()
+ * This function copies the frame counters and the CPU time, the CPU time is written by the SPI interrupt.
+ * Arguments:
+ *   - LOC_PtrStats: where to copy them
+ * Return value: void
+ */
+void SHIFT_GetStats(ST_ShiftStats_t* LOC_PtrStats){
+	LOC_PtrStats->unchanged = SHIFT_Unchanged;
+	LOC_PtrStats->deferred = SHIFT_Deferred;
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	LOC_PtrStats->frames = SHIFT_Frames;
+	LOC_PtrStats->cpuLast = SHIFT_CpuLast;
+	LOC_PtrStats->cpuMax = SHIFT_CpuMax;
+	if(LOC_U8Interrupts) CPU_SEI();
+}
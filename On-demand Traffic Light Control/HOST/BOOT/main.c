@@ -0,0 +1,392 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "bootsim" host tool, which measures the downtime of a firmware update
+ * through the serial bootloader (BOOT) and checks that a power failure during the update never leaves
+ * a broken application.
+ * The unmodified bootloader runs on the host backend with a simulated flash holding an old application image
+ * (random bytes). The tool plays the updater on the PC side of the serial line (9600 baud, one byte every 1042 cycles):
+ * it sends the frames, waits for the answers (the line time of the answer included), and sends a frame again when
+ * the answer does not come or is corrupted. The new image is the old one with a few bytes changed (constants),
+ * with a few words inserted (the code after them moves), or a new image.
+ * Each run starts when the application jumps to the bootloader and ends when the bootloader starts the application:
+ *   - full update: every page of the new image is sent, then the commit
+ *   - incremental update: the CRC of each page of the application is asked first, only the pages that differ are sent
+ *     (all of them if the commit fails on a CRC collision)
+ *   - power failures: the incremental update is cut by a reset at times spread over its duration, the application
+ *     started after the reset must be the old or the new image, never a mix
+ * The bootloader time spent in the CRCs is not simulated (the virtual time only advances while the firmware waits):
+ * it is estimated at BOOT_CRC_CYCLES per byte and added to the downtime.
+ * Usage:
+ *   bootsim [-k old image KB] [-u c|i|f] [-n changes] [-e byte error rate] [-f power failures] [-s seed]
+ *     defaults: 12 KB, changed constants, 3 changes, no error, 20 power failures, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../HOST_Interface.h"
+#include "../../BOOT/BOOT_Interface.h"
+#include "../../SERVICES/CRC/CRC_Interface.h"
+
+#define BYTE_CYCLES     1042     // one 10-bit character at 9600 baud
+#define BOOT_CRC_CYCLES 100      // bootloader cycles per byte of a CRC (CRC_16Update and FLASH_ReadByte, estimated)
+#define REPLY_TIMEOUT   1000000ULL // after the last byte of a frame, longer than the gap that drops a frame
+#define COMMIT_TIMEOUT  5000000ULL // the commit copies up to all the pages
+#define MAX_TRIES       8
+#define APP_BYTES       (BOOT_APP_PAGES * FLASH_PAGE_SIZE)
+#define MAX_FRAME       (2 + FLASH_PAGE_SIZE + 2)
+#define MAX_REPLY       (1 + 2 * BOOT_APP_PAGES + 2)
+
+// Updater steps
+typedef enum {PC_INFO, PC_CRC, PC_WRITE, PC_FINISH, PC_DONE, PC_FAILED} EN_PcStep_t;
+
+// Options
+static double imageKB = 12, errorRate;
+static char kind = 'c';
+static unsigned changes = 3, failures = 20;
+
+// Images, padded with 0xFF to whole pages
+static uint8_t oldImage[APP_BYTES], newImage[APP_BYTES];
+static uint8_t oldPages, newPages;
+
+// Updater
+static EN_PcStep_t step;
+static uint8_t incremental, fellBack, tries;
+static uint8_t frame[MAX_FRAME], frameLen, framePos;
+static uint8_t reply[MAX_REPLY];
+static uint16_t replyLen, replyNeed;
+static uint64_t replyTime, pcTime, deadline, resetTime;
+static uint8_t toSend[BOOT_APP_PAGES], sendNum, sendNext;
+static uint8_t first;
+
+// Results of a run
+typedef struct {
+	uint64_t bytesOut, bytesIn, resent, pagesSent, crcBytes, pageWrites;
+	uint64_t downtime;
+	EN_HostStop_t stop;
+} ST_Run_t;
+static ST_Run_t run;
+
+static uint8_t Noise(uint8_t LOC_U8Byte){
+	if(errorRate > 0 && HOST_Uniform() < errorRate) LOC_U8Byte ^= (uint8_t)(1 + HOST_Uniform() * 255);
+	return LOC_U8Byte;
+}
+
+/*
+ * Builds the images: the old one, and the new one changed as asked.
+ */
+static uint8_t MakeImages(void){
+	uint32_t LOC_U32Old = (uint32_t)(imageKB * 1024) & ~1U, LOC_U32New = LOC_U32Old;
+	if(LOC_U32Old < 2 || LOC_U32Old > APP_BYTES) return 0;
+	memset(oldImage, 0xFF, sizeof(oldImage));
+	memset(newImage, 0xFF, sizeof(newImage));
+	for(uint32_t i=0; i<LOC_U32Old; i++) oldImage[i] = (uint8_t)(HOST_Uniform() * 256);
+	oldImage[0] = 0x0C; // the reset vector is not erased
+	switch(kind){
+		case 'c':
+			memcpy(newImage, oldImage, LOC_U32Old);
+			for(unsigned n=0; n<changes; n++) newImage[(uint32_t)(HOST_Uniform() * LOC_U32Old)] ^= (uint8_t)(1 + HOST_Uniform() * 255);
+		break;
+		case 'i':{
+			uint32_t LOC_U32At = (uint32_t)(HOST_Uniform() * LOC_U32Old / 2) & ~1U;
+			LOC_U32New = LOC_U32Old + 2 * changes;
+			if(LOC_U32New > APP_BYTES) return 0;
+			memcpy(newImage, oldImage, LOC_U32At);
+			for(unsigned n=0; n<2 * changes; n++) newImage[LOC_U32At + n] = (uint8_t)(HOST_Uniform() * 256);
+			memcpy(newImage + LOC_U32At + 2 * changes, oldImage + LOC_U32At, LOC_U32Old - LOC_U32At);
+		}
+		break;
+		default:
+			for(uint32_t i=0; i<LOC_U32New; i++) newImage[i] = (uint8_t)(HOST_Uniform() * 256);
+		break;
+	}
+	oldPages = (uint8_t)((LOC_U32Old + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE);
+	newPages = (uint8_t)((LOC_U32New + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE);
+	return 1;
+}
+
+/*
+ * Prepares a frame: the command, its arguments and the CRC-16.
+ */
+static void Frame(uint8_t LOC_U8Command, const uint8_t* LOC_PtrArgs, uint8_t LOC_U8Len, uint16_t LOC_U16Answer){
+	frame[0] = LOC_U8Command;
+	memcpy(frame + 1, LOC_PtrArgs, LOC_U8Len);
+	uint16_t LOC_U16Crc = CRC_16(frame, 1 + LOC_U8Len);
+	frame[1 + LOC_U8Len] = (uint8_t)LOC_U16Crc;
+	frame[2 + LOC_U8Len] = (uint8_t)(LOC_U16Crc >> 8);
+	frameLen = 3 + LOC_U8Len;
+	framePos = 0;
+	replyLen = 0;
+	replyNeed = LOC_U16Answer;
+}
+
+/*
+ * Prepares the frame of the current step.
+ */
+static void Next(void){
+	uint8_t LOC_U8Args[1 + FLASH_PAGE_SIZE];
+	uint16_t LOC_U16Crc;
+	switch(step){
+		case PC_INFO:
+			Frame(BOOT_CMD_INFO, NULL, 0, 6);
+		break;
+		case PC_CRC:
+			LOC_U8Args[0] = newPages;
+			Frame(BOOT_CMD_CRC, LOC_U8Args, 1, 3 + 2 * newPages);
+			run.crcBytes += (uint64_t)newPages * FLASH_PAGE_SIZE;
+		break;
+		case PC_WRITE:
+			LOC_U8Args[0] = toSend[sendNext];
+			memcpy(LOC_U8Args + 1, newImage + toSend[sendNext] * FLASH_PAGE_SIZE, FLASH_PAGE_SIZE);
+			Frame(BOOT_CMD_WRITE, LOC_U8Args, 1 + FLASH_PAGE_SIZE, 3);
+			run.pagesSent++;
+		break;
+		case PC_FINISH:
+			LOC_U16Crc = CRC_16(newImage, newPages * FLASH_PAGE_SIZE);
+			LOC_U8Args[0] = newPages;
+			LOC_U8Args[1] = (uint8_t)LOC_U16Crc;
+			LOC_U8Args[2] = (uint8_t)(LOC_U16Crc >> 8);
+			Frame(BOOT_CMD_FINISH, LOC_U8Args, 3, 3);
+			run.crcBytes += (uint64_t)newPages * FLASH_PAGE_SIZE;
+		break;
+		default:
+		break;
+	}
+}
+
+/*
+ * Sends all the pages of the new image, or the pages that differ from the CRCs of the answer.
+ */
+static void SendPages(const uint8_t* LOC_PtrCrcs){
+	sendNum = 0;
+	sendNext = 0;
+	for(uint8_t p=0; p<newPages; p++){
+		uint16_t LOC_U16Crc = CRC_16(newImage + p * FLASH_PAGE_SIZE, FLASH_PAGE_SIZE);
+		if(!LOC_PtrCrcs || (LOC_PtrCrcs[2 * p] | (LOC_PtrCrcs[2 * p + 1] << 8)) != LOC_U16Crc) toSend[sendNum++] = p;
+	}
+	step = sendNum ? PC_WRITE : PC_FINISH;
+}
+
+/*
+ * Handles a complete answer with a good CRC, and prepares the next frame.
+ */
+static void Answer(void){
+	uint8_t LOC_U8Ack = (BOOT_ACK == reply[0]);
+	tries = 0;
+	switch(step){
+		case PC_INFO:
+			if(!LOC_U8Ack || BOOT_LAYOUT != reply[1] || FLASH_PAGE_SIZE != reply[2] || newPages > reply[3]) step = PC_FAILED;
+			else if(incremental) step = PC_CRC;
+			else SendPages(NULL);
+		break;
+		case PC_CRC:
+			if(LOC_U8Ack) SendPages(reply + 1);
+			else step = PC_FAILED;
+		break;
+		case PC_WRITE:
+			if(!LOC_U8Ack) tries = MAX_TRIES; // a page that does not read back: the flash is worn out
+			else if(++sendNext == sendNum) step = PC_FINISH;
+		break;
+		case PC_FINISH:
+			if(LOC_U8Ack) step = PC_DONE;
+			else if(incremental && !fellBack){ // CRC collision on a page kept
+				fellBack = 1;
+				SendPages(NULL);
+			}
+			else step = PC_FAILED;
+		break;
+		default:
+		break;
+	}
+	if(tries >= MAX_TRIES) step = PC_FAILED;
+	if(PC_DONE != step && PC_FAILED != step) Next();
+}
+
+/*
+ * Serial output of the bootloader: the bytes of the answer, corrupted at the error rate.
+ */
+static void Serial(uint64_t now, uint8_t byte, void* arg){
+	(void)arg;
+	run.bytesIn++;
+	if(!replyLen) replyTime = now;
+	if(replyLen < MAX_REPLY) reply[replyLen++] = Noise(byte);
+}
+
+/*
+ * Tells whether the answer received is complete (the answer of a NAK is short) and has a good CRC.
+ */
+static uint8_t ReplyComplete(void){
+	uint16_t LOC_U16Need = (replyLen && BOOT_NAK == reply[0]) ? 3 : replyNeed;
+	return replyLen >= LOC_U16Need &&
+	       CRC_16(reply, LOC_U16Need - 2) == (reply[LOC_U16Need - 2] | (reply[LOC_U16Need - 1] << 8));
+}
+
+/*
+ * Input source: the updater sends a byte or looks at the answer at each character time, and cuts the power once
+ * at resetTime (0: never).
+ */
+static uint8_t Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	while(PC_DONE != step && PC_FAILED != step){
+		if(resetTime && pcTime >= resetTime){
+			event->time = resetTime;
+			event->code = HOST_EV_CODE(HOST_EV_RESET, 0);
+			resetTime = 0;
+			return 1;
+		}
+		if(framePos < frameLen){
+			event->time = pcTime;
+			event->code = HOST_EV_CODE(HOST_EV_SERIAL, 0);
+			event->data = Noise(frame[framePos++]);
+			run.bytesOut++;
+			pcTime += BYTE_CYCLES;
+			if(framePos == frameLen) deadline = pcTime + ((BOOT_CMD_FINISH == frame[0]) ? COMMIT_TIMEOUT : REPLY_TIMEOUT);
+			return 1;
+		}
+		if(ReplyComplete() && pcTime >= replyTime + (uint64_t)replyLen * BYTE_CYCLES){
+			Answer();
+			continue;
+		}
+		if(pcTime >= deadline){ // no answer, or a corrupted one
+			if(++tries >= MAX_TRIES){
+				step = PC_FAILED;
+				break;
+			}
+			run.resent++;
+			framePos = 0;
+			replyLen = 0;
+			continue;
+		}
+		event->time = pcTime;
+		event->code = HOST_EV_CODE(HOST_EV_SYNC, 0);
+		pcTime += BYTE_CYCLES;
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Firmware: the application jumped to the bootloader (reset flags cleared) the first time, a power-on reset after.
+ */
+static void Init(void){
+	if(first){
+		first = 0;
+		MCUCSR &= ~BOOT_RESET_FLAGS;
+	}
+	BOOT_Start();
+}
+
+static void Loop(void){
+	BOOT_Poll();
+}
+
+static uint64_t Writes(void){
+	uint64_t LOC_U64Writes = 0;
+	for(uint16_t p=0; p<FLASH_SIZE / FLASH_PAGE_SIZE; p++) LOC_U64Writes += HOST_FlashWrites(p);
+	return LOC_U64Writes;
+}
+
+/*
+ * Runs one update from the old image, with a power failure at the given time (0: none).
+ */
+static void Update(uint8_t LOC_U8Incremental, uint64_t LOC_U64Reset){
+	uint8_t* LOC_PtrFlash = HOST_Flash();
+	memset(LOC_PtrFlash, 0xFF, FLASH_BOOT_START);
+	memcpy(LOC_PtrFlash, oldImage, APP_BYTES);
+	memset(&run, 0, sizeof(run));
+	step = PC_INFO;
+	incremental = LOC_U8Incremental;
+	fellBack = 0;
+	tries = 0;
+	pcTime = 1000; // the application answered the "U" command, the updater starts at once
+	resetTime = LOC_U64Reset;
+	first = 1;
+	Next();
+	uint64_t LOC_U64Writes = Writes();
+	HOST_SetInput(Input, NULL);
+	HOST_SetSerial(Serial, NULL);
+	run.stop = HOST_Run(Init, Loop, HOST_CYCLES_PER_HOUR);
+	if(PC_FINISH == step && ReplyComplete()) Answer(); // the commit is answered just before the jump, which ends the run
+	run.downtime = HOST_Time + run.crcBytes * BOOT_CRC_CYCLES;
+	run.pageWrites = Writes() - LOC_U64Writes;
+}
+
+/*
+ * Tells which image the application section holds: 2 the new one, 1 the old one, 0 neither.
+ */
+static uint8_t Installed(void){
+	const uint8_t* LOC_PtrFlash = HOST_Flash();
+	if(!memcmp(LOC_PtrFlash, newImage, newPages * FLASH_PAGE_SIZE)) return 2;
+	if(!memcmp(LOC_PtrFlash, oldImage, oldPages * FLASH_PAGE_SIZE)) return 1;
+	return 0;
+}
+
+static void Report(const char* LOC_PtrName){
+	printf("%-19s %3llu pages sent, %6llu bytes sent, %4llu received, %llu frames sent again, %3llu page writes, "
+	       "downtime %.2f s (%.2f s of CRCs)\n", LOC_PtrName, (unsigned long long)run.pagesSent,
+	       (unsigned long long)run.bytesOut, (unsigned long long)run.bytesIn, (unsigned long long)run.resent,
+	       (unsigned long long)run.pageWrites, run.downtime / 1e6, run.crcBytes * BOOT_CRC_CYCLES / 1e6);
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'k': imageKB = atof(arg); break;
+		case 'u': kind = arg[0]; break;
+		case 'n': changes = (unsigned)atoi(arg); break;
+		case 'e': errorRate = atof(arg); break;
+		case 'f': failures = (unsigned)atoi(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "k:u:n:e:f:s:", Option,
+	                "bootsim [-k old image KB] [-u c|i|f] [-n changes] [-e byte error rate] [-f power failures] [-s seed]") < 0) return 2;
+	if(('c' != kind && 'i' != kind && 'f' != kind) || errorRate < 0 || errorRate > 0.5 || !MakeImages()){
+		fprintf(stderr, "bootsim: the images must fit in %u bytes, kinds c, i or f, error rate up to 0.5\n", APP_BYTES);
+		return 2;
+	}
+
+	static const char* const LOC_Kinds[] = {"changed constants", "inserted words", "new image"};
+	printf("old image %u pages, new image %u pages (%u changes, %s), %u application pages of %u bytes, byte error rate %g\n",
+	       oldPages, newPages, changes, LOC_Kinds['c' == kind ? 0 : ('i' == kind ? 1 : 2)], BOOT_APP_PAGES, FLASH_PAGE_SIZE, errorRate);
+	uint8_t LOC_U8Fail = 0;
+
+	Update(0, 0);
+	Report("full update:");
+	if(HOST_STOP_JUMP != run.stop || PC_DONE != step || 2 != Installed()){
+		printf("full update FAILED\n");
+		LOC_U8Fail = 1;
+	}
+
+	Update(1, 0);
+	Report("incremental update:");
+	if(HOST_STOP_JUMP != run.stop || PC_DONE != step || 2 != Installed()){
+		printf("incremental update FAILED\n");
+		LOC_U8Fail = 1;
+	}
+
+	// Power failures spread over the incremental update
+	uint64_t LOC_U64Length = HOST_Time;
+	unsigned LOC_Kept = 0, LOC_Done = 0, LOC_Broken = 0;
+	for(unsigned i=0; i<failures; i++){
+		Update(1, 1000 + (LOC_U64Length - 1000) * (2 * i + 1) / (2 * failures));
+		switch((HOST_STOP_JUMP == run.stop && 0 == HOST_JumpAddress()) ? Installed() : 0){
+			case 1: LOC_Kept++; break;
+			case 2: LOC_Done++; break;
+			default: LOC_Broken++; break;
+		}
+	}
+	if(failures){
+		printf("power failures: %u during the incremental update, old application kept %u, new application completed %u, broken %u\n",
+		       failures, LOC_Kept, LOC_Done, LOC_Broken);
+	}
+	return LOC_U8Fail || LOC_Broken;
+}
@@ -0,0 +1,268 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "corridor" host tool, which tests the corridor coordination (SERVICES/CORR)
+ * with several controllers on one serial bus.
+ * Each controller is the unmodified firmware on the host backend, in its own process (the backend state is global),
+ * connected to the parent process by a socketpair. The processes run in lockstep in virtual time:
+ * at the end of each quantum a controller sends the bytes it transmitted during the quantum and waits
+ * for the bytes of the other controllers, which it receives during the next quantum at 9600 baud
+ * (the bus is shared, every byte reaches all the other controllers).
+ * Controller 0 is the master, controller i follows it with an offset of i times the hop offset.
+ * The controllers boot at random times, so the followers start out of step, and bus errors can be injected.
+ * At the end the offset between the green starts of each follower and of the master is measured
+ * over the second half of the run.
+ * Usage:
+ *   corridor [-n controllers] [-o hop offset] [-t seconds] [-q quantum ms] [-e byte error rate] [-s seed]
+ *     defaults: 3 controllers, 8 half seconds per hop, 1800 s, 10 ms, no error, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#define MAX_NODES     8
+#define MAX_BYTES     1024
+#define MAX_GREENS    1024
+#define BYTE_CYCLES   1042   // one 10-bit character at 9600 baud
+
+// Messages from a controller to the parent
+#define MSG_BYTES  0
+#define MSG_RESULT 1
+
+typedef struct {
+	uint8_t type;
+	uint16_t count;
+	uint8_t bytes[MAX_BYTES];
+} ST_Message_t;
+
+typedef struct {
+	ST_CorrStats_t stats;
+	uint16_t greens;
+	uint64_t green[MAX_GREENS]; // car green starts, second half of the run
+} ST_Result_t;
+
+// Options
+static uint8_t nodes = 3;
+static uint8_t hopOffset = 8;
+static uint64_t runTime = 1800000000ULL;
+static uint64_t quantum = 10000;
+static double errorRate;
+
+// Controller process
+static int busLink;
+static uint8_t node;
+static uint64_t bootTime, quantumEnd;
+static ST_Message_t tx, rx;
+static uint16_t rxNext;
+static uint8_t syncPending, booted;
+static uint8_t greenLit;
+static ST_Result_t result;
+
+static void Send(int fd, const void* data, size_t len){
+	if((ssize_t)len != send(fd, data, len, 0)){ perror("corridor"); exit(2); }
+}
+
+static void Receive(int fd, void* data, size_t len){
+	if(recv(fd, data, len, 0) <= 0){ perror("corridor"); exit(2); }
+}
+
+/************************************************************************/
+/*                       Controller process                             */
+/************************************************************************/
+
+static void Serial(uint64_t now, uint8_t byte, void* arg){
+	(void)now; (void)arg;
+	if(tx.count < MAX_BYTES) tx.bytes[tx.count++] = byte;
+}
+
+static void Output(uint64_t now, void* arg){
+	(void)arg;
+	uint8_t LOC_U8Lit = (HOST_LAMP_ON == HOST_Lamp(APP_Sites[0].lamps[APP_MAIN_GREEN].port, APP_Sites[0].lamps[APP_MAIN_GREEN].pin));
+	if(LOC_U8Lit && !greenLit && now >= runTime / 2 && result.greens < MAX_GREENS) result.green[result.greens++] = now;
+	greenLit = LOC_U8Lit;
+}
+
+/*
+ * Input source: the boot (reset), the bytes of the bus, and a sync event at the end of each quantum
+ * where the bytes are exchanged with the parent.
+ */
+static uint8_t Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	if(!booted && bootTime < quantumEnd){
+		booted = 1;
+		event->time = bootTime;
+		event->code = HOST_EV_CODE(HOST_EV_RESET, 0);
+		return 1;
+	}
+	if(rxNext < rx.count){
+		event->time = quantumEnd - quantum + (uint64_t)rxNext * BYTE_CYCLES;
+		event->code = HOST_EV_CODE(HOST_EV_SERIAL, 0);
+		event->data = rx.bytes[rxNext++];
+		return 1;
+	}
+	if(!syncPending){
+		syncPending = 1;
+		event->time = quantumEnd;
+		event->code = HOST_EV_CODE(quantumEnd >= runTime ? HOST_EV_END : HOST_EV_SYNC, 0);
+		return 1;
+	}
+
+	// End of the quantum: publish the bytes sent, get the bytes of the others
+	syncPending = 0;
+	tx.type = MSG_BYTES;
+	Send(busLink, &tx, sizeof(tx));
+	tx.count = 0;
+	Receive(busLink, &rx, sizeof(rx));
+	rxNext = 0;
+	quantumEnd += quantum;
+	return Input(event, arg);
+}
+
+static void Init(void){
+	APP_Init();
+	CORR_Init(node, 0, (uint8_t)(node * hopOffset));
+}
+
+static void Loop(void){
+	APP_Start();
+}
+
+static void Controller(uint8_t LOC_U8Node, int LOC_S32Link){
+	node = LOC_U8Node;
+	busLink = LOC_S32Link;
+	bootTime = (uint64_t)(HOST_Uniform() * 30e6); // up to 30 s after power-up
+	quantumEnd = quantum;
+	HOST_SetInput(Input, NULL);
+	HOST_SetSerial(Serial, NULL);
+	HOST_SetOutput(Output, NULL);
+	HOST_Run(Init, Loop, UINT64_MAX);
+
+	tx.type = MSG_RESULT;
+	CORR_GetStats(&result.stats);
+	tx.count = sizeof(result);
+	Send(busLink, &tx, sizeof(tx));
+	Send(busLink, &result, sizeof(result));
+	exit(0);
+}
+
+/************************************************************************/
+/*                       Parent process                                 */
+/************************************************************************/
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'n': nodes = (uint8_t)atoi(arg); break;
+		case 'o': hopOffset = (uint8_t)atoi(arg); break;
+		case 't': runTime = (uint64_t)(atof(arg) * 1e6); break;
+		case 'q': quantum = (uint64_t)(atof(arg) * 1e3); break;
+		case 'e': errorRate = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "n:o:t:q:e:s:", Option,
+	                "corridor [-n controllers] [-o hop offset] [-t seconds] [-q quantum ms] [-e byte error rate] [-s seed]") < 0) return 2;
+	if(nodes < 2 || nodes > MAX_NODES || !quantum || !runTime){
+		fprintf(stderr, "corridor: 2 to %u controllers, positive quantum and duration\n", MAX_NODES);
+		return 2;
+	}
+
+	int LOC_S32Links[MAX_NODES];
+	for(uint8_t i=0; i<nodes; i++){
+		int LOC_S32Pair[2];
+		if(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, LOC_S32Pair)){ perror("corridor"); return 2; }
+		HOST_Uniform();
+		pid_t LOC_Pid = fork();
+		if(LOC_Pid < 0){ perror("corridor"); return 2; }
+		if(!LOC_Pid){
+			close(LOC_S32Pair[0]);
+			Controller(i, LOC_S32Pair[1]);
+		}
+		close(LOC_S32Pair[1]);
+		LOC_S32Links[i] = LOC_S32Pair[0];
+	}
+
+	// Lockstep: one message per controller and per quantum, the bus bytes are sent back to the others
+	static ST_Message_t LOC_In[MAX_NODES], LOC_Out;
+	static ST_Result_t LOC_Results[MAX_NODES];
+	uint8_t LOC_U8Active = nodes, LOC_U8Done[MAX_NODES] = {0};
+	uint64_t LOC_U64Corrupted = 0, LOC_U64Bytes = 0;
+	while(LOC_U8Active){
+		for(uint8_t i=0; i<nodes; i++){
+			if(LOC_U8Done[i]) continue;
+			Receive(LOC_S32Links[i], &LOC_In[i], sizeof(ST_Message_t));
+			if(MSG_RESULT == LOC_In[i].type){
+				Receive(LOC_S32Links[i], &LOC_Results[i], sizeof(ST_Result_t));
+				LOC_U8Done[i] = 1;
+				LOC_U8Active--;
+				LOC_In[i].count = 0;
+			}
+		}
+		for(uint8_t i=0; i<nodes; i++){
+			if(LOC_U8Done[i]) continue;
+			LOC_Out.type = MSG_BYTES;
+			LOC_Out.count = 0;
+			for(uint8_t k=0; k<nodes; k++){
+				if(k == i) continue;
+				for(uint16_t b=0; b<LOC_In[k].count && LOC_Out.count < MAX_BYTES; b++){
+					uint8_t LOC_U8Byte = LOC_In[k].bytes[b];
+					if(errorRate > 0 && HOST_Uniform() < errorRate){
+						LOC_U8Byte ^= (uint8_t)(1 << (uint8_t)(HOST_Uniform() * 8));
+						LOC_U64Corrupted++;
+					}
+					LOC_Out.bytes[LOC_Out.count++] = LOC_U8Byte;
+					LOC_U64Bytes++;
+				}
+			}
+			Send(LOC_S32Links[i], &LOC_Out, sizeof(LOC_Out));
+		}
+	}
+	while(wait(NULL) > 0);
+
+	// Offsets of the green starts, modulo the cycle of the default plan
+	int64_t LOC_S64Cycle = 4LL * PLAN_DEFAULT_HALF_SECS * 500000;
+	const ST_Result_t* LOC_PtrMaster = &LOC_Results[0];
+	uint8_t LOC_U8Fail = 0;
+	printf("%u controllers, %.0f s, quantum %.1f ms, %llu bus bytes delivered, %llu corrupted\n", nodes, runTime / 1e6,
+	       quantum / 1e3, (unsigned long long)LOC_U64Bytes, (unsigned long long)LOC_U64Corrupted);
+	for(uint8_t i=1; i<nodes; i++){
+		const ST_Result_t* r = &LOC_Results[i];
+		int64_t LOC_S64Target = (int64_t)((i * hopOffset) % (4 * PLAN_DEFAULT_HALF_SECS)) * 500000;
+		double LOC_Sum = 0, LOC_Max = 0;
+		uint16_t LOC_U16Count = 0;
+		for(uint16_t g=0; g<r->greens; g++){
+			int64_t LOC_S64Master = -1;
+			for(uint16_t m=0; m<LOC_PtrMaster->greens && LOC_PtrMaster->green[m] <= r->green[g]; m++) LOC_S64Master = LOC_PtrMaster->green[m];
+			if(LOC_S64Master < 0) continue;
+			int64_t LOC_S64Error = ((int64_t)r->green[g] - LOC_S64Master - LOC_S64Target) % LOC_S64Cycle;
+			if(LOC_S64Error > LOC_S64Cycle / 2) LOC_S64Error -= LOC_S64Cycle;
+			if(LOC_S64Error < -LOC_S64Cycle / 2) LOC_S64Error += LOC_S64Cycle;
+			double LOC_Abs = (LOC_S64Error < 0 ? -LOC_S64Error : LOC_S64Error) / 1e6;
+			LOC_Sum += LOC_Abs;
+			if(LOC_Abs > LOC_Max) LOC_Max = LOC_Abs;
+			LOC_U16Count++;
+		}
+		// Half a tick of resolution, plus the bus latency (up to two quanta and a frame)
+		double LOC_Limit = 0.5 + 2 * quantum / 1e6 + CORR_FRAME_LEN * BYTE_CYCLES / 1e6;
+		uint8_t LOC_U8Ok = LOC_U16Count && LOC_Max <= LOC_Limit;
+		if(!LOC_U8Ok) LOC_U8Fail = 1;
+		printf("node %u: offset %.1f s, %u cycles, error mean %.3f s max %.3f s, frames %u, crc errors %u, lost %u: %s\n",
+		       i, LOC_S64Target / 1e6, LOC_U16Count, LOC_U16Count ? LOC_Sum / LOC_U16Count : 0.0, LOC_Max,
+		       r->stats.frames, r->stats.crcErrors, r->stats.lost, LOC_U8Ok ? "OK" : "FAIL");
+	}
+	return LOC_U8Fail;
+}
@@ -0,0 +1,80 @@
+/*
+ * File: DEMAND_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the traffic demand model of the host backend: vehicles and pedestrians
+ * arriving at the intersection and reacting to the lamps of the unmodified firmware (closed loop).
+ *   - vehicles: Poisson arrivals with a 1 second minimum headway, optionally in platoons released by an upstream
+ *     signal (a share of the vehicles arrives during a window of the upstream cycle). Each vehicle is a pulse
+ *     on T0 at its arrival (the loop detector) and joins the queue at the stop line. The queue leaves one vehicle
+ *     every DEMAND_SAT_HEADWAY while the car's green is lit, a vehicle arriving to an empty queue during the green
+ *     goes through without delay (the same queue as detsim).
+ *   - pedestrians: Poisson arrivals. A pedestrian arriving during the walk (crossing's green lit, its yellow off)
+ *     crosses at once, the others press the button (a pulse on INT0) and wait for the walk.
+ * The model is an input source and an output observer of the backend (HOST_SetInput, HOST_SetOutput).
+ * The arrivals are delivered at their time: a pedestrian is a sync event first, so the decision to press
+ * is taken with the lamps of its arrival. The lamps are taken at the end of each instant (the firmware writes
+ * one port at a time), and the queue is advanced in time order between the callbacks.
+ * The functions prototypes defined in this file include:
+ *   - DEMAND_Init: function to set the demand and connect the model to the backend
+ *   - DEMAND_Finish: function to advance the model to the end of the run
+ *   - DEMAND_GetStats: function to get the queue, delay and pedestrian wait statistics
+ *   - DEMAND_Percentile: function to get a percentile of a delay or wait distribution
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef DEMAND_INTERFACE_H_
+#define DEMAND_INTERFACE_H_
+
+#include "../HOST_Interface.h"
+
+#define DEMAND_MIN_HEADWAY 1000000ULL // vehicle arrivals: 1 s minimum headway
+#define DEMAND_SAT_HEADWAY 2000000ULL // queue discharge: one vehicle every 2 s
+#define DEMAND_QUEUE_SIZE  65536      // vehicles or pedestrians waiting, the others are counted as lost
+#define DEMAND_BUCKETS     6000       // 100 ms buckets up to 600 s, plus one bucket for the longer ones
+#define DEMAND_BUCKET      100000ULL
+
+typedef struct {
+	double vehicleRate;   // vehicles per hour, below 3600
+	double platoonShare;  // share of the vehicles arriving in platoons, 0 for Poisson arrivals
+	double platoonWindow; // part of the upstream cycle during which the platoons arrive (0 to 1)
+	double upstreamCycle; // seconds
+	double pedRate;       // pedestrians per hour
+	uint64_t endTime;     // no arrival from this time (cycles)
+} ST_DemandConfig_t;
+
+// Distribution of durations in cycles (1 us)
+typedef struct {
+	uint64_t count, sum, max;
+	uint32_t hist[DEMAND_BUCKETS + 1];
+} ST_DemandDist_t;
+
+typedef struct {
+	uint64_t vehicles;      // arrived
+	uint64_t departed;
+	uint64_t stopped;       // departed with a delay
+	uint64_t lost;          // arrived to a full queue
+	uint64_t greens;
+	uint64_t failures;      // greens ended with vehicles still queued (cycle failures)
+	uint64_t queueAtGreen;  // sum of the queues at the start of the greens
+	uint64_t queueArea;     // integral of the queue length over time (vehicle cycles)
+	uint32_t maxQueue;
+	uint64_t peds;          // arrived
+	uint64_t presses;
+	uint64_t crossedAtOnce; // arrived during the walk
+	uint32_t maxWaiting;
+	uint64_t time;          // end of the statistics (cycles)
+	ST_DemandDist_t delay;  // vehicles departed
+	ST_DemandDist_t wait;   // pedestrians who waited for the walk
+} ST_DemandStats_t;
+
+// Demand function prototypes
+void DEMAND_Init(const ST_DemandConfig_t* config);
+void DEMAND_Finish(uint64_t now);
+const ST_DemandStats_t* DEMAND_GetStats(void);
+double DEMAND_Percentile(const ST_DemandDist_t* dist, double percent);
+
+#endif
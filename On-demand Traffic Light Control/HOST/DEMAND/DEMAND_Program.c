@@ -0,0 +1,278 @@
+/*
+ * File: DEMAND_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the traffic demand model declared in DEMAND_Interface.h.
+ * The model keeps the vehicles and the pedestrians waiting in two rings of arrival times. Its time is advanced
+ * by the input source and the output observer: the lamps of an instant, the arrivals delivered by the backend
+ * and the departures of the queue are applied in time order up to the time of the callback.
+ * The platoon arrivals are a Poisson process whose rate is high in the upstream window and low outside,
+ * after the minimum headway (the rates are raised so the minimum headway keeps the mean rate).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "DEMAND_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+typedef struct {
+	uint64_t time[DEMAND_QUEUE_SIZE];
+	uint32_t head, num;
+} ST_DemandRing_t;
+
+static ST_DemandConfig_t DEMAND_Config;
+static ST_DemandStats_t DEMAND_Stats;
+static double DEMAND_RateIn, DEMAND_RateOut; // vehicle arrivals per cycle in and out of the platoon window
+static uint64_t DEMAND_NextVehicle, DEMAND_NextPed;
+
+// Vehicles delivered to the backend, not in the queue yet
+static uint64_t DEMAND_Delivered[4];
+static uint8_t DEMAND_DeliveredHead, DEMAND_DeliveredNum;
+static uint8_t DEMAND_PedDue; // the sync event of a pedestrian arrival was delivered
+
+static ST_DemandRing_t DEMAND_Queue, DEMAND_Waiting;
+static uint64_t DEMAND_Departure, DEMAND_LastDeparture, DEMAND_AreaTime;
+static uint8_t DEMAND_Green, DEMAND_Walk;
+
+// Lamps of the current instant, applied when the time moves on
+static uint8_t DEMAND_Pending, DEMAND_PendingGreen, DEMAND_PendingWalk;
+static uint64_t DEMAND_PendingTime;
+
+/*
+ * Function: DEMAND_NextArrival()
+ * Description: Gets the arrival of the vehicle after the one arriving at LOC_U64Last: the minimum headway,
+ * then an exponential time at the rate of the part of the upstream cycle it falls in.
+ */
+static uint64_t DEMAND_NextArrival(uint64_t LOC_U64Last){
+	double LOC_Time = LOC_U64Last + DEMAND_MIN_HEADWAY;
+	double LOC_Need = -log(HOST_Uniform());
+	double LOC_Cycle = DEMAND_Config.upstreamCycle * 1e6, LOC_Window = DEMAND_Config.platoonWindow * LOC_Cycle;
+	if(DEMAND_Config.platoonShare <= 0) return (uint64_t)(LOC_Time + LOC_Need / DEMAND_RateOut);
+	while(1){
+		double LOC_Start = LOC_Cycle * floor(LOC_Time / LOC_Cycle);
+		uint8_t LOC_U8In = LOC_Time - LOC_Start < LOC_Window;
+		double LOC_End = LOC_Start + (LOC_U8In ? LOC_Window : LOC_Cycle);
+		double LOC_Rate = LOC_U8In ? DEMAND_RateIn : DEMAND_RateOut;
+		if(LOC_Rate > 0 && LOC_Need <= LOC_Rate * (LOC_End - LOC_Time)) return (uint64_t)(LOC_Time + LOC_Need / LOC_Rate);
+		LOC_Need -= LOC_Rate * (LOC_End - LOC_Time);
+		LOC_Time = LOC_End;
+	}
+}
+
+static void DEMAND_Add(ST_DemandDist_t* dist, uint64_t value){
+	if(value > dist->max) dist->max = value;
+	dist->count++;
+	dist->sum += value;
+	uint64_t LOC_U64Bucket = value ? (value - 1) / DEMAND_BUCKET : 0; // a bucket holds its upper bound
+	dist->hist[(LOC_U64Bucket < DEMAND_BUCKETS) ? LOC_U64Bucket : DEMAND_BUCKETS]++;
+}
+
+static uint8_t DEMAND_Push(ST_DemandRing_t* ring, uint64_t time){
+	if(DEMAND_QUEUE_SIZE == ring->num) return 0;
+	ring->time[(ring->head + ring->num++) % DEMAND_QUEUE_SIZE] = time;
+	return 1;
+}
+
+static uint64_t DEMAND_Pop(ST_DemandRing_t* ring){
+	uint64_t LOC_U64Time = ring->time[ring->head];
+	ring->head = (ring->head + 1) % DEMAND_QUEUE_SIZE;
+	ring->num--;
+	return LOC_U64Time;
+}
+
+/*
+ * Function: DEMAND_Lamps()
+ * Description: Applies the lamps of an instant: the queue starts to leave at the start of the green,
+ * and the pedestrians waiting cross at the start of the walk.
+ */
+static void DEMAND_Lamps(uint64_t now, uint8_t green, uint8_t walk){
+	if(green && !DEMAND_Green){
+		DEMAND_Stats.greens++;
+		DEMAND_Stats.queueAtGreen += DEMAND_Queue.num;
+		uint64_t LOC_U64Next = DEMAND_LastDeparture + DEMAND_SAT_HEADWAY;
+		DEMAND_Departure = (DEMAND_Stats.departed && LOC_U64Next > now) ? LOC_U64Next : now;
+	}
+	if(!green && DEMAND_Green && DEMAND_Queue.num) DEMAND_Stats.failures++;
+	if(walk && !DEMAND_Walk){
+		while(DEMAND_Waiting.num) DEMAND_Add(&DEMAND_Stats.wait, now - DEMAND_Pop(&DEMAND_Waiting));
+	}
+	DEMAND_Green = green;
+	DEMAND_Walk = walk;
+}
+
+/*
+ * Function: DEMAND_Advance()
+ * Description: Applies the lamps of the previous instants, the vehicle arrivals and the departures up to a time.
+ */
+static void DEMAND_Advance(uint64_t now){
+	enum {NONE, LAMPS, ARRIVAL, DEPARTURE} LOC_Kind;
+	while(1){
+		uint64_t LOC_U64Time = UINT64_MAX;
+		LOC_Kind = NONE;
+		if(DEMAND_Pending && DEMAND_PendingTime < now){ LOC_U64Time = DEMAND_PendingTime; LOC_Kind = LAMPS; }
+		if(DEMAND_DeliveredNum && DEMAND_Delivered[DEMAND_DeliveredHead] <= now
+		   && DEMAND_Delivered[DEMAND_DeliveredHead] < LOC_U64Time){
+			LOC_U64Time = DEMAND_Delivered[DEMAND_DeliveredHead];
+			LOC_Kind = ARRIVAL;
+		}
+		if(DEMAND_Green && DEMAND_Queue.num && DEMAND_Departure <= now && DEMAND_Departure < LOC_U64Time){
+			LOC_U64Time = DEMAND_Departure;
+			LOC_Kind = DEPARTURE;
+		}
+		if(NONE == LOC_Kind) return;
+
+		DEMAND_Stats.queueArea += DEMAND_Queue.num * (LOC_U64Time - DEMAND_AreaTime);
+		DEMAND_AreaTime = LOC_U64Time;
+		switch(LOC_Kind){
+			case LAMPS:
+				DEMAND_Pending = 0;
+				DEMAND_Lamps(LOC_U64Time, DEMAND_PendingGreen, DEMAND_PendingWalk);
+			break;
+			case ARRIVAL:
+				DEMAND_DeliveredHead = (DEMAND_DeliveredHead + 1) & 3;
+				DEMAND_DeliveredNum--;
+				DEMAND_Stats.vehicles++;
+				if(!DEMAND_Push(&DEMAND_Queue, LOC_U64Time)){
+					DEMAND_Stats.lost++;
+					break;
+				}
+				if(DEMAND_Queue.num > DEMAND_Stats.maxQueue) DEMAND_Stats.maxQueue = DEMAND_Queue.num;
+				if(1 == DEMAND_Queue.num){
+					uint64_t LOC_U64Next = DEMAND_LastDeparture + DEMAND_SAT_HEADWAY;
+					DEMAND_Departure = (DEMAND_Stats.departed && LOC_U64Next > LOC_U64Time) ? LOC_U64Next : LOC_U64Time;
+				}
+			break;
+			case DEPARTURE:{
+				uint64_t LOC_U64Delay = LOC_U64Time - DEMAND_Pop(&DEMAND_Queue);
+				DEMAND_Add(&DEMAND_Stats.delay, LOC_U64Delay);
+				if(LOC_U64Delay) DEMAND_Stats.stopped++;
+				DEMAND_Stats.departed++;
+				DEMAND_LastDeparture = LOC_U64Time;
+				DEMAND_Departure = LOC_U64Time + DEMAND_SAT_HEADWAY;
+			} break;
+			default: break;
+		}
+	}
+}
+
+/*
+ * Function: DEMAND_Input()
+ * Description: Input source of the backend: the next vehicle (pulse on T0) or pedestrian (sync event) arrival,
+ * and the press of a pedestrian who arrived outside the walk.
+ */
+static uint8_t DEMAND_Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	DEMAND_Advance(HOST_Time);
+	if(DEMAND_PedDue){
+		DEMAND_PedDue = 0;
+		DEMAND_Stats.peds++;
+		if(DEMAND_Pending ? DEMAND_PendingWalk : DEMAND_Walk) DEMAND_Stats.crossedAtOnce++;
+		else{
+			if(DEMAND_Push(&DEMAND_Waiting, HOST_Time) && DEMAND_Waiting.num > DEMAND_Stats.maxWaiting) DEMAND_Stats.maxWaiting = DEMAND_Waiting.num;
+			DEMAND_Stats.presses++;
+			event->time = HOST_Time;
+			event->code = HOST_EV_CODE(HOST_EV_PULSE, HOST_PIN_INT0);
+			return 1;
+		}
+	}
+	if(DEMAND_NextVehicle < DEMAND_Config.endTime && DEMAND_NextVehicle <= DEMAND_NextPed){
+		if(4 == DEMAND_DeliveredNum) return 0;
+		DEMAND_Delivered[(DEMAND_DeliveredHead + DEMAND_DeliveredNum++) & 3] = DEMAND_NextVehicle;
+		event->time = DEMAND_NextVehicle;
+		event->code = HOST_EV_CODE(HOST_EV_PULSE, HOST_PIN_T0);
+		DEMAND_NextVehicle = DEMAND_NextArrival(DEMAND_NextVehicle);
+		return 1;
+	}
+	if(DEMAND_NextPed < DEMAND_Config.endTime){
+		event->time = DEMAND_NextPed;
+		event->code = HOST_EV_CODE(HOST_EV_SYNC, 0);
+		DEMAND_PedDue = 1;
+		DEMAND_NextPed += HOST_Arrival(DEMAND_Config.pedRate);
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Function: DEMAND_Output()
+ * Description: Output observer of the backend: keeps the car's green and the walk of the current instant.
+ */
+static void DEMAND_Output(uint64_t now, void* arg){
+	(void)arg;
+	DEMAND_Advance(now);
+	uint8_t LOC_U8Walk = HOST_LAMP_ON == HOST_Lamp(APP_Lamps[APP_LAMP_PED_GREEN].port, APP_Lamps[APP_LAMP_PED_GREEN].pin)
+	                     && HOST_LAMP_OFF == HOST_Lamp(APP_Lamps[APP_LAMP_PED_YELLOW].port, APP_Lamps[APP_LAMP_PED_YELLOW].pin);
+	DEMAND_PendingGreen = HOST_LAMP_ON == HOST_Lamp(APP_Lamps[APP_MAIN_GREEN].port, APP_Lamps[APP_MAIN_GREEN].pin);
+	DEMAND_PendingWalk = LOC_U8Walk;
+	DEMAND_PendingTime = now;
+	DEMAND_Pending = 1;
+}
+
+/*
+ * Function: DEMAND_Init()
+ * Description: Clears the model, draws the first arrivals and connects the model to the backend.
+ * Arguments:
+ *   - config: the demand, copied
+ * Returns: void
+ */
+void DEMAND_Init(const ST_DemandConfig_t* config){
+	DEMAND_Config = *config;
+	memset(&DEMAND_Stats, 0, sizeof(DEMAND_Stats));
+	memset(&DEMAND_Queue, 0, sizeof(DEMAND_Queue));
+	memset(&DEMAND_Waiting, 0, sizeof(DEMAND_Waiting));
+	DEMAND_DeliveredHead = DEMAND_DeliveredNum = DEMAND_PedDue = 0;
+	DEMAND_Green = DEMAND_Walk = DEMAND_Pending = 0;
+	DEMAND_LastDeparture = DEMAND_AreaTime = 0;
+
+	// Arrival rates per cycle, raised so that the minimum headway keeps the mean rate
+	double LOC_Rate = DEMAND_Config.vehicleRate / HOST_CYCLES_PER_HOUR / (1 - DEMAND_Config.vehicleRate * DEMAND_MIN_HEADWAY / HOST_CYCLES_PER_HOUR);
+	double LOC_Share = DEMAND_Config.platoonShare, LOC_Window = DEMAND_Config.platoonWindow;
+	if(LOC_Share > 0){
+		DEMAND_RateIn = LOC_Rate * LOC_Share / LOC_Window;
+		DEMAND_RateOut = (LOC_Window < 1) ? LOC_Rate * (1 - LOC_Share) / (1 - LOC_Window) : 0;
+	}
+	else DEMAND_RateIn = DEMAND_RateOut = LOC_Rate;
+	DEMAND_NextVehicle = (DEMAND_Config.vehicleRate > 0) ? DEMAND_NextArrival(0) : UINT64_MAX;
+	DEMAND_NextPed = HOST_Arrival(DEMAND_Config.pedRate);
+
+	HOST_SetInput(DEMAND_Input, NULL);
+	HOST_SetOutput(DEMAND_Output, NULL);
+}
+
+/*
+ * Function: DEMAND_Finish()
+ * Description: Advances the model to the end of the run, the vehicles and pedestrians still waiting are not counted.
+ * Arguments:
+ *   - now: the end of the run (HOST_Time)
+ * Returns: void
+ */
+void DEMAND_Finish(uint64_t now){
+	DEMAND_Advance(now + 1);
+	DEMAND_Stats.queueArea += DEMAND_Queue.num * (now - DEMAND_AreaTime);
+	DEMAND_AreaTime = now;
+	DEMAND_Stats.time = now;
+}
+
+const ST_DemandStats_t* DEMAND_GetStats(void){
+	return &DEMAND_Stats;
+}
+
+/*
+ * Function: DEMAND_Percentile()
+ * Description: Gets a percentile of a distribution, the upper bound of its 100 ms bucket.
+ * Returns: the percentile in seconds, negative above 600 s
+ */
+double DEMAND_Percentile(const ST_DemandDist_t* dist, double percent){
+	uint64_t LOC_U64Rank = (uint64_t)ceil(dist->count * percent / 100), LOC_U64Seen = 0;
+	if(!LOC_U64Rank) LOC_U64Rank = 1;
+	for(int i=0; i<DEMAND_BUCKETS; i++){
+		LOC_U64Seen += dist->hist[i];
+		if(LOC_U64Seen >= LOC_U64Rank) return (i + 1) * (DEMAND_BUCKET / 1e6);
+	}
+	return -1;
+}
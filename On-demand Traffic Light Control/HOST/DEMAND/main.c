@@ -0,0 +1,107 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "demandsim" host tool, which runs the unmodified firmware against
+ * the traffic demand model (DEMAND_Interface.h): vehicles arriving at random or in platoons and counted
+ * by the loop detector, and pedestrians pressing the button when they arrive outside the walk.
+ * It reports the queue at the stop line (mean over time, largest, at the start of the greens, cycle failures),
+ * the delay of the vehicles, the wait of the pedestrians, and how much faster than real time the run went.
+ * The arrivals stop after the given duration and the firmware keeps running 10 minutes so the queue is cleared.
+ * Build the tool twice to compare: by default the green is actuated, with -DAPP_ACTUATED=0 it is the fixed green.
+ * Usage:
+ *   demandsim [-m minutes] [-v vehicles per hour] [-k platoon share] [-w platoon window] [-c upstream cycle]
+ *             [-p pedestrians per hour] [-s seed]
+ *     defaults: one day, 600 vehicles per hour in Poisson arrivals (share 0), platoons in 30 % of a 60 s cycle,
+ *     60 pedestrians per hour, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "DEMAND_Interface.h"
+#include "../../APP/APP_Interface.h"
+
+#define CLEAR_TIME 600000000ULL
+
+static double minutes = 24 * 60;
+static ST_DemandConfig_t config = {600, 0, 0.3, 60, 60, 0};
+static uint64_t endTime;
+static ST_Stats_t stats;
+
+static void Done(void){
+	STATS_Read(&stats);
+}
+
+static void PrintDist(const char* name, const ST_DemandDist_t* dist){
+	double LOC_P50 = DEMAND_Percentile(dist, 50), LOC_P95 = DEMAND_Percentile(dist, 95);
+	printf("%s: mean %.2f s, p50 ", name, dist->count ? dist->sum / 1e6 / dist->count : 0.0);
+	if(LOC_P50 < 0) printf(">600 s"); else printf("%.1f s", LOC_P50);
+	if(LOC_P95 < 0) printf(", p95 >600 s"); else printf(", p95 %.1f s", LOC_P95);
+	printf(", max %.1f s\n", dist->max / 1e6);
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'v': config.vehicleRate = atof(arg); break;
+		case 'k': config.platoonShare = atof(arg); break;
+		case 'w': config.platoonWindow = atof(arg); break;
+		case 'c': config.upstreamCycle = atof(arg); break;
+		case 'p': config.pedRate = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "m:v:k:w:c:p:s:", Option,
+	                "demandsim [-m minutes] [-v vehicles per hour] [-k platoon share] [-w platoon window]"
+	                " [-c upstream cycle] [-p pedestrians per hour] [-s seed]") < 0) return 2;
+	if(minutes <= 0 || minutes > 60 * 24 * 366){
+		fprintf(stderr, "demandsim: the duration must be from 0 to 366 days\n");
+		return 2;
+	}
+	if(config.vehicleRate < 0 || config.vehicleRate >= 3600 || config.pedRate < 0){
+		fprintf(stderr, "demandsim: the vehicle rate must be from 0 to 3600 per hour\n");
+		return 2;
+	}
+	if(config.platoonShare < 0 || config.platoonShare > 1 || config.platoonWindow <= 0
+	   || config.platoonWindow > 1 || config.upstreamCycle <= 0){
+		fprintf(stderr, "demandsim: the platoon share must be from 0 to 1, the window from 0 to 1 of a positive cycle\n");
+		return 2;
+	}
+
+	endTime = (uint64_t)(minutes * 60e6);
+	config.endTime = endTime;
+	DEMAND_Init(&config);
+	double LOC_Cpu = (double)clock();
+	HOST_Simulate(APP_Init, APP_Start, Done, endTime + CLEAR_TIME);
+	LOC_Cpu = ((double)clock() - LOC_Cpu) / CLOCKS_PER_SEC;
+	DEMAND_Finish(HOST_Time);
+	const ST_DemandStats_t* LOC_Stats = DEMAND_GetStats();
+
+	printf("%.0f minutes, %s green, %.0f vehicles per hour", minutes, APP_ACTUATED ? "actuated" : "fixed", config.vehicleRate);
+	if(config.platoonShare > 0) printf(" (%.0f %% in platoons in %.0f %% of a %.0f s cycle)", config.platoonShare * 100,
+	                                       config.platoonWindow * 100, config.upstreamCycle);
+	printf(", %.0f pedestrians per hour\n", config.pedRate);
+	printf("%llu vehicles, %llu departed, %llu stopped, %llu lost (queue full)\n", (unsigned long long)LOC_Stats->vehicles,
+	       (unsigned long long)LOC_Stats->departed, (unsigned long long)LOC_Stats->stopped, (unsigned long long)LOC_Stats->lost);
+	PrintDist("vehicle delay", &LOC_Stats->delay);
+	printf("queue: mean %.2f vehicles, largest %u, mean %.2f at the start of the green, %llu cycle failures in %llu greens\n",
+	       LOC_Stats->time ? (double)LOC_Stats->queueArea / LOC_Stats->time : 0.0, LOC_Stats->maxQueue,
+	       LOC_Stats->greens ? (double)LOC_Stats->queueAtGreen / LOC_Stats->greens : 0.0,
+	       (unsigned long long)LOC_Stats->failures, (unsigned long long)LOC_Stats->greens);
+	printf("%llu pedestrians, %llu crossed at once, %llu presses, at most %u waiting\n", (unsigned long long)LOC_Stats->peds,
+	       (unsigned long long)LOC_Stats->crossedAtOnce, (unsigned long long)LOC_Stats->presses, LOC_Stats->maxWaiting);
+	PrintDist("pedestrian wait", &LOC_Stats->wait);
+	printf("controller: %u cycles (%u cut short), %u pedestrian sequences", stats.counter[STATS_CYCLES],
+	       stats.counter[STATS_CUT_SHORT], stats.counter[STATS_ACCEPTED]);
+	if(APP_ACTUATED) printf(", %u gap-outs, %u max-outs", stats.counter[STATS_GAP_OUTS], stats.counter[STATS_MAX_OUTS]);
+	printf("\n%.1f s of CPU time, %.0f times real time\n", LOC_Cpu, LOC_Cpu > 0 ? HOST_Time / 1e6 / LOC_Cpu : 0.0);
+	return 0;
+}
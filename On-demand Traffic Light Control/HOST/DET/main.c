@@ -0,0 +1,187 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "detsim" host tool, which measures the delay of the cars
+ * with the actuated green (vehicle detector, ECUAL/DET) and with the fixed green.
+ * The unmodified firmware runs on the host backend for a number of virtual minutes. The vehicles arrive at random
+ * (Poisson arrivals with a 1 second minimum headway, fixed seed) or at the times of an arrival trace,
+ * each one is a pulse on T0 at its arrival. Button presses can be added at random as well.
+ * The queue at the stop line is modelled from the car green intervals seen on the lamps: the queued vehicles leave
+ * one every SAT_HEADWAY seconds while the green is on, a vehicle arriving to an empty queue during the green
+ * goes through without delay. The delay of a vehicle is its departure time minus its arrival time.
+ * The firmware keeps running 10 minutes after the last arrival so the queue is cleared.
+ * Build the tool twice to compare: by default the green is actuated (standalone controller),
+ * with -DAPP_ACTUATED=0 it is the fixed green of the plan.
+ * Usage:
+ *   detsim [-m minutes] [-v vehicles per hour] [-p presses per hour] [-t arrival trace] [-s seed]
+ *     defaults: 60 minutes, 600 vehicles per hour, no presses, seed 1
+ *   arrival trace: a text file with one arrival time in seconds per line, in increasing order ('#' starts a comment),
+ *     arrivals closer than 0.2 s to the previous one are moved (the detector pulses last 0.1 s)
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#define MIN_HEADWAY     1000000ULL  // random arrivals: 1 s minimum headway
+#define TRACE_SPACING   200000ULL   // trace arrivals: 0.2 s minimum spacing
+#define SAT_HEADWAY     2000000ULL  // queue discharge: one vehicle every 2 s
+#define CLEAR_TIME      600000000ULL
+
+// Options
+static double minutes = 60, vehicleRate = 600, pressRate = 0;
+static const char* tracePath;
+
+// Arrivals
+static FILE* trace;
+static uint64_t* arrivals;
+static size_t vehicles, arrivalSize, moved;
+static uint64_t nextVehicle = UINT64_MAX;
+static ST_HostPresses_t presses;
+
+// Simulation
+static uint64_t endTime;
+static ST_Stats_t stats;
+
+// Car green intervals
+static uint64_t (*greens)[2];
+static size_t greenNum, greenSize;
+static uint8_t greenOn;
+
+/*
+ * Time of the vehicle after the one arriving at LOC_U64Last, UINT64_MAX after the end of the trace.
+ */
+static uint64_t NextArrival(uint64_t LOC_U64Last){
+	if(!trace) return LOC_U64Last + MIN_HEADWAY + (uint64_t)(-log(HOST_Uniform()) * (HOST_CYCLES_PER_HOUR / vehicleRate - MIN_HEADWAY));
+	char LOC_Line[128];
+	while(fgets(LOC_Line, sizeof(LOC_Line), trace)){
+		char* LOC_PtrEnd;
+		double t = strtod(LOC_Line, &LOC_PtrEnd);
+		if(LOC_PtrEnd == LOC_Line) continue; // blank line or comment
+		uint64_t LOC_U64Time = (uint64_t)(t * 1e6);
+		if(vehicles && LOC_U64Time < LOC_U64Last + TRACE_SPACING){
+			LOC_U64Time = LOC_U64Last + TRACE_SPACING;
+			moved++;
+		}
+		return LOC_U64Time;
+	}
+	return UINT64_MAX;
+}
+
+/*
+ * Input source: the vehicles (pulses on T0) and the button presses, in time order.
+ */
+static uint8_t Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	if(nextVehicle < endTime && nextVehicle <= presses.next){
+		event->time = nextVehicle;
+		event->code = HOST_EV_CODE(HOST_EV_PULSE, HOST_PIN_T0);
+		if(vehicles == arrivalSize){
+			arrivalSize = arrivalSize ? 2 * arrivalSize : 4096;
+			arrivals = realloc(arrivals, arrivalSize * sizeof(*arrivals));
+		}
+		arrivals[vehicles++] = nextVehicle;
+		nextVehicle = NextArrival(nextVehicle);
+		return 1;
+	}
+	return HOST_PressInput(event, &presses);
+}
+
+/*
+ * Output observer: records the car green intervals.
+ */
+static void Output(uint64_t now, void* arg){
+	(void)arg;
+	uint8_t LOC_U8Green = HOST_LAMP_ON == HOST_Lamp(APP_Sites[0].lamps[APP_MAIN_GREEN].port, APP_Sites[0].lamps[APP_MAIN_GREEN].pin);
+	if(LOC_U8Green && !greenOn){
+		if(greenNum == greenSize){
+			greenSize = greenSize ? 2 * greenSize : 1024;
+			greens = realloc(greens, greenSize * sizeof(*greens));
+		}
+		greens[greenNum][0] = now;
+		greens[greenNum][1] = UINT64_MAX;
+	}
+	if(!LOC_U8Green && greenOn) greens[greenNum++][1] = now;
+	greenOn = LOC_U8Green;
+}
+
+static void Loop(void){
+	if(HOST_Time >= endTime && !stats.counter[STATS_CYCLES]) STATS_Read(&stats); // first cycle after the last arrival
+	APP_Start();
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'v': vehicleRate = atof(arg); break;
+		case 'p': pressRate = atof(arg); break;
+		case 't': tracePath = arg; break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "m:v:p:t:s:", Option,
+	                "detsim [-m minutes] [-v vehicles per hour] [-p presses per hour] [-t arrival trace] [-s seed]") < 0) return 2;
+	if(minutes <= 0 || minutes > 60 * 24 * 7){
+		fprintf(stderr, "detsim: the duration must be from 0 to 7 days\n");
+		return 2;
+	}
+	if(!tracePath && (vehicleRate <= 0 || vehicleRate >= 3600)){
+		fprintf(stderr, "detsim: the vehicle rate must be from 0 to 3600 per hour\n");
+		return 2;
+	}
+	if(tracePath && !(trace = fopen(tracePath, "r"))){
+		perror(tracePath);
+		return 2;
+	}
+
+	endTime = (uint64_t)(minutes * 60e6);
+	nextVehicle = NextArrival(0);
+	HOST_PressStart(&presses, pressRate, endTime);
+	HOST_SetInput(Input, NULL);
+	HOST_SetOutput(Output, NULL);
+	HOST_Simulate(APP_Init, Loop, NULL, endTime + CLEAR_TIME);
+
+	// Queue discharge during the greens
+	uint64_t LOC_U64Departure = 0, LOC_U64Total = 0, LOC_U64Max = 0;
+	size_t LOC_Served = 0, g = 0;
+	for(size_t i=0; i<vehicles; i++){
+		uint64_t t = arrivals[i];
+		if(i && t < LOC_U64Departure + SAT_HEADWAY) t = LOC_U64Departure + SAT_HEADWAY;
+		while(g < greenNum && greens[g][1] <= t) g++;
+		if(g == greenNum) break;
+		if(t < greens[g][0]) t = greens[g][0];
+		LOC_U64Departure = t;
+		LOC_U64Total += t - arrivals[i];
+		if(t - arrivals[i] > LOC_U64Max) LOC_U64Max = t - arrivals[i];
+		LOC_Served++;
+	}
+	uint64_t LOC_U64Green = 0;
+	size_t LOC_Greens = 0;
+	for(size_t i=0; i<greenNum && greens[i][0] < endTime; i++){
+		LOC_U64Green += greens[i][1] - greens[i][0];
+		LOC_Greens++;
+	}
+
+	printf("%.0f minutes, %s green, %zu vehicles (%s), %llu presses\n", minutes,
+	       APP_ACTUATED ? "actuated" : "fixed", vehicles, trace ? tracePath : "random", (unsigned long long)presses.count);
+	if(APP_ACTUATED) printf("gap %.1f s, maximum green %.1f s: %u gap-outs, %u max-outs\n", APP_GAP_HALF_SECS * 0.5,
+	                        APP_MAX_GREEN_HALF_SECS * 0.5, stats.counter[STATS_GAP_OUTS], stats.counter[STATS_MAX_OUTS]);
+	if(moved) printf("%zu trace arrivals moved to 0.2 s after the previous one\n", moved);
+	printf("%zu greens, mean green %.2f s, mean cycle %.2f s, %u vehicles counted by the detector\n", LOC_Greens,
+	       LOC_Greens ? LOC_U64Green / 1e6 / LOC_Greens : 0.0, LOC_Greens ? minutes * 60 / LOC_Greens : 0.0,
+	       stats.counter[STATS_VEHICLES]);
+	printf("average delay %.2f s, largest delay %.1f s, %zu vehicles not served\n",
+	       LOC_Served ? LOC_U64Total / 1e6 / LOC_Served : 0.0, LOC_U64Max / 1e6, vehicles - LOC_Served);
+	return 0;
+}
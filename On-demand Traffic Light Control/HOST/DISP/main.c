@@ -0,0 +1,168 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "dispsim" host tool, which checks the pedestrian countdown display (ECUAL/DISP).
+ * The firmware is built with -DDISP_ENABLE=1 and runs on the host backend for a number of virtual minutes
+ * with button presses arriving at random (Poisson arrivals, fixed seed), so the display refresh runs
+ * next to the shift register frames, the EEPROM log writes and the phase changes.
+ * Every write to the display port is a refresh: the tool measures the interval between two refreshes of the same digit
+ * and checks that the digits alternate. Each digit is decoded and compared with the countdown expected at that time:
+ * the seconds left until the pedestrian's green LED turns off, rounded up (the end is predicted from the plan
+ * when the LED turns on), blank when it is off. A refresh at the same time as the update may show the previous value
+ * (1 ms tolerance). The tool also counts the updates of the units digit: one per second of walk plus the blanking
+ * for the walks ended before the end of the run.
+ * The CPU time of the refresh interrupt is not modelled by the backend, see README.md for its cycle count.
+ * Usage:
+ *   dispsim [-m minutes] [-r presses per hour] [-s seed]
+ *     defaults: 60 minutes, 60 presses per hour, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#define TOLERANCE       1000ULL
+
+#if !DISP_ENABLE
+#error "dispsim needs the display build (-DDISP_ENABLE=1)"
+#endif
+
+// Options
+static double minutes = 60, pressRate = 60;
+
+// Simulation
+static ST_HostPresses_t presses;
+static uint64_t endTime;
+
+// Walk (pedestrian's green) in progress or last one
+static uint8_t walkOn, started;
+static uint16_t walkHalfSecs;
+static uint64_t walkStart, walkEnd = 0, walkOff, walks, walkSeconds, walkLate;
+
+// Refreshes
+static const uint8_t segments[11] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x00};
+static uint8_t lastPort;
+static uint64_t refreshes, lastRefresh[2], minInterval[2] = {UINT64_MAX, UINT64_MAX}, maxInterval[2], sumInterval[2], intervals[2];
+static uint64_t repeated, wrong, unitChanges, pendingChanges; // changes of the walk in progress are pending
+static uint8_t lastFrame[2] = {0xFF, 0xFF};
+
+/*
+ * Countdown expected at a time: the seconds left of the walk rounded up, 0 (blank) outside of it.
+ */
+static uint8_t Expected(uint64_t t){
+	if(!started || t < walkStart || t >= walkEnd || (!walkOn && t >= walkOff)) return 0;
+	uint64_t LOC_U64Secs = (walkEnd - t + 999999) / 1000000;
+	return (LOC_U64Secs > 99) ? 99 : (uint8_t)LOC_U64Secs;
+}
+
+/*
+ * Segments of a digit of a value (1: tens, 0: units), the leading zero and 0 are blank.
+ */
+static uint8_t Digit(uint8_t value, uint8_t digit){
+	if(!value) return segments[10];
+	if(digit) return (value < 10) ? segments[10] : segments[value / 10];
+	return segments[value % 10];
+}
+
+/*
+ * Output observer: follows the pedestrian's green LED and checks each refresh of the display.
+ */
+static void Output(uint64_t now, void* arg){
+	(void)arg;
+	uint8_t LOC_U8Walk = HOST_LAMP_ON == HOST_Lamp(APP_Sites[0].lamps[APP_LAMP_PED_GREEN].port, APP_Sites[0].lamps[APP_LAMP_PED_GREEN].pin);
+	if(LOC_U8Walk && !walkOn){
+		const uint8_t* LOC_PtrHalfSecs = PLAN_Get()->halfSecs;
+		uint16_t LOC_U16Half = (PEDESTRIAN == APP_Contexts[0].mode) ? LOC_PtrHalfSecs[PLAN_PED_WALK] + LOC_PtrHalfSecs[PLAN_PED_CLEAR]
+		                                              : LOC_PtrHalfSecs[PLAN_RED];
+		walkStart = now;
+		walkEnd = now + LOC_U16Half * 500000ULL;
+		walkHalfSecs = LOC_U16Half;
+		started = 1;
+		if(walkOff < endTime) unitChanges += pendingChanges; // the previous walk ended in the run
+		pendingChanges = 0;
+	}
+	if(!LOC_U8Walk && walkOn){
+		walkOff = now;
+		if(now < endTime){
+			walkSeconds += (walkHalfSecs + 1) / 2;
+			walks++;
+		}
+		if(now != walkEnd && now + TOLERANCE < walkEnd){
+			if(walkLate < 10) printf("walk ended at %.3f s, %.3f s before the predicted end\n", now / 1e6, (walkEnd - now) / 1e6);
+			walkLate++;
+		}
+	}
+	walkOn = LOC_U8Walk;
+
+	uint8_t LOC_U8Port = 0;
+	for(uint8_t i=0; i<8; i++) LOC_U8Port |= (HOST_LAMP_ON == HOST_Lamp(DISP_PORT, i)) << i;
+	if(LOC_U8Port == lastPort) return;
+	lastPort = LOC_U8Port;
+	if(now >= endTime) return;
+
+	uint8_t LOC_U8Digit = (LOC_U8Port >> DISP_SELECT_PIN) & 1;
+	uint8_t LOC_U8Seg = LOC_U8Port & 0x7F;
+	refreshes++;
+	if(lastRefresh[LOC_U8Digit]){
+		uint64_t LOC_U64Interval = now - lastRefresh[LOC_U8Digit];
+		if(LOC_U64Interval < minInterval[LOC_U8Digit]) minInterval[LOC_U8Digit] = LOC_U64Interval;
+		if(LOC_U64Interval > maxInterval[LOC_U8Digit]) maxInterval[LOC_U8Digit] = LOC_U64Interval;
+		sumInterval[LOC_U8Digit] += LOC_U64Interval;
+		intervals[LOC_U8Digit]++;
+	}
+	if(lastRefresh[LOC_U8Digit] > lastRefresh[!LOC_U8Digit]) repeated++; // the other digit was skipped
+	lastRefresh[LOC_U8Digit] = now;
+
+	uint8_t LOC_U8Now = Expected(now), LOC_U8Before = Expected(now > TOLERANCE ? now - TOLERANCE : 0);
+	if(LOC_U8Seg != Digit(LOC_U8Now, LOC_U8Digit) && LOC_U8Seg != Digit(LOC_U8Before, LOC_U8Digit)){
+		if(wrong < 10) printf("%s digit 0x%02X at %.3f s, expected %u\n", LOC_U8Digit ? "tens" : "units", LOC_U8Seg, now / 1e6, LOC_U8Now);
+		wrong++;
+	}
+	if(!LOC_U8Digit && lastFrame[0] != 0xFF && LOC_U8Seg != lastFrame[0]) pendingChanges++;
+	lastFrame[LOC_U8Digit] = LOC_U8Seg;
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "m:r:s:", Option, "dispsim [-m minutes] [-r presses per hour] [-s seed]") < 0) return 2;
+	if(minutes <= 0 || minutes > 60 * 24 * 7){
+		fprintf(stderr, "dispsim: the duration must be from 0 to 7 days\n");
+		return 2;
+	}
+
+	endTime = (uint64_t)(minutes * 60e6);
+	HOST_PressStart(&presses, pressRate, endTime);
+	HOST_SetInput(HOST_PressInput, &presses);
+	HOST_SetOutput(Output, NULL);
+	HOST_Simulate(APP_Init, APP_Start, NULL, endTime);
+	if(!walkOn && walkOff < endTime) unitChanges += pendingChanges;
+
+	printf("%.0f minutes, %llu presses, %llu walks (%llu seconds)\n", minutes, (unsigned long long)presses.count,
+	       (unsigned long long)walks, (unsigned long long)walkSeconds);
+	printf("%llu refreshes (%.1f per second), %llu digits lit twice in a row\n", (unsigned long long)refreshes,
+	       refreshes / (minutes * 60), (unsigned long long)repeated);
+	for(uint8_t d=0; d<2; d++){
+		printf("%s digit refreshed every %.3f ms (min %.3f, max %.3f)\n", d ? "tens " : "units",
+		       intervals[d] ? sumInterval[d] / 1e3 / intervals[d] : 0.0, intervals[d] ? minInterval[d] / 1e3 : 0.0, maxInterval[d] / 1e3);
+	}
+	printf("%llu units digit updates (%llu seconds of walk and %llu blankings)\n", (unsigned long long)unitChanges,
+	       (unsigned long long)walkSeconds, (unsigned long long)walks);
+	printf("%llu digits different from the countdown, %llu walks ended before the predicted end\n",
+	       (unsigned long long)wrong, (unsigned long long)walkLate);
+	return (wrong || repeated || walkLate || unitChanges != walkSeconds + walks) ? 1 : 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "elogsim" host tool, which estimates the EEPROM lifetime of the event log
+ * (SERVICES/ELOG) at given event rates.
+ * The unmodified firmware runs on the host backend for a number of virtual days, with button presses and resets
+ * arriving at random (Poisson arrivals, fixed seed). The backend counts the writes of each EEPROM byte,
+ * and the lifetime is the endurance of a byte divided by the writes per byte and per day of the log ring.
+ * At the end the log is read back with ELOG_Rewind/ELOG_Next and the records are counted per event,
+ * to check the log against the simulated events.
+ * Usage:
+ *   elogsim [-d days] [-r presses per hour] [-b resets per day] [-e endurance] [-s seed]
+ *     defaults: 7 days, 60 presses per hour, 1 reset per day, 100000 writes per byte, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+
+// Options
+static double days = 7, pressRate = 60, resetRate = 1, endurance = 100000;
+
+// Simulation
+static ST_HostPresses_t presses;
+static uint64_t endTime, nextReset;
+static uint64_t resets;
+
+// Log read back at the end
+static uint64_t records[ELOG_EVENT_NUM], recordCount, recordTicks;
+
+/*
+ * Input source: the next press or reset, then the end of the stream.
+ */
+static uint8_t Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	if(presses.next >= endTime && nextReset >= endTime) return 0;
+	if(presses.next <= nextReset) return HOST_PressInput(event, &presses);
+	event->time = nextReset;
+	event->code = HOST_EV_CODE(HOST_EV_RESET, 0);
+	nextReset += HOST_Arrival(resetRate / 24);
+	resets++;
+	return 1;
+}
+
+/*
+ * Reads the whole log back, from the firmware context (the EEPROM reads poll the simulated hardware).
+ */
+static void ReadBack(void){
+	ST_ElogRecord_t LOC_Record;
+	ELOG_Rewind();
+	while(ELOG_Next(&LOC_Record)){
+		if(LOC_Record.event < ELOG_EVENT_NUM) records[LOC_Record.event]++;
+		recordCount++;
+		recordTicks += LOC_Record.delta;
+	}
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'd': days = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+		case 'b': resetRate = atof(arg); break;
+		case 'e': endurance = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "d:r:b:e:s:", Option,
+	                "elogsim [-d days] [-r presses per hour] [-b resets per day] [-e endurance] [-s seed]") < 0) return 2;
+	if(days <= 0){
+		fprintf(stderr, "elogsim: the duration must be positive\n");
+		return 2;
+	}
+
+	endTime = (uint64_t)(days * 24 * HOST_CYCLES_PER_HOUR);
+	HOST_PressStart(&presses, pressRate, endTime);
+	nextReset = HOST_Arrival(resetRate / 24);
+	HOST_SetInput(Input, NULL);
+	HOST_Simulate(APP_Init, APP_Start, ReadBack, endTime);
+
+	uint64_t LOC_U64Total = 0, LOC_U64Max = 0;
+	for(uint16_t a=ELOG_EE_START; a<ELOG_EE_END; a++){
+		uint32_t LOC_U32Writes = HOST_EepromWrites(a);
+		LOC_U64Total += LOC_U32Writes;
+		if(LOC_U32Writes > LOC_U64Max) LOC_U64Max = LOC_U32Writes;
+	}
+	double LOC_BytesPerDay = LOC_U64Total / days;
+	double LOC_Passes = (double)LOC_U64Total / ELOG_SIZE;
+
+	printf("%.1f days, %llu presses, %llu resets\n", days, (unsigned long long)presses.count, (unsigned long long)resets);
+	printf("log ring %u bytes, %.0f bytes written per day, %.2f passes (max %llu writes per byte)\n",
+	       (unsigned)ELOG_SIZE, LOC_BytesPerDay, LOC_Passes, (unsigned long long)LOC_U64Max);
+	printf("log read back: %llu records over %.1f hours (boot %llu, watchdog %llu, pedestrian %llu, plan %llu), %u dropped\n",
+	       (unsigned long long)recordCount, recordTicks / 7200.0, (unsigned long long)records[ELOG_BOOT],
+	       (unsigned long long)records[ELOG_WATCHDOG], (unsigned long long)records[ELOG_PEDESTRIAN],
+	       (unsigned long long)records[ELOG_PLAN], ELOG_Dropped());
+	if(LOC_U64Total){
+		double LOC_Days = endurance * ELOG_SIZE / LOC_BytesPerDay;
+		printf("lifetime at %.0f writes per byte: %.0f days (%.1f years)\n", endurance, LOC_Days, LOC_Days / 365.25);
+	}
+	else printf("nothing written\n");
+	return 0;
+}
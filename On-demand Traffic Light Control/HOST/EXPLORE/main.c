@@ -0,0 +1,237 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "explore" host tool, an exhaustive state-space explorer of the application.
+ * The outcome of a button press depends on where it lands in APP_Start: during a delay, right before or after
+ * a mode check, or between two lamp writes (the EXTI0 ISR reads the car lamps to decide).
+ * The tool runs the unmodified APP logic on the host backend and, at every preemption point (output write,
+ * poll of a hardware flag, main loop pass), tries both "no press" and "press now", up to a number of presses.
+ * Each branch is re-executed from reset with its press schedule (the firmware is deterministic in virtual time),
+ * and a branch stops as soon as it reaches a state already visited:
+ *   state = simulated hardware (HOST_StateHash) + APP variables + call stack of the preemption point
+ *           + current and previous lamp states + time since the last lamp change
+ *           + presses already used + age of the unanswered press
+ * At every new state the safety invariants are checked:
+ *   - no conflicting greens: the car green and the pedestrian green lamps are never lit together
+ *   - bounded wait: after a press the pedestrian green lamp is lit within the wait limit
+ * A violation is printed with its press schedule as a replay event list (see HOST/REPLAY/main.c),
+ * the comment gives the preemption point of each press (the replay tool delivers a press at the next poll).
+ * Usage:
+ *   explore [-p presses] [-w seconds] [-t seconds] [-v]
+ *     -p: maximum presses per run (default 2), -w: wait limit (default 20 s),
+ *     -t: virtual time limit of a run (default 600 s), -v: print every violation (default the first 10)
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <execinfo.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#define EXPLORE_MAX_PRESSES 8
+#define EXPLORE_MAX_FRAMES  32
+#define EXPLORE_HASH_BITS   22
+
+// Lamp state: 2 bits (HOST_LAMP_OFF, ON, FLASH) per lamp, in the order of the lamps of the first site (APP_Signals.h)
+#define LAMP_LIT(state, i) (((state) >> (2 * (i))) & 0x03)
+#if APP_LAMP_NUM > 8
+#error "The lamp state holds 8 lamps"
+#endif
+
+// Press schedule: preemption point numbers of the presses, in order
+typedef struct {
+	uint32_t point[EXPLORE_MAX_PRESSES];
+	uint8_t count;
+} ST_Schedule_t;
+
+// Run state, reset before each run
+typedef struct {
+	const ST_Schedule_t* schedule;
+	uint32_t start;          // first point not explored by the parent run
+	uint32_t point;          // number of the current preemption point
+	uint8_t used;            // presses done
+	uint64_t pressTime[EXPLORE_MAX_PRESSES];
+	uint16_t lamps, prevLamps;
+	uint64_t lampTime;       // time of the last lamp change
+	uint8_t waiting;         // a press is not answered yet
+	uint64_t waitStart;
+} ST_Run_t;
+
+static ST_Run_t run;
+
+// Options
+static uint8_t maxPresses = 2;
+static uint64_t maxWait = 20000000ULL;
+static uint64_t timeLimit = 600000000ULL;
+static uint8_t verbose;
+
+// Results
+static ST_Schedule_t* work;
+static size_t workCount, workSize;
+static uint64_t* visited;
+static uint64_t states, runs, points, violations, longestWait;
+
+/************************************************************************/
+/*                       Visited states                                 */
+/************************************************************************/
+
+static uint64_t Mix(uint64_t h, uint64_t v){
+	h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+	return h * 0xFF51AFD7ED558CCDULL;
+}
+
+/*
+ * Inserts a state hash in the open addressing table (0 marks an empty slot).
+ * Return value: 1 if the state is new, 0 if it was already visited
+ */
+static uint8_t Visit(uint64_t key){
+	size_t mask = ((size_t)1 << EXPLORE_HASH_BITS) - 1;
+	if(!key) key = 1;
+	for(size_t i = key & mask; ; i = (i + 1) & mask){
+		if(visited[i] == key) return 0;
+		if(!visited[i]){
+			visited[i] = key;
+			return 1;
+		}
+	}
+}
+
+static void Push(const ST_Schedule_t* schedule, uint32_t point){
+	if(workCount == workSize){
+		workSize = workSize ? 2 * workSize : 1024;
+		work = realloc(work, workSize * sizeof(ST_Schedule_t));
+		if(!work){ perror("explore"); exit(2); }
+	}
+	work[workCount] = *schedule;
+	work[workCount].point[work[workCount].count++] = point;
+	workCount++;
+}
+
+/************************************************************************/
+/*                       Preemption hook                                */
+/************************************************************************/
+
+static void Violation(const char* what, uint64_t now){
+	violations++;
+	if(verbose || violations <= 10){
+		printf("VIOLATION %s at %.3f ms, presses:\n", what, now / 1e3);
+		for(uint8_t i=0; i<run.used; i++) printf("  %.3f press # point %u\n", run.pressTime[i] / 1e3, run.schedule->point[i]);
+		printf("  %.3f end\n", now / 1e3);
+	}
+	HOST_Halt();
+}
+
+static void Preempt(uint64_t now, void* arg){
+	(void)arg;
+	uint32_t point = run.point++;
+	points++;
+
+	// Press at this point if the schedule says so
+	if(run.used < run.schedule->count && run.schedule->point[run.used] == point){
+		run.pressTime[run.used++] = now;
+		if(!run.waiting){
+			run.waiting = 1;
+			run.waitStart = now;
+		}
+		HOST_Inject(HOST_EV_CODE(HOST_EV_PULSE, HOST_PIN_INT0));
+	}
+
+	// Observe the lamps
+	uint16_t LOC_U16Lamps = 0;
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++) LOC_U16Lamps |= (uint16_t)HOST_Lamp(APP_Sites[0].lamps[i].port, APP_Sites[0].lamps[i].pin) << (2 * i);
+	if(LOC_U16Lamps != run.lamps){
+		run.prevLamps = run.lamps;
+		run.lamps = LOC_U16Lamps;
+		run.lampTime = now;
+	}
+	uint8_t LOC_U8CarGreen = LAMP_LIT(run.lamps, APP_MAIN_GREEN);
+	uint8_t LOC_U8PedGreen = LAMP_LIT(run.lamps, APP_LAMP_PED_GREEN);
+	if(run.waiting && LOC_U8PedGreen){
+		if(now - run.waitStart > longestWait) longestWait = now - run.waitStart;
+		run.waiting = 0;
+	}
+
+	// The points before the last press were explored by the parent run
+	if(point < run.start) return;
+
+	if(LOC_U8CarGreen && LOC_U8PedGreen) Violation("conflicting greens", now);
+	if(run.waiting && now - run.waitStart > maxWait) Violation("pedestrian wait limit", now);
+
+	void* LOC_Frames[EXPLORE_MAX_FRAMES];
+	int LOC_S32Frames = backtrace(LOC_Frames, EXPLORE_MAX_FRAMES);
+	uint64_t LOC_U64Key = HOST_StateHash();
+	for(int i=0; i<LOC_S32Frames; i++) LOC_U64Key = Mix(LOC_U64Key, (uint64_t)(uintptr_t)LOC_Frames[i]);
+	LOC_U64Key = Mix(LOC_U64Key, APP_Contexts[0].mode);
+	LOC_U64Key = Mix(LOC_U64Key, APP_Contexts[0].carLEDColor);
+	LOC_U64Key = Mix(LOC_U64Key, run.lamps);
+	LOC_U64Key = Mix(LOC_U64Key, run.prevLamps);
+	LOC_U64Key = Mix(LOC_U64Key, now - run.lampTime);
+	LOC_U64Key = Mix(LOC_U64Key, run.used);
+	LOC_U64Key = Mix(LOC_U64Key, run.waiting ? now - run.waitStart : UINT64_MAX);
+	if(!Visit(LOC_U64Key)) HOST_Halt();
+	states++;
+
+	if(run.used < maxPresses) Push(run.schedule, point);
+}
+
+static void Loop(void){
+	APP_Start();
+}
+
+int main(int argc, char** argv){
+	int opt;
+	while(-1 != (opt = getopt(argc, argv, "p:w:t:v"))){
+		switch(opt){
+			case 'p': maxPresses = (uint8_t)atoi(optarg); break;
+			case 'w': maxWait = (uint64_t)(atof(optarg) * 1e6); break;
+			case 't': timeLimit = (uint64_t)(atof(optarg) * 1e6); break;
+			case 'v': verbose = 1; break;
+			default:
+				fprintf(stderr, "usage: explore [-p presses] [-w seconds] [-t seconds] [-v]\n");
+				return 2;
+		}
+	}
+	if(maxPresses > EXPLORE_MAX_PRESSES) maxPresses = EXPLORE_MAX_PRESSES;
+	visited = calloc((size_t)1 << EXPLORE_HASH_BITS, sizeof(uint64_t));
+	if(!visited){ perror("explore"); return 2; }
+
+	struct timespec LOC_Start, LOC_End;
+	clock_gettime(CLOCK_MONOTONIC, &LOC_Start);
+	ST_Schedule_t LOC_Schedule = {{0}, 0}; // first run: no press
+	while(1){
+		memset(&run, 0, sizeof(run));
+		run.schedule = &LOC_Schedule;
+		run.start = LOC_Schedule.count ? LOC_Schedule.point[LOC_Schedule.count - 1] : 0;
+		APP_Contexts[0].mode = NORMAL; // power-on RAM
+		APP_Contexts[0].carLEDColor = RED;
+		HOST_SetInput(NULL, NULL);
+		HOST_SetPreempt(Preempt, NULL);
+		HOST_Run(APP_Init, Loop, timeLimit);
+		runs++;
+		if(states > ((uint64_t)1 << EXPLORE_HASH_BITS) / 2){
+			printf("state table full, increase EXPLORE_HASH_BITS\n");
+			return 2;
+		}
+		if(!workCount) break;
+		LOC_Schedule = work[--workCount];
+	}
+	clock_gettime(CLOCK_MONOTONIC, &LOC_End);
+
+	double LOC_Seconds = (LOC_End.tv_sec - LOC_Start.tv_sec) + (LOC_End.tv_nsec - LOC_Start.tv_nsec) / 1e9;
+	printf("%llu states, %llu runs, %llu preemption points, up to %u presses\n", (unsigned long long)states,
+	       (unsigned long long)runs, (unsigned long long)points, maxPresses);
+	printf("longest pedestrian wait %.3f s (limit %.3f s)\n", longestWait / 1e6, maxWait / 1e6);
+	printf("%.2f s, %.0f states/s\n", LOC_Seconds, states / (LOC_Seconds > 0 ? LOC_Seconds : 1e-9));
+	printf("%llu violations\n", (unsigned long long)violations);
+	return violations ? 1 : 0;
+}
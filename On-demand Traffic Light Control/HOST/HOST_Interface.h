@@ -0,0 +1,215 @@
+/*
+ * File: HOST_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the host backend, which runs the unmodified drivers and application on a PC.
+ * The project is compiled with HOST_BUILD defined (see utils/IO_ACCESS.h): the registers live in a simulated register file,
+ * and the backend models the parts of the ATmega32 used by the firmware in virtual time (1 cycle = 1 us at F_CPU = 1 MHz):
+ *   - GPIO: PORTx/DDRx/PINx, input pins are driven by input events
+ *   - EXTI: INT0 (PD2), INT1 (PD3), INT2 (PB2) edge detection, flags and vectors
+ *   - Timer0: normal mode overflow flag and interrupt, external clock (edges of T0 counted)
+ *   - Timer1: compare output mode of OC1A/OC1B (used to report flashing lamps)
+ *   - Timer2: normal mode overflow and CTC mode compare match interrupts
+ *   - Watchdog: timeout and watchdog reset
+ *   - EEPROM: reads, timed writes (HOST_EE_WRITE_CYCLES) and the ready interrupt, with a write counter per byte,
+ *     a write cut by a power failure leaves its byte erased
+ *   - USART: received bytes (input events) and receive interrupt, sent bytes reported to a callback
+ *   - SPI: master transfers and interrupt, shifted into a chain of 74HC595 registers latched by SS (PB4)
+ *   - ADC: single and free running conversions and interrupt, the inputs are given by an analog source
+ *   - Analog comparator: bandgap against the supply sense on AIN1 (input events), edge flags and interrupt
+ *   - TWI: slave receiver and transmitter with its interrupt, driven by a bus master of the tool, with clock stretching
+ *   - Flash: lpm reads, and the spm page erase, buffer fill and page write of the bootloader (HOST_SPM_CYCLES each),
+ *     with a write counter per page, the jumps of the bootloader (ijmp) stop the run
+ * The virtual time only advances when the firmware polls a hardware flag (IO_POLL) or calls HOST_Idle,
+ * it then jumps directly to the next event, so the firmware runs much faster than real time.
+ * Tools can take control at every preemption point (output write, poll, main loop pass) to inject inputs
+ * exactly between two firmware statements, and stop the run from there.
+ * The functions prototypes defined in this file include:
+ *   - HOST_Run: function to run the firmware from reset until a stop time
+ *   - HOST_SetInput: function to set the source of the timestamped input events
+ *   - HOST_SetOutput: function to set the function called when an output changes
+ *   - HOST_SetSerial: function to set the function called with each byte sent by the USART
+ *   - HOST_SetAnalog: function to set the analog source converted by the ADC
+ *   - HOST_SetTwi: function to set the master of the TWI bus
+ *   - HOST_Idle: function to account the time of one pass of the main loop
+ *   - HOST_Lamp: function to get the state of an output pin (off, on, flashing)
+ *   - HOST_SetPreempt: function to set the function called at each preemption point
+ *   - HOST_Inject: function to apply an input event immediately
+ *   - HOST_Halt: function to stop the run from a preemption point
+ *   - HOST_StateHash: function to get a hash of the simulated hardware state
+ *   - HOST_EepromWrites: function to get the number of writes of an EEPROM byte (wear)
+ *   - HOST_EepromRead: function to get the content of an EEPROM byte
+ *   - HOST_Shift: function to get the latched outputs of a register of the shift register chain
+ *   - HOST_Flash: function to get the simulated flash, to load or check the programs
+ *   - HOST_FlashWrites: function to get the number of erases and writes of a flash page (wear)
+ *   - HOST_JumpAddress: function to get the address of the jump that stopped the run
+ *   - HOST_Options: function to parse the command line of a simulation tool
+ *   - HOST_Uniform: function to draw a uniform random number
+ *   - HOST_Arrival: function to draw the interval to the next random arrival
+ *   - HOST_PressStart: function to start a source of random button presses
+ *   - HOST_PressInput: function to give the next random button press (input source)
+ *   - HOST_Simulate: function to run the application of a simulation tool until an end time
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef HOST_INTERFACE_H_
+#define HOST_INTERFACE_H_
+
+#include "../utils/STD_TYPES.h"
+#include "../utils/IO_ACCESS.h"
+
+// Size of the simulated register file (data memory addresses 0x00..0x5F)
+#define HOST_IO_SIZE 0x60
+
+// Virtual cycles accounted for one pass of the main loop (HOST_Idle)
+#define HOST_IDLE_CYCLES 100
+
+// Width of a pulse event in cycles
+#define HOST_PULSE_CYCLES 100000UL
+
+// Duration of an EEPROM byte write in cycles (8.5 ms)
+#define HOST_EE_WRITE_CYCLES 8500UL
+
+// Duration of a flash page erase or page write in cycles (4.5 ms)
+#define HOST_SPM_CYCLES 4500UL
+
+// Registers in the shift register chain on the SPI
+#define HOST_SHIFT_CHIPS 8
+
+// Cycles in one hour of virtual time
+#define HOST_CYCLES_PER_HOUR 3600000000ULL
+
+// Largest number of bytes written or read by a TWI transaction
+#define HOST_TWI_MAX 32
+
+// Input pins that can be driven by events
+typedef enum hostPin{
+	HOST_PIN_INT0, // PD2
+	HOST_PIN_INT1, // PD3
+	HOST_PIN_INT2, // PB2
+	HOST_PIN_T0,   // PB0
+	HOST_PIN_T1,   // PB1
+	HOST_PIN_NUM
+} EN_HostPin_t;
+
+// Input event types, an event code is (type << 4) | pin
+typedef enum hostEvent{
+	HOST_EV_RISE  = 0x1,
+	HOST_EV_FALL  = 0x2,
+	HOST_EV_PULSE = 0x3, // rising edge followed by a falling edge after HOST_PULSE_CYCLES
+	HOST_EV_RESET = 0x4, // external reset (pin field unused)
+	HOST_EV_SERIAL = 0x5, // byte received by the USART, in the data field (pin field unused)
+	HOST_EV_SYNC  = 0x6, // no effect, gives control back to the input source at the event time (pin field unused)
+	HOST_EV_DROOP = 0x7, // supply under the comparator threshold, AIN1 under the bandgap (pin field unused)
+	HOST_EV_SUPPLY = 0x8, // supply back above the comparator threshold (pin field unused)
+	HOST_EV_POWER = 0x9, // power cut and back: power-on reset, a write of the EEPROM in progress is lost (pin field unused)
+	HOST_EV_WATCHDOG = 0xA, // watchdog reset, as if the firmware got stuck (pin field unused)
+	HOST_EV_END   = 0xF  // end of the input stream
+} EN_HostEvent_t;
+
+#define HOST_EV_CODE(type, pin) ((uint8_t)(((type) << 4) | (pin)))
+#define HOST_EV_TYPE(code)      ((code) >> 4)
+#define HOST_EV_PIN(code)       ((code) & 0x0F)
+
+// Lamp (output pin) state
+#define HOST_LAMP_OFF   0
+#define HOST_LAMP_ON    1
+#define HOST_LAMP_FLASH 2
+
+// Reason returned by HOST_Run
+typedef enum hostStop{
+	HOST_STOP_TIME,  // stop time reached
+	HOST_STOP_END,   // end of the input stream
+	HOST_STOP_IDLE,  // nothing can happen any more (no running timer, no input)
+	HOST_STOP_HALT,  // HOST_Halt called
+	HOST_STOP_JUMP   // the firmware jumped to an address of the flash (CPU_JUMP), see HOST_JumpAddress
+} EN_HostStop_t;
+
+// Timestamped input event
+typedef struct {
+	uint64_t time;
+	uint8_t code;
+	uint8_t data;   // HOST_EV_SERIAL only
+} ST_HostEvent_t;
+
+// Input source: fills the next event and returns 1, returns 0 when there are no more events
+typedef uint8_t (*HOST_InputFn_t)(ST_HostEvent_t* event, void* arg);
+
+// Output observer: called with the virtual time whenever a port, direction or compare output setting changed
+typedef void (*HOST_OutputFn_t)(uint64_t now, void* arg);
+
+// Serial output: called with each byte sent by the USART
+typedef void (*HOST_SerialFn_t)(uint64_t now, uint8_t byte, void* arg);
+
+// Analog source: returns the 10-bit result of the conversion of a channel ending now
+typedef uint16_t (*HOST_AnalogFn_t)(uint64_t now, uint8_t channel, void* arg);
+
+// TWI transaction of the master: START, SLA+W and the bytes written, then a repeated START, SLA+R and the bytes read
+// (the last one not acknowledged), then STOP. Without bytes to write it starts with SLA+R, without bytes to read
+// it ends after the bytes written. The master stops at the first byte not acknowledged by the slave.
+typedef struct {
+	uint64_t time;                 // START, or the end of the previous transaction if later
+	uint8_t address;               // 7-bit slave address
+	uint8_t writeLen;
+	uint8_t readLen;
+	uint8_t write[HOST_TWI_MAX];
+	uint8_t read[HOST_TWI_MAX];    // filled by the backend
+	uint8_t acked;                 // bytes acknowledged by the slave (address bytes included), filled by the backend
+	uint8_t events;                // slave interrupts (SCL held), filled by the backend
+	uint64_t end;                  // STOP, filled by the backend
+} ST_HostTwi_t;
+
+// TWI master: called when the bus is free with the transaction that ended (end 0 the first time),
+// fills the next one and returns 1, returns 0 when there are no more transactions
+typedef uint8_t (*HOST_TwiFn_t)(ST_HostTwi_t* transaction, void* arg);
+
+// Preemption hook: called with the virtual time where an interrupt could be delivered, outside of the interrupts
+typedef void (*HOST_PreemptFn_t)(uint64_t now, void* arg);
+
+// Option of a simulation tool: called with the option letter and its argument, returns 0 to reject it
+typedef uint8_t (*HOST_OptionFn_t)(int opt, const char* arg);
+
+// Random button presses of a simulation tool (HOST_PressStart, HOST_PressInput)
+typedef struct {
+	double rate;     // presses per hour, none if not positive
+	uint64_t end;    // no press from this time
+	uint64_t next;   // time of the next press
+	uint64_t count;  // presses given to the firmware
+} ST_HostPresses_t;
+
+// Current virtual time in cycles
+extern uint64_t HOST_Time;
+
+// State of the random generator of the simulation tools (HOST_Uniform), 1 by default, never 0
+extern uint64_t HOST_Seed;
+
+// Host backend function prototypes
+EN_HostStop_t HOST_Run(void (*init)(void), void (*loop)(void), uint64_t stopTime);
+void HOST_SetInput(HOST_InputFn_t input, void* arg);
+void HOST_SetOutput(HOST_OutputFn_t output, void* arg);
+void HOST_SetSerial(HOST_SerialFn_t serial, void* arg);
+void HOST_SetAnalog(HOST_AnalogFn_t analog, void* arg);
+void HOST_SetTwi(HOST_TwiFn_t master, uint16_t bitCycles, uint16_t isrCycles, void* arg);
+void HOST_Idle(void);
+uint8_t HOST_Lamp(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
+void HOST_SetPreempt(HOST_PreemptFn_t preempt, void* arg);
+void HOST_Inject(uint8_t LOC_U8Code);
+void HOST_Halt(void);
+uint64_t HOST_StateHash(void);
+uint32_t HOST_EepromWrites(uint16_t LOC_U16Address);
+uint8_t HOST_EepromRead(uint16_t LOC_U16Address);
+uint8_t HOST_Shift(uint8_t LOC_U8Chip);
+uint8_t* HOST_Flash(void);
+uint32_t HOST_FlashWrites(uint16_t LOC_U16Page);
+uint16_t HOST_JumpAddress(void);
+int HOST_Options(int argc, char** argv, const char* options, HOST_OptionFn_t option, const char* usage);
+double HOST_Uniform(void);
+uint64_t HOST_Arrival(double perHour);
+void HOST_PressStart(ST_HostPresses_t* presses, double perHour, uint64_t end);
+uint8_t HOST_PressInput(ST_HostEvent_t* event, void* arg);
+EN_HostStop_t HOST_Simulate(void (*init)(void), void (*loop)(void), void (*done)(void), uint64_t endTime);
+
+#endif
@@ -0,0 +1,1354 @@
+/*
+ * File: HOST_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the host backend declared in HOST_Interface.h.
+ * It holds the simulated register file used by the drivers when the project is compiled with HOST_BUILD,
+ * and models the hardware used by the firmware in virtual time.
+ * The firmware only waits for the hardware inside IO_POLL (polling loops) and HOST_Idle (main loop),
+ * so the backend jumps directly to the next event (timer overflow or compare match, input edge, watchdog timeout) at each call:
+ * a 5 seconds delay costs a handful of function calls.
+ * Timer1 is modelled in normal mode (overflow) and CTC mode (compare match at OCR1A, the timebase and the flasher),
+ * TCNT1 is loaded with the current count before the firmware runs.
+ * Timer2 is modelled in normal mode (overflow) and CTC mode (compare match at OCR2), TCNT2 is not updated.
+ * Interrupts are delivered by calling the vector functions (__vector_n) defined by the firmware ISR() macros,
+ * vectors that the firmware does not define are weak and skipped.
+ * A reset (input event or watchdog) jumps back to HOST_Run which clears the registers and calls the init function again.
+ * The EEPROM keeps its content and its wear counters across these resets (both are cleared at the start of HOST_Run),
+ * the USART transmitter is always ready: a byte is sent at once when the firmware loads UDR after clearing TXC
+ * (UART_SendByte), and the received bytes come as input events.
+ * The SPI master shifts its bytes into a chain of HOST_SHIFT_CHIPS 74HC595 registers, latched on the rising edge of SS (PB4),
+ * MISO is not connected.
+ * A transfer starts when the backend sees the SPI interrupt enabled with no transfer or flag pending (next poll,
+ * main loop pass or end of interrupt, at the same virtual time): the firmware driver loads SPDR before enabling
+ * the interrupt, and disables it after the last byte (SPI_Send, SPI_Stop).
+ * The ADC converts in single or free running mode (auto trigger source 0), 25 ADC clocks for the first conversion after
+ * it is enabled and 13 for the others, with the channel of ADMUX latched at the start of each conversion:
+ * the results come from the analog source of the tool (0 without one), and ADIF is cleared by writing it to one.
+ * The TWI is modelled as an interrupt driven slave on a bus driven by the master of the tool, one bus step
+ * (START and address, byte and acknowledge, repeated START, STOP) at a time. At each slave event TWINT is set and SCL is held
+ * low: TWINT is cleared when the interrupt is served, and SCL released when the interrupt writes TWINT to one.
+ * The bus goes on the given interrupt time later, since the virtual time does not advance while the firmware runs.
+ * The flash is only written by the bootloader: a page erase is done at once and a page write at its end, both keep SPMEN
+ * (and RWWSB below the NRWW section) set for HOST_SPM_CYCLES, the buffer fill and the RWW read enable take no time.
+ * A reset drops a page write in progress (the page stays erased). The flash keeps its content across the resets
+ * and the runs, the tool loads the programs in it (HOST_Flash). A jump (CPU_JUMP) stops the run: the program jumped to
+ * is not simulated with the one running.
+ * The analog comparator compares the bandgap reference (ACBG) with the supply sense on AIN1, given by the input events:
+ * its output is high while the supply is under the threshold, and ACI is set on the edges selected by ACIS
+ * (written to one it is cleared, like ADIF). Without the bandgap the output stays low (AIN0 is not modelled).
+ * A power cut (HOST_EV_POWER) is a power-on reset that also clears the shift register chain,
+ * and a write of the EEPROM in progress is lost: the byte is left erased.
+ * The simulation tools share their command line parsing, random arrivals and end of run (HOST_Options, HOST_Uniform,
+ * HOST_Presses, HOST_Simulate): a tool only keeps its own options, events and checks.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "HOST_Interface.h"
+#include "../MCAL/GPIO/GPIO_Interface.h"
+#include "../MCAL/EXTI/EXTI_Interface.h"
+#include "../MCAL/TMR0/TMR0_Interface.h"
+#include "../MCAL/TMR1/TMR1_Interface.h"
+#include "../MCAL/TMR2/TMR2_Interface.h"
+#include "../MCAL/WDT/WDT_Interface.h"
+#include "../MCAL/EEPROM/EEPROM_Interface.h"
+#include "../MCAL/UART/UART_Interface.h"
+#include "../MCAL/SPI/SPI_Interface.h"
+#include "../MCAL/ADC/ADC_Interface.h"
+#include "../MCAL/TWI/TWI_Interface.h"
+#include "../MCAL/FLASH/FLASH_Interface.h"
+#include "../MCAL/ACOMP/ACOMP_Interface.h"
+
+// Bits not defined by the drivers
+#define TOIE0 0 // TIMSK
+#define PORF  0 // MCUCSR
+#define EXTRF 1 // MCUCSR
+
+// Reasons of the jumps back to HOST_Run
+#define HOST_JMP_RESET 1
+#define HOST_JMP_STOP  2
+
+/************************************************************************/
+/*                       Simulated hardware state                       */
+/************************************************************************/
+
+static uint8_t HOST_Regs[HOST_IO_SIZE];
+volatile uint8_t* HOST_IoSpace = HOST_Regs;
+uint64_t HOST_Time;
+
+static uint8_t HOST_IFlag;      // global interrupt enable (I bit, mirrored in SREG)
+static uint8_t HOST_InIsr;      // an interrupt is being served
+static jmp_buf HOST_Exit;
+static uint64_t HOST_StopTime;
+static EN_HostStop_t HOST_StopReason;
+static uint8_t HOST_ResetFlags;
+
+// Input events
+static HOST_InputFn_t HOST_Input;
+static void* HOST_InputArg;
+static ST_HostEvent_t HOST_Next;
+static uint8_t HOST_HasNext;
+static uint8_t HOST_PinLevel[HOST_PIN_NUM];
+static uint64_t HOST_FallTime[HOST_PIN_NUM]; // pending end of a pulse, 0 = none
+
+// Simulation tools
+uint64_t HOST_Seed = 1;
+static uint64_t HOST_SimEnd;
+static void (*HOST_SimLoop)(void);
+static void (*HOST_SimDone)(void);
+
+// Preemption hook
+static HOST_PreemptFn_t HOST_Preempt;
+static void* HOST_PreemptArg;
+
+// Outputs
+static HOST_OutputFn_t HOST_Output;
+static void* HOST_OutputArg;
+static HOST_SerialFn_t HOST_Serial;
+static void* HOST_SerialArg;
+static uint8_t HOST_OutSnap[9];
+
+// Timer0
+static uint64_t HOST_T0Base;
+static uint8_t HOST_T0Count;
+static uint8_t HOST_T0ShadowTCCR;
+static uint8_t HOST_T0ShadowTCNT;
+static uint8_t HOST_T0Seen;
+
+// Timer flags as last left by the hardware
+static uint8_t HOST_TifrShadow;
+
+// Timer1
+static uint64_t HOST_T1Base;
+static uint16_t HOST_T1Count;
+static uint8_t HOST_T1ShadowTCCR;
+static uint16_t HOST_T1ShadowTCNT;
+
+// Timer2
+static uint64_t HOST_T2Base;
+static uint8_t HOST_T2Count;
+static uint8_t HOST_T2ShadowTCCR;
+static uint8_t HOST_T2ShadowTCNT;
+static uint8_t HOST_T2Seen;
+
+// Watchdog
+static uint64_t HOST_WdtLast;
+static uint8_t HOST_WdtShadowWDE;
+
+// EEPROM
+static uint8_t HOST_Eeprom[EEPROM_SIZE];
+static uint32_t HOST_EeWrites[EEPROM_SIZE];
+static uint64_t HOST_EeDone;    // end of the write in progress, 0 = none
+static uint16_t HOST_EeAddr;    // byte of the write in progress
+
+// SPI and shift register chain
+static uint64_t HOST_SpiDone;   // end of the transfer in progress, 0 = none
+static uint8_t HOST_SpiByte;    // byte being sent
+static uint8_t HOST_Chain[HOST_SHIFT_CHIPS];   // shift stages, register 0 on MOSI
+static uint8_t HOST_Latched[HOST_SHIFT_CHIPS]; // outputs
+static uint8_t HOST_LatchShadow;
+
+// ADC
+static HOST_AnalogFn_t HOST_Analog;
+static void* HOST_AnalogArg;
+static uint64_t HOST_AdcDone;     // end of the conversion in progress, 0 = none
+static uint8_t HOST_AdcChannel;   // channel latched at the start of the conversion
+static uint8_t HOST_AdcEnabled;   // ADEN seen set: the next conversion is not the first one
+static uint8_t HOST_AdcShadowADIF;
+
+// TWI bus
+typedef enum {HOST_TWI_IDLE, HOST_TWI_SLA_W, HOST_TWI_DATA_W, HOST_TWI_RSTART, HOST_TWI_SLA_R, HOST_TWI_DATA_R, HOST_TWI_STOP} EN_HostTwiStep_t;
+static HOST_TwiFn_t HOST_Twi;
+static void* HOST_TwiArg;
+static uint16_t HOST_TwiBit;      // cycles per SCL period
+static uint16_t HOST_TwiIsr;      // cycles from a slave event to the release of SCL
+static uint16_t HOST_TwiDelay;    // interrupt time before the next bus step
+static ST_HostTwi_t HOST_TwiTxn;  // transaction in progress
+static uint8_t HOST_TwiOver;      // the master has no more transactions
+static EN_HostTwiStep_t HOST_TwiStep; // bus step in progress, or the last one while SCL is held
+static uint8_t HOST_TwiIndex;     // byte of the step
+static uint8_t HOST_TwiAck;       // the byte of the last step was acknowledged
+static uint64_t HOST_TwiDone;     // end of the bus step in progress, 0 = none
+static uint8_t HOST_TwiHeld;      // TWINT set by a slave event, SCL held low
+static uint8_t HOST_TwiServed;    // the interrupt of the slave event was served
+static uint8_t HOST_TwiSlave;     // 0: not addressed, 1: addressed as receiver, 2: addressed as transmitter
+static uint8_t HOST_TwiByte;      // byte sent by the slave (TWDR at the release of SCL)
+static uint8_t HOST_TwiLast;      // the slave sent its last byte (TWEA cleared)
+
+// Flash
+static uint8_t HOST_FlashMem[FLASH_SIZE];
+static uint8_t HOST_FlashReady;   // erased once, before the first use
+static uint32_t HOST_FlashWr[FLASH_SIZE / FLASH_PAGE_SIZE];
+static uint8_t HOST_SpmBuffer[FLASH_PAGE_SIZE]; // temporary page buffer
+static uint64_t HOST_SpmDone;     // end of the page erase or write in progress, 0 = none
+static uint16_t HOST_SpmPage;     // page written at HOST_SpmDone
+static uint8_t HOST_SpmWrite;     // the operation in progress is a page write
+static uint16_t HOST_Jumped;      // address of the last jump
+
+// Analog comparator
+static uint8_t HOST_SupplyLow;    // the supply is under the threshold (AIN1 under the bandgap)
+static uint8_t HOST_AcOut;        // comparator output (ACO)
+static uint8_t HOST_AcShadowACI;
+
+// Input pin locations (PINx register address and bit)
+static const uint8_t HOST_PinReg[HOST_PIN_NUM] = {0x30, 0x30, 0x36, 0x36, 0x36};
+static const uint8_t HOST_PinBit[HOST_PIN_NUM] = {PIN2, PIN3, PIN2, PIN0, PIN1};
+
+// Port and direction register addresses (PORTA..PORTD)
+static const uint8_t HOST_PortReg[4] = {0x3B, 0x38, 0x35, 0x32};
+static const uint8_t HOST_DdrReg[4]  = {0x3A, 0x37, 0x34, 0x31};
+
+// Timer0 and Timer1 prescaler for each clock select value (0 = stopped or external clock)
+static const uint16_t HOST_Prescale[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+
+// Timer2 prescaler for each clock select value (0 = stopped)
+static const uint16_t HOST_Prescale2[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+
+// ADC clock divider for each ADPS value
+static const uint8_t HOST_AdcDiv[8] = {2, 2, 4, 8, 16, 32, 64, 128};
+
+// SPI clock divider for each SPI2X << 2 | SPR1..0 value
+static const uint8_t HOST_SpiDiv[8] = {4, 16, 64, 128, 2, 8, 32, 64};
+
+// Interrupt vectors, weak so that vectors not used by the firmware are skipped
+void __vector_1(void) __attribute__((weak));
+void __vector_2(void) __attribute__((weak));
+void __vector_3(void) __attribute__((weak));
+void __vector_4(void) __attribute__((weak));
+void __vector_5(void) __attribute__((weak));
+void __vector_7(void) __attribute__((weak));
+void __vector_11(void) __attribute__((weak));
+void __vector_12(void) __attribute__((weak));
+void __vector_13(void) __attribute__((weak));
+void __vector_16(void) __attribute__((weak));
+void __vector_17(void) __attribute__((weak));
+void __vector_18(void) __attribute__((weak));
+void __vector_19(void) __attribute__((weak));
+
+// An interrupt is requested while its flag bit is set (cleared when served),
+// or while it is cleared for the level interrupts (left to the firmware)
+typedef struct {
+	void (*vector)(void);
+	uint8_t flagReg, flagBit, maskReg, maskBit;
+	uint8_t level;
+} ST_HostVector_t;
+
+// Ordered by priority (lower vector number first)
+static const ST_HostVector_t HOST_Vectors[] = {
+	{__vector_1,  0x5A, INTF0, 0x5B, INT0,   0}, // INT0
+	{__vector_2,  0x5A, INTF1, 0x5B, INT1,   0}, // INT1
+	{__vector_3,  0x5A, INTF2, 0x5B, INT2,   0}, // INT2
+	{__vector_4,  0x58, OCF2,  0x59, OCIE2,  0}, // TIMER2 COMP
+	{__vector_5,  0x58, TOV2,  0x59, TOIE2,  0}, // TIMER2 OVF
+	{__vector_7,  0x58, OCF1A, 0x59, OCIE1A, 0}, // TIMER1 COMPA
+	{__vector_11, 0x58, TOV0,  0x59, TOIE0,  0}, // TIMER0 OVF
+	{__vector_12, 0x2E, SPIF,  0x2D, SPIE,   0}, // SPI STC
+	{__vector_13, 0x2B, RXC,   0x2A, RXCIE,  0}, // USART RXC
+	{__vector_16, 0x26, ADIF,  0x26, ADIE,   0}, // ADC
+	{__vector_17, 0x3C, EEWE,  0x3C, EERIE,  1}, // EE_RDY
+	{__vector_18, 0x28, ACI,   0x28, ACIE,   0}, // ANA_COMP
+	{__vector_19, 0x56, TWINT, 0x56, TWIE,   0}, // TWI
+};
+
+
+/************************************************************************/
+/*                       Internal Functions                             */
+/************************************************************************/
+
+/*
+ * Function: HOST_ResetRegs()
+ * Description: Puts the simulated hardware in its reset state, the input pins keep their levels.
+ */
+static void HOST_ResetRegs(uint8_t LOC_U8Flags){
+	memset((void*)HOST_IoSpace, 0, HOST_IO_SIZE);
+	MCUCSR = LOC_U8Flags;
+	for(uint8_t i=0; i<HOST_PIN_NUM; i++){
+		if(HOST_PinLevel[i]) SET_BIT(HOST_IoSpace[HOST_PinReg[i]], HOST_PinBit[i]);
+	}
+	HOST_IFlag = 0;
+	HOST_InIsr = 0;
+	HOST_T0Base = HOST_Time;
+	HOST_T0Count = 0;
+	HOST_T0ShadowTCCR = 0;
+	HOST_T0ShadowTCNT = 0;
+	HOST_T0Seen = 0;
+	HOST_T1Base = HOST_Time;
+	HOST_T1Count = 0;
+	HOST_T1ShadowTCCR = 0;
+	HOST_T1ShadowTCNT = 0;
+	HOST_T2Base = HOST_Time;
+	HOST_T2Count = 0;
+	HOST_T2ShadowTCCR = 0;
+	HOST_T2ShadowTCNT = 0;
+	HOST_T2Seen = 0;
+	HOST_TifrShadow = 0;
+	HOST_WdtShadowWDE = 0;
+	HOST_EeDone = 0; // a write in progress completes, the registers are cleared
+	HOST_SpiDone = 0; // a transfer in progress is lost, the chain keeps its content
+	HOST_LatchShadow = 0;
+	HOST_AdcDone = 0;
+	HOST_AdcEnabled = 0;
+	HOST_AdcShadowADIF = 0;
+	HOST_AcOut = 0; // the bandgap is not selected
+	HOST_AcShadowACI = 0;
+	HOST_TwiServed = 0; // a held SCL is released by the next HOST_Sync (TWEN cleared)
+	HOST_TwiSlave = 0;
+	HOST_SpmDone = 0; // a page write in progress is lost, the page stays erased
+	memset(HOST_SpmBuffer, 0xFF, sizeof(HOST_SpmBuffer));
+}
+
+/*
+ * Function: HOST_AdcStart()
+ * Description: Starts a conversion of the channel selected in ADMUX, 25 ADC clocks long if it is the first one after ADEN was set.
+ */
+static void HOST_AdcStart(void){
+	uint8_t LOC_U8Clocks = HOST_AdcEnabled ? 13 : 25;
+	HOST_AdcEnabled = 1;
+	HOST_AdcChannel = ADMUX & 0x07;
+	HOST_AdcDone = HOST_Time + (uint64_t)LOC_U8Clocks * HOST_AdcDiv[ADCSRA & 0x07];
+}
+
+/*
+ * Function: HOST_AcUpdate()
+ * Description: Updates the comparator output and sets ACI on the edges selected by ACIS
+ * (0: toggle, 2: falling edge, 3: rising edge).
+ */
+static void HOST_AcUpdate(void){
+	uint8_t LOC_U8Out = !GET_BIT(ACSR, ACD) && GET_BIT(ACSR, ACBG) && HOST_SupplyLow;
+	if(LOC_U8Out != HOST_AcOut){
+		uint8_t LOC_U8Mode = ACSR & 0x03;
+		if(0 == LOC_U8Mode || (3 == LOC_U8Mode) == LOC_U8Out){
+			SET_BIT(ACSR, ACI);
+			HOST_AcShadowACI = 1;
+		}
+		HOST_AcOut = LOC_U8Out;
+	}
+	if(LOC_U8Out) SET_BIT(ACSR, ACO);
+	else CLR_BIT(ACSR, ACO);
+}
+
+/*
+ * Function: HOST_TwiFetch()
+ * Description: Gets the next transaction from the master, it starts with its START and address byte.
+ */
+static void HOST_TwiFetch(void){
+	HOST_TwiStep = HOST_TWI_IDLE;
+	if(!HOST_Twi || HOST_TwiOver) return;
+	if(!HOST_Twi(&HOST_TwiTxn, HOST_TwiArg)){
+		HOST_TwiOver = 1;
+		return;
+	}
+	HOST_TwiTxn.acked = 0;
+	HOST_TwiTxn.events = 0;
+	HOST_TwiTxn.end = 0;
+	HOST_TwiIndex = 0;
+	HOST_TwiStep = (HOST_TwiTxn.writeLen || !HOST_TwiTxn.readLen) ? HOST_TWI_SLA_W : HOST_TWI_SLA_R;
+	if(HOST_TwiTxn.time < HOST_Time) HOST_TwiTxn.time = HOST_Time;
+	HOST_TwiDone = HOST_TwiTxn.time + 10UL * HOST_TwiBit;
+}
+
+/*
+ * Function: HOST_TwiStart()
+ * Description: Starts a bus step of the given number of SCL periods, after the interrupt time if SCL was held.
+ */
+static void HOST_TwiStart(EN_HostTwiStep_t LOC_Step, uint8_t LOC_U8Bits){
+	HOST_TwiStep = LOC_Step;
+	HOST_TwiDone = HOST_Time + HOST_TwiDelay + (uint64_t)LOC_U8Bits * HOST_TwiBit;
+	if(HOST_TWI_DATA_R == LOC_Step){ // the slave transmitter sends the byte it loaded before releasing SCL
+		HOST_TwiByte = (2 == HOST_TwiSlave) ? TWDR : 0xFF;
+		HOST_TwiLast = !GET_BIT(TWCR, TWEA);
+	}
+}
+
+/*
+ * Function: HOST_TwiNext()
+ * Description: Starts the bus step after the one that ended, or ends the transaction and gets the next one.
+ */
+static void HOST_TwiNext(void){
+	const ST_HostTwi_t* t = &HOST_TwiTxn;
+	switch(HOST_TwiStep){
+		case HOST_TWI_SLA_W:
+			if(HOST_TwiAck && t->writeLen) HOST_TwiStart(HOST_TWI_DATA_W, 9);
+			else if(HOST_TwiAck && t->readLen) HOST_TwiStart(HOST_TWI_RSTART, 1);
+			else HOST_TwiStart(HOST_TWI_STOP, 1);
+		break;
+		case HOST_TWI_DATA_W:
+			if(HOST_TwiAck && ++HOST_TwiIndex < t->writeLen) HOST_TwiStart(HOST_TWI_DATA_W, 9);
+			else if(HOST_TwiAck && t->readLen) HOST_TwiStart(HOST_TWI_RSTART, 1);
+			else HOST_TwiStart(HOST_TWI_STOP, 1);
+		break;
+		case HOST_TWI_RSTART:
+			HOST_TwiStart(HOST_TWI_SLA_R, 9);
+		break;
+		case HOST_TWI_SLA_R:
+			HOST_TwiIndex = 0;
+			if(HOST_TwiAck) HOST_TwiStart(HOST_TWI_DATA_R, 9);
+			else HOST_TwiStart(HOST_TWI_STOP, 1);
+		break;
+		case HOST_TWI_DATA_R:
+			if(HOST_TwiAck && ++HOST_TwiIndex < t->readLen) HOST_TwiStart(HOST_TWI_DATA_R, 9);
+			else HOST_TwiStart(HOST_TWI_STOP, 1);
+		break;
+		case HOST_TWI_STOP:
+			HOST_TwiTxn.end = HOST_Time + HOST_TwiDelay;
+			HOST_TwiDone = 0;
+			HOST_TwiFetch();
+		break;
+		default:
+		break;
+	}
+}
+
+/*
+ * Function: HOST_TwiHold()
+ * Description: Reports a slave event: the state in TWSR, TWINT set and SCL held low.
+ */
+static void HOST_TwiHold(uint8_t LOC_U8Status){
+	TWSR = (TWSR & 0x07) | LOC_U8Status;
+	SET_BIT(TWCR, TWINT);
+	HOST_TwiHeld = 1;
+	HOST_TwiTxn.events++;
+}
+
+/*
+ * Function: HOST_TwiEnd()
+ * Description: Ends a bus step: the slave answers, and holds SCL if it has an event, otherwise the next step starts.
+ */
+static void HOST_TwiEnd(void){
+	ST_HostTwi_t* t = &HOST_TwiTxn;
+	uint8_t LOC_U8Match = GET_BIT(TWCR, TWEN) && GET_BIT(TWCR, TWEA) && (TWAR >> 1) == t->address;
+	switch(HOST_TwiStep){
+		case HOST_TWI_SLA_W:
+			HOST_TwiAck = LOC_U8Match;
+			if(LOC_U8Match){
+				t->acked++;
+				HOST_TwiSlave = 1;
+				HOST_TwiHold(TWI_SR_SLA_ACK);
+				return;
+			}
+		break;
+		case HOST_TWI_DATA_W:
+			HOST_TwiAck = 0;
+			if(1 == HOST_TwiSlave){
+				TWDR = t->write[HOST_TwiIndex];
+				HOST_TwiAck = GET_BIT(TWCR, TWEA);
+				if(HOST_TwiAck) t->acked++;
+				else HOST_TwiSlave = 0;
+				HOST_TwiHold(HOST_TwiAck ? TWI_SR_DATA_ACK : TWI_SR_DATA_NACK);
+				return;
+			}
+		break;
+		case HOST_TWI_RSTART:
+		case HOST_TWI_STOP:
+			if(1 == HOST_TwiSlave){
+				HOST_TwiSlave = 0;
+				HOST_TwiHold(TWI_SR_STOP);
+				return;
+			}
+			HOST_TwiSlave = 0;
+		break;
+		case HOST_TWI_SLA_R:
+			HOST_TwiAck = LOC_U8Match;
+			if(LOC_U8Match){
+				t->acked++;
+				HOST_TwiSlave = 2;
+				HOST_TwiHold(TWI_ST_SLA_ACK);
+				return;
+			}
+		break;
+		case HOST_TWI_DATA_R:
+			t->read[HOST_TwiIndex] = HOST_TwiByte;
+			HOST_TwiAck = (HOST_TwiIndex + 1 < t->readLen); // the master does not acknowledge the last byte
+			if(2 == HOST_TwiSlave){
+				if(!HOST_TwiAck || HOST_TwiLast) HOST_TwiSlave = 0;
+				HOST_TwiHold(!HOST_TwiAck ? TWI_ST_DATA_NACK : (HOST_TwiLast ? TWI_ST_LAST_ACK : TWI_ST_DATA_ACK));
+				return;
+			}
+		break;
+		default:
+		break;
+	}
+	HOST_TwiNext();
+}
+
+/*
+ * Function: HOST_Reset()
+ * Description: Leaves the firmware and restarts it from HOST_Run with the given reset flags.
+ */
+static void HOST_Reset(uint8_t LOC_U8Flags){
+	HOST_ResetFlags = LOC_U8Flags;
+	longjmp(HOST_Exit, HOST_JMP_RESET);
+}
+
+/*
+ * Function: HOST_Stop()
+ * Description: Leaves the firmware and returns from HOST_Run.
+ */
+static void HOST_Stop(EN_HostStop_t LOC_Reason){
+	HOST_StopReason = LOC_Reason;
+	longjmp(HOST_Exit, HOST_JMP_STOP);
+}
+
+/*
+ * Function: HOST_T1Next()
+ * Description: Gets the time of the next Timer1 match: the top (OCR1A) in CTC mode, 0xFFFF in normal mode.
+ * A top below the counter is reached after the counter wraps. Returns UINT64_MAX if Timer1 is stopped.
+ */
+static uint64_t HOST_T1Next(void){
+	uint16_t LOC_U16Pre = HOST_Prescale[TCCR1B & 0x07];
+	if(!LOC_U16Pre) return UINT64_MAX;
+	uint32_t LOC_U32Top = GET_BIT(TCCR1B, WGM12) ? OCR1A : 0xFFFF;
+	uint32_t LOC_U32Counts = (HOST_T1Count <= LOC_U32Top) ? LOC_U32Top + 1 - HOST_T1Count : 0x10000UL - HOST_T1Count + LOC_U32Top + 1;
+	return HOST_T1Base + (uint64_t)LOC_U32Counts * LOC_U16Pre;
+}
+
+/*
+ * Function: HOST_T1Update()
+ * Description: Loads TCNT1 with the counter value at the current time, the firmware reads it directly.
+ */
+static void HOST_T1Update(void){
+	uint16_t LOC_U16Pre = HOST_Prescale[TCCR1B & 0x07];
+	if(LOC_U16Pre) TCNT1 = (uint16_t)(HOST_T1Count + (HOST_Time - HOST_T1Base) / LOC_U16Pre);
+	HOST_T1ShadowTCNT = TCNT1;
+}
+
+/*
+ * Function: HOST_T2Next()
+ * Description: Gets the time of the next Timer2 match: the top (OCR2) in CTC mode, 0xFF in normal mode.
+ * A top below the counter is reached after the counter wraps. Returns UINT64_MAX if Timer2 is stopped.
+ */
+static uint64_t HOST_T2Next(void){
+	uint16_t LOC_U16Pre = HOST_Prescale2[TCCR2 & 0x07];
+	if(!LOC_U16Pre) return UINT64_MAX;
+	uint16_t LOC_U16Top = GET_BIT(TCCR2, WGM21) ? OCR2 : 0xFF;
+	uint16_t LOC_U16Counts = (HOST_T2Count <= LOC_U16Top) ? LOC_U16Top + 1 - HOST_T2Count : 0x100 - HOST_T2Count + LOC_U16Top + 1;
+	return HOST_T2Base + (uint64_t)LOC_U16Counts * LOC_U16Pre;
+}
+
+/*
+ * Function: HOST_Sync()
+ * Description: Takes into account what the firmware wrote to the registers since the last call
+ * (timer started, stopped or reloaded, watchdog enabled) and reports output changes.
+ */
+static void HOST_Sync(void){
+	// Timer flags written by the firmware: the flags written to one are cleared, the others are kept
+	// (writing back the only flag set can not be told from no write, see HOST_Poll)
+	if(TIFR != HOST_TifrShadow) TIFR = HOST_TifrShadow & ~TIFR;
+
+	// Timer0 written by the firmware: restart counting from the written value
+	if(TCCR0 != HOST_T0ShadowTCCR || TCNT0 != HOST_T0ShadowTCNT){
+		HOST_T0Base = HOST_Time;
+		HOST_T0Count = TCNT0;
+		HOST_T0ShadowTCCR = TCCR0;
+		HOST_T0ShadowTCNT = TCNT0;
+	}
+
+	// Timer1 written by the firmware: restart counting from the written value
+	if(TCCR1B != HOST_T1ShadowTCCR || TCNT1 != HOST_T1ShadowTCNT){
+		HOST_T1Base = HOST_Time;
+		HOST_T1Count = TCNT1;
+		HOST_T1ShadowTCCR = TCCR1B;
+	}
+	HOST_T1Update();
+
+	// Timer2 written by the firmware: restart counting from the written value
+	if(TCCR2 != HOST_T2ShadowTCCR || TCNT2 != HOST_T2ShadowTCNT){
+		HOST_T2Base = HOST_Time;
+		HOST_T2Count = TCNT2;
+		HOST_T2ShadowTCCR = TCCR2;
+		HOST_T2ShadowTCNT = TCNT2;
+	}
+
+	// Watchdog enabled
+	uint8_t LOC_U8Wde = GET_BIT(WDTCR, WDE);
+	if(LOC_U8Wde && !HOST_WdtShadowWDE) HOST_WdtLast = HOST_Time;
+	HOST_WdtShadowWDE = LOC_U8Wde;
+
+	// EEPROM read or write strobe
+	if(GET_BIT(EECR, EERE)){
+		EEDR = HOST_Eeprom[EEAR % EEPROM_SIZE];
+		CLR_BIT(EECR, EERE);
+	}
+	if(GET_BIT(EECR, EEWE) && !HOST_EeDone){
+		if(GET_BIT(EECR, EEMWE)){
+			HOST_EeAddr = EEAR % EEPROM_SIZE;
+			HOST_Eeprom[HOST_EeAddr] = EEDR;
+			HOST_EeWrites[HOST_EeAddr]++;
+			HOST_EeDone = HOST_Time + HOST_EE_WRITE_CYCLES;
+		}
+		else CLR_BIT(EECR, EEWE); // EEWE without EEMWE does not start a write
+	}
+	CLR_BIT(EECR, EEMWE);
+
+	// USART byte sent: TXC written to one (cleared on the target) before UDR is loaded
+	if(GET_BIT(UCSRA, TXC)){
+		CLR_BIT(UCSRA, TXC);
+		if(GET_BIT(UCSRB, TXEN) && HOST_Serial) HOST_Serial(HOST_Time, UDR, HOST_SerialArg);
+	}
+	SET_BIT(UCSRA, UDRE); // read-only, the transmitter is always ready
+
+	// SPI transfer started: the interrupt is enabled and nothing is pending
+	if(GET_BIT(SPCR, SPE) && GET_BIT(SPCR, MSTR) && GET_BIT(SPCR, SPIE) && !HOST_SpiDone && !GET_BIT(SPSR, SPIF)){
+		HOST_SpiByte = SPDR;
+		HOST_SpiDone = HOST_Time + 8UL * HOST_SpiDiv[(GET_BIT(SPSR, SPI2X) << 2) | (SPCR & 0x03)];
+	}
+
+	// ADC flag written by the firmware: written to one it is cleared, written to zero it is kept
+	// (like TIFR, writing one to the flag set can not be told from no write), then the ADC turned off or started (ADSC)
+	if(HOST_AdcShadowADIF) SET_BIT(ADCSRA, ADIF);
+	else CLR_BIT(ADCSRA, ADIF);
+	if(!GET_BIT(ADCSRA, ADEN)){
+		HOST_AdcDone = 0;
+		HOST_AdcEnabled = 0;
+		CLR_BIT(ADCSRA, ADSC);
+	}
+	else if(GET_BIT(ADCSRA, ADSC) && !HOST_AdcDone) HOST_AdcStart();
+
+	// Comparator flag written by the firmware (like ADIF), then the inputs selected
+	if(HOST_AcShadowACI) SET_BIT(ACSR, ACI);
+	else CLR_BIT(ACSR, ACI);
+	HOST_AcUpdate();
+
+	// TWI: SCL released when the interrupt served writes TWINT to one, or when the TWI is turned off,
+	// the other writes of TWINT have no effect
+	if(HOST_TwiHeld && ((HOST_TwiServed && GET_BIT(TWCR, TWINT)) || !GET_BIT(TWCR, TWEN))){
+		HOST_TwiHeld = 0;
+		HOST_TwiServed = 0;
+		if(!GET_BIT(TWCR, TWEN)) HOST_TwiSlave = 0;
+		HOST_TwiDelay = HOST_TwiIsr;
+		HOST_TwiNext();
+		HOST_TwiDelay = 0;
+	}
+	if(!HOST_TwiHeld) CLR_BIT(TWCR, TWINT);
+
+	// Latch clock of the chain (SS): the rising edge copies the stages to the outputs
+	uint8_t LOC_U8Latch = GET_BIT(HOST_IoSpace[HOST_PortReg[PORTB]], PIN4) && GET_BIT(HOST_IoSpace[HOST_DdrReg[PORTB]], PIN4);
+	if(LOC_U8Latch && !HOST_LatchShadow) memcpy(HOST_Latched, HOST_Chain, sizeof(HOST_Latched));
+	HOST_LatchShadow = LOC_U8Latch;
+
+	// Outputs: ports, directions and Timer1 compare output mode
+	uint8_t LOC_U8Snap[9];
+	for(uint8_t i=0; i<4; i++){
+		LOC_U8Snap[2*i] = HOST_IoSpace[HOST_PortReg[i]];
+		LOC_U8Snap[2*i+1] = HOST_IoSpace[HOST_DdrReg[i]];
+	}
+	LOC_U8Snap[8] = TCCR1A & 0xF0;
+	if(memcmp(LOC_U8Snap, HOST_OutSnap, sizeof(LOC_U8Snap))){
+		memcpy(HOST_OutSnap, LOC_U8Snap, sizeof(LOC_U8Snap));
+		if(HOST_Output) HOST_Output(HOST_Time, HOST_OutputArg);
+	}
+}
+
+/*
+ * Function: HOST_Preemption()
+ * Description: Gives control to the preemption hook, except inside an interrupt (the I bit is cleared there).
+ */
+static void HOST_Preemption(void){
+	if(HOST_Preempt && !HOST_InIsr) HOST_Preempt(HOST_Time, HOST_PreemptArg);
+}
+
+/*
+ * Function: HOST_Fnv()
+ * Description: Adds bytes to a 64-bit FNV-1a hash.
+ */
+static uint64_t HOST_Fnv(uint64_t LOC_U64Hash, const uint8_t* LOC_PtrData, uint16_t LOC_U16Len){
+	for(uint16_t i=0; i<LOC_U16Len; i++) LOC_U64Hash = (LOC_U64Hash ^ LOC_PtrData[i]) * 1099511628211ULL;
+	return LOC_U64Hash;
+}
+
+/*
+ * Function: HOST_Dispatch()
+ * Description: Serves the pending interrupts, like the CPU does between two instructions.
+ */
+static void HOST_Dispatch(void){
+	uint8_t LOC_U8Served = 1;
+	while(LOC_U8Served && HOST_IFlag && !HOST_InIsr){
+		LOC_U8Served = 0;
+		for(uint8_t i=0; i<sizeof(HOST_Vectors)/sizeof(HOST_Vectors[0]); i++){
+			const ST_HostVector_t* v = &HOST_Vectors[i];
+			uint8_t LOC_U8Flag = GET_BIT(HOST_IoSpace[v->flagReg], v->flagBit);
+			if(v->level) LOC_U8Flag = !LOC_U8Flag;
+			if(LOC_U8Flag && GET_BIT(HOST_IoSpace[v->maskReg], v->maskBit)){
+				if(!v->level) CLR_BIT(HOST_IoSpace[v->flagReg], v->flagBit); // flag cleared by hardware
+				HOST_TifrShadow = TIFR;
+				HOST_AdcShadowADIF = GET_BIT(ADCSRA, ADIF);
+				HOST_AcShadowACI = GET_BIT(ACSR, ACI);
+				if(&HOST_IoSpace[v->flagReg] == &TWCR && HOST_TwiHeld) HOST_TwiServed = 1; // TWINT cleared above, SCL still held
+				HOST_InIsr = 1;
+				HOST_IFlag = 0;
+				CLR_BIT(SREG, SREG_I);
+				if(v->vector) v->vector();
+				HOST_IFlag = 1;
+				SET_BIT(SREG, SREG_I);
+				HOST_InIsr = 0;
+				HOST_Sync();
+				LOC_U8Served = 1;
+				break;
+			}
+		}
+	}
+}
+
+/*
+ * Function: HOST_SetPin()
+ * Description: Drives an input pin and sets the external interrupt flag if the edge matches the interrupt sense.
+ */
+static void HOST_SetPin(uint8_t LOC_U8Pin, uint8_t LOC_U8Level){
+	if(LOC_U8Pin >= HOST_PIN_NUM || HOST_PinLevel[LOC_U8Pin] == LOC_U8Level) return;
+	HOST_PinLevel[LOC_U8Pin] = LOC_U8Level;
+	if(LOC_U8Level) SET_BIT(HOST_IoSpace[HOST_PinReg[LOC_U8Pin]], HOST_PinBit[LOC_U8Pin]);
+	else CLR_BIT(HOST_IoSpace[HOST_PinReg[LOC_U8Pin]], HOST_PinBit[LOC_U8Pin]);
+
+	// Timer0 external clock: the edge selected by the clock select bits counts (6: falling, 7: rising)
+	if(HOST_PIN_T0 == LOC_U8Pin && (TCCR0 & 0x07) == 6 + LOC_U8Level){
+		TCNT0++;
+		HOST_T0ShadowTCNT = TCNT0;
+		if(0 == TCNT0) SET_BIT(TIFR, TOV0);
+		return;
+	}
+
+	uint8_t LOC_U8Sense, LOC_U8Flag;
+	switch(LOC_U8Pin){
+		case HOST_PIN_INT0: LOC_U8Sense = MCUCR & 0x03; LOC_U8Flag = INTF0; break;
+		case HOST_PIN_INT1: LOC_U8Sense = (MCUCR >> 2) & 0x03; LOC_U8Flag = INTF1; break;
+		case HOST_PIN_INT2: LOC_U8Sense = GET_BIT(MCUCSR, ISC2) ? 3 : 2; LOC_U8Flag = INTF2; break;
+		default: return;
+	}
+	// 0: low level (modelled as the falling edge), 1: any change, 2: falling edge, 3: rising edge
+	if(1 == LOC_U8Sense || (3 == LOC_U8Sense) == LOC_U8Level) SET_BIT(GIFR, LOC_U8Flag);
+}
+
+/*
+ * Function: HOST_PowerCut()
+ * Description: Cuts the power and gives it back at once: the byte of an EEPROM write in progress is left erased,
+ * the shift registers are cleared, and the firmware restarts with a power-on reset, the supply above the threshold.
+ */
+static void HOST_PowerCut(void){
+	if(HOST_EeDone) HOST_Eeprom[HOST_EeAddr] = 0xFF;
+	memset(HOST_Chain, 0, sizeof(HOST_Chain));
+	memset(HOST_Latched, 0, sizeof(HOST_Latched));
+	HOST_SupplyLow = 0;
+	HOST_Reset(1<<PORF);
+}
+
+/*
+ * Function: HOST_ApplyInput()
+ * Description: Applies one input event at the current virtual time.
+ */
+static void HOST_ApplyInput(uint8_t LOC_U8Code, uint8_t LOC_U8Data){
+	uint8_t LOC_U8Pin = HOST_EV_PIN(LOC_U8Code);
+	switch(HOST_EV_TYPE(LOC_U8Code)){
+		case HOST_EV_RISE: HOST_SetPin(LOC_U8Pin, 1); break;
+		case HOST_EV_FALL: HOST_SetPin(LOC_U8Pin, 0); break;
+		case HOST_EV_PULSE:
+			HOST_SetPin(LOC_U8Pin, 1);
+			if(LOC_U8Pin < HOST_PIN_NUM) HOST_FallTime[LOC_U8Pin] = HOST_Time + HOST_PULSE_CYCLES;
+		break;
+		case HOST_EV_RESET: HOST_Reset(1<<EXTRF); break;
+		case HOST_EV_WATCHDOG: HOST_Reset(1<<WDRF); break;
+		case HOST_EV_SERIAL:
+			if(!GET_BIT(UCSRB, RXEN)) break;
+			UDR = LOC_U8Data; // replaces a byte not read yet
+			SET_BIT(UCSRA, RXC);
+		break;
+		case HOST_EV_DROOP:
+		case HOST_EV_SUPPLY:
+			HOST_SupplyLow = (HOST_EV_DROOP == HOST_EV_TYPE(LOC_U8Code));
+			HOST_AcUpdate();
+		break;
+		case HOST_EV_POWER: HOST_PowerCut(); break;
+		case HOST_EV_END: HOST_Stop(HOST_STOP_END); break;
+	}
+}
+
+/*
+ * Function: HOST_Advance()
+ * Description: Moves the virtual time to the next event, but not after LOC_U64Limit, and processes that event.
+ * Returns 1 if an event was processed, 2 if it was the end of an SPI transfer, 0 if the time reached the limit without an event.
+ */
+static uint8_t HOST_Advance(uint64_t LOC_U64Limit){
+	enum {EV_NONE, EV_INPUT, EV_FALL, EV_T0, EV_T1, EV_T2, EV_WDT, EV_EE, EV_SPI, EV_ADC, EV_TWI, EV_SPM} LOC_Kind = EV_NONE;
+	uint64_t LOC_U64Time = LOC_U64Limit;
+	uint8_t LOC_U8FallPin = 0;
+	uint8_t LOC_U8Flag2;
+	uint16_t LOC_U16Result;
+
+	if(!HOST_HasNext && HOST_Input) HOST_HasNext = HOST_Input(&HOST_Next, HOST_InputArg);
+	if(HOST_HasNext){
+		uint64_t t = (HOST_Next.time < HOST_Time) ? HOST_Time : HOST_Next.time;
+		if(t <= LOC_U64Time){ LOC_U64Time = t; LOC_Kind = EV_INPUT; }
+	}
+	for(uint8_t i=0; i<HOST_PIN_NUM; i++){
+		if(HOST_FallTime[i] && HOST_FallTime[i] < LOC_U64Time){ LOC_U64Time = HOST_FallTime[i]; LOC_Kind = EV_FALL; LOC_U8FallPin = i; }
+	}
+	uint16_t LOC_U16Pre = HOST_Prescale[TCCR0 & 0x07];
+	if(LOC_U16Pre){
+		uint64_t t = HOST_T0Base + (uint64_t)(256 - HOST_T0Count) * LOC_U16Pre;
+		if(t < LOC_U64Time){ LOC_U64Time = t; LOC_Kind = EV_T0; }
+	}
+	uint64_t LOC_U64T1 = HOST_T1Next();
+	if(LOC_U64T1 < LOC_U64Time){ LOC_U64Time = LOC_U64T1; LOC_Kind = EV_T1; }
+	uint64_t LOC_U64T2 = HOST_T2Next();
+	if(LOC_U64T2 < LOC_U64Time){ LOC_U64Time = LOC_U64T2; LOC_Kind = EV_T2; }
+	if(HOST_WdtShadowWDE){
+		uint64_t t = HOST_WdtLast + (16384UL << (WDTCR & 0x07));
+		if(t < LOC_U64Time){ LOC_U64Time = t; LOC_Kind = EV_WDT; }
+	}
+	if(HOST_EeDone && HOST_EeDone < LOC_U64Time){ LOC_U64Time = HOST_EeDone; LOC_Kind = EV_EE; }
+	if(HOST_SpiDone && HOST_SpiDone < LOC_U64Time){ LOC_U64Time = HOST_SpiDone; LOC_Kind = EV_SPI; }
+	if(HOST_AdcDone && HOST_AdcDone < LOC_U64Time){ LOC_U64Time = HOST_AdcDone; LOC_Kind = EV_ADC; }
+	if(HOST_TWI_IDLE == HOST_TwiStep && !HOST_TwiHeld) HOST_TwiFetch();
+	if(HOST_TwiDone && HOST_TwiDone < LOC_U64Time){ LOC_U64Time = HOST_TwiDone; LOC_Kind = EV_TWI; }
+	if(HOST_SpmDone && HOST_SpmDone < LOC_U64Time){ LOC_U64Time = HOST_SpmDone; LOC_Kind = EV_SPM; }
+
+	if(LOC_U64Time >= HOST_StopTime){
+		if(EV_NONE == LOC_Kind && UINT64_MAX == HOST_StopTime) HOST_Stop(HOST_STOP_IDLE);
+		HOST_Time = HOST_StopTime;
+		HOST_Sync();
+		HOST_Stop(HOST_STOP_TIME);
+	}
+	HOST_Time = LOC_U64Time;
+	HOST_T1Update();
+
+	switch(LOC_Kind){
+		case EV_NONE: return 0;
+		case EV_INPUT:
+			HOST_HasNext = 0;
+			HOST_ApplyInput(HOST_Next.code, HOST_Next.data);
+		break;
+		case EV_FALL:
+			HOST_FallTime[LOC_U8FallPin] = 0;
+			HOST_SetPin(LOC_U8FallPin, 0);
+		break;
+		case EV_T0:
+			HOST_T0Base = HOST_Time;
+			HOST_T0Count = 0;
+			TCNT0 = 0;
+			HOST_T0ShadowTCNT = 0;
+			SET_BIT(TIFR, TOV0);
+		break;
+		case EV_T1:
+			HOST_T1Base = HOST_Time;
+			HOST_T1Count = 0;
+			TCNT1 = 0;
+			HOST_T1ShadowTCNT = 0;
+			if(!GET_BIT(TCCR1B, WGM12)) SET_BIT(TIFR, TOV1);
+			else{
+				SET_BIT(TIFR, OCF1A);
+				if(OCR1B == OCR1A) SET_BIT(TIFR, OCF1B); // the firmware only matches channel B at the top
+			}
+		break;
+		case EV_T2:
+			HOST_T2Base = HOST_Time;
+			HOST_T2Count = 0;
+			TCNT2 = 0;
+			HOST_T2ShadowTCNT = 0;
+			LOC_U8Flag2 = GET_BIT(TCCR2, WGM21) ? OCF2 : TOV2;
+			SET_BIT(TIFR, LOC_U8Flag2);
+		break;
+		case EV_WDT:
+			HOST_Reset(1<<WDRF);
+		break;
+		case EV_EE:
+			HOST_EeDone = 0;
+			CLR_BIT(EECR, EEWE);
+		break;
+		case EV_SPI:
+			HOST_SpiDone = 0;
+			SPDR = 0xFF; // MISO not connected
+			memmove(HOST_Chain + 1, HOST_Chain, HOST_SHIFT_CHIPS - 1);
+			HOST_Chain[0] = HOST_SpiByte;
+			SET_BIT(SPSR, SPIF);
+		break;
+		case EV_ADC:
+			HOST_AdcDone = 0;
+			LOC_U16Result = HOST_Analog ? (HOST_Analog(HOST_Time, HOST_AdcChannel, HOST_AnalogArg) & 0x3FF) : 0;
+			if(GET_BIT(ADMUX, ADLAR)){
+				ADCH = (uint8_t)(LOC_U16Result >> 2);
+				ADCL = (uint8_t)(LOC_U16Result << 6);
+			}
+			else{
+				ADCH = (uint8_t)(LOC_U16Result >> 8);
+				ADCL = (uint8_t)LOC_U16Result;
+			}
+			SET_BIT(ADCSRA, ADIF);
+			HOST_AdcShadowADIF = 1;
+			// Free running: the next conversion starts at once, with the channel selected now
+			if(GET_BIT(ADCSRA, ADATE) && !(SFIOR & (0x07<<ADTS0))) HOST_AdcStart();
+			else CLR_BIT(ADCSRA, ADSC);
+		break;
+		case EV_TWI:
+			HOST_TwiDone = 0;
+			HOST_TwiEnd();
+		break;
+		case EV_SPM:
+			HOST_SpmDone = 0;
+			if(HOST_SpmWrite){ // the page is only programmed (bits cleared), it was erased before
+				for(uint16_t i=0; i<FLASH_PAGE_SIZE; i++) HOST_FlashMem[HOST_SpmPage + i] &= HOST_SpmBuffer[i];
+				memset(HOST_SpmBuffer, 0xFF, sizeof(HOST_SpmBuffer));
+			}
+			SPMCR &= (1<<RWWSB) | (1<<SPMIE); // the operation bits and SPMEN are cleared, RWWSB until RWWSRE
+		break;
+	}
+	HOST_TifrShadow = TIFR;
+	HOST_Dispatch();
+	return (EV_SPI == LOC_Kind) ? 2 : 1;
+}
+
+
+/************************************************************************/
+/*                       CPU hooks (IO_ACCESS.h)                        */
+/************************************************************************/
+
+/*
+ * Function: HOST_Poll()
+ * Description: Called by the firmware each time it polls a hardware flag.
+ * The firmware clears TOV0 (and TOV2 without its interrupt) right after it has seen it set,
+ * so a polled flag seen by the previous call is cleared here.
+ * Then the virtual time jumps to the next event. The ends of the SPI transfers are served on the way:
+ * they are only seen by the SPI interrupt, never by a polling loop.
+ */
+void HOST_Poll(void){
+	HOST_Sync();
+	HOST_Preemption();
+	if(HOST_T0Seen && !GET_BIT(TIMSK, TOIE0)) CLR_BIT(TIFR, TOV0);
+	if(HOST_T2Seen && !GET_BIT(TIMSK, TOIE2)) CLR_BIT(TIFR, TOV2);
+	HOST_T0Seen = 0;
+	HOST_T2Seen = 0;
+	HOST_TifrShadow = TIFR;
+
+	while(2 == HOST_Advance(HOST_StopTime));
+
+	HOST_Sync();
+	HOST_T0Seen = GET_BIT(TIFR, TOV0);
+	HOST_T2Seen = GET_BIT(TIFR, TOV2) && !GET_BIT(TIMSK, TOIE2);
+}
+
+/*
+ * Function: HOST_Write()
+ * Description: Called by the firmware after each output register write, the new outputs are reported at once.
+ */
+void HOST_Write(void){
+	HOST_Sync();
+	HOST_Preemption();
+}
+
+void HOST_Sei(void){
+	HOST_IFlag = 1;
+	SET_BIT(SREG, SREG_I);
+	HOST_Sync();
+	HOST_Dispatch();
+}
+
+void HOST_Cli(void){
+	HOST_IFlag = 0;
+	CLR_BIT(SREG, SREG_I);
+}
+
+void HOST_Wdr(void){
+	HOST_WdtLast = HOST_Time;
+}
+
+/*
+ * Function: HOST_Spm()
+ * Description: Executes spm with the operation just written to SPMCR, ignored while a page erase or write runs.
+ * The buffer fill stores the word at the word of the page selected by the address (little endian),
+ * the RWW read enable clears RWWSB and the buffer.
+ */
+void HOST_Spm(uint16_t LOC_U16Address, uint16_t LOC_U16Word){
+	uint8_t* LOC_PtrFlash = HOST_Flash();
+	uint8_t LOC_U8Op = SPMCR & ((1<<PGERS) | (1<<PGWRT) | (1<<BLBSET) | (1<<RWWSRE) | (1<<SPMEN));
+	uint16_t LOC_U16Page = (LOC_U16Address % FLASH_SIZE) & ~(FLASH_PAGE_SIZE - 1);
+	if(HOST_SpmDone || !GET_BIT(LOC_U8Op, SPMEN)) return;
+	switch(LOC_U8Op){
+		case (1<<SPMEN):
+			HOST_SpmBuffer[LOC_U16Address & (FLASH_PAGE_SIZE - 2)] = (uint8_t)LOC_U16Word;
+			HOST_SpmBuffer[(LOC_U16Address & (FLASH_PAGE_SIZE - 2)) + 1] = (uint8_t)(LOC_U16Word >> 8);
+		break;
+		case (1<<PGERS) | (1<<SPMEN):
+			memset(LOC_PtrFlash + LOC_U16Page, 0xFF, FLASH_PAGE_SIZE);
+			HOST_SpmWrite = 0;
+			HOST_SpmDone = HOST_Time + HOST_SPM_CYCLES;
+		break;
+		case (1<<PGWRT) | (1<<SPMEN):
+			HOST_FlashWr[LOC_U16Page / FLASH_PAGE_SIZE]++;
+			HOST_SpmPage = LOC_U16Page;
+			HOST_SpmWrite = 1;
+			HOST_SpmDone = HOST_Time + HOST_SPM_CYCLES;
+		break;
+		case (1<<RWWSRE) | (1<<SPMEN):
+			CLR_BIT(SPMCR, RWWSB);
+			memset(HOST_SpmBuffer, 0xFF, sizeof(HOST_SpmBuffer));
+		break;
+		default: // boot lock bits are not modelled
+		break;
+	}
+	if(!HOST_SpmDone) SPMCR &= (1<<RWWSB) | (1<<SPMIE); // done at once
+	else if(LOC_U16Page < FLASH_NRWW_START) SET_BIT(SPMCR, RWWSB);
+}
+
+/*
+ * Function: HOST_Lpm()
+ * Description: Reads a byte of the flash, the RWW section reads 0xFF while it is busy.
+ */
+uint8_t HOST_Lpm(uint16_t LOC_U16Address){
+	LOC_U16Address %= FLASH_SIZE;
+	if(GET_BIT(SPMCR, RWWSB) && LOC_U16Address < FLASH_NRWW_START) return 0xFF;
+	return HOST_Flash()[LOC_U16Address];
+}
+
+/*
+ * Function: HOST_Jump()
+ * Description: Leaves the firmware at a jump to another program, HOST_Run returns HOST_STOP_JUMP.
+ */
+void HOST_Jump(uint16_t LOC_U16Address){
+	HOST_Jumped = LOC_U16Address;
+	HOST_Sync();
+	HOST_Stop(HOST_STOP_JUMP);
+}
+
+
+/************************************************************************/
+/*                       Interface Functions                            */
+/************************************************************************/
+
+/*
+ * Function: HOST_Run()
+ * Description: Runs the firmware from power-on reset: calls init once, then loop forever,
+ * until the stop time is reached, the input stream ends, or nothing can happen any more.
+ * After a reset the registers are cleared and init is called again (RAM variables are kept,
+ * the firmware init function must set the state it depends on).
+ * Returns: the reason of the stop
+ */
+EN_HostStop_t HOST_Run(void (*init)(void), void (*loop)(void), uint64_t stopTime){
+	static void (*volatile LOC_Init)(void);
+	static void (*volatile LOC_Loop)(void);
+	LOC_Init = init;
+	LOC_Loop = loop;
+	HOST_StopTime = stopTime;
+	HOST_Time = 0;
+	HOST_HasNext = 0;
+	HOST_ResetFlags = 1<<PORF;
+	memset(HOST_PinLevel, 0, sizeof(HOST_PinLevel));
+	memset(HOST_FallTime, 0, sizeof(HOST_FallTime));
+	memset(HOST_OutSnap, 0, sizeof(HOST_OutSnap));
+	memset(HOST_Eeprom, 0xFF, sizeof(HOST_Eeprom)); // erased
+	memset(HOST_EeWrites, 0, sizeof(HOST_EeWrites));
+	memset(HOST_Chain, 0, sizeof(HOST_Chain));
+	memset(HOST_Latched, 0, sizeof(HOST_Latched));
+	HOST_SupplyLow = 0;
+
+	if(HOST_JMP_STOP == setjmp(HOST_Exit)) return HOST_StopReason;
+
+	HOST_ResetRegs(HOST_ResetFlags);
+	HOST_Sync();
+	LOC_Init();
+	while(1){
+		LOC_Loop();
+		HOST_Idle();
+	}
+}
+
+void HOST_SetInput(HOST_InputFn_t input, void* arg){
+	HOST_Input = input;
+	HOST_InputArg = arg;
+	HOST_HasNext = 0;
+}
+
+void HOST_SetOutput(HOST_OutputFn_t output, void* arg){
+	HOST_Output = output;
+	HOST_OutputArg = arg;
+}
+
+void HOST_SetSerial(HOST_SerialFn_t serial, void* arg){
+	HOST_Serial = serial;
+	HOST_SerialArg = arg;
+}
+
+void HOST_SetAnalog(HOST_AnalogFn_t analog, void* arg){
+	HOST_Analog = analog;
+	HOST_AnalogArg = arg;
+}
+
+void HOST_SetTwi(HOST_TwiFn_t master, uint16_t bitCycles, uint16_t isrCycles, void* arg){
+	HOST_Twi = master;
+	HOST_TwiArg = arg;
+	HOST_TwiBit = bitCycles ? bitCycles : 1;
+	HOST_TwiIsr = isrCycles;
+	HOST_TwiOver = 0;
+	HOST_TwiStep = HOST_TWI_IDLE;
+	HOST_TwiDone = 0;
+	HOST_TwiHeld = 0;
+	memset(&HOST_TwiTxn, 0, sizeof(HOST_TwiTxn));
+}
+
+/*
+ * Function: HOST_Idle()
+ * Description: Accounts the time of one pass of the main loop, processing the events that happen meanwhile.
+ */
+void HOST_Idle(void){
+	uint64_t LOC_U64End = HOST_Time + HOST_IDLE_CYCLES;
+	HOST_Sync();
+	HOST_Preemption();
+	while(HOST_Advance(LOC_U64End));
+	HOST_Sync();
+}
+
+/*
+ * Function: HOST_Lamp()
+ * Description: Gets the state of an output pin as seen by a lamp connected to it.
+ * Pins connected to a Timer1 compare output in toggle mode are reported as flashing.
+ * Returns: HOST_LAMP_OFF, HOST_LAMP_ON or HOST_LAMP_FLASH
+ */
+uint8_t HOST_Lamp(uint8_t LOC_U8Port, uint8_t LOC_U8Pin){
+	if(LOC_U8Port > PORTD || !GET_BIT(HOST_IoSpace[HOST_DdrReg[LOC_U8Port]], LOC_U8Pin)) return HOST_LAMP_OFF;
+	if(PORTD == LOC_U8Port && (PIN5 == LOC_U8Pin || PIN4 == LOC_U8Pin)){
+		uint8_t LOC_U8Com = (TCCR1A >> ((PIN5 == LOC_U8Pin) ? COM1A0 : COM1B0)) & 0x03;
+		if(OC_TOGGLE == LOC_U8Com && (TCCR1B & 0x07)) return HOST_LAMP_FLASH;
+	}
+	return GET_BIT(HOST_IoSpace[HOST_PortReg[LOC_U8Port]], LOC_U8Pin) ? HOST_LAMP_ON : HOST_LAMP_OFF;
+}
+
+void HOST_SetPreempt(HOST_PreemptFn_t preempt, void* arg){
+	HOST_Preempt = preempt;
+	HOST_PreemptArg = arg;
+}
+
+/*
+ * Function: HOST_Inject()
+ * Description: Applies an input event at the current virtual time and serves the interrupt it raises,
+ * used from the preemption hook to deliver an input between two firmware statements.
+ */
+void HOST_Inject(uint8_t LOC_U8Code){
+	HOST_ApplyInput(LOC_U8Code, 0);
+	HOST_Dispatch();
+}
+
+/*
+ * Function: HOST_Halt()
+ * Description: Leaves the firmware, HOST_Run returns HOST_STOP_HALT.
+ */
+void HOST_Halt(void){
+	HOST_Stop(HOST_STOP_HALT);
+}
+
+/*
+ * Function: HOST_StateHash()
+ * Description: Hashes (FNV-1a) everything that decides the future of the simulated hardware:
+ * the registers, the I bit, the input pins, the EEPROM, the shift register chain and the time left until each pending hardware event
+ * (the analog inputs are the tool's).
+ * Two runs with the same hash (and the same firmware RAM) behave the same from now on.
+ * Returns: the 64-bit hash
+ */
+uint64_t HOST_StateHash(void){
+	uint64_t LOC_U64Left[6 + HOST_PIN_NUM] = {0};
+	uint8_t LOC_U8Cpu[2] = {HOST_IFlag, HOST_T0Seen};
+	uint16_t LOC_U16Pre = HOST_Prescale[TCCR0 & 0x07];
+	if(LOC_U16Pre) LOC_U64Left[0] = HOST_T0Base + (uint64_t)(256 - HOST_T0Count) * LOC_U16Pre - HOST_Time;
+	uint64_t LOC_U64T1 = HOST_T1Next();
+	if(UINT64_MAX != LOC_U64T1) LOC_U64Left[3] = LOC_U64T1 - HOST_Time;
+	uint64_t LOC_U64T2 = HOST_T2Next();
+	if(UINT64_MAX != LOC_U64T2) LOC_U64Left[5] = LOC_U64T2 - HOST_Time;
+	if(HOST_WdtShadowWDE) LOC_U64Left[1] = HOST_WdtLast + (16384UL << (WDTCR & 0x07)) - HOST_Time;
+	for(uint8_t i=0; i<HOST_PIN_NUM; i++){
+		if(HOST_FallTime[i]) LOC_U64Left[6 + i] = HOST_FallTime[i] - HOST_Time;
+	}
+	if(HOST_EeDone) LOC_U64Left[2] = HOST_EeDone - HOST_Time;
+	if(HOST_SpiDone) LOC_U64Left[4] = HOST_SpiDone - HOST_Time;
+	uint64_t LOC_U64Hash = HOST_Fnv(14695981039346656037ULL, (const uint8_t*)HOST_IoSpace, HOST_IO_SIZE);
+	LOC_U64Hash = HOST_Fnv(LOC_U64Hash, LOC_U8Cpu, sizeof(LOC_U8Cpu));
+	LOC_U64Hash = HOST_Fnv(LOC_U64Hash, HOST_PinLevel, sizeof(HOST_PinLevel));
+	LOC_U64Hash = HOST_Fnv(LOC_U64Hash, HOST_Eeprom, sizeof(HOST_Eeprom));
+	LOC_U64Hash = HOST_Fnv(LOC_U64Hash, &HOST_SpiByte, 1);
+	LOC_U64Hash = HOST_Fnv(LOC_U64Hash, HOST_Chain, sizeof(HOST_Chain));
+	LOC_U64Hash = HOST_Fnv(LOC_U64Hash, HOST_Latched, sizeof(HOST_Latched));
+	if(HOST_AdcDone){ // only while the ADC runs, so the hashes of the runs without it do not change
+		uint64_t LOC_U64AdcLeft = HOST_AdcDone - HOST_Time;
+		uint8_t LOC_U8Adc[2] = {HOST_AdcChannel, HOST_AdcEnabled};
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, (const uint8_t*)&LOC_U64AdcLeft, sizeof(LOC_U64AdcLeft));
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, LOC_U8Adc, sizeof(LOC_U8Adc));
+	}
+	if(HOST_SpmDone){ // only during a page erase or write (the flash itself is the tool's)
+		uint64_t LOC_U64SpmLeft = HOST_SpmDone - HOST_Time;
+		uint8_t LOC_U8Spm[3] = {HOST_SpmWrite, (uint8_t)HOST_SpmPage, (uint8_t)(HOST_SpmPage >> 8)};
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, (const uint8_t*)&LOC_U64SpmLeft, sizeof(LOC_U64SpmLeft));
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, LOC_U8Spm, sizeof(LOC_U8Spm));
+	}
+	if(HOST_SupplyLow){ // only while the supply is low
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, &HOST_SupplyLow, 1);
+	}
+	if(HOST_T2Seen){ // only while a polled overflow is pending
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, &HOST_T2Seen, 1);
+	}
+	if(HOST_TWI_IDLE != HOST_TwiStep){ // only during a transaction, the master is the tool's
+		uint64_t LOC_U64TwiLeft = HOST_TwiDone ? HOST_TwiDone - HOST_Time : 0;
+		uint8_t LOC_U8Twi[7] = {HOST_TwiStep, HOST_TwiIndex, HOST_TwiAck, HOST_TwiHeld, HOST_TwiServed, HOST_TwiSlave, HOST_TwiByte};
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, (const uint8_t*)&LOC_U64TwiLeft, sizeof(LOC_U64TwiLeft));
+		LOC_U64Hash = HOST_Fnv(LOC_U64Hash, LOC_U8Twi, sizeof(LOC_U8Twi));
+	}
+	return HOST_Fnv(LOC_U64Hash, (const uint8_t*)LOC_U64Left, sizeof(LOC_U64Left));
+}
+
+/*
+ * Function: HOST_EepromWrites()
+ * Description: Gets the number of writes of an EEPROM byte since the start of HOST_Run.
+ * Returns: the number of writes, 0 for an address outside the EEPROM
+ */
+uint32_t HOST_EepromWrites(uint16_t LOC_U16Address){
+	return (LOC_U16Address < EEPROM_SIZE) ? HOST_EeWrites[LOC_U16Address] : 0;
+}
+
+/*
+ * Function: HOST_EepromRead()
+ * Description: Gets the content of an EEPROM byte, as the firmware would read it.
+ * Returns: the byte, 0xFF for an address outside the EEPROM
+ */
+uint8_t HOST_EepromRead(uint16_t LOC_U16Address){
+	return (LOC_U16Address < EEPROM_SIZE) ? HOST_Eeprom[LOC_U16Address] : 0xFF;
+}
+
+/*
+ * Function: HOST_Shift()
+ * Description: Gets the outputs of a register of the shift register chain, as latched last.
+ * Returns: the outputs (bit n = Qa + n), 0 for a register outside the chain
+ */
+uint8_t HOST_Shift(uint8_t LOC_U8Chip){
+	return (LOC_U8Chip < HOST_SHIFT_CHIPS) ? HOST_Latched[LOC_U8Chip] : 0;
+}
+
+/*
+ * Function: HOST_Flash()
+ * Description: Gets the simulated flash, erased at the first call and kept across the runs:
+ * the tool loads the programs in it before HOST_Run and checks it after.
+ * Returns: the FLASH_SIZE bytes of the flash
+ */
+uint8_t* HOST_Flash(void){
+	if(!HOST_FlashReady){
+		memset(HOST_FlashMem, 0xFF, sizeof(HOST_FlashMem));
+		HOST_FlashReady = 1;
+	}
+	return HOST_FlashMem;
+}
+
+/*
+ * Function: HOST_FlashWrites()
+ * Description: Gets the number of page writes of a flash page since the start of the program (each one follows an erase).
+ * Returns: the number of writes, 0 for a page outside the flash
+ */
+uint32_t HOST_FlashWrites(uint16_t LOC_U16Page){
+	return (LOC_U16Page < FLASH_SIZE / FLASH_PAGE_SIZE) ? HOST_FlashWr[LOC_U16Page] : 0;
+}
+
+/*
+ * Function: HOST_JumpAddress()
+ * Description: Gets the byte address of the jump that stopped the last run (HOST_STOP_JUMP).
+ * Returns: the address
+ */
+uint16_t HOST_JumpAddress(void){
+	return HOST_Jumped;
+}
+
+/************************************************************************/
+/*                       Simulation tools                               */
+/************************************************************************/
+
+/*
+ * Function: HOST_Options()
+ * Description: Parses the command line of a simulation tool with getopt: "-s seed" seeds HOST_Uniform when the
+ * getopt string has it, the other options are given to the option function of the tool.
+ * The usage (if any) is printed when an option is unknown or rejected by the tool.
+ * Returns: the index of the first operand, -1 if an option is unknown or rejected
+ */
+int HOST_Options(int argc, char** argv, const char* options, HOST_OptionFn_t option, const char* usage){
+	int opt;
+	while(-1 != (opt = getopt(argc, argv, options))){
+		if('s' == opt) HOST_Seed = strtoull(optarg, NULL, 0) | 1;
+		else if('?' == opt || ':' == opt || !option(opt, optarg)){
+			if(usage) fprintf(stderr, "usage: %s\n", usage);
+			return -1;
+		}
+	}
+	return optind;
+}
+
+/*
+ * Function: HOST_Uniform()
+ * Description: Draws a number from the xorshift64* generator seeded by HOST_Seed (never 0).
+ * Returns: a uniform number in (0, 1)
+ */
+double HOST_Uniform(void){
+	HOST_Seed ^= HOST_Seed >> 12;
+	HOST_Seed ^= HOST_Seed << 25;
+	HOST_Seed ^= HOST_Seed >> 27;
+	return ((HOST_Seed * 2685821657736338717ULL >> 11) + 0.5) / 9007199254740992.0;
+}
+
+/*
+ * Function: HOST_Arrival()
+ * Description: Draws the time to the next arrival of a Poisson process (exponential interval).
+ * Returns: the interval in cycles (at least 1), UINT64_MAX if the rate is not positive
+ */
+uint64_t HOST_Arrival(double perHour){
+	if(perHour <= 0) return UINT64_MAX;
+	return (uint64_t)(-log(HOST_Uniform()) * HOST_CYCLES_PER_HOUR / perHour) + 1;
+}
+
+/*
+ * Function: HOST_PressStart()
+ * Description: Starts a source of button presses arriving at random at a rate per hour until an end time,
+ * and draws the first one.
+ */
+void HOST_PressStart(ST_HostPresses_t* presses, double perHour, uint64_t end){
+	presses->rate = perHour;
+	presses->end = end;
+	presses->next = HOST_Arrival(perHour);
+	presses->count = 0;
+}
+
+/*
+ * Function: HOST_PressInput()
+ * Description: Input source (HOST_SetInput) of the presses of arg (ST_HostPresses_t), a pulse on INT0 each:
+ * fills the next press and draws the one after it. The tools merging the presses with other events call it
+ * when the press is the first event.
+ * Returns: 1, 0 when there are no more presses before the end time
+ */
+uint8_t HOST_PressInput(ST_HostEvent_t* event, void* arg){
+	ST_HostPresses_t* LOC_PtrPresses = (ST_HostPresses_t*)arg;
+	if(LOC_PtrPresses->next >= LOC_PtrPresses->end) return 0;
+	event->time = LOC_PtrPresses->next;
+	event->code = HOST_EV_CODE(HOST_EV_PULSE, HOST_PIN_INT0);
+	LOC_PtrPresses->next += HOST_Arrival(LOC_PtrPresses->rate);
+	LOC_PtrPresses->count++;
+	return 1;
+}
+
+static void HOST_SimPass(void){
+	if(HOST_Time >= HOST_SimEnd){
+		if(HOST_SimDone) HOST_SimDone();
+		HOST_Halt();
+	}
+	HOST_SimLoop();
+}
+
+/*
+ * Function: HOST_Simulate()
+ * Description: Runs the firmware from power-on reset (HOST_Run), one pass of loop per main loop pass,
+ * up to the first pass at or after the end time: done (if any) is called there, from the firmware context
+ * (to read the state of the firmware back), and the run stops. The run also stops one hour after the end time.
+ * Returns: the reason of the stop
+ */
+EN_HostStop_t HOST_Simulate(void (*init)(void), void (*loop)(void), void (*done)(void), uint64_t endTime){
+	HOST_SimEnd = endTime;
+	HOST_SimLoop = loop;
+	HOST_SimDone = done;
+	return HOST_Run(init, HOST_SimPass, endTime + HOST_CYCLES_PER_HOUR);
+}
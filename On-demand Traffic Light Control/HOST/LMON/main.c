@@ -0,0 +1,146 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "lampsim" host tool, which checks the lamp current monitor (ECUAL/LMON).
+ * The unmodified firmware runs on the host backend for a number of virtual minutes with button presses arriving
+ * at random (Poisson arrivals, fixed seed). The ADC converts the sense voltage of each sensed lamp of APP_Signals.h:
+ * a lit lamp gives LIT_LEVEL with some noise, a lamp off or failed gives a few counts of noise.
+ * One sensed lamp can fail (no current while it is lit) from a given time.
+ * The tool counts the conversions, reads the event log back at the end, and checks that:
+ *   - without a failure, the controller never goes to the fail-safe state and no lamp is logged out
+ *   - a failed red lamp puts the controller in the fail-safe state, and the delay after the first time
+ *     the lamp was lit without current is reported
+ *   - a failed lamp of another color is logged out without the fail-safe state
+ * The tool needs the monitor build: it is compiled with -DLMON_ENABLE=1.
+ * Usage:
+ *   lampsim [-m minutes] [-f sensed lamp] [-t seconds] [-r presses per hour] [-s seed]
+ *     defaults: 10 minutes, no failure, failure after 60 seconds, 60 presses per hour, seed 1
+ *   sensed lamp: the index of the lamp in the sense lines of APP_Signals.txt, from 0
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#if !LMON_ENABLE || !APP_SENSE_NUM
+#error "lampsim needs -DLMON_ENABLE=1 and sensed lamps in APP_Signals.txt"
+#endif
+
+#define LIT_LEVEL       600U // 10-bit counts of a lit lamp (2.9 V)
+#define LIT_NOISE       60U
+#define OFF_NOISE       16U
+
+// Options
+static double minutes = 10, failSecs = 60, pressRate = 60;
+static int failed = -1;
+
+// Simulation
+static ST_HostPresses_t presses;
+static uint64_t endTime, failTime;
+static uint64_t conversions[APP_SENSE_NUM];
+static uint64_t litFailed;     // first conversion of the failed lamp lit without current, 0 = none yet
+static uint64_t failSafeTime;  // 0 = not in the fail-safe state
+static uint64_t lampOuts;      // lamp out records of the event log
+
+/*
+ * Analog source: the sense voltage of the lamp on the channel converted.
+ */
+static uint16_t Analog(uint64_t now, uint8_t channel, void* arg){
+	(void)arg;
+	for(int i=0; i<APP_SENSE_NUM; i++){
+		if(APP_SenseChannels[i] != channel) continue;
+		const ST_AppLamp_t* LOC_PtrLamp = &APP_Lamps[APP_SenseLamps[i]];
+		uint8_t LOC_U8Lit = HOST_LAMP_ON == HOST_Lamp(LOC_PtrLamp->port, LOC_PtrLamp->pin);
+		conversions[i]++;
+		if(LOC_U8Lit && i == failed && now >= failTime){
+			if(!litFailed) litFailed = now;
+			LOC_U8Lit = 0;
+		}
+		if(LOC_U8Lit) return (uint16_t)(LIT_LEVEL - LIT_NOISE / 2 + HOST_Uniform() * LIT_NOISE);
+		break;
+	}
+	return (uint16_t)(HOST_Uniform() * OFF_NOISE);
+}
+
+/*
+ * Reads the event log back, from the firmware context (the EEPROM reads poll the simulated hardware).
+ */
+static void ReadBack(void){
+	ST_ElogRecord_t LOC_Record;
+	ELOG_Rewind();
+	while(ELOG_Next(&LOC_Record)){
+		if(ELOG_LAMP_OUT == LOC_Record.event) lampOuts++;
+	}
+}
+
+static void Loop(void){
+	if(!failSafeTime && FAIL_SAFE == APP_Contexts[0].mode) failSafeTime = HOST_Time;
+	APP_Start();
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'f': failed = atoi(arg); break;
+		case 't': failSecs = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "m:f:t:r:s:", Option,
+	                "lampsim [-m minutes] [-f sensed lamp] [-t seconds] [-r presses per hour] [-s seed]") < 0) return 2;
+	if(minutes <= 0 || minutes > 60 * 24 * 7){
+		fprintf(stderr, "lampsim: the duration must be from 0 to 7 days\n");
+		return 2;
+	}
+	if(failed < -1 || failed >= APP_SENSE_NUM){
+		fprintf(stderr, "lampsim: the failed lamp must be from 0 to %d\n", APP_SENSE_NUM - 1);
+		return 2;
+	}
+	if(failSecs < 0 || failSecs >= minutes * 60){
+		fprintf(stderr, "lampsim: the failure must come before the end of the run\n");
+		return 2;
+	}
+
+	endTime = (uint64_t)(minutes * 60e6);
+	failTime = (uint64_t)(failSecs * 1e6);
+	HOST_PressStart(&presses, pressRate, endTime);
+	HOST_SetInput(HOST_PressInput, &presses);
+	HOST_SetAnalog(Analog, NULL);
+	HOST_Simulate(APP_Init, Loop, ReadBack, endTime);
+
+	uint64_t LOC_U64Total = 0;
+	for(int i=0; i<APP_SENSE_NUM; i++) LOC_U64Total += conversions[i];
+	printf("%.0f minutes, %llu presses, %d sensed lamps, level %u (8-bit), %u checks to confirm\n", minutes,
+	       (unsigned long long)presses.count, APP_SENSE_NUM, LMON_LEVEL, LMON_CONFIRM);
+	printf("%llu conversions (%.1f per second):", (unsigned long long)LOC_U64Total, LOC_U64Total / (minutes * 60));
+	for(int i=0; i<APP_SENSE_NUM; i++) printf(" %llu on channel %u", (unsigned long long)conversions[i], APP_SenseChannels[i]);
+	printf("\n%llu lamp out records in the event log\n", (unsigned long long)lampOuts);
+
+	int LOC_Fail = 0;
+	if(failed < 0){
+		printf("no failure: %s\n", failSafeTime ? "fail-safe state entered" : "no fail-safe state");
+		LOC_Fail = failSafeTime || lampOuts;
+	}
+	else{
+		uint8_t LOC_U8Red = (APP_SENSE_REDS >> failed) & 1;
+		printf("sensed lamp %d (lamp %u, channel %u, %s) failed at %.1f s, first lit without current at %.3f s\n", failed,
+		       APP_SenseLamps[failed], APP_SenseChannels[failed], LOC_U8Red ? "red" : "not red", failTime / 1e6, litFailed / 1e6);
+		if(failSafeTime) printf("fail-safe state at %.3f s, %.3f s after\n", failSafeTime / 1e6,
+		                        (failSafeTime >= litFailed) ? (failSafeTime - litFailed) / 1e6 : -((litFailed - failSafeTime) / 1e6));
+		else printf("no fail-safe state\n");
+		if(LOC_U8Red) LOC_Fail = !litFailed || !failSafeTime || failSafeTime < litFailed || !lampOuts;
+		else LOC_Fail = (litFailed && !lampOuts) || failSafeTime;
+	}
+	return LOC_Fail;
+}
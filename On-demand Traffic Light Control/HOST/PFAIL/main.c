@@ -0,0 +1,208 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "pfsim" host tool, which checks the power-fail save (SERVICES/PFAIL)
+ * and measures its time against the hold-up of the supply. It needs a power-fail build (-DPFAIL_ENABLE=1).
+ * The unmodified firmware runs on the host backend with button presses and supply droops arriving at random
+ * (Poisson arrivals, fixed seed, the supply up for 1 s at least between two failures). A droop makes the analog
+ * comparator output go high; the power is cut the hold-up time later (power-on reset, an EEPROM write in progress
+ * is lost), or, for a given share of the droops (brownouts), the supply comes back after half the hold-up time.
+ * At each power-up the tool checks that the record was complete, that the controller resumed with the aspect it showed
+ * when the supply drooped, and reads the save time measured by the firmware (PFAIL_SaveTime). A brownout must leave
+ * the record invalidated and the save armed again. At the end the event log is read back: every pedestrian sequence
+ * started and every boot must have its record, the records queued when the supply drooped are written by the save
+ * (as long as the ring did not wrap).
+ * Usage:
+ *   pfsim [-m minutes] [-f failures per hour] [-H hold-up ms] [-b brownout share] [-r presses per hour] [-s seed]
+ *     defaults: 60 minutes, 30 failures per hour, 100 ms, 0.2, 60 presses per hour, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+
+#if !PFAIL_ENABLE
+#error "pfsim needs the power-fail build (-DPFAIL_ENABLE=1)"
+#endif
+
+#define CYCLES_PER_MS   1000ULL
+#define US_PER_COUNT    8U          // Timer1 counts of the save time (1 MHz, prescaler 8)
+#define CHECK_DELAY     1000000ULL  // brownout: record checked 1 s after the supply is back
+#define SUPPLY_UP       1000000ULL  // the supply stays up at least 1 s between two failures
+
+// Options
+static double minutes = 60, failRate = 30, holdUp = 100, brownShare = 0.2, pressRate = 60;
+
+// Input stream
+static ST_HostPresses_t presses;
+static uint64_t endTime, nextFail;
+static uint8_t failStep;            // 0: droop next, 1: cut or supply back next
+static uint8_t failBrown;           // the failure in progress is a brownout
+
+// Observations
+static uint64_t droopAt = UINT64_MAX; // time of the droop in progress
+static uint8_t shownAspect;           // aspect of the main intersection before the droop
+static uint64_t checkAt;              // brownout record check, 0 = none
+static uint8_t booted, started;       // a reset happened, the first init is done
+static uint8_t wasPedestrian;
+static uint64_t cuts, brownouts, saved, resumed, sameAspect, staleRecords, pedStarts;
+static uint64_t timeCount, timeSum;
+static uint16_t timeMin = 0xFFFF, timeMax;
+
+// Log read back at the end
+static uint64_t records[ELOG_EVENT_NUM];
+
+/*
+ * Input source: the next press or step of a failure (droop, then cut or supply back), then the end of the stream.
+ */
+static uint8_t Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	uint64_t LOC_U64Fail = nextFail;
+	if(failStep) LOC_U64Fail += (uint64_t)(holdUp * CYCLES_PER_MS / (failBrown ? 2 : 1));
+	else if(LOC_U64Fail < endTime && LOC_U64Fail + (uint64_t)(holdUp * CYCLES_PER_MS) >= endTime){
+		LOC_U64Fail = nextFail = UINT64_MAX; // no failure ending after the run
+	}
+	if(presses.next >= endTime && LOC_U64Fail >= endTime) return 0;
+	if(presses.next <= LOC_U64Fail) return HOST_PressInput(event, &presses);
+	if(!failStep){
+		event->time = LOC_U64Fail;
+		event->code = HOST_EV_CODE(HOST_EV_DROOP, 0);
+		failBrown = (HOST_Uniform() < brownShare);
+		failStep = 1;
+		droopAt = LOC_U64Fail;
+	}
+	else{
+		event->time = LOC_U64Fail;
+		event->code = HOST_EV_CODE(failBrown ? HOST_EV_SUPPLY : HOST_EV_POWER, 0);
+		if(failBrown){
+			brownouts++;
+			checkAt = LOC_U64Fail + CHECK_DELAY;
+			droopAt = UINT64_MAX;
+		}
+		else cuts++;
+		failStep = 0;
+		nextFail = LOC_U64Fail + SUPPLY_UP + HOST_Arrival(failRate); // the save is armed after the power-up
+	}
+	return 1;
+}
+
+/*
+ * Firmware init: checks the record left by the power failure, then initializes the firmware and checks the resume.
+ */
+static void Init(void){
+	if(started){
+		booted = 1;
+		if(PFAIL_VALID == HOST_EepromRead(PFAIL_EE_START)) saved++;
+	}
+	started = 1;
+	APP_Init();
+	const ST_AppContext_t* LOC_PtrMain = &APP_Contexts[0];
+	if(booted){
+		if(LOC_PtrMain->steps){
+			resumed++;
+			if(LOC_PtrMain->aspect == shownAspect) sameAspect++;
+			uint16_t LOC_U16Time = PFAIL_SaveTime();
+			if(LOC_U16Time){
+				timeCount++;
+				timeSum += LOC_U16Time;
+				if(LOC_U16Time < timeMin) timeMin = LOC_U16Time;
+				if(LOC_U16Time > timeMax) timeMax = LOC_U16Time;
+			}
+		}
+		booted = 0;
+		droopAt = UINT64_MAX;
+	}
+	wasPedestrian = (LOC_PtrMain->steps && PEDESTRIAN == LOC_PtrMain->sequenceMode);
+}
+
+/*
+ * Reads the whole log back, from the firmware context (the EEPROM reads poll the simulated hardware).
+ */
+static void ReadBack(void){
+	ST_ElogRecord_t LOC_Record;
+	ELOG_Rewind();
+	while(ELOG_Next(&LOC_Record)){
+		if(LOC_Record.event < ELOG_EVENT_NUM) records[LOC_Record.event]++;
+	}
+}
+
+/*
+ * End of the run: writes the log records still pending, then reads the log back.
+ */
+static void Done(void){
+	ELOG_Flush();
+	ReadBack();
+}
+
+/*
+ * Main loop pass: runs the tasks, then samples the main intersection (the aspect shown until the droop,
+ * the pedestrian sequences started) and checks the record after a brownout.
+ */
+static void Loop(void){
+	APP_Start();
+	const ST_AppContext_t* LOC_PtrMain = &APP_Contexts[0];
+	uint8_t LOC_U8Pedestrian = (LOC_PtrMain->steps && PEDESTRIAN == LOC_PtrMain->sequenceMode);
+	if(LOC_U8Pedestrian && !wasPedestrian) pedStarts++;
+	wasPedestrian = LOC_U8Pedestrian;
+	if(HOST_Time < droopAt) shownAspect = LOC_PtrMain->aspect;
+	if(checkAt && HOST_Time >= checkAt){
+		if(PFAIL_VALID == HOST_EepromRead(PFAIL_EE_START)) staleRecords++;
+		checkAt = 0;
+	}
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'f': failRate = atof(arg); break;
+		case 'H': holdUp = atof(arg); break;
+		case 'b': brownShare = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "m:f:H:b:r:s:", Option,
+	                "pfsim [-m minutes] [-f failures per hour] [-H hold-up ms] [-b brownout share] [-r presses per hour] [-s seed]") < 0) return 2;
+	if(minutes <= 0 || holdUp <= 0){
+		fprintf(stderr, "pfsim: the duration and the hold-up must be positive\n");
+		return 2;
+	}
+
+	endTime = (uint64_t)(minutes * 60e6);
+	HOST_PressStart(&presses, pressRate, endTime);
+	nextFail = HOST_Arrival(failRate);
+	HOST_SetInput(Input, NULL);
+	HOST_Simulate(Init, Loop, Done, endTime);
+
+	printf("%.0f minutes, %llu presses, %llu power cuts, %llu brownouts, hold-up %.0f ms\n", minutes,
+	       (unsigned long long)presses.count, (unsigned long long)cuts, (unsigned long long)brownouts, holdUp);
+	printf("records complete at the cut %llu, resumed %llu (same aspect as at the droop %llu), restarted %llu\n",
+	       (unsigned long long)saved, (unsigned long long)resumed, (unsigned long long)sameAspect,
+	       (unsigned long long)(cuts - resumed));
+	if(timeCount){
+		printf("save time of %llu records: min %.1f ms, mean %.1f ms, max %.1f ms, +25.5 ms for the time\n", (unsigned long long)timeCount,
+		       timeMin * US_PER_COUNT / 1000.0, (double)timeSum / timeCount * US_PER_COUNT / 1000.0, timeMax * US_PER_COUNT / 1000.0);
+	}
+	printf("brownouts with the record left valid: %llu\n", (unsigned long long)staleRecords);
+	uint8_t LOC_U8Ok = (saved == cuts && resumed == cuts && sameAspect == resumed && !staleRecords && !ELOG_Dropped());
+	if(HOST_EepromWrites(ELOG_EE_END - 1)){
+		printf("log ring full, the records are not checked (shorter run)\n");
+	}
+	else{
+		printf("log read back: boot %llu (%llu expected), restore %llu, pedestrian %llu (%llu sequences), %u dropped\n",
+		       (unsigned long long)records[ELOG_BOOT], (unsigned long long)(cuts + 1), (unsigned long long)records[ELOG_RESTORE],
+		       (unsigned long long)records[ELOG_PEDESTRIAN], (unsigned long long)pedStarts, ELOG_Dropped());
+		LOC_U8Ok = LOC_U8Ok && records[ELOG_BOOT] == cuts + 1 && records[ELOG_RESTORE] == resumed && records[ELOG_PEDESTRIAN] == pedStarts;
+	}
+	printf("%s\n", LOC_U8Ok ? "OK" : "FAILED");
+	return LOC_U8Ok ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "profsym" host tool, which symbolises a histogram of the PC-sampling profiler
+ * (SERVICES/PROF) into a per-function flat profile.
+ * The functions and their address ranges are read from the symbol table of the firmware .elf file,
+ * or from the input sections of the linker .map file (the project is compiled with one section per function).
+ * A bucket that spans several functions is shared between them in proportion of the bytes of each one in the bucket.
+ * Usage:
+ *   profsym <firmware.elf|firmware.map> <prof.bin>
+ *     prof.bin: raw dump of PROF_Data (layout in SERVICES/PROF/PROF_Interface.h)
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <elf.h>
+
+#define MAX_BUCKETS 256
+
+// Function with its flash byte address range and its share of the samples
+typedef struct {
+	char name[64];
+	uint32_t start, end;
+	double samples;
+} ST_Function_t;
+
+static ST_Function_t* functions;
+static size_t functionCount, functionSize;
+
+static void AddFunction(const char* name, uint32_t start, uint32_t size){
+	if(!size) return;
+	for(size_t i=0; i<functionCount; i++){
+		if(functions[i].start == start && functions[i].end == start + size) return; // alias
+	}
+	if(functionCount == functionSize){
+		functionSize = functionSize ? 2 * functionSize : 256;
+		functions = realloc(functions, functionSize * sizeof(ST_Function_t));
+		if(!functions){ perror("profsym"); exit(2); }
+	}
+	ST_Function_t* f = &functions[functionCount++];
+	snprintf(f->name, sizeof(f->name), "%s", name);
+	f->start = start;
+	f->end = start + size;
+	f->samples = 0;
+}
+
+/************************************************************************/
+/*                       Symbol sources                                 */
+/************************************************************************/
+
+/*
+ * Reads the function symbols (STT_FUNC in .symtab) of a 32-bit little endian ELF file.
+ * Return value: 1 on success, 0 if the file is not such an ELF file
+ */
+static uint8_t ReadElf(FILE* file){
+	Elf32_Ehdr eh;
+	if(1 != fread(&eh, sizeof(eh), 1, file) || memcmp(eh.e_ident, ELFMAG, SELFMAG)
+	   || ELFCLASS32 != eh.e_ident[EI_CLASS] || ELFDATA2LSB != eh.e_ident[EI_DATA]) return 0;
+	Elf32_Shdr* sh = calloc(eh.e_shnum, sizeof(Elf32_Shdr));
+	if(!sh || fseek(file, eh.e_shoff, SEEK_SET) || eh.e_shnum != fread(sh, sizeof(Elf32_Shdr), eh.e_shnum, file)) return 0;
+	for(uint16_t i=0; i<eh.e_shnum; i++){
+		if(SHT_SYMTAB != sh[i].sh_type || sh[i].sh_link >= eh.e_shnum) continue;
+		Elf32_Shdr* strSh = &sh[sh[i].sh_link];
+		char* strtab = malloc(strSh->sh_size + 1);
+		Elf32_Sym* syms = malloc(sh[i].sh_size);
+		if(!strtab || !syms) return 0;
+		if(fseek(file, strSh->sh_offset, SEEK_SET) || 1 != fread(strtab, strSh->sh_size, 1, file)) return 0;
+		if(fseek(file, sh[i].sh_offset, SEEK_SET) || 1 != fread(syms, sh[i].sh_size, 1, file)) return 0;
+		strtab[strSh->sh_size] = 0;
+		for(size_t k=0; k<sh[i].sh_size / sizeof(Elf32_Sym); k++){
+			// AVR flash addresses are below 0x800000 (RAM is mapped at 0x800000)
+			if(STT_FUNC == ELF32_ST_TYPE(syms[k].st_info) && syms[k].st_value < 0x800000 && syms[k].st_name < strSh->sh_size){
+				AddFunction(strtab + syms[k].st_name, syms[k].st_value, syms[k].st_size);
+			}
+		}
+		free(strtab);
+		free(syms);
+	}
+	free(sh);
+	return 1;
+}
+
+/*
+ * Reads the ".text.<function>" input sections of the memory map part of a GNU ld map file,
+ * the input sections named ".text" are reported with the name of their object file.
+ */
+static void ReadMap(FILE* file){
+	char line[512], name[256], pending[256] = "", object[256];
+	unsigned long addr, size;
+	uint8_t inMap = 0;
+	while(fgets(line, sizeof(line), file)){
+		if(!inMap){
+			inMap = !strncmp(line, "Linker script and memory map", 28);
+			continue;
+		}
+		object[0] = 0;
+		if(' ' == line[0] && '.' == line[1]){
+			// input section: " .text.name 0xaddr 0xsize object", long names are alone on their line
+			int n = sscanf(line, " %255s 0x%lx 0x%lx %255[^\n]", name, &addr, &size, object);
+			pending[0] = 0;
+			if(1 == n) strcpy(pending, name);
+			if(n < 3) continue;
+		}
+		else if(pending[0] && 2 <= sscanf(line, " 0x%lx 0x%lx %255[^\n]", &addr, &size, object)){
+			strcpy(name, pending);
+			pending[0] = 0;
+		}
+		else{
+			pending[0] = 0;
+			continue;
+		}
+		if(!strncmp(name, ".text.", 6)) AddFunction(name + 6, addr, size);
+		else if(!strcmp(name, ".text")){
+			const char* base = strrchr(object, '\\');
+			if(!base) base = strrchr(object, '/');
+			AddFunction(base ? base + 1 : object, addr, size);
+		}
+	}
+}
+
+static int BySamples(const void* a, const void* b){
+	double d = ((const ST_Function_t*)b)->samples - ((const ST_Function_t*)a)->samples;
+	return (d > 0) - (d < 0);
+}
+
+int main(int argc, char** argv){
+	if(3 != argc){
+		fprintf(stderr, "usage: profsym <firmware.elf|firmware.map> <prof.bin>\n");
+		return 2;
+	}
+
+	FILE* symFile = fopen(argv[1], "rb");
+	if(!symFile){ perror(argv[1]); return 2; }
+	if(!ReadElf(symFile)){
+		rewind(symFile);
+		ReadMap(symFile);
+	}
+	fclose(symFile);
+	if(!functionCount){
+		fprintf(stderr, "profsym: no function found in %s\n", argv[1]);
+		return 2;
+	}
+
+	// PROF_Data dump: buckets, shift, base, outside, hist[buckets] (little endian)
+	uint8_t raw[6 + 2 * MAX_BUCKETS];
+	FILE* profFile = fopen(argv[2], "rb");
+	if(!profFile){ perror(argv[2]); return 2; }
+	size_t len = fread(raw, 1, sizeof(raw), profFile);
+	fclose(profFile);
+	unsigned buckets = raw[0], shift = raw[1];
+	uint32_t base = raw[2] | (raw[3] << 8);
+	uint32_t outside = raw[4] | (raw[5] << 8);
+	if(len < 6 || !buckets || shift > 15 || len < 6 + 2 * (size_t)buckets){
+		fprintf(stderr, "profsym: %s is not a profiler dump\n", argv[2]);
+		return 2;
+	}
+
+	double total = outside, unknown = 0;
+	for(unsigned b=0; b<buckets; b++){
+		uint32_t count = raw[6 + 2*b] | (raw[7 + 2*b] << 8);
+		if(!count) continue;
+		total += count;
+		// bucket byte range (the program counter counts words)
+		uint32_t lo = 2 * (base + (b << shift)), hi = lo + (2U << shift);
+		double left = count;
+		for(size_t i=0; i<functionCount; i++){
+			uint32_t s = functions[i].start > lo ? functions[i].start : lo;
+			uint32_t e = functions[i].end < hi ? functions[i].end : hi;
+			if(s >= e) continue;
+			double share = (double)count * (e - s) / (hi - lo);
+			functions[i].samples += share;
+			left -= share;
+		}
+		if(left > 0.5) unknown += left;
+	}
+	if(!total){
+		printf("no samples\n");
+		return 0;
+	}
+
+	qsort(functions, functionCount, sizeof(ST_Function_t), BySamples);
+	printf("%.0f samples, %u bytes per bucket\n", total, 2U << shift);
+	printf(" samples  percent  function\n");
+	for(size_t i=0; i<functionCount && functions[i].samples >= 0.5; i++){
+		printf("%8.0f  %6.2f%%  %s\n", functions[i].samples, 100 * functions[i].samples / total, functions[i].name);
+	}
+	if(unknown >= 0.5) printf("%8.0f  %6.2f%%  (no symbol)\n", unknown, 100 * unknown / total);
+	if(outside) printf("%8u  %6.2f%%  (outside the histogram)\n", outside, 100 * outside / total);
+	return 0;
+}
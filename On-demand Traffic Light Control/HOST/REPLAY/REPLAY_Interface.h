@@ -0,0 +1,57 @@
+/*
+ * File: REPLAY_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces used to record and replay streams of timestamped input events
+ * (EXTI edges, detector pulses, resets) for deterministic regression runs on the host backend.
+ * Recording file format (all multi-byte values little-endian):
+ *   - header: "TLEV", version (1 byte), 3 reserved bytes
+ *   - one record per event: time since the previous event in cycles (1 us) as an unsigned LEB128 varint,
+ *     followed by the event code (HOST_EV_CODE(type, pin), see HOST_Interface.h)
+ * A button press 1.2 seconds after the previous event takes 4 bytes, so long field recordings stay small.
+ * The same format is used whether the events come from the host backend or are converted from on-target traces.
+ * The functions prototypes defined in this file include:
+ *   - REPLAY_OpenRead, REPLAY_OpenWrite, REPLAY_Close: functions to open and close a recording
+ *   - REPLAY_Read, REPLAY_Write: functions to read and append one event
+ *   - REPLAY_Input: input source for HOST_SetInput reading from an open recording
+ *   - REPLAY_TapInput: input source that forwards another source and records every event it delivers
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef REPLAY_INTERFACE_H_
+#define REPLAY_INTERFACE_H_
+
+#include <stdio.h>
+#include "../HOST_Interface.h"
+
+#define REPLAY_MAGIC   "TLEV"
+#define REPLAY_VERSION 1
+#define REPLAY_HEADER_SIZE 8
+
+// Open recording
+typedef struct {
+	FILE* file;
+	uint64_t lastTime; // time of the previous event
+	uint32_t count;    // number of events read or written
+} ST_ReplayFile_t;
+
+// Recording tap: forwards the events of another input source and records them
+typedef struct {
+	HOST_InputFn_t source;
+	void* sourceArg;
+	ST_ReplayFile_t* record;
+} ST_ReplayTap_t;
+
+// Replay function prototypes
+uint8_t REPLAY_OpenRead(ST_ReplayFile_t* rec, const char* path);
+uint8_t REPLAY_OpenWrite(ST_ReplayFile_t* rec, const char* path);
+void REPLAY_Close(ST_ReplayFile_t* rec);
+uint8_t REPLAY_Read(ST_ReplayFile_t* rec, ST_HostEvent_t* event);
+uint8_t REPLAY_Write(ST_ReplayFile_t* rec, const ST_HostEvent_t* event);
+uint8_t REPLAY_Input(ST_HostEvent_t* event, void* arg);
+uint8_t REPLAY_TapInput(ST_HostEvent_t* event, void* arg);
+
+#endif
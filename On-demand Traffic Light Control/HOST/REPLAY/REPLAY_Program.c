@@ -0,0 +1,126 @@
+/*
+ * File: REPLAY_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions declared in REPLAY_Interface.h
+ * The functions defined in this file are used to read and write recordings of input events
+ * and to feed them to the host backend.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <string.h>
+#include "REPLAY_Interface.h"
+
+/*
+ * Function: REPLAY_OpenRead()
+ * This function opens a recording and checks its header.
+ * Return value: 1 on success, 0 if the file can not be opened or is not a recording
+ */
+uint8_t REPLAY_OpenRead(ST_ReplayFile_t* rec, const char* path){
+	uint8_t LOC_U8Header[REPLAY_HEADER_SIZE];
+	rec->lastTime = 0;
+	rec->count = 0;
+	rec->file = fopen(path, "rb");
+	if(!rec->file) return 0;
+	if(REPLAY_HEADER_SIZE != fread(LOC_U8Header, 1, REPLAY_HEADER_SIZE, rec->file)
+	   || memcmp(LOC_U8Header, REPLAY_MAGIC, 4) || REPLAY_VERSION != LOC_U8Header[4]){
+		REPLAY_Close(rec);
+		return 0;
+	}
+	return 1;
+}
+
+/*
+ * Function: REPLAY_OpenWrite()
+ * This function creates a recording and writes its header.
+ * Return value: 1 on success, 0 if the file can not be created
+ */
+uint8_t REPLAY_OpenWrite(ST_ReplayFile_t* rec, const char* path){
+	uint8_t LOC_U8Header[REPLAY_HEADER_SIZE] = {'T', 'L', 'E', 'V', REPLAY_VERSION, 0, 0, 0};
+	rec->lastTime = 0;
+	rec->count = 0;
+	rec->file = fopen(path, "wb");
+	if(!rec->file) return 0;
+	return REPLAY_HEADER_SIZE == fwrite(LOC_U8Header, 1, REPLAY_HEADER_SIZE, rec->file);
+}
+
+/*
+ * Function: REPLAY_Close()
+ * This function closes a recording.
+ * Return value: void
+ */
+void REPLAY_Close(ST_ReplayFile_t* rec){
+	if(rec->file) fclose(rec->file);
+	rec->file = NULL;
+}
+
+/*
+ * Function: REPLAY_Read()
+ * This function reads the next event of a recording.
+ * Return value: 1 if an event was read, 0 at the end of the recording or if the record is truncated
+ */
+uint8_t REPLAY_Read(ST_ReplayFile_t* rec, ST_HostEvent_t* event){
+	uint64_t LOC_U64Delta = 0;
+	uint8_t LOC_U8Shift = 0;
+	int LOC_Byte;
+	do{
+		LOC_Byte = fgetc(rec->file);
+		if(EOF == LOC_Byte || LOC_U8Shift > 63) return 0;
+		LOC_U64Delta |= (uint64_t)(LOC_Byte & 0x7F) << LOC_U8Shift;
+		LOC_U8Shift += 7;
+	} while(LOC_Byte & 0x80);
+	LOC_Byte = fgetc(rec->file);
+	if(EOF == LOC_Byte) return 0;
+	rec->lastTime += LOC_U64Delta;
+	event->time = rec->lastTime;
+	event->code = (uint8_t)LOC_Byte;
+	rec->count++;
+	return 1;
+}
+
+/*
+ * Function: REPLAY_Write()
+ * This function appends an event to a recording, events must be written in time order.
+ * Return value: 1 on success, 0 on write error or if the event is older than the previous one
+ */
+uint8_t REPLAY_Write(ST_ReplayFile_t* rec, const ST_HostEvent_t* event){
+	uint8_t LOC_U8Buf[11];
+	uint8_t LOC_U8Len = 0;
+	if(event->time < rec->lastTime) return 0;
+	uint64_t LOC_U64Delta = event->time - rec->lastTime;
+	do{
+		LOC_U8Buf[LOC_U8Len] = LOC_U64Delta & 0x7F;
+		LOC_U64Delta >>= 7;
+		if(LOC_U64Delta) LOC_U8Buf[LOC_U8Len] |= 0x80;
+		LOC_U8Len++;
+	} while(LOC_U64Delta);
+	LOC_U8Buf[LOC_U8Len++] = event->code;
+	rec->lastTime = event->time;
+	rec->count++;
+	return LOC_U8Len == fwrite(LOC_U8Buf, 1, LOC_U8Len, rec->file);
+}
+
+/*
+ * Function: REPLAY_Input()
+ * This function is an input source for the host backend (HOST_SetInput), arg is an open ST_ReplayFile_t.
+ * Return value: 1 if an event was read, 0 at the end of the recording
+ */
+uint8_t REPLAY_Input(ST_HostEvent_t* event, void* arg){
+	return REPLAY_Read((ST_ReplayFile_t*)arg, event);
+}
+
+/*
+ * Function: REPLAY_TapInput()
+ * This function is an input source for the host backend (HOST_SetInput), arg is an ST_ReplayTap_t.
+ * It takes the events from another source and records each of them, so any host run can be replayed later.
+ * Return value: the return value of the tapped source
+ */
+uint8_t REPLAY_TapInput(ST_HostEvent_t* event, void* arg){
+	ST_ReplayTap_t* LOC_Tap = (ST_ReplayTap_t*)arg;
+	if(!LOC_Tap->source(event, LOC_Tap->sourceArg)) return 0;
+	REPLAY_Write(LOC_Tap->record, event);
+	return 1;
+}
@@ -0,0 +1,18 @@
+#!/bin/sh
+# Builds the replay tool in a temporary directory and replays the whole corpus against its golden timelines.
+# Each text event list (*.txt) is recorded again first, so a list and its recording never disagree.
+# Usage: HOST/REPLAY/corpus/run.sh [-u]   (-u writes the golden timelines after an intended change of behavior)
+# The exit status is 0 when every recording passes.
+#
+# Created on: Oct 19, 2026
+# Author: Maged Magdy Asaad
+# Copyright (c) 2026 Maged Magdy. All rights reserved.
+set -e
+cd "$(dirname "$0")/../../.."
+BUILD=$(mktemp -d)
+trap 'rm -rf "$BUILD"' EXIT
+gcc -O2 -DHOST_BUILD -o "$BUILD/replay" HOST/REPLAY/*.c HOST/HOST_Program.c APP/APP_Program.c ECUAL/*/*_Program.c MCAL/*/*_Program.c SERVICES/*/*_Program.c -lm
+for LIST in HOST/REPLAY/corpus/*.txt; do
+	"$BUILD/replay" record "$LIST" "${LIST%.txt}.tlev"
+done
+"$BUILD/replay" run "$@" HOST/REPLAY/corpus/*.tlev
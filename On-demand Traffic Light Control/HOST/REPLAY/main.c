@@ -0,0 +1,257 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "replay" host tool, used for deterministic regression runs of the application.
+ * It feeds recorded input events into the unmodified APP logic running on the host backend in virtual time,
+ * writes the resulting lamp timeline, and compares it with a golden timeline.
+ * Recordings are replayed in parallel, one process per recording (the firmware keeps its state in globals).
+ * Usage:
+ *   replay record <events.txt> <events.tlev>   convert a text event list to a recording
+ *   replay dump <events.tlev>                  print a recording as a text event list
+ *   replay run [-j jobs] [-u] [-t seconds] <events.tlev>...
+ *       replays each recording until its end event (or the time limit, default 3600 s),
+ *       writes <events.tlev>.out and compares it with <events.tlev>.golden (-u writes the golden file instead)
+ * Text event list: one event per line "<time in ms> <event> [pin]", '#' starts a comment
+ *   events: rise, fall, pulse, press (pulse on INT0), reset, watchdog (watchdog reset), end
+ *   pins: INT0, INT1, INT2, T0, T1
+ * Timeline: one line per change "<time in ms> car=RYG ped=RYG", a lamp is '-' when off,
+ * its upper case letter when on and its lower case letter when flashing.
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "REPLAY_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+// Letters of the lamps reported in the timeline, in the order of the lamps of the first site (APP_Signals.h)
+static const char lampNames[APP_LAMP_NUM] = {'R', 'Y', 'G', 'R', 'Y', 'G'};
+
+static const char* pinNames[HOST_PIN_NUM] = {"INT0", "INT1", "INT2", "T0", "T1"};
+static const char* eventNames[16] = {NULL, "rise", "fall", "pulse", "reset", [HOST_EV_WATCHDOG] = "watchdog"};
+
+/************************************************************************/
+/*                       Timeline                                       */
+/************************************************************************/
+
+// The outputs change one write at a time, only the state reached at the end of each instant is written
+typedef struct {
+	FILE* file;
+	char last[16];
+	char pending[16];
+	uint64_t pendingTime;
+} ST_Timeline_t;
+
+static void TimelineFlush(ST_Timeline_t* timeline){
+	if(!timeline->pending[0] || !strcmp(timeline->pending, timeline->last)) return;
+	strcpy(timeline->last, timeline->pending);
+	fprintf(timeline->file, "%llu.%03llu car=%.3s ped=%.3s\n", (unsigned long long)(timeline->pendingTime / 1000),
+	        (unsigned long long)(timeline->pendingTime % 1000), timeline->last, timeline->last + 3);
+}
+
+static void TimelineOutput(uint64_t now, void* arg){
+	ST_Timeline_t* timeline = (ST_Timeline_t*)arg;
+	if(now != timeline->pendingTime) TimelineFlush(timeline);
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++){
+		const ST_AppLamp_t* LOC_PtrLamp = &APP_Sites[0].lamps[i];
+		char c = '-';
+		switch(HOST_Lamp(LOC_PtrLamp->port, LOC_PtrLamp->pin)){
+			case HOST_LAMP_ON: c = lampNames[i]; break;
+			case HOST_LAMP_FLASH: c = lampNames[i] - 'A' + 'a'; break;
+		}
+		timeline->pending[i] = c;
+	}
+	timeline->pending[APP_LAMP_NUM] = 0;
+	timeline->pendingTime = now;
+}
+
+/************************************************************************/
+/*                       Commands                                       */
+/************************************************************************/
+
+static int Record(const char* in, const char* out){
+	FILE* text = fopen(in, "r");
+	ST_ReplayFile_t rec;
+	char line[256];
+	unsigned lineNo = 0;
+	if(!text || !REPLAY_OpenWrite(&rec, out)){
+		fprintf(stderr, "replay: can not open %s or %s\n", in, out);
+		return 2;
+	}
+	while(fgets(line, sizeof(line), text)){
+		char name[16] = "", pin[16] = "INT0";
+		double ms;
+		ST_HostEvent_t event;
+		uint8_t type = 0, pinId = HOST_PIN_NUM;
+		lineNo++;
+		char* hash = strchr(line, '#');
+		if(hash) *hash = 0;
+		int n = sscanf(line, "%lf %15s %15s", &ms, name, pin);
+		if(n <= 0) continue;
+		if(n < 2 || ms < 0){
+			fprintf(stderr, "%s:%u: expected '<time in ms> <event> [pin]'\n", in, lineNo);
+			return 2;
+		}
+		if(!strcmp(name, "press")) type = HOST_EV_PULSE;
+		else if(!strcmp(name, "end")) type = HOST_EV_END;
+		else for(uint8_t i=1; i<16; i++) if(eventNames[i] && !strcmp(name, eventNames[i])) type = i;
+		for(uint8_t i=0; i<HOST_PIN_NUM; i++) if(!strcmp(pin, pinNames[i])) pinId = i;
+		if(!type || ((HOST_EV_RISE == type || HOST_EV_FALL == type || HOST_EV_PULSE == type) && HOST_PIN_NUM == pinId)){
+			fprintf(stderr, "%s:%u: unknown event '%s %s'\n", in, lineNo, name, pin);
+			return 2;
+		}
+		event.time = (uint64_t)(ms * 1000 + 0.5);
+		event.code = HOST_EV_CODE(type, (HOST_EV_RESET == type || HOST_EV_WATCHDOG == type || HOST_EV_END == type) ? 0 : pinId);
+		if(!REPLAY_Write(&rec, &event)){
+			fprintf(stderr, "%s:%u: events must be in time order\n", in, lineNo);
+			return 2;
+		}
+	}
+	fclose(text);
+	REPLAY_Close(&rec);
+	return 0;
+}
+
+static int Dump(const char* path){
+	ST_ReplayFile_t rec;
+	ST_HostEvent_t event;
+	if(!REPLAY_OpenRead(&rec, path)){
+		fprintf(stderr, "replay: %s is not a recording\n", path);
+		return 2;
+	}
+	while(REPLAY_Read(&rec, &event)){
+		uint8_t type = HOST_EV_TYPE(event.code), pin = HOST_EV_PIN(event.code);
+		printf("%llu.%03llu ", (unsigned long long)(event.time / 1000), (unsigned long long)(event.time % 1000));
+		if(HOST_EV_END == type) printf("end\n");
+		else if(HOST_EV_RESET == type || HOST_EV_WATCHDOG == type) printf("%s\n", eventNames[type]);
+		else printf("%s %s\n", eventNames[type] ? eventNames[type] : "?", pin < HOST_PIN_NUM ? pinNames[pin] : "?");
+	}
+	REPLAY_Close(&rec);
+	return 0;
+}
+
+/*
+ * Compares two text files line by line.
+ * Return value: 0 if equal, otherwise the number of the first different line
+ */
+static unsigned Compare(const char* a, const char* b){
+	FILE* fa = fopen(a, "r");
+	FILE* fb = fopen(b, "r");
+	char la[128], lb[128];
+	unsigned lineNo = 0, diff = 0;
+	if(!fa || !fb) diff = 1;
+	while(!diff){
+		char* ra = fgets(la, sizeof(la), fa);
+		char* rb = fgets(lb, sizeof(lb), fb);
+		lineNo++;
+		if(!ra && !rb) break;
+		if(!ra || !rb || strcmp(la, lb)) diff = lineNo;
+	}
+	if(fa) fclose(fa);
+	if(fb) fclose(fb);
+	return diff;
+}
+
+static void Loop(void){
+	APP_Start();
+}
+
+/*
+ * Replays one recording (in its own process).
+ * Return value: 0 pass, 1 timeline differs from the golden file, 2 error
+ */
+static int ReplayOne(const char* path, uint8_t update, uint64_t limit){
+	char outPath[512], goldenPath[512];
+	ST_ReplayFile_t rec;
+	ST_Timeline_t timeline = {NULL, "", "", 0};
+	snprintf(outPath, sizeof(outPath), "%s.out", path);
+	snprintf(goldenPath, sizeof(goldenPath), "%s.golden", path);
+	if(!REPLAY_OpenRead(&rec, path)){
+		printf("ERROR %s: not a recording\n", path);
+		return 2;
+	}
+	timeline.file = fopen(outPath, "w");
+	if(!timeline.file){
+		printf("ERROR %s: can not write %s\n", path, outPath);
+		return 2;
+	}
+	HOST_SetInput(REPLAY_Input, &rec);
+	HOST_SetOutput(TimelineOutput, &timeline);
+	HOST_Run(APP_Init, Loop, limit);
+	TimelineFlush(&timeline);
+	fprintf(timeline.file, "%llu.%03llu end\n", (unsigned long long)(HOST_Time / 1000), (unsigned long long)(HOST_Time % 1000));
+	fclose(timeline.file);
+	REPLAY_Close(&rec);
+
+	if(update){
+		if(rename(outPath, goldenPath)){
+			printf("ERROR %s: can not write %s\n", path, goldenPath);
+			return 2;
+		}
+		printf("UPDATED %s (%u events)\n", path, rec.count);
+		return 0;
+	}
+	if(access(goldenPath, R_OK)){
+		printf("NOGOLDEN %s\n", path);
+		return 2;
+	}
+	unsigned diff = Compare(outPath, goldenPath);
+	if(diff){
+		printf("FAIL %s: timeline differs from golden at line %u\n", path, diff);
+		return 1;
+	}
+	printf("PASS %s (%u events, %.1f s virtual)\n", path, rec.count, HOST_Time / 1e6);
+	return 0;
+}
+
+static int Run(int argc, char** argv){
+	long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	uint8_t update = 0;
+	uint64_t limit = 3600ULL * 1000000ULL;
+	int opt, running = 0, failed = 0, status;
+	while(-1 != (opt = getopt(argc, argv, "j:ut:"))){
+		switch(opt){
+			case 'j': jobs = atol(optarg); break;
+			case 'u': update = 1; break;
+			case 't': limit = (uint64_t)(atof(optarg) * 1e6); break;
+			default: return 2;
+		}
+	}
+	if(jobs < 1) jobs = 1;
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	for(int i=optind; i<argc || running; ){
+		if(i < argc && running < jobs){
+			pid_t pid = fork();
+			if(0 == pid) exit(ReplayOne(argv[i], update, limit));
+			if(pid < 0){ perror("fork"); return 2; }
+			running++;
+			i++;
+			continue;
+		}
+		if(wait(&status) > 0){
+			running--;
+			if(!WIFEXITED(status) || WEXITSTATUS(status)) failed++;
+		}
+	}
+	printf("%d of %d recordings failed\n", failed, argc - optind);
+	return failed ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+	if(argc >= 4 && !strcmp(argv[1], "record")) return Record(argv[2], argv[3]);
+	if(argc == 3 && !strcmp(argv[1], "dump")) return Dump(argv[2]);
+	if(argc >= 3 && !strcmp(argv[1], "run")) return Run(argc - 1, argv + 1);
+	fprintf(stderr, "usage: replay record <events.txt> <events.tlev>\n"
+	                "       replay dump <events.tlev>\n"
+	                "       replay run [-j jobs] [-u] [-t seconds] <events.tlev>...\n");
+	return 2;
+}
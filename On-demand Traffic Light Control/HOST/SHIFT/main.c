@@ -0,0 +1,110 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "shiftsim" host tool, which checks the shift register output expansion (ECUAL/SHIFT)
+ * against the signal heads it repeats.
+ * The unmodified firmware runs on the host backend for a number of virtual minutes with button presses arriving
+ * at random (Poisson arrivals, fixed seed). The backend shifts the SPI bytes into a chain of 74HC595 registers.
+ * At each latch pulse the outputs of the chain are compared with the lamps on the port pins: the red and green lamps
+ * must match, a yellow output may only be on while its lamp flashes.
+ * The tool counts the latch pulses per half second (at most one), the delay of each latch after the start of its
+ * half second, and the frame counters of the driver (the CPU time of the frames is only measured on the target).
+ * Usage:
+ *   shiftsim [-m minutes] [-r presses per hour] [-s seed]
+ *     defaults: 60 minutes, 60 presses per hour, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#define HALF_SEC        500000ULL
+
+// Options
+static double minutes = 60, pressRate = 60;
+
+// Simulation
+static ST_HostPresses_t presses;
+static uint64_t endTime;
+static ST_ShiftStats_t stats;
+
+// Latch pulses
+static uint8_t latchOn;
+static uint64_t latches, mismatches, lastHalf = UINT64_MAX, doubles, maxDelay;
+static uint8_t yellowOn;
+static uint64_t yellowFlashes;
+
+/*
+ * Output observer: checks the chain at each rising edge of the latch pin.
+ */
+static void Output(uint64_t now, void* arg){
+	(void)arg;
+	uint8_t LOC_U8Latch = HOST_LAMP_ON == HOST_Lamp(SHIFT_LATCH_PORT, SHIFT_LATCH_PIN);
+	if(LOC_U8Latch && !latchOn){
+		latches++;
+		uint64_t LOC_U64Half = now / HALF_SEC;
+		if(LOC_U64Half == lastHalf) doubles++;
+		lastHalf = LOC_U64Half;
+		if(now % HALF_SEC > maxDelay) maxDelay = now % HALF_SEC;
+		// Each lamp of the first site is repeated on the chain output APP_Sites[0].output + lamp
+		for(uint8_t i=0; i<APP_LAMP_NUM; i++){
+			uint8_t LOC_U8Output = APP_Sites[0].output + i;
+			uint8_t LOC_U8Out = (HOST_Shift(LOC_U8Output >> 3) >> (LOC_U8Output & 0x07)) & 1;
+			uint8_t LOC_U8Lamp = HOST_Lamp(APP_Sites[0].lamps[i].port, APP_Sites[0].lamps[i].pin);
+			if(HOST_LAMP_FLASH == LOC_U8Lamp) continue;
+			if(LOC_U8Out != (HOST_LAMP_ON == LOC_U8Lamp)){
+				if(mismatches < 10) printf("mismatch at %.3f s: output %u is %u, lamp %u\n", now / 1e6, LOC_U8Output, LOC_U8Out, LOC_U8Lamp);
+				mismatches++;
+			}
+		}
+		uint8_t LOC_U8Yellow = (HOST_Shift((APP_Sites[0].output + APP_LAMP_CAR_YELLOW) >> 3) >> ((APP_Sites[0].output + APP_LAMP_CAR_YELLOW) & 0x07)) & 1;
+		if(LOC_U8Yellow && !yellowOn) yellowFlashes++;
+		yellowOn = LOC_U8Yellow;
+	}
+	latchOn = LOC_U8Latch;
+}
+
+static void Done(void){
+	SHIFT_GetStats(&stats);
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "m:r:s:", Option, "shiftsim [-m minutes] [-r presses per hour] [-s seed]") < 0) return 2;
+	if(minutes <= 0 || minutes > 60 * 24 * 7){
+		fprintf(stderr, "shiftsim: the duration must be from 0 to 7 days\n");
+		return 2;
+	}
+
+	endTime = (uint64_t)(minutes * 60e6);
+	HOST_PressStart(&presses, pressRate, endTime);
+	HOST_SetInput(HOST_PressInput, &presses);
+	HOST_SetOutput(Output, NULL);
+	HOST_Simulate(APP_Init, APP_Start, Done, endTime);
+
+	uint64_t LOC_U64Halves = endTime / HALF_SEC;
+	printf("%.0f minutes, %llu presses, %u registers (%u outputs)\n", minutes, (unsigned long long)presses.count, SHIFT_CHIPS, SHIFT_OUTPUTS);
+	printf("%llu half seconds, %llu latch pulses (%.1f %%), %llu in the same half second as the previous one, %llu yellow flashes\n",
+	       (unsigned long long)LOC_U64Halves, (unsigned long long)latches, 100.0 * latches / LOC_U64Halves,
+	       (unsigned long long)doubles, (unsigned long long)yellowFlashes);
+	printf("latest latch %.3f ms after the start of its half second\n", maxDelay / 1e3);
+	printf("driver counters (saturating): %u frames, %u commits unchanged, %u deferred\n",
+	       stats.frames, stats.unchanged, stats.deferred);
+	printf("%llu outputs different from their lamp at the latch\n", (unsigned long long)mismatches);
+	return (mismatches || doubles) ? 1 : 0;
+}
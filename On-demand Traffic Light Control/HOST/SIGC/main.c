@@ -0,0 +1,702 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "sigc" host tool, the signal plan compiler. It reads the intersection description
+ * (APP/APP_Signals.txt: lamps, approaches and crossings, conflicts, clearance, sequences of steps, fail-safe lamps),
+ * checks it and writes the constant tables used by the application (APP/APP_Signals.h), so the firmware
+ * does not check anything at runtime. The checks are:
+ *   - the lamps are on free pins: not on the pins of the other drivers, the flash lamps on the Timer1 compare outputs
+ *   - each lamp belongs to one signal, and each signal shows a lamp in each step, never its red and green together
+ *   - the greens of two conflicting signals are never lit together
+ *   - the end of the green of a signal is followed by the clearance before the green of a conflicting signal, on every
+ *     path: the end of a sequence, the press that leaves the normal sequence at any step (counted as 0),
+ *     and each step lasting the shortest duration a plan can give (PLAN_MIN_HALF_SECS)
+ *   - the normal sequence has one green of the main approach, the plan phases are used once
+ *   - the other intersections of the same design (sites) give a free pin to each lamp and have their own button
+ *   - the sensed lamps of the first intersection are steady, with their own ADC channel on a free pin of PORTA
+ * The tables are compact: the aspects (lamps lit) of the steps are deduplicated, and the steady lamps are packed
+ * into one mask per port, so an aspect is applied with one write per port (the tables of each site are packed for its pins).
+ * Usage:
+ *   sigc <description> [header]
+ *     writes the header (default: standard output) only if the description is correct
+ * Exit status: 0 written, 1 error in the description, 2 file error.
+ * Build: see the "Signal Plan Compiler" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include "../../SERVICES/PLAN/PLAN_Interface.h"
+
+#define MAX_NAME    32
+#define MAX_LAMPS   16  // lamps in a step are a 16-bit mask
+#define MAX_FLASH   8   // flash bits of an aspect
+#define MAX_SIGNALS 8
+#define MAX_TOKENS  20
+#define MAX_SITES   3   // one button interrupt each (INT0, INT1, INT2)
+#define MAX_SENSE   8   // ADC channels (PIN 0 to PIN 7 in PORTA)
+#define SEQ_NORMAL     0
+#define SEQ_PEDESTRIAN 1
+#define SEQ_NUM        2
+
+typedef struct {
+	char name[MAX_NAME];
+	uint8_t port, pin;
+	uint8_t flash; // flash bit (1 << k), 0 for a steady lamp
+	int line;
+} ST_Lamp_t;
+
+// Another intersection of the same design: the pins of the lamps (same order as lamps) and the button
+typedef struct {
+	char name[MAX_NAME];
+	uint8_t button; // 1: INT1, 2: INT2
+	uint8_t port[MAX_LAMPS], pin[MAX_LAMPS];
+	int pinLine[MAX_LAMPS]; // 0 if the lamp has no pin yet
+	int line;
+} ST_Site_t;
+
+typedef struct {
+	char name[MAX_NAME];
+	uint8_t crossing;
+	uint8_t red, yellow, green; // lamp indexes
+} ST_Signal_t;
+
+typedef struct {
+	uint8_t phase;
+	uint16_t lit; // lamps lit (bit i for lamp i)
+	uint8_t aspect;
+	int line;
+} ST_Step_t;
+
+typedef struct {
+	ST_Step_t steps[PLAN_PHASE_NUM];
+	uint8_t num;
+	int line;
+} ST_Sequence_t;
+
+// Plan phase names, in the order of EN_PlanPhase_t
+static const char* const phaseNames[] = {"GREEN", "YELLOW", "RED", "YELLOW_2", "PED_YELLOW", "PED_WALK", "PED_CLEAR"};
+typedef char phaseNamesCheck[(sizeof(phaseNames) / sizeof(phaseNames[0]) == PLAN_PHASE_NUM) ? 1 : -1];
+static const char* const seqNames[SEQ_NUM] = {"NORMAL", "PEDESTRIAN"};
+static const char* const seqTables[SEQ_NUM] = {"APP_Normal", "APP_Pedestrian"};
+static const char* const statsNames[] = {"STATS_GREEN", "STATS_YELLOW", "STATS_RED"};
+
+// Pins of the other drivers
+static const struct {
+	uint8_t port, pin;
+	const char* use;
+} reserved[] = {
+	{1, 0, "the vehicle detector (T0)"}, {1, 4, "the shift register latch (SS)"}, {1, 5, "the SPI (MOSI)"},
+	{1, 6, "the SPI (MISO)"}, {1, 7, "the SPI (SCK)"}, {3, 0, "the serial port (RXD)"}, {3, 1, "the serial port (TXD)"},
+	{3, 2, "the button (INT0)"}, {3, 3, "the 1PPS input (INT1)"}, {3, 6, "the latency capture (ICP1)"},
+	{2, 0xFF, "the countdown display or the TWI"},
+};
+
+static const char* fileName;
+static int errors;
+
+static ST_Lamp_t lamps[MAX_LAMPS];
+static uint8_t lampNum, flashNum;
+static ST_Signal_t signals[MAX_SIGNALS];
+static uint8_t signalNum;
+static uint8_t conflicts[MAX_SIGNALS][MAX_SIGNALS];
+static int clearance = -1;
+static ST_Sequence_t sequences[SEQ_NUM];
+static int seqLine[SEQ_NUM];
+static uint16_t failSafe;
+static int failSafeLine;
+static ST_Site_t sites[MAX_SITES - 1]; // the first intersection is given by the lamps
+static uint8_t siteNum;
+static struct {
+	uint8_t lamp, channel;
+	int line;
+} senses[MAX_SENSE]; // lamps of the first intersection sensed by the lamp monitor
+static uint8_t senseNum;
+
+// Aspects: port values (A to D) and flash bits, the dark aspect first
+static uint8_t aspects[1 + SEQ_NUM * PLAN_PHASE_NUM + 1][5];
+static uint16_t aspectLit[1 + SEQ_NUM * PLAN_PHASE_NUM + 1]; // lamps lit in each aspect
+static uint8_t aspectNum;
+static uint8_t portMask[4];
+static const uint8_t buttonPins[MAX_SITES][2] = {{3, 2}, {3, 3}, {1, 2}}; // INT0 (PD2), INT1 (PD3), INT2 (PB2)
+
+static void Error(int line, const char* format, ...) __attribute__((format(printf, 2, 3)));
+static void Error(int line, const char* format, ...){
+	va_list args;
+	va_start(args, format);
+	fprintf(stderr, "%s:%d: ", fileName, line);
+	vfprintf(stderr, format, args);
+	fputc('\n', stderr);
+	va_end(args);
+	errors++;
+}
+
+static int FindLamp(const char* name){
+	for(int i=0; i<lampNum; i++) if(!strcmp(lamps[i].name, name)) return i;
+	return -1;
+}
+
+static int FindSignal(const char* name){
+	for(int i=0; i<signalNum; i++) if(!strcmp(signals[i].name, name)) return i;
+	return -1;
+}
+
+/************************************************************************/
+/*                            Parser                                    */
+/************************************************************************/
+
+static uint8_t ParsePin(int line, const char* name, const char* portText, const char* pinText, uint8_t* port, uint8_t* pin){
+	*port = (uint8_t)(toupper((unsigned char)portText[0]) - 'A');
+	if(portText[1] || *port > 3 || !isdigit((unsigned char)pinText[0]) || pinText[1] || pinText[0] > '7'){
+		Error(line, "lamp %s: bad port or pin", name);
+		return 0;
+	}
+	*pin = (uint8_t)(pinText[0] - '0');
+	return 1;
+}
+
+static void CheckReserved(int line, const char* name, uint8_t port, uint8_t pin){
+	for(size_t i=0; i<sizeof(reserved)/sizeof(reserved[0]); i++){
+		if(reserved[i].port == port && (0xFF == reserved[i].pin || reserved[i].pin == pin)){
+			Error(line, "lamp %s: PIN %u in PORT%c is used by %s", name, pin, 'A' + port, reserved[i].use);
+		}
+	}
+}
+
+static void ParseLamp(int line, char** tok, int n){
+	if(n < 4 || n > 5 || (5 == n && strcmp(tok[4], "flash"))){ Error(line, "usage: lamp <name> <port A-D> <pin 0-7> [flash]"); return; }
+	if(lampNum == MAX_LAMPS){ Error(line, "more than %d lamps", MAX_LAMPS); return; }
+	if(FindLamp(tok[1]) >= 0){ Error(line, "lamp %s already defined", tok[1]); return; }
+	uint8_t port, pin;
+	if(!ParsePin(line, tok[1], tok[2], tok[3], &port, &pin)) return;
+	ST_Lamp_t* l = &lamps[lampNum];
+	snprintf(l->name, sizeof(l->name), "%s", tok[1]);
+	l->port = port;
+	l->pin = pin;
+	l->line = line;
+	uint8_t oc = (3 == l->port && (4 == l->pin || 5 == l->pin));
+	if(5 == n){
+		if(!oc) Error(line, "lamp %s: only PIN 5 (OC1A) and PIN 4 (OC1B) in PORTD can flash", l->name);
+		if(flashNum == MAX_FLASH) Error(line, "more than %d flash lamps", MAX_FLASH);
+		else l->flash = (uint8_t)(1 << flashNum++);
+	}
+	else if(oc) Error(line, "lamp %s: PIN %u in PORTD is a flasher output, the lamp must flash", l->name, l->pin);
+	CheckReserved(line, l->name, l->port, l->pin);
+	for(int i=0; i<lampNum; i++){
+		if(lamps[i].port == l->port && lamps[i].pin == l->pin) Error(line, "lamp %s: same pin as lamp %s", l->name, lamps[i].name);
+	}
+	lampNum++;
+}
+
+static void ParseSite(int line, char** tok, int n){
+	if(3 != n || (strcmp(tok[2], "INT1") && strcmp(tok[2], "INT2"))){ Error(line, "usage: site <name> INT1|INT2"); return; }
+	if(!lampNum){ Error(line, "the lamps must be defined before the sites"); return; }
+	if(siteNum == MAX_SITES - 1){ Error(line, "more than %d intersections", MAX_SITES); return; }
+	for(const char* c = tok[1]; *c; c++){
+		if(!isalnum((unsigned char)*c) && '_' != *c){ Error(line, "site %s: letters, digits and _ only", tok[1]); return; }
+	}
+	ST_Site_t* st = &sites[siteNum];
+	snprintf(st->name, sizeof(st->name), "%s", tok[1]);
+	st->button = (uint8_t)(tok[2][3] - '0');
+	st->line = line;
+	for(int i=0; i<siteNum; i++){
+		if(!strcmp(sites[i].name, st->name)) Error(line, "site %s already defined", st->name);
+		if(sites[i].button == st->button) Error(line, "site %s: INT%u is the button of site %s", st->name, st->button, sites[i].name);
+	}
+	siteNum++;
+}
+
+static void ParseSitePin(int line, ST_Site_t* st, char** tok, int n){
+	if(4 != n){ Error(line, "usage: pin <lamp> <port A-D> <pin 0-7>"); return; }
+	int l = FindLamp(tok[1]);
+	if(l < 0){ Error(line, "unknown lamp %s", tok[1]); return; }
+	if(st->pinLine[l]){ Error(line, "site %s: lamp %s already has a pin", st->name, tok[1]); return; }
+	if(!ParsePin(line, tok[1], tok[2], tok[3], &st->port[l], &st->pin[l])) return;
+	st->pinLine[l] = line;
+}
+
+static void ParseSense(int line, char** tok, int n){
+	if(3 != n || !isdigit((unsigned char)tok[2][0]) || tok[2][1] || tok[2][0] > '7'){ Error(line, "usage: sense <lamp> <ADC channel 0-7>"); return; }
+	int l = FindLamp(tok[1]);
+	if(l < 0){ Error(line, "unknown lamp %s", tok[1]); return; }
+	uint8_t channel = (uint8_t)(tok[2][0] - '0');
+	if(senseNum == MAX_SENSE){ Error(line, "more than %d sensed lamps", MAX_SENSE); return; }
+	if(lamps[l].flash) Error(line, "lamp %s: a flash lamp can not be sensed", tok[1]);
+	for(int i=0; i<senseNum; i++){
+		if(senses[i].lamp == l) Error(line, "lamp %s is already sensed", tok[1]);
+		if(senses[i].channel == channel) Error(line, "ADC channel %u already senses lamp %s", channel, lamps[senses[i].lamp].name);
+	}
+	senses[senseNum].lamp = (uint8_t)l;
+	senses[senseNum].channel = channel;
+	senses[senseNum].line = line;
+	senseNum++;
+}
+
+static void ParseSignal(int line, char** tok, int n){
+	if(5 != n){ Error(line, "usage: %s <name> <red lamp> <yellow lamp> <green lamp>", tok[0]); return; }
+	if(signalNum == MAX_SIGNALS){ Error(line, "more than %d signals", MAX_SIGNALS); return; }
+	if(FindSignal(tok[1]) >= 0){ Error(line, "signal %s already defined", tok[1]); return; }
+	ST_Signal_t* s = &signals[signalNum];
+	snprintf(s->name, sizeof(s->name), "%s", tok[1]);
+	s->crossing = !strcmp(tok[0], "crossing");
+	uint8_t* colors[3] = {&s->red, &s->yellow, &s->green};
+	for(int c=0; c<3; c++){
+		int l = FindLamp(tok[2 + c]);
+		if(l < 0){ Error(line, "unknown lamp %s", tok[2 + c]); return; }
+		for(int i=0; i<signalNum; i++){
+			if(signals[i].red == l || signals[i].yellow == l || signals[i].green == l) Error(line, "lamp %s already belongs to %s", tok[2 + c], signals[i].name);
+		}
+		for(int k=0; k<c; k++) if(*colors[k] == l) Error(line, "lamp %s used twice", tok[2 + c]);
+		*colors[c] = (uint8_t)l;
+	}
+	signalNum++;
+}
+
+static uint16_t ParseLamps(int line, char** tok, int n){
+	uint16_t lit = 0;
+	for(int i=0; i<n; i++){
+		int l = FindLamp(tok[i]);
+		if(l < 0) Error(line, "unknown lamp %s", tok[i]);
+		else lit |= (uint16_t)(1 << l);
+	}
+	return lit;
+}
+
+static int Parse(FILE* f){
+	char buf[512];
+	char* tok[MAX_TOKENS];
+	int line = 0, seq = -1, site = -1;
+	while(fgets(buf, sizeof(buf), f)){
+		line++;
+		char* hash = strchr(buf, '#');
+		if(hash) *hash = 0;
+		int n = 0;
+		for(char* t = strtok(buf, " \t\r\n"); t && n < MAX_TOKENS; t = strtok(NULL, " \t\r\n")) tok[n++] = t;
+		if(!n) continue;
+
+		if(!strcmp(tok[0], "lamp")){
+			if(signalNum || siteNum) Error(line, "the lamps must be defined before the signals and the sites");
+			ParseLamp(line, tok, n);
+		}
+		else if(!strcmp(tok[0], "site")){
+			uint8_t num = siteNum;
+			ParseSite(line, tok, n);
+			site = (siteNum > num) ? siteNum - 1 : -1;
+		}
+		else if(!strcmp(tok[0], "pin")){
+			if(site < 0) Error(line, "pin outside of a site");
+			else ParseSitePin(line, &sites[site], tok, n);
+		}
+		else if(!strcmp(tok[0], "sense")){
+			if(siteNum) Error(line, "the sensed lamps must be defined before the sites");
+			else ParseSense(line, tok, n);
+		}
+		else if(!strcmp(tok[0], "approach") || !strcmp(tok[0], "crossing")) ParseSignal(line, tok, n);
+		else if(!strcmp(tok[0], "conflict")){
+			int a = (3 == n) ? FindSignal(tok[1]) : -1, b = (3 == n) ? FindSignal(tok[2]) : -1;
+			if(a < 0 || b < 0 || a == b) Error(line, "usage: conflict <signal> <signal> (two different signals)");
+			else conflicts[a][b] = conflicts[b][a] = 1;
+		}
+		else if(!strcmp(tok[0], "clearance")){
+			char* end = NULL;
+			long v = (2 == n) ? strtol(tok[1], &end, 10) : -1;
+			if(v < 0 || v > PLAN_MAX_HALF_SECS || (end && *end)) Error(line, "usage: clearance <half seconds>");
+			else clearance = (int)v;
+		}
+		else if(!strcmp(tok[0], "sequence")){
+			seq = -1;
+			for(int s=0; s<SEQ_NUM; s++) if(2 == n && !strcmp(tok[1], seqNames[s])) seq = s;
+			if(seq < 0) Error(line, "usage: sequence NORMAL|PEDESTRIAN");
+			else if(seqLine[seq]){ Error(line, "sequence %s already defined", seqNames[seq]); seq = -1; }
+			else seqLine[seq] = line;
+		}
+		else if(!strcmp(tok[0], "step")){
+			if(seq < 0){ Error(line, "step outside of a sequence"); continue; }
+			int phase = -1;
+			for(int p=0; p<PLAN_PHASE_NUM; p++) if(n > 1 && !strcmp(tok[1], phaseNames[p])) phase = p;
+			if(phase < 0){ Error(line, "usage: step <plan phase> <lamps>..."); continue; }
+			for(int s=0; s<SEQ_NUM; s++){
+				for(int i=0; i<sequences[s].num; i++){
+					if(sequences[s].steps[i].phase == phase) Error(line, "plan phase %s already used", phaseNames[phase]);
+				}
+			}
+			if(sequences[seq].num == PLAN_PHASE_NUM){ Error(line, "too many steps"); continue; }
+			ST_Step_t* st = &sequences[seq].steps[sequences[seq].num++];
+			st->phase = (uint8_t)phase;
+			st->lit = ParseLamps(line, tok + 2, n - 2);
+			st->line = line;
+		}
+		else if(!strcmp(tok[0], "failsafe")){
+			failSafe = ParseLamps(line, tok + 1, n - 1);
+			failSafeLine = line;
+		}
+		else Error(line, "unknown keyword %s", tok[0]);
+	}
+	return line;
+}
+
+/************************************************************************/
+/*                            Checks                                    */
+/************************************************************************/
+
+#define LIT(step, lamp) (((step)->lit >> (lamp)) & 1)
+
+static uint8_t Green(const ST_Step_t* st, int s){ return LIT(st, signals[s].green); }
+static uint8_t Go(const ST_Step_t* st, int s){ return LIT(st, signals[s].green) && !LIT(st, signals[s].yellow); }
+
+// Path followed by the clearance check, for the error message
+static struct {
+	int seq, idx;
+	uint8_t cut; // left by a press
+} path[4 * SEQ_NUM * PLAN_PHASE_NUM];
+
+static const char* PathText(int depth){
+	static char text[1024];
+	size_t len = 0;
+	text[0] = 0;
+	for(int i=0; i<=depth && len < sizeof(text); i++){
+		len += (size_t)snprintf(text + len, sizeof(text) - len, "%s%s", i ? (path[i - 1].cut ? " | press | " : " > ") : "",
+		                        phaseNames[sequences[path[i].seq].steps[path[i].idx].phase]);
+	}
+	return text;
+}
+
+/*
+ * Follows the steps after the end of the green of signal a, until the green of signal b (checked), a new green of a,
+ * or the clearance is reached. acc is the shortest time since the end of the green.
+ */
+static void Clear(int a, int b, int seq, int idx, int acc, int depth){
+	const ST_Step_t* st = &sequences[seq].steps[idx];
+	path[depth].seq = seq;
+	path[depth].idx = idx;
+	if(Green(st, b)){
+		if(acc < clearance){
+			Error(st->line, "%s green %d half seconds after the end of %s green (clearance %d): %s",
+			      signals[b].name, acc, signals[a].name, clearance, PathText(depth));
+		}
+		return;
+	}
+	if(Go(st, a) || acc >= clearance || depth + 1 >= (int)(sizeof(path) / sizeof(path[0]))) return;
+
+	// Step completed at its shortest duration, then the next one
+	path[depth].cut = 0;
+	if(idx + 1 < sequences[seq].num) Clear(a, b, seq, idx + 1, acc + PLAN_MIN_HALF_SECS, depth + 1);
+	else Clear(a, b, SEQ_NORMAL, 0, acc + PLAN_MIN_HALF_SECS, depth + 1);
+
+	// Step left at once by a press
+	path[depth].cut = 1;
+	if(SEQ_NORMAL == seq) Clear(a, b, SEQ_PEDESTRIAN, 0, acc, depth + 1);
+}
+
+static void Check(void){
+	if(!lampNum){ Error(1, "no lamps"); return; }
+	if(!signalNum || signals[0].crossing){ Error(1, "the first signal must be an approach"); return; }
+	if(clearance < 0) Error(1, "no clearance");
+	for(int s=0; s<SEQ_NUM; s++){
+		if(!sequences[s].num) Error(seqLine[s] ? seqLine[s] : 1, "sequence %s has no step", seqNames[s]);
+	}
+	if(errors) return;
+
+	uint16_t signalLamps = 0;
+	for(int s=0; s<signalNum; s++) signalLamps |= (uint16_t)((1 << signals[s].red) | (1 << signals[s].yellow) | (1 << signals[s].green));
+	for(int l=0; l<lampNum; l++) if(!((signalLamps >> l) & 1)) Error(lamps[l].line, "lamp %s belongs to no signal", lamps[l].name);
+
+	// Steps: each signal shows one lamp at least, never red and green, no conflicting greens
+	uint8_t mainGreens = 0;
+	for(int q=0; q<SEQ_NUM; q++){
+		for(int i=0; i<sequences[q].num; i++){
+			const ST_Step_t* st = &sequences[q].steps[i];
+			for(int s=0; s<signalNum; s++){
+				const ST_Signal_t* g = &signals[s];
+				if(!LIT(st, g->red) && !LIT(st, g->yellow) && !LIT(st, g->green)) Error(st->line, "%s shows no lamp", g->name);
+				if(LIT(st, g->red) && LIT(st, g->green)) Error(st->line, "%s shows red and green", g->name);
+				for(int t=s+1; t<signalNum; t++){
+					if(conflicts[s][t] && Green(st, s) && Green(st, t)) Error(st->line, "conflicting greens %s and %s", g->name, signals[t].name);
+				}
+			}
+			if(SEQ_NORMAL == q && Go(st, 0)) mainGreens++;
+		}
+	}
+	if(1 != mainGreens) Error(seqLine[SEQ_NORMAL], "the normal sequence must have one green of %s (not %u)", signals[0].name, mainGreens);
+
+	// Clearance from the end of each green to each conflicting green
+	for(int a=0; a<signalNum; a++){
+		for(int b=0; b<signalNum; b++){
+			if(!conflicts[a][b]) continue;
+			for(int q=0; q<SEQ_NUM; q++){
+				for(int i=0; i<sequences[q].num; i++){
+					if(!Go(&sequences[q].steps[i], a)) continue;
+					// the green ends with the step, or when a press leaves the normal sequence
+					path[0].seq = q;
+					path[0].idx = i;
+					path[0].cut = 0;
+					if(i + 1 < sequences[q].num) Clear(a, b, q, i + 1, 0, 1);
+					else Clear(a, b, SEQ_NORMAL, 0, 0, 1);
+					path[0].cut = 1;
+					if(SEQ_NORMAL == q) Clear(a, b, SEQ_PEDESTRIAN, 0, 0, 1);
+				}
+			}
+		}
+	}
+
+	// Fail-safe: flash lamps only
+	for(int l=0; l<lampNum; l++){
+		if(((failSafe >> l) & 1) && !lamps[l].flash) Error(failSafeLine, "fail-safe lamp %s is not a flash lamp", lamps[l].name);
+	}
+
+	// Sites: a free pin for each lamp, the flashers of the first intersection and the buttons excluded
+	for(int k=0; k<siteNum; k++){
+		ST_Site_t* st = &sites[k];
+		for(int l=0; l<lampNum; l++){
+			if(!st->pinLine[l]){ Error(st->line, "site %s: no pin for lamp %s", st->name, lamps[l].name); continue; }
+			int line = st->pinLine[l];
+			uint8_t port = st->port[l], pin = st->pin[l];
+			CheckReserved(line, lamps[l].name, port, pin);
+			if(3 == port && (4 == pin || 5 == pin)) Error(line, "lamp %s: PIN %u in PORTD is a flasher output of the first intersection", lamps[l].name, pin);
+			for(int i=0; i<lampNum; i++){
+				if(lamps[i].port == port && lamps[i].pin == pin) Error(line, "lamp %s: same pin as lamp %s of the first intersection", lamps[l].name, lamps[i].name);
+			}
+			for(int j=0; j<=k; j++){
+				for(int i=0; i<((j == k) ? l : lampNum); i++){
+					if(sites[j].pinLine[i] && sites[j].port[i] == port && sites[j].pin[i] == pin){
+						Error(line, "lamp %s: same pin as lamp %s of site %s", lamps[l].name, lamps[i].name, sites[j].name);
+					}
+				}
+			}
+		}
+	}
+	for(int k=0; k<siteNum; k++){
+		const uint8_t* b = buttonPins[sites[k].button];
+		for(int l=0; l<lampNum; l++){
+			if(lamps[l].port == b[0] && lamps[l].pin == b[1]) Error(sites[k].line, "site %s: the button pin of INT%u is lamp %s", sites[k].name, sites[k].button, lamps[l].name);
+			for(int j=0; j<siteNum; j++){
+				if(sites[j].pinLine[l] && sites[j].port[l] == b[0] && sites[j].pin[l] == b[1]){
+					Error(sites[k].line, "site %s: the button pin of INT%u is lamp %s of site %s", sites[k].name, sites[k].button, lamps[l].name, sites[j].name);
+				}
+			}
+		}
+	}
+
+	// Sensed lamps: the ADC channel (PIN n in PORTA) is not a lamp pin
+	for(int i=0; i<senseNum; i++){
+		for(int l=0; l<lampNum; l++){
+			if(0 == lamps[l].port && lamps[l].pin == senses[i].channel){
+				Error(senses[i].line, "ADC channel %u: PIN %u in PORTA is lamp %s", senses[i].channel, senses[i].channel, lamps[l].name);
+			}
+			for(int k=0; k<siteNum; k++){
+				if(sites[k].pinLine[l] && 0 == sites[k].port[l] && sites[k].pin[l] == senses[i].channel){
+					Error(senses[i].line, "ADC channel %u: PIN %u in PORTA is lamp %s of site %s", senses[i].channel, senses[i].channel, lamps[l].name, sites[k].name);
+				}
+			}
+		}
+	}
+}
+
+/************************************************************************/
+/*                            Tables                                    */
+/************************************************************************/
+
+static uint8_t Aspect(uint16_t lit){
+	uint8_t a[5] = {0};
+	for(int l=0; l<lampNum; l++){
+		if(!((lit >> l) & 1)) continue;
+		if(lamps[l].flash) a[4] |= lamps[l].flash;
+		else a[lamps[l].port] |= (uint8_t)(1 << lamps[l].pin);
+	}
+	for(uint8_t i=0; i<aspectNum; i++) if(!memcmp(aspects[i], a, sizeof(a))) return i;
+	memcpy(aspects[aspectNum], a, sizeof(a));
+	aspectLit[aspectNum] = lit;
+	return aspectNum++;
+}
+
+static void Upper(char* dst, const char* src){
+	while(*src) *dst++ = (char)toupper((unsigned char)*src++);
+	*dst = 0;
+}
+
+static void Write(FILE* out, const char* description){
+	char name[MAX_NAME];
+	uint8_t ports = 0;
+	for(int l=0; l<lampNum; l++) if(!lamps[l].flash) portMask[lamps[l].port] |= (uint8_t)(1 << lamps[l].pin);
+	for(int p=0; p<4; p++) if(portMask[p]) ports++;
+
+	aspectNum = 0;
+	Aspect(0); // dark
+	for(int q=0; q<SEQ_NUM; q++) for(int i=0; i<sequences[q].num; i++) sequences[q].steps[i].aspect = Aspect(sequences[q].steps[i].lit);
+	uint8_t failSafeAspect = Aspect(failSafe);
+
+	fprintf(out, "/*\n * File: APP_Signals.h\n *\n * Description:\n"
+	        " * This header file contains the signal tables of the application, generated by the sigc host tool (HOST/SIGC)\n"
+	        " * from %s: do not edit it, change the description and run sigc again.\n"
+	        " * The description was checked by sigc (conflicts, clearance, pins), the application does not check the tables.\n"
+	        " * It is only included by APP_Program.c (and the host tools).\n *\n"
+	        " * Created on: Oct 19, 2026\n * Author: Maged Magdy Asaad\n"
+	        " * Copyright (c) 2026 Maged Magdy. All rights reserved.\n"
+	        " */\n\n#ifndef APP_SIGNALS_H\n#define APP_SIGNALS_H\n\n#include \"APP_Interface.h\"\n\n", description);
+
+	fprintf(out, "// Lamps, the index is also the shift register output\n");
+	for(int l=0; l<lampNum; l++){
+		Upper(name, lamps[l].name);
+		fprintf(out, "#define APP_LAMP_%-12s %d\n", name, l);
+	}
+	fprintf(out, "#define APP_LAMP_NUM          %d\n", lampNum);
+	fprintf(out, "#define APP_MAIN_RED          APP_LAMP_");
+	Upper(name, lamps[signals[0].red].name);
+	fprintf(out, "%s // main approach\n#define APP_MAIN_GREEN        APP_LAMP_", name);
+	Upper(name, lamps[signals[0].green].name);
+	fprintf(out, "%s\n\n", name);
+	fprintf(out, "static const ST_AppLamp_t APP_Lamps[APP_LAMP_NUM] = {\n");
+	for(int l=0; l<lampNum; l++){
+		fprintf(out, "\t{PORT%c, PIN%u, 0x%02X}, // %s\n", 'A' + lamps[l].port, lamps[l].pin, lamps[l].flash, lamps[l].name);
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "// Ports of the steady lamps and their pins\n#define APP_PORT_NUM %u\n\n", ports);
+	fprintf(out, "static const ST_AppPort_t APP_Ports[APP_PORT_NUM] = {");
+	for(int p=0, k=0; p<4; p++) if(portMask[p]) fprintf(out, "%s{PORT%c, 0x%02X}", k++ ? ", " : "", 'A' + p, portMask[p]);
+	fprintf(out, "};\n\n");
+
+	fprintf(out, "// Aspects: the pins lit in each port (APP_Ports order), then the flash bits of the lamps flashing\n");
+	fprintf(out, "#define APP_ASPECT_DARK      0\n#define APP_ASPECT_FAIL_SAFE %u\n#define APP_ASPECT_NUM       %u\n\n", failSafeAspect, aspectNum);
+	fprintf(out, "static const uint8_t APP_Aspects[APP_ASPECT_NUM][APP_PORT_NUM + 1] = {\n");
+	for(uint8_t a=0; a<aspectNum; a++){
+		fprintf(out, "\t{");
+		for(int p=0; p<4; p++) if(portMask[p]) fprintf(out, "0x%02X, ", aspects[a][p]);
+		fprintf(out, "0x%02X}, //", aspects[a][4]);
+		if(!a) fprintf(out, " dark");
+		for(int q=0; q<SEQ_NUM; q++){
+			for(int i=0; i<sequences[q].num; i++) if(sequences[q].steps[i].aspect == a) fprintf(out, " %s", phaseNames[sequences[q].steps[i].phase]);
+		}
+		if(failSafeAspect == a) fprintf(out, " fail-safe");
+		fprintf(out, "\n");
+	}
+	fprintf(out, "};\n\n");
+	unsigned bytes = 3U * lampNum + 2U * ports + (ports + 1U) * aspectNum;
+
+	// Sensed lamps: channels, lamps, and the sensed lamps lit in each aspect and the reds (bit n: the lamp on channel n of the list)
+	uint8_t reds = 0;
+	for(int i=0; i<senseNum; i++){
+		for(int s=0; s<signalNum; s++) if(signals[s].red == senses[i].lamp) reds |= (uint8_t)(1 << i);
+	}
+	fprintf(out, "// Sensed lamps of the first intersection (LMON): ADC channel and lamp of each one, the sensed lamps lit in each aspect\n");
+	fprintf(out, "// and the reds (bit n: the lamp sensed on channel n of the list)\n#define APP_SENSE_NUM  %u\n", senseNum);
+	if(senseNum){
+		fprintf(out, "#define APP_SENSE_REDS 0x%02X\n\nstatic const uint8_t APP_SenseChannels[APP_SENSE_NUM] = {", reds);
+		for(int i=0; i<senseNum; i++) fprintf(out, "%s%u", i ? ", " : "", senses[i].channel);
+		fprintf(out, "};\nstatic const uint8_t APP_SenseLamps[APP_SENSE_NUM] = {");
+		for(int i=0; i<senseNum; i++){
+			Upper(name, lamps[senses[i].lamp].name);
+			fprintf(out, "%sAPP_LAMP_%s", i ? ", " : "", name);
+		}
+		fprintf(out, "};\nstatic const uint8_t APP_SenseLit[APP_ASPECT_NUM] = {");
+		for(uint8_t a=0; a<aspectNum; a++){
+			uint8_t lit = 0;
+			for(int i=0; i<senseNum; i++) if((aspectLit[a] >> senses[i].lamp) & 1) lit |= (uint8_t)(1 << i);
+			fprintf(out, "%s0x%02X", a ? ", " : "", lit);
+		}
+		fprintf(out, "};\n");
+		bytes += 2U * senseNum + aspectNum;
+	}
+	fprintf(out, "\n");
+
+	// Other intersections: the same aspects packed for the pins of the site
+	for(int k=0; k<siteNum; k++){
+		const ST_Site_t* st = &sites[k];
+		uint8_t mask[4] = {0}, sitePorts = 0;
+		for(int l=0; l<lampNum; l++) if(!lamps[l].flash) mask[st->port[l]] |= (uint8_t)(1 << st->pin[l]);
+		for(int p=0; p<4; p++) if(mask[p]) sitePorts++;
+		Upper(name, st->name);
+		fprintf(out, "// Site %s: the pins of the lamps, the ports of the steady lamps and the aspects for these pins\n", st->name);
+		fprintf(out, "static const ST_AppLamp_t APP_Lamps_%s[APP_LAMP_NUM] = {\n", name);
+		for(int l=0; l<lampNum; l++){
+			fprintf(out, "\t{PORT%c, PIN%u, 0x%02X}, // %s\n", 'A' + st->port[l], st->pin[l], lamps[l].flash, lamps[l].name);
+		}
+		fprintf(out, "};\n\n#define APP_PORT_NUM_%s %u\n\n", name, sitePorts);
+		fprintf(out, "static const ST_AppPort_t APP_Ports_%s[APP_PORT_NUM_%s] = {", name, name);
+		for(int p=0, n=0; p<4; p++) if(mask[p]) fprintf(out, "%s{PORT%c, 0x%02X}", n++ ? ", " : "", 'A' + p, mask[p]);
+		fprintf(out, "};\n\n");
+		fprintf(out, "static const uint8_t APP_Aspects_%s[APP_ASPECT_NUM][APP_PORT_NUM_%s + 1] = {\n", name, name);
+		for(uint8_t a=0; a<aspectNum; a++){
+			uint8_t v[4] = {0};
+			for(int l=0; l<lampNum; l++) if(!lamps[l].flash && ((aspectLit[a] >> l) & 1)) v[st->port[l]] |= (uint8_t)(1 << st->pin[l]);
+			fprintf(out, "\t{");
+			for(int p=0; p<4; p++) if(mask[p]) fprintf(out, "0x%02X, ", v[p]);
+			fprintf(out, "0x%02X},\n", aspects[a][4]);
+		}
+		fprintf(out, "};\n\n");
+		bytes += 3U * lampNum + 2U * sitePorts + (sitePorts + 1U) * aspectNum;
+	}
+
+	// Intersections: the first one is given by the lamps, its flash lamps are on the Timer1 compare outputs
+	fprintf(out, "// Intersections: tables, button (external interrupt and pin), first shift register output, flashed in software\n");
+	fprintf(out, "#define APP_SITE_NUM %u\n", siteNum + 1U);
+	for(int k=0; k<siteNum; k++) if(1 == sites[k].button) fprintf(out, "#define APP_SITE_INT1 // the 1PPS input can not be used\n");
+	fprintf(out, "\nstatic const ST_AppSite_t APP_Sites[APP_SITE_NUM] = {\n");
+	fprintf(out, "\t{APP_Lamps, APP_Ports, APP_Aspects[0], APP_PORT_NUM, INT0, PORTD, PIN2, 0, 0},\n");
+	for(int k=0; k<siteNum; k++){
+		const uint8_t* b = buttonPins[sites[k].button];
+		Upper(name, sites[k].name);
+		fprintf(out, "\t{APP_Lamps_%s, APP_Ports_%s, APP_Aspects_%s[0], APP_PORT_NUM_%s, INT%u, PORT%c, PIN%u, %u, 1}, // %s\n",
+		        name, name, name, name, sites[k].button, 'A' + b[0], b[1], (k + 1U) * lampNum, sites[k].name);
+	}
+	fprintf(out, "};\n\n");
+	bytes += 12U * (siteNum + 1U);
+
+	int walkSignal = -1;
+	for(int s=0; s<signalNum && walkSignal < 0; s++) if(signals[s].crossing) walkSignal = s;
+	fprintf(out, "// Steps: aspect, plan phase, statistics phase, flags, steps of the crossing's green starting with the step\n");
+	for(int q=0; q<SEQ_NUM; q++){
+		const ST_Sequence_t* seq = &sequences[q];
+		Upper(name, seqNames[q]);
+		fprintf(out, "#define APP_%s_STEPS %u\n\n", name, seq->num);
+		fprintf(out, "static const ST_AppStep_t %s[APP_%s_STEPS] = {\n", seqTables[q], name);
+		for(int i=0; i<seq->num; i++){
+			const ST_Step_t* st = &seq->steps[i];
+			int stats = Green(st, 0) ? 0 : LIT(st, signals[0].red) ? 2 : 1;
+			int walk = 0;
+			if(walkSignal >= 0 && Green(st, walkSignal) && (!i || !Green(&seq->steps[i - 1], walkSignal))){
+				while(i + walk < seq->num && Green(&seq->steps[i + walk], walkSignal)) walk++;
+			}
+			fprintf(out, "\t{%u, PLAN_%s, %s, %s, %d},\n", st->aspect, phaseNames[st->phase], statsNames[stats],
+			        (SEQ_NORMAL == q && Go(st, 0)) ? "APP_STEP_GREEN" : "0", walk);
+		}
+		fprintf(out, "};\n\n");
+	}
+	fprintf(out, "#endif\n");
+
+	bytes += 5U * (sequences[0].num + sequences[1].num);
+	fprintf(stderr, "%u lamps, %u signals, %u steps, %u aspects (dark and fail-safe included), %u ports, %u intersection%s, %u sensed lamp%s,"
+	        " %u bytes of tables\n", lampNum, signalNum, sequences[0].num + sequences[1].num, aspectNum, ports, siteNum + 1U,
+	        siteNum ? "s" : "", senseNum, (1 == senseNum) ? "" : "s", bytes);
+}
+
+int main(int argc, char** argv){
+	if(argc < 2 || argc > 3){
+		fprintf(stderr, "usage: sigc <description> [header]\n");
+		return 2;
+	}
+	fileName = argv[1];
+	FILE* f = fopen(fileName, "r");
+	if(!f){ perror(fileName); return 2; }
+	Parse(f);
+	fclose(f);
+	if(!errors) Check();
+	if(errors){
+		fprintf(stderr, "%s: %d error%s, nothing written\n", fileName, errors, (1 == errors) ? "" : "s");
+		return 1;
+	}
+
+	const char* base = strrchr(fileName, '/');
+	FILE* out = (3 == argc) ? fopen(argv[2], "w") : stdout;
+	if(!out){ perror(argv[2]); return 2; }
+	Write(out, base ? base + 1 : fileName);
+	if(out != stdout && fclose(out)){ perror(argv[2]); return 2; }
+	return 0;
+}
@@ -0,0 +1,297 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "stackcheck" host tool, which computes the worst case stack of a firmware build
+ * and checks it against the RAM budget. It reads the extended listing (.lss) written by the build:
+ *   - the size of .data, .bss and .noinit, the stack gets the rest of the RAM
+ *   - the stack frame of each function: pushed registers, frame allocated in the prologue ("in r28, 0x3d"
+ *     then sbiw or subi/sbci), and "rcall .+0" allocations
+ *   - the call graph: call/rcall to a function (2 bytes of return address), jmp/rjmp to another function (tail call)
+ * The worst case is the deepest path from main (called by the startup code) plus the deepest interrupt handler
+ * (the CPU pushes the 2 bytes return address, the interrupts do not nest unless a handler executes sei).
+ * Indirect calls (icall, ijmp) cannot be followed from the listing, their targets are given with -e.
+ * Usage:
+ *   stackcheck [-r ram] [-b budget] [-g guard] [-e caller:callee]... <firmware.lss>
+ *     -r: RAM size (default 2048), -b: stack budget in bytes (default the RAM left by the variables),
+ *     -g: bytes kept free above the variables (default 8, STACK_GUARD), -e: edge of an indirect call
+ * Exit status: 0 within the budget, 1 over the budget or not bounded (recursion, unresolved indirect call), 2 error.
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define MAX_NAME 64
+
+typedef struct {
+	char name[MAX_NAME];
+	char callee[MAX_NAME];
+	uint8_t ret;    // return address bytes pushed by the call (0 for a tail jump)
+	uint8_t manual; // indirect call given with -e
+} ST_Edge_t;
+
+typedef struct {
+	char name[MAX_NAME];
+	uint32_t frame;       // bytes pushed or allocated by the function itself
+	uint8_t indirect;     // has an indirect call
+	uint8_t sei;          // enables the interrupts
+	uint8_t state;        // 0 not visited, 1 in progress, 2 done
+	uint32_t depth;       // deepest stack from the entry of the function
+	long next;            // callee on the deepest path (-1 none)
+	uint8_t bounded;
+} ST_Function_t;
+
+static ST_Function_t* functions;
+static size_t functionCount, functionSize;
+static ST_Edge_t* edges;
+static size_t edgeCount, edgeSize;
+static uint8_t unbounded;
+
+static long Find(const char* name){
+	for(size_t i=0; i<functionCount; i++){
+		if(!strcmp(functions[i].name, name)) return (long)i;
+	}
+	return -1;
+}
+
+static ST_Function_t* AddFunction(const char* name){
+	if(functionCount == functionSize){
+		functionSize = functionSize ? 2 * functionSize : 256;
+		functions = realloc(functions, functionSize * sizeof(ST_Function_t));
+		if(!functions){ perror("stackcheck"); exit(2); }
+	}
+	ST_Function_t* f = &functions[functionCount++];
+	memset(f, 0, sizeof(*f));
+	snprintf(f->name, sizeof(f->name), "%s", name);
+	f->next = -1;
+	return f;
+}
+
+static void AddEdge(const char* name, const char* callee, uint8_t ret, uint8_t manual){
+	for(size_t i=0; i<edgeCount; i++){
+		if(!strcmp(edges[i].name, name) && !strcmp(edges[i].callee, callee) && edges[i].ret >= ret){
+			edges[i].manual |= manual;
+			return;
+		}
+	}
+	if(edgeCount == edgeSize){
+		edgeSize = edgeSize ? 2 * edgeSize : 1024;
+		edges = realloc(edges, edgeSize * sizeof(ST_Edge_t));
+		if(!edges){ perror("stackcheck"); exit(2); }
+	}
+	ST_Edge_t* e = &edges[edgeCount++];
+	snprintf(e->name, sizeof(e->name), "%s", name);
+	snprintf(e->callee, sizeof(e->callee), "%s", callee);
+	e->ret = ret;
+	e->manual = manual;
+}
+
+/************************************************************************/
+/*                       Listing                                        */
+/************************************************************************/
+
+/*
+ * Gets the symbol of a branch target ("; 0x34c <LED_IsOn>"), without offset.
+ * Return value: 1 if the target is the start of a symbol, 0 otherwise
+ */
+static uint8_t Target(const char* operands, char* name){
+	const char* lt = strchr(operands, '<');
+	const char* gt = lt ? strchr(lt, '>') : NULL;
+	if(!gt || gt - lt - 1 >= MAX_NAME) return 0;
+	memcpy(name, lt + 1, gt - lt - 1);
+	name[gt - lt - 1] = 0;
+	return NULL == strchr(name, '+') && '.' != name[0];
+}
+
+/*
+ * Reads the section sizes and the functions of the listing.
+ * Return value: the bytes used by the variables
+ */
+static uint32_t ReadListing(FILE* file){
+	char line[1024], name[MAX_NAME], section[64];
+	uint32_t variables = 0;
+	ST_Function_t* f = NULL;
+	uint8_t prologue = 0; // "in r28, 0x3d" seen, frame not allocated yet
+	unsigned idx, size;
+	while(fgets(line, sizeof(line), file)){
+		// section header: "  1 .data         00000004  00800060 ..."
+		if(3 == sscanf(line, " %u %63s %x", &idx, section, &size) && '.' == section[0]){
+			if(!strcmp(section, ".data") || !strcmp(section, ".bss") || !strcmp(section, ".noinit")) variables += size;
+			continue;
+		}
+		// symbol: "000002a8 <__vector_1>:", the local labels (".name") belong to the function before them
+		unsigned long addr;
+		if(2 == sscanf(line, "%lx <%63[^>]>:", &addr, name) && '0' <= line[0] && line[0] <= 'f'){
+			if('.' != name[0]){
+				f = AddFunction(name);
+				prologue = 0;
+			}
+			continue;
+		}
+		// instruction: " 2a8:\t1f 92       \tpush\tr1", the source lines have no address and tab
+		char* colon = strchr(line, ':');
+		if(!f || ' ' != line[0] || !colon || '\t' != colon[1]) continue;
+		char* fields[4] = {NULL};
+		char* save = NULL;
+		char* tok = strtok_r(colon + 2, "\t\r\n", &save);
+		for(int i=0; tok && i<4; i++, tok = strtok_r(NULL, "\t\r\n", &save)) fields[i] = tok;
+		const char* op = fields[1];
+		const char* args = fields[2] ? fields[2] : "";
+		if(!op) continue;
+		// the rest of the line holds the target comment
+		char rest[512];
+		snprintf(rest, sizeof(rest), "%s %s", args, fields[3] ? fields[3] : "");
+
+		if(!strcmp(op, "push")) f->frame += 1;
+		else if(!strcmp(op, "in") && !strncmp(args, "r28, 0x3d", 9)) prologue = 1;
+		else if(prologue && !strcmp(op, "sbiw") && !strncmp(args, "r28, ", 5)){
+			f->frame += strtoul(args + 5, NULL, 0);
+			prologue = 0;
+		}
+		else if(prologue && !strcmp(op, "subi") && !strncmp(args, "r28, ", 5)){
+			f->frame += strtoul(args + 5, NULL, 0);
+		}
+		else if(prologue && !strcmp(op, "sbci") && !strncmp(args, "r29, ", 5)){
+			f->frame += strtoul(args + 5, NULL, 0) << 8;
+			prologue = 0;
+		}
+		else if(!strcmp(op, "out") && !strncmp(args, "0x3d", 4)) prologue = 0;
+		else if(!strcmp(op, "rcall") && !strncmp(args, ".+0", 3)) f->frame += 2;
+		else if(!strcmp(op, "call") || !strcmp(op, "rcall")){
+			if(Target(rest, name)) AddEdge(f->name, name, 2, 0);
+		}
+		else if(!strcmp(op, "jmp") || !strcmp(op, "rjmp")){
+			if(Target(rest, name) && strcmp(name, f->name)) AddEdge(f->name, name, 0, 0);
+		}
+		else if(!strcmp(op, "icall") || !strcmp(op, "eicall") || !strcmp(op, "ijmp") || !strcmp(op, "eijmp")) f->indirect = 1;
+		else if(!strcmp(op, "sei")) f->sei = 1;
+	}
+	return variables;
+}
+
+/************************************************************************/
+/*                       Call graph                                     */
+/************************************************************************/
+
+/*
+ * Gets the deepest stack used from the entry of a function (its return address not included).
+ */
+static uint32_t Depth(long i){
+	ST_Function_t* f = &functions[i];
+	if(2 == f->state) return f->depth;
+	if(1 == f->state){
+		printf("recursion through %s, the stack is not bounded\n", f->name);
+		unbounded = 1;
+		return 0;
+	}
+	f->state = 1;
+	uint32_t deepest = 0;
+	uint8_t resolved = 0;
+	for(size_t e=0; e<edgeCount; e++){
+		if(strcmp(edges[e].name, f->name)) continue;
+		long c = Find(edges[e].callee);
+		if(c < 0) continue;
+		resolved |= edges[e].manual;
+		uint32_t d = edges[e].ret + Depth(c);
+		if(d > deepest || f->next < 0){
+			deepest = d;
+			f->next = c;
+		}
+	}
+	if(f->indirect && !resolved){
+		printf("indirect call in %s not resolved (use -e %s:<callee>)\n", f->name, f->name);
+		unbounded = 1;
+	}
+	f->depth = f->frame + deepest;
+	f->state = 2;
+	return f->depth;
+}
+
+static void PrintPath(long i){
+	printf("%s", functions[i].name);
+	for(i = functions[i].next; i >= 0; i = functions[i].next) printf(" > %s", functions[i].name);
+	printf("\n");
+}
+
+int main(int argc, char** argv){
+	uint32_t ram = 2048, budget = 0, guard = 8;
+	int opt;
+	while(-1 != (opt = getopt(argc, argv, "r:b:g:e:"))){
+		switch(opt){
+			case 'r': ram = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'b': budget = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'g': guard = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'e':{
+				char* sep = strchr(optarg, ':');
+				if(!sep){ fprintf(stderr, "stackcheck: -e caller:callee\n"); return 2; }
+				*sep = 0;
+				AddEdge(optarg, sep + 1, 2, 1);
+			} break;
+			default:
+				fprintf(stderr, "usage: stackcheck [-r ram] [-b budget] [-g guard] [-e caller:callee]... <firmware.lss>\n");
+				return 2;
+		}
+	}
+	if(optind + 1 != argc){
+		fprintf(stderr, "usage: stackcheck [-r ram] [-b budget] [-g guard] [-e caller:callee]... <firmware.lss>\n");
+		return 2;
+	}
+	FILE* file = fopen(argv[optind], "r");
+	if(!file){ perror(argv[optind]); return 2; }
+	uint32_t variables = ReadListing(file);
+	fclose(file);
+	long mainIdx = Find("main");
+	if(mainIdx < 0){
+		fprintf(stderr, "stackcheck: no main in %s\n", argv[optind]);
+		return 2;
+	}
+
+	uint32_t available = ram > variables + guard ? ram - variables - guard : 0;
+	if(!budget) budget = available;
+
+	// main is called by the startup code
+	uint32_t mainDepth = 2 + Depth(mainIdx);
+	printf("%-20s %5u bytes  ", "main", mainDepth);
+	PrintPath(mainIdx);
+
+	// interrupts: return address pushed by the CPU
+	uint32_t isrDepth = 0;
+	uint8_t nested = 0;
+	for(size_t i=0; i<functionCount; i++){
+		unsigned vector;
+		char tail;
+		if(1 != sscanf(functions[i].name, "__vector_%u%c", &vector, &tail)) continue;
+		uint32_t d = 2 + Depth((long)i);
+		printf("%-20s %5u bytes  ", functions[i].name, d);
+		PrintPath((long)i);
+		if(d > isrDepth) isrDepth = d;
+		for(long k = (long)i; k >= 0; k = functions[k].next) nested |= functions[k].sei;
+	}
+	if(nested){
+		printf("an interrupt handler enables the interrupts, the nesting is not bounded\n");
+		unbounded = 1;
+	}
+
+	uint32_t peak = mainDepth + isrDepth;
+	printf("variables %u bytes, guard %u bytes, %u bytes left for the stack\n", variables, guard, available);
+	printf("worst case stack %u bytes (main %u + interrupt %u), budget %u bytes, margin %d bytes\n",
+	       peak, mainDepth, isrDepth, budget, (int)budget - (int)peak);
+	if(unbounded){
+		printf("FAIL: the stack is not bounded\n");
+		return 1;
+	}
+	if(peak > budget || peak > available){
+		printf("FAIL: over the budget\n");
+		return 1;
+	}
+	printf("OK\n");
+	return 0;
+}
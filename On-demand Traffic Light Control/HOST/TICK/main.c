@@ -0,0 +1,151 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "driftsim" host tool, which measures the long-run drift of the timebase
+ * (SERVICES/TICK) with a CPU clock that is off its nominal frequency.
+ * The unmodified firmware runs on the host backend for a number of virtual days without presses.
+ * The backend counts CPU cycles, so the clock error is modelled by the true time of each cycle:
+ * a constant error plus a daily wander (temperature), f(t) = F_CPU * (1 + (c + w * sin(2 pi t / day)) * 1e-6).
+ * The 1PPS pulses arrive on INT1 every true second, with a uniform jitter.
+ * Each car green start is compared with the ideal grid: the first green start plus whole cycles of the default plan,
+ * in true time. The error is printed at the end of each day, with the largest error of the run and the drift
+ * after the first day (the error of the first day includes the first rate measurement: the first pulse, then
+ * TICK_WINDOW seconds, at the nominal rate).
+ * The 1PPS input only has an effect when the tool is built with -DTICK_PPS_ENABLE=1.
+ * Usage:
+ *   driftsim [-d days] [-c clock error ppm] [-w daily wander ppm] [-j pulse jitter us] [-n] [-s seed]
+ *     defaults: 7 days, 1000 ppm, 0 ppm, 1 us, seed 1, -n: no 1PPS pulses
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#define DAY 86400.0
+
+// Options
+static double days = 7, clockPpm = 1000, wanderPpm = 0, jitterUs = 1;
+static uint8_t pps = 1;
+
+// Simulation
+static uint64_t endTime;
+static uint32_t pulses;
+static ST_TickStats_t stats;
+
+// Green starts
+static uint8_t greenOn;
+static double firstGreen = -1, cycleTime;
+static uint64_t greens;
+static double maxError, dayError[64];
+static int lastDay = -1;
+
+/*
+ * CPU cycles elapsed at a true time in seconds (the integral of the clock frequency).
+ */
+static double Cycles(double t){
+	double LOC_Wander = wanderPpm * DAY / (2 * M_PI) * (1 - cos(2 * M_PI * t / DAY));
+	return F_CPU * (t + (clockPpm * t + LOC_Wander) * 1e-6);
+}
+
+/*
+ * True time in seconds of a CPU cycle count (Newton iterations on Cycles).
+ */
+static double TrueTime(double cycles){
+	double t = cycles / F_CPU;
+	for(int i=0; i<4; i++){
+		double LOC_Rate = F_CPU * (1 + (clockPpm + wanderPpm * sin(2 * M_PI * t / DAY)) * 1e-6);
+		t -= (Cycles(t) - cycles) / LOC_Rate;
+	}
+	return t;
+}
+
+/*
+ * Input source: a 1PPS pulse every true second.
+ */
+static uint8_t Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	if(!pps) return 0;
+	double LOC_Pulse = (pulses + 1) + (2 * HOST_Uniform() - 1) * jitterUs * 1e-6;
+	uint64_t LOC_U64Time = (uint64_t)Cycles(LOC_Pulse);
+	if(LOC_U64Time >= endTime) return 0;
+	event->time = LOC_U64Time;
+	event->code = HOST_EV_CODE(HOST_EV_PULSE, HOST_PIN_INT1);
+	pulses++;
+	return 1;
+}
+
+/*
+ * Output observer: compares each car green start with the ideal grid.
+ */
+static void Output(uint64_t now, void* arg){
+	(void)arg;
+	uint8_t LOC_U8Green = HOST_LAMP_ON == HOST_Lamp(APP_Sites[0].lamps[APP_MAIN_GREEN].port, APP_Sites[0].lamps[APP_MAIN_GREEN].pin);
+	double t = TrueTime((double)now);
+	if(LOC_U8Green && !greenOn && t < days * DAY){
+		if(firstGreen < 0) firstGreen = t;
+		double LOC_Error = t - (firstGreen + greens * cycleTime);
+		if(fabs(LOC_Error) > fabs(maxError)) maxError = LOC_Error;
+		int LOC_Day = (int)(t / DAY);
+		dayError[LOC_Day] = LOC_Error;
+		if(LOC_Day > lastDay) lastDay = LOC_Day;
+		greens++;
+	}
+	greenOn = LOC_U8Green;
+}
+
+static void Done(void){
+	TICK_GetStats(&stats);
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'd': days = atof(arg); break;
+		case 'c': clockPpm = atof(arg); break;
+		case 'w': wanderPpm = atof(arg); break;
+		case 'j': jitterUs = atof(arg); break;
+		case 'n': pps = 0; break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "d:c:w:j:ns:", Option,
+	                "driftsim [-d days] [-c clock error ppm] [-w daily wander ppm] [-j pulse jitter us] [-n] [-s seed]") < 0) return 2;
+	if(days <= 0 || days > 64){
+		fprintf(stderr, "driftsim: the duration must be from 0 to 64 days\n");
+		return 2;
+	}
+	if(fabs(clockPpm) + fabs(wanderPpm) >= 30000){
+		fprintf(stderr, "driftsim: the clock error must stay below 3%%\n");
+		return 2;
+	}
+
+	cycleTime = 4 * PLAN_DEFAULT_HALF_SECS * 0.5;
+	endTime = (uint64_t)Cycles(days * DAY);
+	HOST_SetInput(Input, NULL);
+	HOST_SetOutput(Output, NULL);
+	HOST_Simulate(APP_Init, APP_Start, Done, endTime);
+
+	printf("%.1f days, clock error %+.0f ppm, wander %.0f ppm, %s\n", days, clockPpm, wanderPpm,
+	       !pps ? "no 1PPS" : TICK_PPS_ENABLE ? "1PPS" : "1PPS not built (-DTICK_PPS_ENABLE=1)");
+	printf("%llu cycles of %.1f s, %u pulses accepted, %u rejected, %u rate updates, %u slips, rate %lu counts per %u s\n",
+	       (unsigned long long)greens, cycleTime, stats.pulses, stats.rejected, stats.windows,
+	       stats.slips, (unsigned long)stats.period, TICK_WINDOW);
+	for(int d=0; d<=lastDay; d++) printf("day %2d: green start off the grid by %+10.3f ms\n", d + 1, dayError[d] * 1e3);
+	printf("largest error %+.3f ms", maxError * 1e3);
+	if(lastDay > 0){
+		double LOC_Drift = dayError[lastDay] - dayError[0];
+		printf(", drift after day 1 %+.3f ms (%+.4f ppm)", LOC_Drift * 1e3, LOC_Drift / (lastDay * DAY) * 1e6);
+	}
+	printf("\n");
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * File: TRACE_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces used to write and decode controller traces: the lamp changes,
+ * button presses and resets of one cabinet, in time order. The analysis reads the trace files mapped in memory
+ * and decodes them in place, one record at a time, without copying or allocating anything.
+ * Trace file format (all multi-byte values little-endian):
+ *   - header: "TLTR", version (1 byte), number of lamps (1 byte, 16 at most), index of the green lamp of the main
+ *     approach and of the crossing (1 byte each), cabinet number (4 bytes)
+ *   - one record per change: time since the previous record in cycles (1 us) as an unsigned LEB128 varint,
+ *     followed by the record code (type in the high nibble, low nibble 0)
+ *   - a lamps record is followed by the state of every lamp, 2 bits per lamp (HOST_LAMP_OFF, ON or FLASH)
+ *     in the order of APP/APP_Signals.txt, lamp 0 in the low bits, in as many bytes as needed (2 for 6 lamps)
+ * A lamps record is only written when the lamps differ from the previous record, with the state reached at the end
+ * of the instant (the firmware writes one port at a time). An aspect change 5 seconds after the previous record
+ * takes 7 bytes with 6 lamps.
+ * The functions prototypes defined in this file include:
+ *   - TRACE_OpenWrite, TRACE_Write, TRACE_CloseWrite: functions to create a trace and append records
+ *   - TRACE_Map, TRACE_Unmap: functions to map a trace file and check its header
+ *   - TRACE_Next: function to decode the next record of a mapped trace
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TRACE_INTERFACE_H_
+#define TRACE_INTERFACE_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_MAGIC       "TLTR"
+#define TRACE_VERSION     1
+#define TRACE_HEADER_SIZE 12
+#define TRACE_MAX_LAMPS   16
+
+// Record types (high nibble of the code)
+typedef enum traceType{
+	TRACE_LAMPS = 0x1, // lamp states follow
+	TRACE_PRESS = 0x2, // button press (rising edge on INT0)
+	TRACE_RESET = 0x3, // reset of the controller (external reset, watchdog or power-up)
+	TRACE_END   = 0xF  // end of the trace
+} EN_TraceType_t;
+
+// Header fields
+typedef struct {
+	uint8_t lampNum;
+	uint8_t mainGreen;  // green lamp of the main approach
+	uint8_t walkGreen;  // green lamp of the crossing
+	uint32_t cabinet;
+} ST_TraceInfo_t;
+
+// Decoded record
+typedef struct {
+	uint64_t time;  // cycles (1 us) since the start of the trace
+	uint8_t type;   // EN_TraceType_t
+	uint32_t lamps; // TRACE_LAMPS only, 2 bits per lamp
+} ST_TraceRecord_t;
+
+// Trace being written
+typedef struct {
+	FILE* file;
+	uint64_t lastTime;
+	uint8_t lampBytes;
+	uint32_t count;
+} ST_TraceWriter_t;
+
+// Trace mapped for reading
+typedef struct {
+	const uint8_t* base;
+	size_t size;
+	const uint8_t* next;  // next record
+	uint64_t time;        // time of the last record decoded
+	uint8_t lampBytes;
+	uint8_t error;        // set when the trace ends in the middle of a record or has an unknown record
+	ST_TraceInfo_t info;
+} ST_TraceReader_t;
+
+// Lamp state in a lamps word
+#define TRACE_LAMP(lamps, lamp) (((lamps) >> (2 * (lamp))) & 0x3)
+
+// Trace function prototypes
+uint8_t TRACE_OpenWrite(ST_TraceWriter_t* trace, const char* path, const ST_TraceInfo_t* info);
+uint8_t TRACE_Write(ST_TraceWriter_t* trace, uint64_t time, uint8_t type, uint32_t lamps);
+uint8_t TRACE_CloseWrite(ST_TraceWriter_t* trace);
+uint8_t TRACE_Map(ST_TraceReader_t* trace, const char* path);
+void TRACE_Unmap(ST_TraceReader_t* trace);
+uint8_t TRACE_Next(ST_TraceReader_t* trace, ST_TraceRecord_t* record);
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ * File: TRACE_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the controller trace functions declared in TRACE_Interface.h.
+ * The writer goes through stdio like the replay recordings. The reader maps the whole file read-only
+ * (the kernel reads it ahead since the access is sequential) and decodes the records straight from the mapping.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "TRACE_Interface.h"
+
+/*
+ * Function: TRACE_OpenWrite()
+ * This function creates a trace and writes its header.
+ * Return value: 1 on success, 0 if the file can not be created or the header is not valid
+ */
+uint8_t TRACE_OpenWrite(ST_TraceWriter_t* trace, const char* path, const ST_TraceInfo_t* info){
+	uint8_t LOC_U8Header[TRACE_HEADER_SIZE] = {'T', 'L', 'T', 'R', TRACE_VERSION, info->lampNum, info->mainGreen, info->walkGreen,
+	                                           (uint8_t)info->cabinet, (uint8_t)(info->cabinet >> 8),
+	                                           (uint8_t)(info->cabinet >> 16), (uint8_t)(info->cabinet >> 24)};
+	trace->file = NULL;
+	trace->lastTime = 0;
+	trace->count = 0;
+	trace->lampBytes = (info->lampNum + 3) / 4;
+	if(!info->lampNum || info->lampNum > TRACE_MAX_LAMPS) return 0;
+	trace->file = fopen(path, "wb");
+	if(!trace->file) return 0;
+	return TRACE_HEADER_SIZE == fwrite(LOC_U8Header, 1, TRACE_HEADER_SIZE, trace->file);
+}
+
+/*
+ * Function: TRACE_Write()
+ * This function appends a record to a trace, records must be written in time order.
+ * Return value: 1 on success, 0 on write error or if the record is older than the previous one
+ */
+uint8_t TRACE_Write(ST_TraceWriter_t* trace, uint64_t time, uint8_t type, uint32_t lamps){
+	uint8_t LOC_U8Buf[16];
+	uint8_t LOC_U8Len = 0;
+	if(time < trace->lastTime) return 0;
+	uint64_t LOC_U64Delta = time - trace->lastTime;
+	do{
+		LOC_U8Buf[LOC_U8Len] = LOC_U64Delta & 0x7F;
+		LOC_U64Delta >>= 7;
+		if(LOC_U64Delta) LOC_U8Buf[LOC_U8Len] |= 0x80;
+		LOC_U8Len++;
+	} while(LOC_U64Delta);
+	LOC_U8Buf[LOC_U8Len++] = type << 4;
+	if(TRACE_LAMPS == type){
+		for(uint8_t i=0; i<trace->lampBytes; i++) LOC_U8Buf[LOC_U8Len++] = (uint8_t)(lamps >> (8 * i));
+	}
+	trace->lastTime = time;
+	trace->count++;
+	return LOC_U8Len == fwrite(LOC_U8Buf, 1, LOC_U8Len, trace->file);
+}
+
+/*
+ * Function: TRACE_CloseWrite()
+ * This function closes a trace being written.
+ * Return value: 1 on success, 0 if the trace could not be written completely
+ */
+uint8_t TRACE_CloseWrite(ST_TraceWriter_t* trace){
+	uint8_t LOC_U8Ok = trace->file && !ferror(trace->file);
+	if(trace->file && fclose(trace->file)) LOC_U8Ok = 0;
+	trace->file = NULL;
+	return LOC_U8Ok;
+}
+
+/*
+ * Function: TRACE_Map()
+ * This function maps a trace file for reading and checks its header.
+ * Return value: 1 on success, 0 if the file can not be mapped or is not a trace of this version
+ */
+uint8_t TRACE_Map(ST_TraceReader_t* trace, const char* path){
+	struct stat LOC_Stat;
+	memset(trace, 0, sizeof(*trace));
+	int LOC_Fd = open(path, O_RDONLY);
+	if(LOC_Fd < 0) return 0;
+	if(fstat(LOC_Fd, &LOC_Stat) || LOC_Stat.st_size < TRACE_HEADER_SIZE){
+		close(LOC_Fd);
+		return 0;
+	}
+	void* LOC_PtrMap = mmap(NULL, LOC_Stat.st_size, PROT_READ, MAP_PRIVATE, LOC_Fd, 0);
+	close(LOC_Fd);
+	if(MAP_FAILED == LOC_PtrMap) return 0;
+	madvise(LOC_PtrMap, LOC_Stat.st_size, MADV_SEQUENTIAL);
+	trace->base = LOC_PtrMap;
+	trace->size = LOC_Stat.st_size;
+	trace->next = trace->base + TRACE_HEADER_SIZE;
+	trace->info.lampNum = trace->base[5];
+	trace->info.mainGreen = trace->base[6];
+	trace->info.walkGreen = trace->base[7];
+	trace->info.cabinet = trace->base[8] | (uint32_t)trace->base[9] << 8 | (uint32_t)trace->base[10] << 16
+	                      | (uint32_t)trace->base[11] << 24;
+	trace->lampBytes = (trace->info.lampNum + 3) / 4;
+	if(memcmp(trace->base, TRACE_MAGIC, 4) || TRACE_VERSION != trace->base[4]
+	   || !trace->info.lampNum || trace->info.lampNum > TRACE_MAX_LAMPS
+	   || trace->info.mainGreen >= trace->info.lampNum || trace->info.walkGreen >= trace->info.lampNum){
+		TRACE_Unmap(trace);
+		return 0;
+	}
+	return 1;
+}
+
+/*
+ * Function: TRACE_Unmap()
+ * This function unmaps a trace file.
+ * Return value: void
+ */
+void TRACE_Unmap(ST_TraceReader_t* trace){
+	if(trace->base) munmap((void*)trace->base, trace->size);
+	trace->base = NULL;
+}
+
+/*
+ * Function: TRACE_Next()
+ * This function decodes the next record of a mapped trace.
+ * Return value: 1 if a record was decoded, 0 at the end of the trace (the error flag is set if it is truncated)
+ */
+uint8_t TRACE_Next(ST_TraceReader_t* trace, ST_TraceRecord_t* record){
+	const uint8_t* LOC_PtrByte = trace->next;
+	const uint8_t* LOC_PtrEnd = trace->base + trace->size;
+	uint64_t LOC_U64Delta = 0;
+	uint8_t LOC_U8Shift = 0;
+	uint8_t LOC_U8Byte;
+	if(LOC_PtrByte >= LOC_PtrEnd) return 0;
+	do{
+		if(LOC_PtrByte >= LOC_PtrEnd || LOC_U8Shift > 63){
+			trace->error = 1;
+			return 0;
+		}
+		LOC_U8Byte = *LOC_PtrByte++;
+		LOC_U64Delta |= (uint64_t)(LOC_U8Byte & 0x7F) << LOC_U8Shift;
+		LOC_U8Shift += 7;
+	} while(LOC_U8Byte & 0x80);
+	if(LOC_PtrByte >= LOC_PtrEnd){
+		trace->error = 1;
+		return 0;
+	}
+	record->type = *LOC_PtrByte++ >> 4;
+	switch(record->type){
+		case TRACE_LAMPS:
+			if(LOC_PtrEnd - LOC_PtrByte < trace->lampBytes){
+				trace->error = 1;
+				return 0;
+			}
+			record->lamps = 0;
+			for(uint8_t i=0; i<trace->lampBytes; i++) record->lamps |= (uint32_t)LOC_PtrByte[i] << (8 * i);
+			LOC_PtrByte += trace->lampBytes;
+		break;
+		case TRACE_PRESS: case TRACE_RESET: case TRACE_END: break;
+		default:
+			trace->error = 1;
+			return 0;
+	}
+	trace->time += LOC_U64Delta;
+	record->time = trace->time;
+	trace->next = LOC_PtrByte;
+	return 1;
+}
@@ -0,0 +1,579 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "tracean" host tool, which turns controller traces (TRACE_Interface.h)
+ * into phase duration distributions, pedestrian wait times and violation reports.
+ * The stats command maps each trace and decodes it in one streaming pass, with no allocation and no copy:
+ * the state of a cabinet is its current lamps, their start time and the first press not answered yet.
+ * The traces are shared between threads (the decoding uses no globals), each thread keeps its own counters
+ * and histograms, and they are added together at the end. The tool reports the ingest throughput in MB/s.
+ *   - aspects: each lamp combination shown is a phase, its durations (from one change to the next, the intervals
+ *     cut by a reset or the end of the trace are not counted) go into a histogram of 100 ms buckets up to 600 s
+ *   - pedestrian wait: from the first press to the crossing's green, a press during the green is answered at once
+ *   - violations: the greens of the main approach and of the crossing lit together, a pedestrian wait longer than
+ *     the limit, a trace truncated (no end record) or with an unknown record
+ * With -o, one row per phase is also written in columns (raw little-endian arrays, one file per column:
+ * <prefix>.cabinet.u32, <prefix>.start.u64 in us, <prefix>.duration.u32 in us, <prefix>.lamps.u32), readable
+ * for example with numpy.fromfile. The rows of a thread are written in blocks, so the rows of one cabinet stay
+ * in order but the cabinets are interleaved.
+ * The gen command writes a synthetic corpus: each trace is recorded from the unmodified firmware running on the
+ * host backend, with presses and resets arriving at random (Poisson arrivals, a seed per cabinet).
+ * The cabinets are simulated in parallel, one process per cabinet (the firmware keeps its state in globals).
+ * Usage:
+ *   tracean stats [-j threads] [-w wait limit in seconds] [-o column prefix] <trace>...
+ *     defaults: one thread per CPU, 20 seconds
+ *   tracean gen [-n cabinets] [-d days] [-r presses per hour] [-b resets per day] [-s seed] [-j jobs] <directory>
+ *     defaults: 8 cabinets of 1 day, 60 presses per hour, 1 reset per day, seed 1, one job per CPU,
+ *     writes <directory>/cabinet<number>.tltr
+ *   tracean dump <trace>
+ *     prints the records, lamps in the order of APP/APP_Signals.txt: '-' off, '#' on, '*' flashing
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include "TRACE_Interface.h"
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+#define HIST_BUCKETS   6000 // 100 ms buckets up to 600 s, plus one bucket for the longer ones
+#define HIST_STEP      100000ULL
+#define MAX_ASPECTS    32   // lamp combinations kept per run, the others are counted together
+#define MAX_VIOLATIONS 10   // violations listed
+#define COLUMN_ROWS    8192 // rows buffered per thread
+#define NO_LAMPS       0xFFFFFFFFUL // lamps word never written (lamp state 3)
+
+static const char lampChars[4] = {'-', '#', '*', '?'};
+
+/************************************************************************/
+/*                       Analysis                                       */
+/************************************************************************/
+
+typedef enum { VIOLATION_CONFLICT, VIOLATION_WAIT, VIOLATION_TRUNCATED } EN_Violation_t;
+static const char* violationNames[3] = {"conflicting greens", "pedestrian wait over the limit", "trace truncated"};
+
+// Distribution of durations in cycles
+typedef struct {
+	uint64_t count, sum, min, max;
+	uint32_t hist[HIST_BUCKETS + 1];
+} ST_Dist_t;
+
+typedef struct {
+	int file;
+	uint64_t time;
+	uint32_t cabinet;
+	uint8_t kind;
+} ST_Violation_t;
+
+// Everything one thread accumulates
+typedef struct {
+	pthread_t thread;
+	uint64_t traces, invalid, bytes, records, span, presses, resets, unanswered, otherPhases;
+	uint64_t violations[3];
+	uint8_t aspectNum;
+	uint32_t aspectLamps[MAX_ASPECTS];
+	uint8_t aspectLampNum[MAX_ASPECTS];
+	ST_Dist_t aspects[MAX_ASPECTS];
+	ST_Dist_t wait;
+	uint8_t listed;
+	ST_Violation_t list[MAX_VIOLATIONS];
+	uint32_t rows;
+	uint32_t colCabinet[COLUMN_ROWS];
+	uint64_t colStart[COLUMN_ROWS];
+	uint32_t colDuration[COLUMN_ROWS];
+	uint32_t colLamps[COLUMN_ROWS];
+} ST_Worker_t;
+
+// Options and shared state of the stats command
+static char** paths;
+static int pathNum, nextPath;
+static uint64_t waitLimit = 20000000ULL;
+static FILE* columns[4];
+static pthread_mutex_t columnLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void DistAdd(ST_Dist_t* dist, uint64_t value){
+	if(!dist->count || value < dist->min) dist->min = value;
+	if(value > dist->max) dist->max = value;
+	dist->count++;
+	dist->sum += value;
+	uint64_t LOC_U64Bucket = value ? (value - 1) / HIST_STEP : 0; // a bucket holds its upper bound
+	dist->hist[(LOC_U64Bucket < HIST_BUCKETS) ? LOC_U64Bucket : HIST_BUCKETS]++;
+}
+
+static void DistMerge(ST_Dist_t* into, const ST_Dist_t* from){
+	if(!from->count) return;
+	if(!into->count || from->min < into->min) into->min = from->min;
+	if(from->max > into->max) into->max = from->max;
+	into->count += from->count;
+	into->sum += from->sum;
+	for(int i=0; i<=HIST_BUCKETS; i++) into->hist[i] += from->hist[i];
+}
+
+/*
+ * Percentile of a distribution, the upper bound of its bucket in seconds (negative above the last bucket).
+ */
+static double DistPercentile(const ST_Dist_t* dist, double percent){
+	uint64_t LOC_U64Rank = (uint64_t)ceil(dist->count * percent / 100), LOC_U64Seen = 0;
+	if(!LOC_U64Rank) LOC_U64Rank = 1;
+	for(int i=0; i<HIST_BUCKETS; i++){
+		LOC_U64Seen += dist->hist[i];
+		if(LOC_U64Seen >= LOC_U64Rank) return (i + 1) * (HIST_STEP / 1e6);
+	}
+	return -1;
+}
+
+static void PrintDist(const ST_Dist_t* dist){
+	double LOC_P50 = DistPercentile(dist, 50), LOC_P99 = DistPercentile(dist, 99);
+	printf("%10llu %9.3f", (unsigned long long)dist->count, dist->count ? dist->sum / 1e6 / dist->count : 0);
+	if(LOC_P50 < 0) printf("     >600"); else printf(" %8.1f", LOC_P50);
+	if(LOC_P99 < 0) printf("     >600"); else printf(" %8.1f", LOC_P99);
+	printf(" %9.3f\n", dist->max / 1e6);
+}
+
+static void Violation(ST_Worker_t* worker, int file, uint32_t cabinet, uint64_t time, uint8_t kind){
+	worker->violations[kind]++;
+	if(worker->listed < MAX_VIOLATIONS) worker->list[worker->listed++] = (ST_Violation_t){file, time, cabinet, kind};
+}
+
+static void FlushColumns(ST_Worker_t* worker){
+	if(!worker->rows) return;
+	pthread_mutex_lock(&columnLock);
+	fwrite(worker->colCabinet, sizeof(uint32_t), worker->rows, columns[0]);
+	fwrite(worker->colStart, sizeof(uint64_t), worker->rows, columns[1]);
+	fwrite(worker->colDuration, sizeof(uint32_t), worker->rows, columns[2]);
+	fwrite(worker->colLamps, sizeof(uint32_t), worker->rows, columns[3]);
+	pthread_mutex_unlock(&columnLock);
+	worker->rows = 0;
+}
+
+/*
+ * Index of the distribution of a lamp combination, MAX_ASPECTS when the table is full.
+ */
+static uint8_t AspectIndex(ST_Worker_t* worker, uint32_t lamps, uint8_t lampNum){
+	uint8_t i;
+	for(i=0; i<worker->aspectNum; i++) if(lamps == worker->aspectLamps[i]) return i;
+	if(MAX_ASPECTS == i) return i;
+	worker->aspectLamps[i] = lamps;
+	worker->aspectLampNum[i] = lampNum;
+	worker->aspectNum++;
+	return i;
+}
+
+/*
+ * Decodes one trace and accumulates it.
+ */
+static void Analyse(ST_Worker_t* worker, int file){
+	ST_TraceReader_t LOC_Trace;
+	ST_TraceRecord_t LOC_Record;
+	if(!TRACE_Map(&LOC_Trace, paths[file])){
+		fprintf(stderr, "tracean: %s is not a trace\n", paths[file]);
+		worker->invalid++;
+		return;
+	}
+	const ST_TraceInfo_t* LOC_Info = &LOC_Trace.info;
+	uint32_t LOC_U32Lamps = NO_LAMPS;
+	uint8_t LOC_U8Aspect = 0, LOC_U8Conflict = 0, LOC_U8Walk = 0, LOC_U8Waiting = 0, LOC_U8End = 0;
+	uint64_t LOC_U64Start = 0, LOC_U64Press = 0, LOC_U64Records = 0;
+	while(TRACE_Next(&LOC_Trace, &LOC_Record)){
+		LOC_U64Records++;
+		if(TRACE_END == LOC_Record.type){
+			LOC_U8End = 1;
+			break;
+		}
+		if(TRACE_PRESS == LOC_Record.type){
+			worker->presses++;
+			if(!LOC_U8Waiting){
+				LOC_U8Waiting = 1;
+				LOC_U64Press = LOC_Record.time;
+			}
+		}
+		else if(TRACE_RESET == LOC_Record.type){
+			worker->resets++;
+			LOC_U32Lamps = NO_LAMPS;
+			LOC_U8Conflict = 0;
+			LOC_U8Walk = 0;
+			if(LOC_U8Waiting){
+				// The press is lost by the reset
+				if(LOC_Record.time - LOC_U64Press > waitLimit) Violation(worker, file, LOC_Info->cabinet, LOC_Record.time, VIOLATION_WAIT);
+				worker->unanswered++;
+				LOC_U8Waiting = 0;
+			}
+			continue;
+		}
+		else if(LOC_Record.lamps != LOC_U32Lamps){
+			// One phase ended
+			if(NO_LAMPS != LOC_U32Lamps){
+				uint64_t LOC_U64Duration = LOC_Record.time - LOC_U64Start;
+				if(MAX_ASPECTS == LOC_U8Aspect) worker->otherPhases++;
+				else DistAdd(&worker->aspects[LOC_U8Aspect], LOC_U64Duration);
+				if(columns[0]){
+					uint32_t LOC_U32Row = worker->rows++;
+					worker->colCabinet[LOC_U32Row] = LOC_Info->cabinet;
+					worker->colStart[LOC_U32Row] = LOC_U64Start;
+					worker->colDuration[LOC_U32Row] = (LOC_U64Duration > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)LOC_U64Duration;
+					worker->colLamps[LOC_U32Row] = LOC_U32Lamps;
+					if(COLUMN_ROWS == worker->rows) FlushColumns(worker);
+				}
+			}
+			LOC_U32Lamps = LOC_Record.lamps;
+			LOC_U64Start = LOC_Record.time;
+			LOC_U8Aspect = AspectIndex(worker, LOC_U32Lamps, LOC_Info->lampNum);
+			uint8_t LOC_U8Both = HOST_LAMP_OFF != TRACE_LAMP(LOC_U32Lamps, LOC_Info->mainGreen)
+			                     && HOST_LAMP_OFF != TRACE_LAMP(LOC_U32Lamps, LOC_Info->walkGreen);
+			if(LOC_U8Both && !LOC_U8Conflict) Violation(worker, file, LOC_Info->cabinet, LOC_Record.time, VIOLATION_CONFLICT);
+			LOC_U8Conflict = LOC_U8Both;
+			LOC_U8Walk = HOST_LAMP_OFF != TRACE_LAMP(LOC_U32Lamps, LOC_Info->walkGreen);
+		}
+
+		// Answered at the crossing's green
+		if(LOC_U8Waiting && LOC_U8Walk){
+			uint64_t LOC_U64Wait = LOC_Record.time - LOC_U64Press;
+			DistAdd(&worker->wait, LOC_U64Wait);
+			if(LOC_U64Wait > waitLimit) Violation(worker, file, LOC_Info->cabinet, LOC_Record.time, VIOLATION_WAIT);
+			LOC_U8Waiting = 0;
+		}
+	}
+	if(LOC_Trace.error || !LOC_U8End) Violation(worker, file, LOC_Info->cabinet, LOC_Trace.time, VIOLATION_TRUNCATED);
+	if(LOC_U8Waiting){
+		if(LOC_Trace.time - LOC_U64Press > waitLimit) Violation(worker, file, LOC_Info->cabinet, LOC_Trace.time, VIOLATION_WAIT);
+		worker->unanswered++;
+	}
+	worker->traces++;
+	worker->records += LOC_U64Records;
+	worker->bytes += LOC_Trace.size;
+	worker->span += LOC_Trace.time;
+	TRACE_Unmap(&LOC_Trace);
+}
+
+static void* Worker(void* arg){
+	ST_Worker_t* LOC_Worker = (ST_Worker_t*)arg;
+	int LOC_File;
+	while((LOC_File = __atomic_fetch_add(&nextPath, 1, __ATOMIC_RELAXED)) < pathNum) Analyse(LOC_Worker, LOC_File);
+	if(columns[0]) FlushColumns(LOC_Worker);
+	return NULL;
+}
+
+/*
+ * Adds the counters of a thread to the first one.
+ */
+static void Merge(ST_Worker_t* into, const ST_Worker_t* from){
+	into->traces += from->traces;
+	into->invalid += from->invalid;
+	into->bytes += from->bytes;
+	into->records += from->records;
+	into->span += from->span;
+	into->presses += from->presses;
+	into->resets += from->resets;
+	into->unanswered += from->unanswered;
+	into->otherPhases += from->otherPhases;
+	for(int i=0; i<3; i++) into->violations[i] += from->violations[i];
+	for(uint8_t i=0; i<from->aspectNum; i++){
+		uint8_t LOC_U8Index = AspectIndex(into, from->aspectLamps[i], from->aspectLampNum[i]);
+		if(MAX_ASPECTS == LOC_U8Index) into->otherPhases += from->aspects[i].count;
+		else DistMerge(&into->aspects[LOC_U8Index], &from->aspects[i]);
+	}
+	DistMerge(&into->wait, &from->wait);
+	for(uint8_t i=0; i<from->listed; i++){
+		// Keep the first ones in the order of the command line
+		uint8_t j = into->listed;
+		if(j == MAX_VIOLATIONS){
+			const ST_Violation_t* LOC_Last = &into->list[j - 1];
+			if(from->list[i].file > LOC_Last->file || (from->list[i].file == LOC_Last->file && from->list[i].time >= LOC_Last->time)) continue;
+			j--;
+		}
+		else into->listed++;
+		while(j && (into->list[j - 1].file > from->list[i].file
+		            || (into->list[j - 1].file == from->list[i].file && into->list[j - 1].time > from->list[i].time))){
+			into->list[j] = into->list[j - 1];
+			j--;
+		}
+		into->list[j] = from->list[i];
+	}
+}
+
+static int CompareAspects(const void* a, const void* b){
+	const ST_Dist_t* LOC_A = *(ST_Dist_t* const*)a;
+	const ST_Dist_t* LOC_B = *(ST_Dist_t* const*)b;
+	return (LOC_A->count < LOC_B->count) - (LOC_A->count > LOC_B->count);
+}
+
+static int Stats(int argc, char** argv){
+	long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	const char* prefix = NULL;
+	int opt;
+	while(-1 != (opt = getopt(argc, argv, "j:w:o:"))){
+		switch(opt){
+			case 'j': jobs = atol(optarg); break;
+			case 'w': waitLimit = (uint64_t)(atof(optarg) * 1e6); break;
+			case 'o': prefix = optarg; break;
+			default: return -1;
+		}
+	}
+	paths = argv + optind;
+	pathNum = argc - optind;
+	if(!pathNum) return -1;
+	if(jobs < 1) jobs = 1;
+	if(jobs > pathNum) jobs = pathNum ? pathNum : 1;
+	if(prefix){
+		static const char* LOC_Names[4] = {"cabinet.u32", "start.u64", "duration.u32", "lamps.u32"};
+		for(int i=0; i<4; i++){
+			char LOC_Path[512];
+			snprintf(LOC_Path, sizeof(LOC_Path), "%s.%s", prefix, LOC_Names[i]);
+			columns[i] = fopen(LOC_Path, "wb");
+			if(!columns[i]){
+				perror(LOC_Path);
+				return 2;
+			}
+		}
+	}
+	ST_Worker_t* LOC_Workers = calloc(jobs, sizeof(ST_Worker_t));
+	if(!LOC_Workers){
+		perror("tracean");
+		return 2;
+	}
+
+	struct timespec LOC_Start, LOC_End;
+	clock_gettime(CLOCK_MONOTONIC, &LOC_Start);
+	for(long i=1; i<jobs; i++) pthread_create(&LOC_Workers[i].thread, NULL, Worker, &LOC_Workers[i]);
+	Worker(&LOC_Workers[0]);
+	for(long i=1; i<jobs; i++) pthread_join(LOC_Workers[i].thread, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &LOC_End);
+	double LOC_Seconds = (LOC_End.tv_sec - LOC_Start.tv_sec) + (LOC_End.tv_nsec - LOC_Start.tv_nsec) / 1e9;
+	for(long i=1; i<jobs; i++) Merge(&LOC_Workers[0], &LOC_Workers[i]);
+	for(int i=0; i<4; i++) if(columns[i] && fclose(columns[i])){
+		perror(prefix);
+		return 2;
+	}
+
+	ST_Worker_t* LOC_All = &LOC_Workers[0];
+	printf("%llu traces (%llu not valid), %.1f MB, %llu records, %ld threads\n", (unsigned long long)LOC_All->traces,
+	       (unsigned long long)LOC_All->invalid, LOC_All->bytes / 1e6, (unsigned long long)LOC_All->records, jobs);
+	printf("%.3f s, %.0f MB/s, %.1f million records/s\n", LOC_Seconds, LOC_All->bytes / 1e6 / LOC_Seconds,
+	       LOC_All->records / 1e6 / LOC_Seconds);
+	printf("%.1f days of traces, %llu presses, %llu resets\n", LOC_All->span / 86400e6,
+	       (unsigned long long)LOC_All->presses, (unsigned long long)LOC_All->resets);
+
+	ST_Dist_t* LOC_Sorted[MAX_ASPECTS];
+	for(uint8_t i=0; i<LOC_All->aspectNum; i++) LOC_Sorted[i] = &LOC_All->aspects[i];
+	qsort(LOC_Sorted, LOC_All->aspectNum, sizeof(LOC_Sorted[0]), CompareAspects);
+	printf("%-16s %10s %9s %8s %8s %9s\n", "lamps", "phases", "mean s", "p50 s", "p99 s", "max s");
+	for(uint8_t i=0; i<LOC_All->aspectNum; i++){
+		uint8_t LOC_U8Index = LOC_Sorted[i] - LOC_All->aspects;
+		char LOC_Lamps[TRACE_MAX_LAMPS + 1];
+		uint8_t LOC_U8LampNum = LOC_All->aspectLampNum[LOC_U8Index];
+		for(uint8_t k=0; k<LOC_U8LampNum; k++) LOC_Lamps[k] = lampChars[TRACE_LAMP(LOC_All->aspectLamps[LOC_U8Index], k)];
+		LOC_Lamps[LOC_U8LampNum] = '\0';
+		printf("%-16s ", LOC_Lamps);
+		PrintDist(LOC_Sorted[i]);
+	}
+	if(LOC_All->otherPhases) printf("%llu phases of other lamp combinations\n", (unsigned long long)LOC_All->otherPhases);
+	printf("%-16s ", "pedestrian wait");
+	PrintDist(&LOC_All->wait);
+	printf("%llu presses not answered (reset or end of the trace)\n", (unsigned long long)LOC_All->unanswered);
+	printf("%llu conflicting greens, %llu pedestrian waits over %.1f s, %llu traces truncated\n",
+	       (unsigned long long)LOC_All->violations[VIOLATION_CONFLICT], (unsigned long long)LOC_All->violations[VIOLATION_WAIT],
+	       waitLimit / 1e6, (unsigned long long)LOC_All->violations[VIOLATION_TRUNCATED]);
+	for(uint8_t i=0; i<LOC_All->listed; i++){
+		const ST_Violation_t* LOC_Violation = &LOC_All->list[i];
+		printf("  %s: cabinet %u at %.3f s: %s\n", paths[LOC_Violation->file], LOC_Violation->cabinet,
+		       LOC_Violation->time / 1e6, violationNames[LOC_Violation->kind]);
+	}
+	uint8_t LOC_U8Failed = LOC_All->invalid || LOC_All->violations[VIOLATION_CONFLICT] || LOC_All->violations[VIOLATION_TRUNCATED];
+	free(LOC_Workers);
+	return LOC_U8Failed ? 1 : 0;
+}
+
+static int Dump(const char* path){
+	ST_TraceReader_t LOC_Trace;
+	ST_TraceRecord_t LOC_Record;
+	if(!TRACE_Map(&LOC_Trace, path)){
+		fprintf(stderr, "tracean: %s is not a trace\n", path);
+		return 2;
+	}
+	printf("cabinet %u, %u lamps, main green %u, crossing green %u\n", LOC_Trace.info.cabinet, LOC_Trace.info.lampNum,
+	       LOC_Trace.info.mainGreen, LOC_Trace.info.walkGreen);
+	while(TRACE_Next(&LOC_Trace, &LOC_Record)){
+		printf("%llu.%03llu ", (unsigned long long)(LOC_Record.time / 1000), (unsigned long long)(LOC_Record.time % 1000));
+		switch(LOC_Record.type){
+			case TRACE_LAMPS:
+				for(uint8_t k=0; k<LOC_Trace.info.lampNum; k++) putchar(lampChars[TRACE_LAMP(LOC_Record.lamps, k)]);
+				putchar('\n');
+			break;
+			case TRACE_PRESS: printf("press\n"); break;
+			case TRACE_RESET: printf("reset\n"); break;
+			case TRACE_END: printf("end\n"); break;
+		}
+	}
+	if(LOC_Trace.error) printf("truncated\n");
+	TRACE_Unmap(&LOC_Trace);
+	return 0;
+}
+
+/************************************************************************/
+/*                       Synthetic corpus                               */
+/************************************************************************/
+
+// Options of the gen command
+static double days = 1, pressRate = 60, resetRate = 1;
+static long cabinets = 8, jobs;
+
+// Cabinet being simulated
+static ST_TraceWriter_t trace;
+static ST_HostPresses_t presses;
+static uint64_t endTime, nextReset;
+static uint64_t inputTime[4];
+static uint8_t inputType[4], inputHead, inputCount;
+static uint32_t lampsWritten = NO_LAMPS, lampsPending;
+static uint64_t pendingTime;
+static uint8_t pending;
+
+/*
+ * Writes the inputs delivered up to a time (the backend takes each event from the source ahead of its time).
+ */
+static void WriteInputs(uint64_t now){
+	while(inputCount && inputTime[inputHead] <= now){
+		uint64_t LOC_U64Time = (inputTime[inputHead] < trace.lastTime) ? trace.lastTime : inputTime[inputHead];
+		TRACE_Write(&trace, LOC_U64Time, inputType[inputHead], 0);
+		inputHead = (inputHead + 1) & 3;
+		inputCount--;
+	}
+}
+
+/*
+ * Writes the lamps reached at the end of the previous instant, if they changed.
+ */
+static void FlushLamps(void){
+	if(pending && lampsPending != lampsWritten){
+		TRACE_Write(&trace, pendingTime, TRACE_LAMPS, lampsPending);
+		lampsWritten = lampsPending;
+	}
+	pending = 0;
+}
+
+/*
+ * Input source: the next press or reset, then the end of the stream.
+ */
+static uint8_t Input(ST_HostEvent_t* event, void* arg){
+	(void)arg;
+	if((presses.next >= endTime && nextReset >= endTime) || 4 == inputCount) return 0;
+	uint8_t LOC_U8Slot = (inputHead + inputCount++) & 3;
+	if(presses.next <= nextReset){
+		HOST_PressInput(event, &presses);
+		inputType[LOC_U8Slot] = TRACE_PRESS;
+	}
+	else{
+		event->time = nextReset;
+		event->code = HOST_EV_CODE(HOST_EV_RESET, 0);
+		inputType[LOC_U8Slot] = TRACE_RESET;
+		nextReset += HOST_Arrival(resetRate / 24);
+	}
+	inputTime[LOC_U8Slot] = event->time;
+	return 1;
+}
+
+/*
+ * Output observer: keeps the lamps of the current instant.
+ */
+static void Output(uint64_t now, void* arg){
+	(void)arg;
+	if(pending && now != pendingTime) FlushLamps();
+	WriteInputs(now);
+	lampsPending = 0;
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++) lampsPending |= (uint32_t)HOST_Lamp(APP_Lamps[i].port, APP_Lamps[i].pin) << (2 * i);
+	pendingTime = now;
+	pending = 1;
+}
+
+/*
+ * Simulates one cabinet (in its own process).
+ * Return value: 0 on success, 2 if the trace can not be written
+ */
+static int GenOne(const char* path, uint32_t cabinet){
+	ST_TraceInfo_t LOC_Info = {APP_LAMP_NUM, APP_MAIN_GREEN, APP_LAMP_PED_GREEN, cabinet};
+	HOST_Seed = HOST_Seed * 0x9E3779B97F4A7C15ULL + cabinet + 1;
+	endTime = (uint64_t)(days * 24 * HOST_CYCLES_PER_HOUR);
+	HOST_PressStart(&presses, pressRate, endTime);
+	nextReset = HOST_Arrival(resetRate / 24);
+	if(!TRACE_OpenWrite(&trace, path, &LOC_Info)){
+		fprintf(stderr, "tracean: can not write %s\n", path);
+		return 2;
+	}
+	HOST_SetInput(Input, NULL);
+	HOST_SetOutput(Output, NULL);
+	HOST_Simulate(APP_Init, APP_Start, NULL, endTime);
+	FlushLamps();
+	WriteInputs(UINT64_MAX);
+	TRACE_Write(&trace, HOST_Time, TRACE_END, 0);
+	if(!TRACE_CloseWrite(&trace)){
+		fprintf(stderr, "tracean: can not write %s\n", path);
+		return 2;
+	}
+	return 0;
+}
+
+static uint8_t GenOption(int opt, const char* arg){
+	switch(opt){
+		case 'n': cabinets = atol(arg); break;
+		case 'd': days = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+		case 'b': resetRate = atof(arg); break;
+		case 'j': jobs = atol(arg); break;
+	}
+	return 1;
+}
+
+static int Gen(int argc, char** argv){
+	int running = 0, failed = 0, status;
+	jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	int LOC_First = HOST_Options(argc, argv, "n:d:r:b:s:j:", GenOption, NULL);
+	if(LOC_First < 0 || LOC_First + 1 != argc) return -1;
+	if(jobs < 1) jobs = 1;
+	struct timespec LOC_Start, LOC_End;
+	clock_gettime(CLOCK_MONOTONIC, &LOC_Start);
+	for(long i=0; i<cabinets || running; ){
+		if(i < cabinets && running < jobs){
+			char LOC_Path[512];
+			snprintf(LOC_Path, sizeof(LOC_Path), "%s/cabinet%04ld.tltr", argv[LOC_First], i);
+			pid_t pid = fork();
+			if(0 == pid) exit(GenOne(LOC_Path, (uint32_t)i));
+			if(pid < 0){ perror("fork"); return 2; }
+			running++;
+			i++;
+			continue;
+		}
+		if(wait(&status) > 0){
+			running--;
+			if(!WIFEXITED(status) || WEXITSTATUS(status)) failed++;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &LOC_End);
+	printf("%ld cabinets of %.1f days in %.1f s, %d failed\n", cabinets, days,
+	       (LOC_End.tv_sec - LOC_Start.tv_sec) + (LOC_End.tv_nsec - LOC_Start.tv_nsec) / 1e9, failed);
+	return failed ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+	int LOC_Result = -1;
+	if(argc >= 2 && !strcmp(argv[1], "stats")) LOC_Result = Stats(argc - 1, argv + 1);
+	else if(argc >= 2 && !strcmp(argv[1], "gen")) LOC_Result = Gen(argc - 1, argv + 1);
+	else if(argc == 3 && !strcmp(argv[1], "dump")) return Dump(argv[2]);
+	if(LOC_Result < 0){
+		fprintf(stderr, "usage: tracean stats [-j threads] [-w wait limit in seconds] [-o column prefix] <trace>...\n"
+		                "       tracean gen [-n cabinets] [-d days] [-r presses per hour] [-b resets per day] [-s seed] [-j jobs] <directory>\n"
+		                "       tracean dump <trace>\n");
+		LOC_Result = 2;
+	}
+	return LOC_Result;
+}
@@ -0,0 +1,164 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "cabsim" host tool, which checks the status register map read by the cabinet
+ * master over the TWI (MCAL/TWI and APP_REG_ of APP_Interface.h).
+ * The unmodified firmware runs on the host backend for a number of virtual minutes with button presses arriving
+ * at random (Poisson arrivals, fixed seed), while a master polls the whole map at random times around the poll rate:
+ * it writes the register pointer 0, then reads the APP_REG_NUM registers after a repeated START.
+ * The slave interrupt holds SCL low for the given number of cycles at each bus event (clock stretching).
+ * The tool checks that:
+ *   - every transaction is acknowledged and the layout register is APP_MAP_LAYOUT
+ *   - the snapshots never go back, and two reads of the same snapshot are identical (no read mixes two snapshots)
+ *   - the time register grows with the snapshot, and the snapshot read is at most a few half seconds old,
+ *     plus the length of the previous read when it just ended (the snapshots are skipped while the map is in use)
+ * and reports the bus time and throughput of the reads, the slave interrupts per byte, and the statistics of the driver.
+ * The tool needs the TWI build: it is compiled with -DTWI_ENABLE=1.
+ * Usage:
+ *   cabsim [-m minutes] [-k SCL kHz] [-c interrupt cycles] [-p polls per second] [-r presses per hour] [-s seed]
+ *     defaults: 10 minutes, 100 kHz, 40 cycles, 4 polls per second, 60 presses per hour, seed 1
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../HOST_Interface.h"
+#include "../../APP/APP_Interface.h"
+
+#if !TWI_ENABLE
+#error "cabsim needs -DTWI_ENABLE=1"
+#endif
+
+#define HALF_SECOND     500000ULL
+#define MAX_AGE         3U // half seconds: the tick jitter, the half second in progress and one snapshot skipped
+
+// Options
+static double minutes = 10, kHz = 100, pollRate = 4, pressRate = 60;
+static unsigned isrCycles = 40;
+
+// Simulation
+static ST_HostPresses_t presses;
+static uint64_t endTime, nextPoll;
+static uint64_t lastStart, lastEnd; // previous read
+static uint64_t reads, nacks, torn, backwards, badLayout, stale, events, bytes, busTime, busMax;
+static uint32_t ageMax;
+static uint8_t last[APP_REG_NUM], haveLast;
+static ST_TwiStats_t stats;
+
+static uint32_t Get32(const uint8_t* LOC_PtrMap, uint8_t LOC_U8Reg){
+	return LOC_PtrMap[LOC_U8Reg] | (uint32_t)LOC_PtrMap[LOC_U8Reg + 1] << 8 |
+	       (uint32_t)LOC_PtrMap[LOC_U8Reg + 2] << 16 | (uint32_t)LOC_PtrMap[LOC_U8Reg + 3] << 24;
+}
+
+/*
+ * Checks the map read by a transaction against the previous read.
+ */
+static void Check(const ST_HostTwi_t* txn){
+	if(3 != txn->acked){ // both address bytes and the pointer
+		nacks++;
+		return;
+	}
+	const uint8_t* LOC_PtrMap = txn->read;
+	reads++;
+	events += txn->events;
+	bytes += 1 + APP_REG_NUM;
+	busTime += txn->end - txn->time;
+	if(txn->end - txn->time > busMax) busMax = txn->end - txn->time;
+	if(APP_MAP_LAYOUT != LOC_PtrMap[APP_REG_LAYOUT]) badLayout++;
+	uint32_t LOC_U32Time = Get32(LOC_PtrMap, APP_REG_TIME);
+	uint64_t LOC_U64Now = txn->time / HALF_SECOND;
+	uint32_t LOC_U32Age = (LOC_U64Now > LOC_U32Time) ? (uint32_t)(LOC_U64Now - LOC_U32Time) : 0;
+	if(LOC_U32Age > ageMax) ageMax = LOC_U32Age;
+	uint32_t LOC_U32Limit = MAX_AGE;
+	if(lastEnd + MAX_AGE * HALF_SECOND > txn->time) LOC_U32Limit += (uint32_t)((lastEnd - lastStart) / HALF_SECOND) + 1;
+	if(LOC_U32Age > LOC_U32Limit && !(LOC_PtrMap[APP_REG_FAULTS] & APP_FAULT_FAIL_SAFE)) stale++;
+	lastStart = txn->time;
+	lastEnd = txn->end;
+	if(haveLast){
+		uint32_t LOC_U32LastTime = Get32(last, APP_REG_TIME);
+		if(LOC_PtrMap[APP_REG_SNAPSHOT] == last[APP_REG_SNAPSHOT]){
+			if(memcmp(LOC_PtrMap, last, APP_REG_NUM)) torn++;
+		}
+		else if(LOC_U32Time <= LOC_U32LastTime) backwards++;
+	}
+	memcpy(last, LOC_PtrMap, APP_REG_NUM);
+	haveLast = 1;
+}
+
+/*
+ * TWI master: checks the read that ended and polls the map again at a random time around the poll period.
+ */
+static uint8_t Master(ST_HostTwi_t* txn, void* arg){
+	(void)arg;
+	if(txn->end) Check(txn);
+	if(nextPoll < txn->end) nextPoll = txn->end; // the polls do not queue up behind a slow bus
+	if(nextPoll >= endTime) return 0;
+	txn->time = nextPoll;
+	txn->address = TWI_ADDRESS;
+	txn->writeLen = 1;
+	txn->write[0] = APP_REG_LAYOUT;
+	txn->readLen = APP_REG_NUM;
+	nextPoll += (uint64_t)(2 * HOST_Uniform() * 1e6 / pollRate) + 1;
+	return 1;
+}
+
+static void Done(void){
+	TWI_GetStats(&stats);
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'k': kHz = atof(arg); break;
+		case 'c': isrCycles = (unsigned)atoi(arg); break;
+		case 'p': pollRate = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+	}
+	return 1;
+}
+
+int main(int argc, char** argv){
+	if(HOST_Options(argc, argv, "m:k:c:p:r:s:", Option,
+	                "cabsim [-m minutes] [-k SCL kHz] [-c interrupt cycles] [-p polls per second] [-r presses per hour] [-s seed]") < 0) return 2;
+	if(minutes <= 0 || minutes > 60 * 24 * 7){
+		fprintf(stderr, "cabsim: the duration must be from 0 to 7 days\n");
+		return 2;
+	}
+	if(kHz < 0.02 || kHz > 400 || isrCycles > 10000 || pollRate <= 0 || pollRate > 1000){
+		fprintf(stderr, "cabsim: SCL from 0.02 to 400 kHz, up to 10000 interrupt cycles, up to 1000 polls per second\n");
+		return 2;
+	}
+	if(APP_REG_NUM > HOST_TWI_MAX){
+		fprintf(stderr, "cabsim: the map is larger than HOST_TWI_MAX\n");
+		return 2;
+	}
+
+	uint16_t LOC_U16Bit = (uint16_t)(1000.0 / kHz + 0.5);
+	endTime = (uint64_t)(minutes * 60e6);
+	HOST_PressStart(&presses, pressRate, endTime);
+	nextPoll = HALF_SECOND * 2; // after the first snapshots
+	HOST_SetInput(HOST_PressInput, &presses);
+	HOST_SetTwi(Master, LOC_U16Bit, (uint16_t)isrCycles, NULL);
+	HOST_Simulate(APP_Init, APP_Start, Done, endTime);
+
+	printf("%.0f minutes, %llu presses, SCL %u cycles (%g kHz), %u cycles per interrupt, %u registers\n", minutes,
+	       (unsigned long long)presses.count, LOC_U16Bit, 1000.0 / LOC_U16Bit, isrCycles, APP_REG_NUM);
+	printf("%llu reads, %llu not acknowledged\n", (unsigned long long)reads, (unsigned long long)nacks);
+	if(reads){
+		printf("read: %.0f us on average, %llu us at most, %.0f bytes per second on the bus, %.2f interrupts per byte\n",
+		       (double)busTime / reads, (unsigned long long)busMax, bytes * 1e6 / busTime, (double)events / bytes);
+		printf("controller time in the slave interrupt: %.0f cycles per read, %.3f %% of the CPU\n",
+		       (double)events * isrCycles / reads, events * isrCycles * 100.0 / endTime);
+	}
+	printf("snapshots: %llu mixed, %llu going back, %llu stale (oldest %u half seconds), %llu bad layouts\n",
+	       (unsigned long long)torn, (unsigned long long)backwards, (unsigned long long)stale, ageMax, (unsigned long long)badLayout);
+	printf("driver: %u reads, %u bytes, %u pointers, %u snapshots skipped (map in use), %u bus errors, interrupt %u timer counts at most\n",
+	       stats.reads, stats.bytes, stats.pointers, stats.busy, stats.errors, stats.cpuMax);
+	return !reads || nacks || torn || backwards || stale || badLayout;
+}
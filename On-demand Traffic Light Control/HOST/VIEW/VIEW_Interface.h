@@ -0,0 +1,69 @@
+/*
+ * File: VIEW_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the shared view of a controller running on the host backend:
+ * a file mapped in memory (mmap) by the host tool running the firmware and by any number of readers
+ * (dashboards, test scripts), which take consistent snapshots of it at any rate without a system call on either side.
+ * The tool publishes the simulated register file and the controller state into the view at its preemption points,
+ * where the firmware is between two statements. A publication is guarded by a sequence counter (seqlock):
+ * the counter is odd while the publication is written, a reader copies the view and keeps the copy only when
+ * the counter was even and unchanged before and after the copy, otherwise it copies again.
+ * The publisher never waits for the readers and the readers never block it.
+ * View file layout (host byte order, the offsets are those of ST_View_t, checked by the magic, version and size fields):
+ *   - magic "TLVW", layout version, size of the view
+ *   - sequence counter (32 bits, odd while a publication is written)
+ *   - publication number, virtual time in cycles (1 us)
+ *   - register file (data memory addresses 0x00..0x5F, PORTx/DDRx/PINx at their ATmega32 addresses)
+ *   - lamps in the order of APP/APP_Signals.txt (HOST_LAMP_OFF, ON or FLASH), shift register outputs
+ *   - statistics counters (STATS_Interface.h), running flag, copy of the publication number written last
+ * The functions prototypes defined in this file include:
+ *   - VIEW_Create, VIEW_Attach, VIEW_Close: functions to create, map and unmap a view file
+ *   - VIEW_Begin, VIEW_End: functions to open and close a publication (publisher)
+ *   - VIEW_Snapshot: function to take a consistent copy of the view (reader)
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef VIEW_INTERFACE_H_
+#define VIEW_INTERFACE_H_
+
+#include "../HOST_Interface.h"
+#include "../../SERVICES/STATS/STATS_Interface.h"
+
+#define VIEW_MAGIC   0x57564C54UL // "TLVW"
+#define VIEW_VERSION 1
+
+// Lamps in the view (the application may use less, see lampNum)
+#define VIEW_LAMPS 16
+
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t size;                        // sizeof(ST_View_t)
+	uint32_t seq;                         // sequence counter, odd while a publication is written
+	uint32_t reserved;
+	// Written under the sequence counter
+	uint64_t serial;                      // publication number, from 1
+	uint64_t time;                        // virtual time in cycles (1 us)
+	uint8_t regs[HOST_IO_SIZE];           // register file
+	uint8_t lamps[VIEW_LAMPS];            // HOST_LAMP_OFF, HOST_LAMP_ON or HOST_LAMP_FLASH
+	uint8_t shift[HOST_SHIFT_CHIPS];      // latched outputs of the shift register chain
+	uint16_t counters[STATS_COUNTER_NUM]; // STATS_PRESSES...
+	uint8_t lampNum;
+	uint8_t running;                      // 0 once the run ended
+	uint8_t pad[6];
+	uint64_t check;                       // equal to serial in a consistent copy
+} ST_View_t;
+
+// VIEW function prototypes
+ST_View_t* VIEW_Create(const char* path);
+const ST_View_t* VIEW_Attach(const char* path);
+void VIEW_Close(const ST_View_t* view);
+void VIEW_Begin(ST_View_t* view);
+void VIEW_End(ST_View_t* view);
+uint32_t VIEW_Snapshot(const ST_View_t* view, ST_View_t* copy);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * File: VIEW_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the shared view declared in VIEW_Interface.h.
+ * The view file is mapped shared, so the stores of the publisher are seen by the readers through the page cache
+ * with no system call once it is mapped. The sequence counter uses the GCC atomic builtins:
+ * the publisher makes it odd before writing (release fence after the store) and even after (release store),
+ * the reader loads it before the copy (acquire) and again after an acquire fence.
+ * A reader that sees an odd counter or a different one after its copy raced with a publication and copies again,
+ * it yields the CPU every 255 attempts in case the publisher was preempted in the middle of a publication.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "VIEW_Interface.h"
+
+/*
+ * Function: VIEW_Create()
+ * Description: Creates (or truncates) the view file and maps it for writing, with an empty view.
+ * Arguments:
+ *   - path: path of the view file, for example in /dev/shm to keep it in memory
+ * Returns: the view, NULL on error (reported on stderr)
+ */
+ST_View_t* VIEW_Create(const char* path){
+	int LOC_Fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(LOC_Fd < 0 || ftruncate(LOC_Fd, sizeof(ST_View_t))){
+		perror(path);
+		if(LOC_Fd >= 0) close(LOC_Fd);
+		return NULL;
+	}
+	ST_View_t* LOC_PtrView = mmap(NULL, sizeof(ST_View_t), PROT_READ | PROT_WRITE, MAP_SHARED, LOC_Fd, 0);
+	close(LOC_Fd);
+	if(MAP_FAILED == LOC_PtrView){
+		perror(path);
+		return NULL;
+	}
+	LOC_PtrView->version = VIEW_VERSION;
+	LOC_PtrView->size = sizeof(ST_View_t);
+	__atomic_store_n(&LOC_PtrView->magic, VIEW_MAGIC, __ATOMIC_RELEASE);
+	return LOC_PtrView;
+}
+
+/*
+ * Function: VIEW_Attach()
+ * Description: Maps an existing view file for reading and checks its layout.
+ * Arguments:
+ *   - path: path of the view file
+ * Returns: the view, NULL on error (reported on stderr)
+ */
+const ST_View_t* VIEW_Attach(const char* path){
+	int LOC_Fd = open(path, O_RDONLY);
+	if(LOC_Fd < 0){
+		perror(path);
+		return NULL;
+	}
+	if(lseek(LOC_Fd, 0, SEEK_END) < (off_t)sizeof(ST_View_t)){
+		fprintf(stderr, "%s: not a view file\n", path);
+		close(LOC_Fd);
+		return NULL;
+	}
+	const ST_View_t* LOC_PtrView = mmap(NULL, sizeof(ST_View_t), PROT_READ, MAP_SHARED, LOC_Fd, 0);
+	close(LOC_Fd);
+	if(MAP_FAILED == LOC_PtrView){
+		perror(path);
+		return NULL;
+	}
+	if(VIEW_MAGIC != __atomic_load_n(&LOC_PtrView->magic, __ATOMIC_ACQUIRE) || VIEW_VERSION != LOC_PtrView->version
+	   || sizeof(ST_View_t) != LOC_PtrView->size){
+		fprintf(stderr, "%s: not a view file of this version\n", path);
+		VIEW_Close(LOC_PtrView);
+		return NULL;
+	}
+	return LOC_PtrView;
+}
+
+void VIEW_Close(const ST_View_t* view){
+	munmap((void*)view, sizeof(ST_View_t));
+}
+
+/*
+ * Function: VIEW_Begin()
+ * Description: Opens a publication: the sequence counter becomes odd before any field is written.
+ */
+void VIEW_Begin(ST_View_t* view){
+	__atomic_store_n(&view->seq, view->seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/*
+ * Function: VIEW_End()
+ * Description: Closes a publication: the sequence counter becomes even after all the fields are written.
+ */
+void VIEW_End(ST_View_t* view){
+	__atomic_store_n(&view->seq, view->seq + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Function: VIEW_Snapshot()
+ * Description: Copies the view as it was between two publications, retrying while one is being written.
+ * Arguments:
+ *   - view: the view mapped by VIEW_Attach
+ *   - copy: where to copy it
+ * Returns: the number of copies thrown away because a publication was being written (0 most of the time)
+ */
+uint32_t VIEW_Snapshot(const ST_View_t* view, ST_View_t* copy){
+	uint32_t LOC_U32Retries = 0;
+	while(1){
+		uint32_t LOC_U32Before = __atomic_load_n(&view->seq, __ATOMIC_ACQUIRE);
+		if(!(LOC_U32Before & 1)){
+			memcpy(copy, view, sizeof(ST_View_t));
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if(LOC_U32Before == __atomic_load_n(&view->seq, __ATOMIC_RELAXED)) return LOC_U32Retries;
+		}
+		// On a single CPU the publisher may have been preempted in the middle of a publication
+		if(0xFF == (++LOC_U32Retries & 0xFF)) sched_yield();
+	}
+}
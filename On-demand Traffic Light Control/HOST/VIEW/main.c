@@ -0,0 +1,228 @@
+/*
+ * File: main.c
+ *
+ * Description:
+ * This file is the entry point of the "hostview" host tool, which shares the state of a controller running
+ * on the host backend with other processes through a view file mapped in memory (VIEW_Interface.h).
+ * The run command runs the unmodified firmware with button presses arriving at random (Poisson arrivals, fixed seed),
+ * and publishes the register file, the lamps, the shift register outputs and the statistics counters at every
+ * preemption point (output write, poll of a hardware flag, main loop pass). A publication is a few stores
+ * into the mapped memory, no system call. The run goes as fast as it can, or is paced to a multiple of the real time.
+ * It reports how fast the controller ran (virtual seconds and preemption points per second of CPU time),
+ * without publishing (-n) to compare, and the time of one publication measured over a million of them after the run.
+ * The bench command is the reader benchmark: it takes snapshots in a loop and reports their rate, the copies thrown away
+ * because a publication was being written, the publications seen, and checks that every snapshot is consistent
+ * (its last field equal to its publication number) and that they never go back in time.
+ * The watch command prints a line each time the lamps or the counters change, like a dashboard would.
+ * Usage:
+ *   hostview run [-m minutes] [-r presses per hour] [-s seed] [-x speed] [-n] <view file>
+ *     defaults: 60 minutes, 60 presses per hour, seed 1, as fast as possible (-x 1 is real time)
+ *   hostview bench [-t seconds] [-f snapshots per second] <view file>
+ *     defaults: 10 seconds or until the run ends, as many snapshots as possible
+ *   hostview watch <view file>
+ *     lamps in the order of APP/APP_Signals.txt: '-' off, '#' on, '*' flashing
+ * Build: see the "Host Backend" section of README.md.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "VIEW_Interface.h"
+#include "../../APP/APP_Interface.h"
+#include "../../APP/APP_Signals.h"
+
+// Options
+static double minutes = 60, pressRate = 60, speed = 0, seconds = 10, rate = 0;
+static uint8_t noPublish;
+
+// Run
+static ST_View_t* view;
+static ST_HostPresses_t presses;
+static uint64_t endTime, points, serial;
+static double startTime;
+
+/*
+ * Monotonic clock in seconds.
+ */
+static double Now(void){
+	struct timespec LOC_Ts;
+	clock_gettime(CLOCK_MONOTONIC, &LOC_Ts);
+	return LOC_Ts.tv_sec + LOC_Ts.tv_nsec / 1e9;
+}
+
+/*
+ * Writes one publication into the view.
+ */
+static void Publish(uint8_t LOC_U8Running){
+	VIEW_Begin(view);
+	view->serial = ++serial;
+	view->time = HOST_Time;
+	memcpy(view->regs, (const uint8_t*)HOST_IoSpace, HOST_IO_SIZE);
+	for(uint8_t i=0; i<APP_LAMP_NUM; i++) view->lamps[i] = HOST_Lamp(APP_Lamps[i].port, APP_Lamps[i].pin);
+	for(uint8_t i=0; i<HOST_SHIFT_CHIPS; i++) view->shift[i] = HOST_Shift(i);
+	memcpy(view->counters, STATS_Data.counter, sizeof(view->counters));
+	view->lampNum = APP_LAMP_NUM;
+	view->running = LOC_U8Running;
+	view->check = serial;
+	VIEW_End(view);
+}
+
+/*
+ * Preemption hook: publishes the state, and waits for the real time when the run is paced.
+ */
+static void Preempt(uint64_t now, void* arg){
+	(void)arg;
+	points++;
+	if(!noPublish) Publish(1);
+	if(speed > 0){
+		double LOC_Ahead = now / 1e6 / speed - (Now() - startTime);
+		if(LOC_Ahead > 0.001) usleep((useconds_t)(LOC_Ahead * 1e6));
+	}
+}
+
+static int Run(const char* path){
+	if(!(view = VIEW_Create(path))) return 2;
+	endTime = (uint64_t)(minutes * 60e6);
+	HOST_PressStart(&presses, pressRate, endTime);
+	HOST_SetInput(HOST_PressInput, &presses);
+	HOST_SetPreempt(Preempt, NULL);
+	startTime = Now();
+	double LOC_Cpu = (double)clock();
+	HOST_Simulate(APP_Init, APP_Start, NULL, endTime);
+	LOC_Cpu = ((double)clock() - LOC_Cpu) / CLOCKS_PER_SEC;
+	double LOC_Wall = Now() - startTime;
+	double LOC_Cost = 0;
+	if(!noPublish){
+		LOC_Cost = Now();
+		for(uint32_t i=0; i<1000000; i++) Publish(1);
+		LOC_Cost = (Now() - LOC_Cost) * 1e3; // ns per publication
+	}
+	Publish(0);
+
+	printf("%.0f minutes, %llu presses, %s\n", minutes, (unsigned long long)presses.count,
+	       noPublish ? "not published" : "published at every preemption point");
+	printf("%llu preemption points, %llu publications, %.3f s (%.3f s of CPU time)\n", (unsigned long long)points,
+	       (unsigned long long)serial, LOC_Wall, LOC_Cpu);
+	if(LOC_Cpu > 0) printf("%.0f times real time, %.0f preemption points per second of CPU time (%.0f ns each)\n",
+	                       HOST_Time / 1e6 / LOC_Cpu, points / LOC_Cpu, LOC_Cpu * 1e9 / points);
+	if(!noPublish) printf("%.0f ns per publication (1000000 more after the run)\n", LOC_Cost);
+	VIEW_Close(view);
+	return 0;
+}
+
+/*
+ * Waits for the first publication of a run, 10 seconds at most.
+ */
+static const ST_View_t* Open(const char* path, ST_View_t* copy){
+	const ST_View_t* LOC_PtrView = VIEW_Attach(path);
+	if(!LOC_PtrView) return NULL;
+	for(uint16_t i=0; i<1000; i++){
+		VIEW_Snapshot(LOC_PtrView, copy);
+		if(copy->serial) return LOC_PtrView;
+		usleep(10000);
+	}
+	fprintf(stderr, "%s: nothing published\n", path);
+	VIEW_Close(LOC_PtrView);
+	return NULL;
+}
+
+static int Bench(const char* path){
+	ST_View_t LOC_Copy;
+	const ST_View_t* LOC_PtrView = Open(path, &LOC_Copy);
+	if(!LOC_PtrView) return 2;
+	uint64_t LOC_U64Snaps = 0, LOC_U64Retries = 0, LOC_U64Seen = 0, LOC_U64Torn = 0, LOC_U64Back = 0;
+	uint64_t LOC_U64Last = LOC_Copy.serial, LOC_U64FirstSerial = LOC_Copy.serial, LOC_U64FirstTime = LOC_Copy.time;
+	uint16_t LOC_U16Batch = (rate > 0) ? 1 : 1024;
+	double LOC_Start = Now(), LOC_Elapsed = 0;
+	while(LOC_Copy.running && LOC_Elapsed < seconds){
+		for(uint16_t i=0; i<LOC_U16Batch; i++){
+			LOC_U64Retries += VIEW_Snapshot(LOC_PtrView, &LOC_Copy);
+			LOC_U64Snaps++;
+			if(LOC_Copy.check != LOC_Copy.serial) LOC_U64Torn++;
+			if(LOC_Copy.serial < LOC_U64Last) LOC_U64Back++;
+			if(LOC_Copy.serial != LOC_U64Last) LOC_U64Seen++;
+			LOC_U64Last = LOC_Copy.serial;
+		}
+		LOC_Elapsed = Now() - LOC_Start;
+		if(rate > 0){
+			double LOC_Wait = LOC_U64Snaps / rate - LOC_Elapsed;
+			if(LOC_Wait > 0) usleep((useconds_t)(LOC_Wait * 1e6));
+		}
+	}
+
+	printf("%llu snapshots in %.3f s: %.0f per second, %llu copies retried\n", (unsigned long long)LOC_U64Snaps,
+	       LOC_Elapsed, LOC_U64Snaps / LOC_Elapsed, (unsigned long long)LOC_U64Retries);
+	printf("%llu publications during the bench (%.0f per second), %llu seen, controller at %.0f times real time\n",
+	       (unsigned long long)(LOC_Copy.serial - LOC_U64FirstSerial), (LOC_Copy.serial - LOC_U64FirstSerial) / LOC_Elapsed,
+	       (unsigned long long)LOC_U64Seen, (LOC_Copy.time - LOC_U64FirstTime) / 1e6 / LOC_Elapsed);
+	printf("%llu inconsistent snapshots, %llu back in time\n", (unsigned long long)LOC_U64Torn, (unsigned long long)LOC_U64Back);
+	VIEW_Close(LOC_PtrView);
+	return (LOC_U64Torn || LOC_U64Back) ? 1 : 0;
+}
+
+static int Watch(const char* path){
+	static const char LOC_Lamp[3] = {'-', '#', '*'};
+	ST_View_t LOC_Copy, LOC_Shown;
+	const ST_View_t* LOC_PtrView = Open(path, &LOC_Copy);
+	if(!LOC_PtrView) return 2;
+	memset(&LOC_Shown, 0xFF, sizeof(LOC_Shown));
+	do{
+		usleep(10000);
+		VIEW_Snapshot(LOC_PtrView, &LOC_Copy);
+		if(!memcmp(LOC_Copy.lamps, LOC_Shown.lamps, sizeof(LOC_Copy.lamps))
+		   && !memcmp(LOC_Copy.counters, LOC_Shown.counters, sizeof(LOC_Copy.counters))) continue;
+		char LOC_Line[VIEW_LAMPS + 1];
+		for(uint8_t i=0; i<LOC_Copy.lampNum && i<VIEW_LAMPS; i++) LOC_Line[i] = LOC_Lamp[LOC_Copy.lamps[i] % 3];
+		LOC_Line[(LOC_Copy.lampNum < VIEW_LAMPS) ? LOC_Copy.lampNum : VIEW_LAMPS] = '\0';
+		printf("%10.3f s %s presses=%u accepted=%u cycles=%u\n", LOC_Copy.time / 1e6, LOC_Line,
+		       LOC_Copy.counters[STATS_PRESSES], LOC_Copy.counters[STATS_ACCEPTED], LOC_Copy.counters[STATS_CYCLES]);
+		fflush(stdout);
+		LOC_Shown = LOC_Copy;
+	}while(LOC_Copy.running);
+	VIEW_Close(LOC_PtrView);
+	return 0;
+}
+
+static uint8_t Option(int opt, const char* arg){
+	switch(opt){
+		case 'm': minutes = atof(arg); break;
+		case 'r': pressRate = atof(arg); break;
+		case 'x': speed = atof(arg); break;
+		case 'n': noPublish = 1; break;
+		case 't': seconds = atof(arg); break;
+		case 'f': rate = atof(arg); break;
+	}
+	return 1;
+}
+
+static int Usage(void){
+	fprintf(stderr, "usage: hostview run [-m minutes] [-r presses per hour] [-s seed] [-x speed] [-n] <view file>\n"
+	                "       hostview bench [-t seconds] [-f snapshots per second] <view file>\n"
+	                "       hostview watch <view file>\n");
+	return 2;
+}
+
+int main(int argc, char** argv){
+	if(argc < 2) return Usage();
+	const char* LOC_Cmd = argv[1];
+	argc--;
+	argv++;
+	int LOC_First = HOST_Options(argc, argv, "m:r:s:x:nt:f:", Option, NULL);
+	if(LOC_First < 0 || LOC_First + 1 != argc) return Usage();
+	if(!strcmp(LOC_Cmd, "run")){
+		if(minutes <= 0 || minutes > 60 * 24 * 366){
+			fprintf(stderr, "hostview: the duration must be from 0 to 366 days\n");
+			return 2;
+		}
+		return Run(argv[LOC_First]);
+	}
+	if(!strcmp(LOC_Cmd, "bench")) return Bench(argv[LOC_First]);
+	if(!strcmp(LOC_Cmd, "watch")) return Watch(argv[LOC_First]);
+	return Usage();
+}
@@ -0,0 +1,54 @@
+/*
+ * File: ACOMP_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to interact with the analog comparator in this project.
+ * It defines the ACSR bits and the vector.
+ * The comparator watches the supply: the raw supply, divided down, is on AIN1 (PB3) and the internal bandgap
+ * reference (1.23 V) on the positive input, so the output (ACO) goes high when the supply droops under the threshold
+ * set by the divider. The interrupt is taken on the rising edge of the output, a few microseconds after the droop,
+ * whatever the main loop is doing.
+ * The functions prototypes defined in this file include:
+ *   - ACOMP_Init: function to select the inputs and the interrupt edge, the interrupt stays disabled
+ *   - ACOMP_SetCallback: function to register the function called by the interrupt
+ *   - ACOMP_EnableInt, ACOMP_DisableInt: functions to control the interrupt
+ *   - ACOMP_Output: function to read the comparator output
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef ACOMP_INTERFACE_H
+#define ACOMP_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "ACOMP_Private.h"
+
+// ACSR bits
+#define ACIS0 0
+#define ACIS1 1
+#define ACIC  2
+#define ACIE  3
+#define ACI   4
+#define ACO   5
+#define ACBG  6
+#define ACD   7
+
+// SREG bits
+#define SREG_I 7
+
+// Interrupts vector
+#define ACOMP_VECT __vector_18
+
+typedef void (*ACOMP_Callback_t)(void);
+
+// ACOMP function prototypes
+void ACOMP_Init(void);
+void ACOMP_SetCallback(ACOMP_Callback_t LOC_PtrCallback);
+void ACOMP_EnableInt(void);
+void ACOMP_DisableInt(void);
+uint8_t ACOMP_Output(void);
+
+#endif
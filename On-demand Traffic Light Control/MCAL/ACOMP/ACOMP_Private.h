@@ -0,0 +1,22 @@
+/*
+ * File: ACOMP_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control the analog comparator in this project.
+ * It defines pointers to the registers ACSR, which holds the comparator control bits, its output and its interrupt flag,
+ * and the status register (SREG) holding the global interrupt enable bit.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef ACOMP_PRIVATE_H
+#define ACOMP_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define ACSR  IO_REG8(0x28) // Analog Comparator Control and Status Register
+#define SREG  IO_REG8(0x5F) // Status Register
+
+#endif
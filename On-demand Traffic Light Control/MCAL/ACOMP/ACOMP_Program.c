@@ -0,0 +1,93 @@
+/*
+ * File: ACOMP_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions used to interact with the analog comparator in this project.
+ * The functions implemented include:
+ *   - ACOMP_Init: function to select the bandgap and AIN1 inputs and the rising edge interrupt
+ *   - ACOMP_SetCallback: function to register the interrupt callback
+ *   - ACOMP_EnableInt, ACOMP_DisableInt: functions to control the interrupt
+ *   - ACOMP_Output: function to read the output
+ * Changing the inputs or the edge can set the interrupt flag (and the bandgap settles in about 70 us),
+ * so the interrupt is enabled separately, the flag being cleared first.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "ACOMP_Interface.h"
+#include "../GPIO/GPIO_Interface.h"
+#include "../EXTI/EXTI_Interface.h"
+
+static void ACOMP_Ignore(void);
+
+static volatile ACOMP_Callback_t ACOMP_Callback = ACOMP_Ignore;
+
+/*
+ * Function: ACOMP_Ignore()
+ * Description: Callback used until one is registered, it stops the interrupt.
+ */
+static void ACOMP_Ignore(void){
+	CLR_BIT(ACSR, ACIE);
+}
+
+/*
+ * Function: ACOMP_Init()
+ * Description: This function sets AIN1 (PB3) as an input without pull-up and turns the comparator on
+ * with the bandgap reference on the positive input, the interrupt on the rising edge of the output and disabled.
+ * Return value: void
+ */
+void ACOMP_Init(void){
+	GPIO_SetPinDir(PORTB, PIN3, INPUT);
+	GPIO_SetPinVal(PORTB, PIN3, LOW);
+	ACSR = (1<<ACBG) | (1<<ACIS1) | (1<<ACIS0); // ACD cleared: comparator on
+}
+
+/*
+ * Function: ACOMP_SetCallback()
+ * Description: This function registers the function called by the interrupt, a null pointer removes it.
+ * The callback runs in the interrupt, with the interrupts disabled.
+ * Arguments:
+ *   - LOC_PtrCallback: the function to call
+ * Return value: void
+ */
+void ACOMP_SetCallback(ACOMP_Callback_t LOC_PtrCallback){
+	ACOMP_Callback = LOC_PtrCallback ? LOC_PtrCallback : ACOMP_Ignore;
+}
+
+/*
+ * Function: ACOMP_EnableInt()
+ * Description: This function clears the interrupt flag (written to one) and enables the interrupt,
+ * an edge seen while it was disabled is forgotten.
+ * Return value: void
+ */
+void ACOMP_EnableInt(void){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	SET_BIT(ACSR, ACI);
+	SET_BIT(ACSR, ACIE);
+	if(LOC_U8Interrupts) CPU_SEI();
+}
+
+/*
+ * Function: ACOMP_DisableInt()
+ * Description: This function disables the interrupt.
+ * Return value: void
+ */
+void ACOMP_DisableInt(void){
+	CLR_BIT(ACSR, ACIE);
+}
+
+/*
+ * Function: ACOMP_Output()
+ * Description: This function reads the comparator output.
+ * Return value: 1 when the supply is under the threshold (AIN1 under the bandgap), 0 otherwise
+ */
+uint8_t ACOMP_Output(void){
+	return GET_BIT(ACSR, ACO);
+}
+
+ISR(ACOMP_VECT){
+	ACOMP_Callback();
+}
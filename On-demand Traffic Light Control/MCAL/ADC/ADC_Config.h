@@ -0,0 +1,26 @@
+/*
+ * File: ADC_Config.h
+ *
+ * Description:
+ * This header file contains the configuration macros for the ADC in this project.
+ * The ADC runs in free running mode and scans a list of channels from its conversion complete interrupt.
+ * With F_CPU = 1 MHz and a prescaler of 128 the ADC clock is 7.8 kHz: a conversion takes 13 ADC clocks (1664 us),
+ * 601 conversions per second shared by the channels. The lamp currents only need 8 bits, so the slow clock is enough
+ * and keeps the interrupt load low.
+ * The average of each channel is an exponential average over 2^ADC_AVG_SHIFT samples,
+ * kept in fixed point with ADC_AVG_SHIFT fraction bits (16 samples, 53 ms with two channels).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef ADC_CONFIG_H_
+#define ADC_CONFIG_H_
+
+#define ADC_PRESCALER    ADC_DIV_128
+#define ADC_REFERENCE    ADC_REF_AVCC
+#define ADC_MAX_CHANNELS 8
+#define ADC_AVG_SHIFT    4
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * File: ADC_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to interact with the ADC in this project.
+ * It defines the ADC register bits, the clock prescalers, the references and the vector.
+ * The ADC only scans a list of channels in free running mode (auto triggered by the end of each conversion):
+ * the conversion complete interrupt adds each 8-bit result (left adjusted, ADCH) to the running average of its channel
+ * and selects the channel after the next one, since the next conversion has already started when the interrupt runs.
+ * The interrupt does the same work for every sample, so its cost is constant, and the CPU never waits for a conversion.
+ * The functions prototypes defined in this file include:
+ *   - ADC_StartScan: function to start scanning a list of channels
+ *   - ADC_StopScan: function to stop the conversions
+ *   - ADC_GetAverage: function to get the running average of a channel of the list
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef ADC_INTERFACE_H
+#define ADC_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "ADC_Private.h"
+#include "ADC_Config.h"
+
+// ADMUX bits
+#define ADLAR 5
+#define REFS0 6
+#define REFS1 7
+
+// ADCSRA bits
+#define ADPS0 0
+#define ADIE  3
+#define ADIF  4
+#define ADATE 5
+#define ADSC  6
+#define ADEN  7
+
+// SFIOR bits
+#define ADTS0 5
+
+// SREG bits
+#define SREG_I 7
+
+// Interrupts vector
+#define ADC_CC __vector_16
+
+// Clock prescalers, the values are the ADPS bits
+#define ADC_DIV_2   1
+#define ADC_DIV_4   2
+#define ADC_DIV_8   3
+#define ADC_DIV_16  4
+#define ADC_DIV_32  5
+#define ADC_DIV_64  6
+#define ADC_DIV_128 7
+
+// References, the values are the REFS bits
+#define ADC_REF_AREF     0x00
+#define ADC_REF_AVCC     (1<<REFS0)
+#define ADC_REF_INTERNAL ((1<<REFS1) | (1<<REFS0)) // 2.56 V
+
+// Largest average: full scale with ADC_AVG_SHIFT fraction bits
+#define ADC_AVG_MAX (255U << ADC_AVG_SHIFT)
+
+// ADC function prototypes
+void ADC_StartScan(const uint8_t* LOC_PtrChannels, uint8_t LOC_U8Num);
+void ADC_StopScan(void);
+uint16_t ADC_GetAverage(uint8_t LOC_U8Index);
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * File: ADC_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control the ADC in this project.
+ * It defines pointers to the registers ADMUX, ADCSRA, ADCH, ADCL and SFIOR which are used for selecting
+ * the reference and the channel, controlling the conversions, reading the result and selecting the auto trigger source,
+ * and the status register (SREG) holding the global interrupt enable bit.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef ADC_PRIVATE_H
+#define ADC_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define ADMUX   IO_REG8(0x27) // ADC Multiplexer Selection Register
+#define ADCSRA  IO_REG8(0x26) // ADC Control and Status Register A
+#define ADCH    IO_REG8(0x25) // ADC Data Register High Byte
+#define ADCL    IO_REG8(0x24) // ADC Data Register Low Byte
+#define SFIOR   IO_REG8(0x50) // Special Function IO Register (auto trigger source)
+#define SREG    IO_REG8(0x5F)  // Status Register
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * File: ADC_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions used to interact with the ADC in this project.
+ * The functions implemented include:
+ *   - ADC_StartScan, ADC_StopScan: functions to start and stop the free running scan of a list of channels
+ *   - ADC_GetAverage: function to read the running average of a channel
+ * In free running mode the next conversion starts as soon as one completes, with the channel selected at that time,
+ * so a channel written in ADMUX by the interrupt is converted after the conversion in progress:
+ * ADC_Slot is the channel of the result read by the interrupt, ADC_Next the channel converted meanwhile.
+ * The first channel is converted twice at the start. ADIF is cleared by the hardware when the interrupt is served.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "ADC_Interface.h"
+#include "../EXTI/EXTI_Interface.h"
+
+static const uint8_t* ADC_Channels;                 // channels scanned
+static uint8_t ADC_Num;
+static uint8_t ADC_Slot;                            // channel of the conversion completed next
+static uint8_t ADC_Next;                            // channel of the conversion after it
+static volatile uint16_t ADC_Average[ADC_MAX_CHANNELS]; // exponential averages, ADC_AVG_SHIFT fraction bits
+
+/*
+ * Function: ADC_StartScan()
+ * Description: This function starts the scan of a list of channels: free running mode, 8-bit results,
+ * reference and prescaler from ADC_Config.h, conversion complete interrupt enabled. The averages start from 0.
+ * The interrupts are enabled later (EXTI_Init), the first conversion takes 25 ADC clocks.
+ * Arguments:
+ *   - LOC_PtrChannels: the channels (0 to 7, PIN 0 to PIN 7 in PORTA), the list must stay valid while the scan runs
+ *   - LOC_U8Num: the number of channels (1 to ADC_MAX_CHANNELS)
+ * Return value: void
+ */
+void ADC_StartScan(const uint8_t* LOC_PtrChannels, uint8_t LOC_U8Num){
+	if(!LOC_U8Num || LOC_U8Num > ADC_MAX_CHANNELS) return;
+	ADCSRA = 0; // stop a scan in progress
+	ADC_Channels = LOC_PtrChannels;
+	ADC_Num = LOC_U8Num;
+	ADC_Slot = 0;
+	ADC_Next = 0;
+	for(uint8_t i=0; i<ADC_MAX_CHANNELS; i++) ADC_Average[i] = 0;
+	ADMUX = ADC_REFERENCE | (1<<ADLAR) | LOC_PtrChannels[0];
+	SFIOR &= ~(0x07<<ADTS0); // auto trigger source: free running
+	ADCSRA = (1<<ADEN) | (1<<ADSC) | (1<<ADATE) | (1<<ADIF) | (1<<ADIE) | ADC_PRESCALER; // ADIF is cleared by writing one
+}
+
+/*
+ * Function: ADC_StopScan()
+ * Description: This function stops the conversions and turns the ADC off, the averages keep their last value.
+ * Return value: void
+ */
+void ADC_StopScan(void){
+	ADCSRA = 0;
+}
+
+/*
+ * Function: ADC_GetAverage()
+ * Description: This function reads the running average of a channel of the list, with the interrupts disabled
+ * around the 16-bit read so the conversion complete interrupt can not change it halfway.
+ * Arguments:
+ *   - LOC_U8Index: the index of the channel in the list given to ADC_StartScan
+ * Return value: the average in fixed point (8-bit result << ADC_AVG_SHIFT, up to ADC_AVG_MAX), 0 for an index outside the list
+ */
+uint16_t ADC_GetAverage(uint8_t LOC_U8Index){
+	if(LOC_U8Index >= ADC_Num) return 0;
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	uint16_t LOC_U16Average = ADC_Average[LOC_U8Index];
+	if(LOC_U8Interrupts) CPU_SEI();
+	return LOC_U16Average;
+}
+
+/*
+ * ISR: ADC conversion complete, adds the result to the average of its channel and selects the channel after the next one.
+ * avg = avg - avg / 2^ADC_AVG_SHIFT + sample keeps avg at 2^ADC_AVG_SHIFT times the average sample.
+ */
+ISR(ADC_CC){
+	uint8_t LOC_U8Slot = ADC_Slot;
+	uint16_t LOC_U16Average = ADC_Average[LOC_U8Slot];
+	ADC_Average[LOC_U8Slot] = LOC_U16Average - (LOC_U16Average >> ADC_AVG_SHIFT) + ADCH;
+	uint8_t LOC_U8Next = ADC_Next;
+	ADC_Slot = LOC_U8Next;
+	if(++LOC_U8Next == ADC_Num) LOC_U8Next = 0;
+	ADC_Next = LOC_U8Next;
+	ADMUX = ADC_REFERENCE | (1<<ADLAR) | ADC_Channels[LOC_U8Next];
+}
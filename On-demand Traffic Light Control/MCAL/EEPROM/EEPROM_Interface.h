@@ -0,0 +1,56 @@
+/*
+ * File: EEPROM_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to interact with the EEPROM module in this project.
+ * It includes the necessary headers and defines the EECR bits and the EEPROM size.
+ * A byte write takes about 8.5 ms, the write functions wait for the previous write to complete.
+ * Writes can also be fed from the EEPROM ready interrupt, so that the main loop never waits:
+ * the ready callback starts the next write with EEPROM_StartWrite, or disables the interrupt when it has nothing to write.
+ * The ready interrupt is held off while the other functions access the EEPROM.
+ * The functions prototypes defined in this file include:
+ *   - EEPROM_ReadByte: function to read one byte
+ *   - EEPROM_WriteByte: function to write one byte (skipped if the byte already holds the value)
+ *   - EEPROM_Read: function to read a block of bytes
+ *   - EEPROM_Write: function to write a block of bytes
+ *   - EEPROM_SetReadyCallback: function to register the ready interrupt callback
+ *   - EEPROM_EnableReadyInt, EEPROM_DisableReadyInt: functions to control the ready interrupt
+ *   - EEPROM_StartWrite: function to start a write from the ready callback
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef EEPROM_INTERFACE_H
+#define EEPROM_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "EEPROM_Private.h"
+
+// EECR bits
+#define EERE  0 // read enable
+#define EEWE  1 // write enable
+#define EEMWE 2 // master write enable
+#define EERIE 3 // ready interrupt enable
+
+// SREG bits
+#define SREG_I 7
+
+#define EEPROM_SIZE 1024U // bytes
+
+// Ready callback, called from the interrupt while the EEPROM is ready and the interrupt enabled
+typedef void (*EEPROM_ReadyCallback_t)(void);
+
+// EEPROM function prototypes
+uint8_t EEPROM_ReadByte(uint16_t LOC_U16Address);
+void EEPROM_WriteByte(uint16_t LOC_U16Address, uint8_t LOC_U8Value);
+void EEPROM_Read(uint16_t LOC_U16Address, uint8_t* LOC_PtrData, uint16_t LOC_U16Len);
+void EEPROM_Write(uint16_t LOC_U16Address, const uint8_t* LOC_PtrData, uint16_t LOC_U16Len);
+void EEPROM_SetReadyCallback(EEPROM_ReadyCallback_t LOC_PtrCallback);
+void EEPROM_EnableReadyInt(void);
+void EEPROM_DisableReadyInt(void);
+void EEPROM_StartWrite(uint16_t LOC_U16Address, uint8_t LOC_U8Value);
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * File: EEPROM_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control the EEPROM module in this project.
+ * It defines pointers to the registers EEAR, EEDR, EECR and SREG.
+ * EEAR holds the byte address, EEDR the data, EECR starts the read and write operations,
+ * and SREG holds the global interrupt flag, which is restored after the timed write sequence.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef EEPROM_PRIVATE_H
+#define EEPROM_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define EEAR    IO_REG16(0x3E) // EEPROM Address Register (EEARH:EEARL)
+#define EEDR    IO_REG8(0x3D)  // EEPROM Data Register
+#define EECR    IO_REG8(0x3C)  // EEPROM Control Register
+#define SREG    IO_REG8(0x5F)  // Status Register
+
+// Interrupts vector
+#define EEPROM_RDY __vector_17
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * File: EEPROM_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions used to interact with the EEPROM module in this project.
+ * The functions implemented include:
+ *   - EEPROM_ReadByte, EEPROM_Read: functions to read one byte or a block of bytes
+ *   - EEPROM_WriteByte, EEPROM_Write: functions to write one byte or a block of bytes
+ *   - EEPROM_SetReadyCallback, EEPROM_EnableReadyInt, EEPROM_DisableReadyInt: functions to control the ready interrupt
+ *   - EEPROM_StartWrite: function to start a write from the ready callback
+ * A write only starts if EEWE is set within four cycles after EEMWE, so the interrupts are disabled
+ * during the sequence and the I flag is restored after it.
+ * A byte that already holds the value is not written, which saves time and wear.
+ * The blocking functions clear EERIE while they wait and access the registers, so the ready callback
+ * cannot change the address register in the middle (EERIE is restored at the end).
+ * The address and data registers are loaded and used with the interrupts disabled, so an interrupt that waits
+ * for the write in progress may use the blocking functions too (power-fail save), if it waits for its own last write.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "EEPROM_Interface.h"
+#include "../EXTI/EXTI_Interface.h"
+
+static void EEPROM_Ignore(void);
+
+static volatile EEPROM_ReadyCallback_t EEPROM_ReadyCallback = EEPROM_Ignore;
+
+/*
+ * Function: EEPROM_Ignore()
+ * Description: Ready callback used until one is registered, it stops the interrupt.
+ */
+static void EEPROM_Ignore(void){
+	CLR_BIT(EECR, EERIE);
+}
+
+/*
+ * Function: EEPROM_Wait()
+ * Description: Waits for the end of the write in progress, the address and data registers cannot change before.
+ */
+static void EEPROM_Wait(void){
+	while(GET_BIT(EECR, EEWE)) IO_POLL();
+}
+
+/*
+ * Function: EEPROM_Lock()
+ * Description: Holds off the ready interrupt and waits for the write in progress.
+ * Returns: the EERIE bit, to be given back to EEPROM_Unlock
+ */
+static uint8_t EEPROM_Lock(void){
+	uint8_t LOC_U8Ready = GET_BIT(EECR, EERIE);
+	CLR_BIT(EECR, EERIE);
+	EEPROM_Wait();
+	return LOC_U8Ready;
+}
+
+/*
+ * Function: EEPROM_Unlock()
+ * Description: Gives the ready interrupt back.
+ */
+static void EEPROM_Unlock(uint8_t LOC_U8Ready){
+	if(LOC_U8Ready) SET_BIT(EECR, EERIE);
+}
+
+/*
+ * Function: EEPROM_Fetch()
+ * Description: Reads one byte, the EEPROM must be ready. The CPU is halted 4 cycles during the read.
+ */
+static uint8_t EEPROM_Fetch(uint16_t LOC_U16Address){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	EEAR = LOC_U16Address;
+	SET_BIT(EECR, EERE);
+	IO_SYNC();
+	uint8_t LOC_U8Value = EEDR;
+	if(LOC_U8Interrupts) CPU_SEI();
+	return LOC_U8Value;
+}
+
+/*
+ * Function: EEPROM_ReadByte()
+ * Description: This function reads one byte of the EEPROM.
+ * Arguments:
+ *   - LOC_U16Address: the byte address (0 to EEPROM_SIZE-1)
+ * Return value: the byte
+ */
+uint8_t EEPROM_ReadByte(uint16_t LOC_U16Address){
+	uint8_t LOC_U8Ready = EEPROM_Lock();
+	uint8_t LOC_U8Value = EEPROM_Fetch(LOC_U16Address);
+	EEPROM_Unlock(LOC_U8Ready);
+	return LOC_U8Value;
+}
+
+/*
+ * Function: EEPROM_WriteByte()
+ * Description: This function writes one byte of the EEPROM if it does not already hold the value.
+ * The function returns while the write goes on (about 8.5 ms), the next access waits for it.
+ * Arguments:
+ *   - LOC_U16Address: the byte address (0 to EEPROM_SIZE-1)
+ *   - LOC_U8Value: the value to write
+ * Return value: void
+ */
+void EEPROM_WriteByte(uint16_t LOC_U16Address, uint8_t LOC_U8Value){
+	uint8_t LOC_U8Ready = EEPROM_Lock();
+	if(EEPROM_Fetch(LOC_U16Address) != LOC_U8Value) EEPROM_StartWrite(LOC_U16Address, LOC_U8Value);
+	EEPROM_Unlock(LOC_U8Ready);
+}
+
+/*
+ * Function: EEPROM_Read()
+ * Description: This function reads a block of bytes of the EEPROM.
+ * Arguments:
+ *   - LOC_U16Address: the address of the first byte
+ *   - LOC_PtrData: where to store the bytes
+ *   - LOC_U16Len: the number of bytes
+ * Return value: void
+ */
+void EEPROM_Read(uint16_t LOC_U16Address, uint8_t* LOC_PtrData, uint16_t LOC_U16Len){
+	for(uint16_t i=0; i<LOC_U16Len; i++) LOC_PtrData[i] = EEPROM_ReadByte(LOC_U16Address + i);
+}
+
+/*
+ * Function: EEPROM_Write()
+ * Description: This function writes a block of bytes of the EEPROM, the unchanged bytes are skipped.
+ * Arguments:
+ *   - LOC_U16Address: the address of the first byte
+ *   - LOC_PtrData: the bytes to write
+ *   - LOC_U16Len: the number of bytes
+ * Return value: void
+ */
+void EEPROM_Write(uint16_t LOC_U16Address, const uint8_t* LOC_PtrData, uint16_t LOC_U16Len){
+	for(uint16_t i=0; i<LOC_U16Len; i++) EEPROM_WriteByte(LOC_U16Address + i, LOC_PtrData[i]);
+}
+
+/*
+ * Function: EEPROM_SetReadyCallback()
+ * Description: This function registers the function called by the ready interrupt, a null pointer removes it.
+ * The callback runs in the interrupt, with the interrupts disabled. It must start a write with EEPROM_StartWrite
+ * or disable the interrupt, which fires again as long as the EEPROM is ready.
+ * Arguments:
+ *   - LOC_PtrCallback: the function to call
+ * Return value: void
+ */
+void EEPROM_SetReadyCallback(EEPROM_ReadyCallback_t LOC_PtrCallback){
+	EEPROM_ReadyCallback = LOC_PtrCallback ? LOC_PtrCallback : EEPROM_Ignore;
+}
+
+/*
+ * Function: EEPROM_EnableReadyInt()
+ * Description: This function enables the ready interrupt. It must be called from the main loop,
+ * not from another interrupt that may preempt a blocking EEPROM function.
+ * Return value: void
+ */
+void EEPROM_EnableReadyInt(void){
+	SET_BIT(EECR, EERIE);
+}
+
+/*
+ * Function: EEPROM_DisableReadyInt()
+ * Description: This function disables the ready interrupt.
+ * Return value: void
+ */
+void EEPROM_DisableReadyInt(void){
+	CLR_BIT(EECR, EERIE);
+}
+
+/*
+ * Function: EEPROM_StartWrite()
+ * Description: This function starts writing one byte, the EEPROM must be ready (from the ready callback).
+ * A write only starts if EEWE is set within four cycles after EEMWE, so the interrupts are disabled meanwhile,
+ * from the load of the address and data registers.
+ * Arguments:
+ *   - LOC_U16Address: the byte address (0 to EEPROM_SIZE-1)
+ *   - LOC_U8Value: the value to write
+ * Return value: void
+ */
+void EEPROM_StartWrite(uint16_t LOC_U16Address, uint8_t LOC_U8Value){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	EEAR = LOC_U16Address;
+	EEDR = LOC_U8Value;
+	SET_BIT(EECR, EEMWE);
+	SET_BIT(EECR, EEWE); // within 4 cycles after EEMWE
+	if(LOC_U8Interrupts) CPU_SEI();
+	IO_SYNC();
+}
+
+ISR(EEPROM_RDY){
+	EEPROM_ReadyCallback();
+}
@@ -4,10 +4,15 @@
  * Description:
  * This header file contains the interfaces of the functions used to interact with the External Interrupt (EXTI) module in this project.
  * It includes the necessary headers and defines the constants used to represent the interrupts, interrupt sense and values.
+ * The driver owns the INT0, INT1 and INT2 vectors: each one calls the callback registered for its interrupt
+ * (an empty function until one is registered), so the users of the interrupts do not define the vectors.
  * The functions prototypes and macros defined in this file include:
  *   - EXTI_Init: function to initialize the external interrupt
  *   - EXTI_ChooseISC: function to choose the interrupt sense of a specific interrupt
- *   - ISR: macro to define the ISR function for external interrupt
+ *   - EXTI_SetCallback: function to register the function called when a specific interrupt fires
+ *   - EXTI_Enable, EXTI_Disable: functions to enable and disable a specific interrupt at runtime
+ *   - EXTI_Rearm: function to drop an edge seen while the interrupt was disabled and enable it
+ *   - ISR: macro to define the ISR function of the other interrupt sources
  *   - sei, cli: macros to enable and disable global interrupts
  *
  * Created on: Jan 13, 2023
@@ -28,7 +33,7 @@
 #define INT1 7
 #define INT2 5
 
-// Interrupt Sense
+// Interrupt Sense (the hardware has no high level sense, INT2 only senses edges)
 typedef enum sense{
     LOW_LEVEL,
     HIGH_LEVEL,
@@ -37,6 +42,16 @@ typedef enum sense{
     ANY_LOGICAL_CHANGE
 } EN_InterruptSense_t;
 
+// Error status
+typedef enum extiError{
+    EXTI_OK,
+    EXTI_WRONG_INT,  // not INT0, INT1 or INT2
+    EXTI_WRONG_SENSE // sense not supported by this interrupt
+} EN_ExtiError_t;
+
+// Interrupt callback
+typedef void (*EXTI_Callback_t)(void);
+
 // ISC bits
 #define ISC00 0
 #define ISC01 1
@@ -49,25 +64,37 @@ typedef enum sense{
 #define INTF1 7
 #define INTF2 5 
 
-// Interrupts vector
-#define EXTI0 __vector_1
-#define EXTI1 __vector_2
-#define EXTI2 __vector_3
-
 // Set global interrupt
-#define sei() __asm__ __volatile__ ("sei" ::: "memory")
+#define sei() CPU_SEI()
 
 // Clear global interrupt
-#define cli() __asm__ __volatile ("cli" ::: "memory")
+#define cli() CPU_CLI()
 
 // Interrupt prototype and definition
+#ifdef HOST_BUILD
+// On the host the vectors are plain functions called by the host backend
+#define ISR(INT_VECT)\
+void INT_VECT(void);\
+void INT_VECT(void) 
+#else
 #define ISR(INT_VECT)\
 void INT_VECT(void) __attribute__ ((signal,used));\
 void INT_VECT(void) 
+#endif
+
+// INT2 vector owned by the driver, set to 0 (-DEXTI_INT2_DISPATCH=0) to leave it to a hand-written ISR:
+// EXTI_DispatchTest then times the hand-written ISR instead of the callback table
+#ifndef EXTI_INT2_DISPATCH
+#define EXTI_INT2_DISPATCH 1
+#endif
 
 // EXTI function prototypes
-void EXTI_Init(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE);
-void EXTI_ChooseISC(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE);
+EN_ExtiError_t EXTI_Init(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE);
+EN_ExtiError_t EXTI_ChooseISC(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE);
+EN_ExtiError_t EXTI_SetCallback(uint8_t LOC_U8INTx, EXTI_Callback_t LOC_PtrCallback);
+void EXTI_Enable(uint8_t LOC_U8INTx);
+void EXTI_Disable(uint8_t LOC_U8INTx);
+void EXTI_Rearm(uint8_t LOC_U8INTx);
 uint8_t EXTI_IsFired(uint8_t interruptNumber);
 
 #endif
@@ -5,6 +5,7 @@
  * This header file contains the addresses of the registers used to control the External Interrupt (EXTI) module in this project.
  * It defines pointers to the registers MCUCR, MCUCSR, GICR, and GIFR.
  * These registers are used to configure and control the EXTI module in a microcontroller.
+ * It also defines the interrupt vectors, which are only defined by the EXTI driver.
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -15,9 +16,16 @@
 #ifndef EXTI_PRIVATE_H
 #define EXTI_PRIVATE_H
 
-#define MCUCR   *((volatile uint8_t*)(0x55))
-#define MCUCSR  *((volatile uint8_t*)(0x54))
-#define GICR    *((volatile uint8_t*)(0x5B))
-#define GIFR    *((volatile uint8_t*)(0x5A))
+#include "../../utils/IO_ACCESS.h"
+
+#define MCUCR   IO_REG8(0x55)
+#define MCUCSR  IO_REG8(0x54)
+#define GICR    IO_REG8(0x5B)
+#define GIFR    IO_REG8(0x5A)
+
+// Interrupts vector
+#define EXTI0 __vector_1
+#define EXTI1 __vector_2
+#define EXTI2 __vector_3
 
 #endif
\ No newline at end of file
@@ -7,6 +7,11 @@
  * The functions implemented include:
  *   - EXTI_Init: function to initialize the external interrupt
  *   - EXTI_ChooseISC: function to choose the interrupt sense of a specific interrupt
+ *   - EXTI_SetCallback: function to register the callback of a specific interrupt
+ *   - EXTI_Enable, EXTI_Disable, EXTI_Rearm: functions to control a specific interrupt at runtime
+ * The vectors load their callback from a fixed slot of the table and call it: no index computation and no null check,
+ * the empty slots hold EXTI_Ignore. Compared to a hand-written ISR doing the same work in a function,
+ * the dispatch adds two loads and an indirect call and return (11 cycles), the saved registers are the same.
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -16,61 +21,146 @@
 
 #include "EXTI_Interface.h"
 
+#define EXTI_INT_NUM 3
+
+static void EXTI_Ignore(void);
+
+// Callback of INT0, INT1 and INT2
+static volatile EXTI_Callback_t EXTI_Callbacks[EXTI_INT_NUM] = {EXTI_Ignore, EXTI_Ignore, EXTI_Ignore};
+
+/*
+ * Function: EXTI_Ignore()
+ * Description: Callback of the interrupts without a registered callback.
+ */
+static void EXTI_Ignore(void){
+}
+
+/*
+ * Function: EXTI_Index()
+ * Description: Gets the callback slot of an interrupt, EXTI_INT_NUM if it is not INT0, INT1 or INT2.
+ */
+static uint8_t EXTI_Index(uint8_t LOC_U8INTx){
+	switch(LOC_U8INTx){
+		case INT0: return 0;
+		case INT1: return 1;
+		case INT2: return 2;
+		default: return EXTI_INT_NUM;
+	}
+}
+
 /*
  * Function: EXTI_Init() 
  * Description: This function is used to initialize the External Interrupt and choose the sense of the interrupt.
+ * The interrupt is not enabled if the sense is not supported.
  * Arguments:
  *   - LOC_U8INTx: the external interrupt number (INT0, INT1, INT2)
  *   - LOC_U8INT_SENSE: the sense of the interrupt (LOW_LEVEL, ANY_LOGICAL_CHANGE, FALLING_EDGE, RISING_EDGE)
- * Return value: void
+ * Return value: EXTI_OK, EXTI_WRONG_INT or EXTI_WRONG_SENSE
  */
-void EXTI_Init(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE){
+EN_ExtiError_t EXTI_Init(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE){
+    // Choose interrupt sense
+    EN_ExtiError_t LOC_Error = EXTI_ChooseISC(LOC_U8INTx, LOC_U8INT_SENSE);
+    if(EXTI_OK != LOC_Error) return LOC_Error;
+
     // Enable global interrupt
     sei(); 
     
-    // Choose interrupt sense
-    EXTI_ChooseISC(LOC_U8INTx, LOC_U8INT_SENSE);
-
-    // Enable external interrupt
-    SET_BIT(GICR, LOC_U8INTx);
+    // Enable external interrupt, an edge seen since reset is served
+    EXTI_Enable(LOC_U8INTx);
+    return EXTI_OK;
 }
 
 /*
  * Function: EXTI_ChooseISC()
- * Description: This function is used to choose the sense of the interrupt
+ * Description: This function is used to choose the sense of the interrupt.
+ * INT0 and INT1 support LOW_LEVEL, ANY_LOGICAL_CHANGE, FALLING_EDGE and RISING_EDGE, INT2 only the two edges,
+ * and none of them supports HIGH_LEVEL: the sense is then left unchanged and an error is returned.
+ * Changing the INT2 edge can set its flag, so INT2 is disabled meanwhile and the flag is cleared (datasheet procedure).
  * Arguments:
  *   - LOC_U8INTx: the external interrupt number (INT0, INT1, INT2)
  *   - LOC_U8INT_SENSE: the sense of the interrupt (LOW_LEVEL, ANY_LOGICAL_CHANGE, FALLING_EDGE, RISING_EDGE)
- * Return value: void
+ * Return value: EXTI_OK, EXTI_WRONG_INT or EXTI_WRONG_SENSE
  */
-void EXTI_ChooseISC(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE){
-    // for INT0
-    if(INT0 == LOC_U8INTx){
+EN_ExtiError_t EXTI_ChooseISC(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE){
+    // for INT0 and INT1, 2 bits each in MCUCR
+    if(INT0 == LOC_U8INTx || INT1 == LOC_U8INTx){
+        uint8_t LOC_U8Shift = (INT0 == LOC_U8INTx) ? ISC00 : ISC10;
+        uint8_t LOC_U8Bits;
         switch(LOC_U8INT_SENSE){
-            case(LOW_LEVEL): CLR_BIT(MCUCR, ISC00); CLR_BIT(MCUCR, ISC01); break;
-            case(ANY_LOGICAL_CHANGE): SET_BIT(MCUCR, ISC00); CLR_BIT(MCUCR, ISC01); break;
-            case(FALLING_EDGE): CLR_BIT(MCUCR, ISC00); SET_BIT(MCUCR, ISC01); break;
-            case(RISING_EDGE): SET_BIT(MCUCR, ISC00); SET_BIT(MCUCR, ISC01); break;
-        }
-    }
-
-    // for INT1
-    if(INT1 == LOC_U8INTx){
-        switch(LOC_U8INT_SENSE){
-            case(LOW_LEVEL): CLR_BIT(MCUCR, ISC10); CLR_BIT(MCUCR, ISC11); break;
-            case(ANY_LOGICAL_CHANGE): SET_BIT(MCUCR, ISC10); CLR_BIT(MCUCR, ISC11); break;
-            case(FALLING_EDGE): CLR_BIT(MCUCR, ISC10); SET_BIT(MCUCR, ISC11); break;
-            case(RISING_EDGE): SET_BIT(MCUCR, ISC10); SET_BIT(MCUCR, ISC11); break;
+            case(LOW_LEVEL): LOC_U8Bits = 0; break;
+            case(ANY_LOGICAL_CHANGE): LOC_U8Bits = 1; break;
+            case(FALLING_EDGE): LOC_U8Bits = 2; break;
+            case(RISING_EDGE): LOC_U8Bits = 3; break;
+            default: return EXTI_WRONG_SENSE;
         }
+        MCUCR = (MCUCR & ~(0x03 << LOC_U8Shift)) | (LOC_U8Bits << LOC_U8Shift);
+        return EXTI_OK;
     }
 
     // for INT2
     if(INT2 == LOC_U8INTx){
-        switch(LOC_U8INT_SENSE){
-            case(FALLING_EDGE): CLR_BIT(MCUCSR, ISC2); break;
-            case(RISING_EDGE): SET_BIT(MCUCSR, ISC2); break;
-        }
+        if(FALLING_EDGE != LOC_U8INT_SENSE && RISING_EDGE != LOC_U8INT_SENSE) return EXTI_WRONG_SENSE;
+        uint8_t LOC_U8Enabled = GET_BIT(GICR, INT2);
+        CLR_BIT(GICR, INT2);
+        if(RISING_EDGE == LOC_U8INT_SENSE) SET_BIT(MCUCSR, ISC2);
+        else CLR_BIT(MCUCSR, ISC2);
+        GIFR = (1<<INTF2); // cleared by writing one
+        if(LOC_U8Enabled) SET_BIT(GICR, INT2);
+        return EXTI_OK;
     }
+    return EXTI_WRONG_INT;
+}
+
+/*
+ * Function: EXTI_SetCallback()
+ * Description: This function registers the function called when the interrupt fires, a null pointer removes it.
+ * The callback runs in the interrupt, with the interrupts disabled.
+ * Arguments:
+ *   - LOC_U8INTx: the external interrupt number (INT0, INT1, INT2)
+ *   - LOC_PtrCallback: the function to call
+ * Return value: EXTI_OK or EXTI_WRONG_INT
+ */
+EN_ExtiError_t EXTI_SetCallback(uint8_t LOC_U8INTx, EXTI_Callback_t LOC_PtrCallback){
+	uint8_t LOC_U8Index = EXTI_Index(LOC_U8INTx);
+	if(EXTI_INT_NUM == LOC_U8Index) return EXTI_WRONG_INT;
+	EXTI_Callbacks[LOC_U8Index] = LOC_PtrCallback ? LOC_PtrCallback : EXTI_Ignore;
+	return EXTI_OK;
+}
+
+/*
+ * Function: EXTI_Enable()
+ * Description: This function enables the interrupt, an edge seen while it was disabled is served now.
+ * Arguments:
+ *   - LOC_U8INTx: the external interrupt number (INT0, INT1, INT2)
+ * Return value: void
+ */
+void EXTI_Enable(uint8_t LOC_U8INTx){
+	if(EXTI_INT_NUM != EXTI_Index(LOC_U8INTx)) SET_BIT(GICR, LOC_U8INTx);
+}
+
+/*
+ * Function: EXTI_Disable()
+ * Description: This function disables the interrupt, its flag still records the next edge.
+ * Arguments:
+ *   - LOC_U8INTx: the external interrupt number (INT0, INT1, INT2)
+ * Return value: void
+ */
+void EXTI_Disable(uint8_t LOC_U8INTx){
+	if(EXTI_INT_NUM != EXTI_Index(LOC_U8INTx)) CLR_BIT(GICR, LOC_U8INTx);
+}
+
+/*
+ * Function: EXTI_Rearm()
+ * Description: This function drops an edge seen while the interrupt was disabled and enables it,
+ * so only the next edge is served. The flag bits in GIFR match the enable bits in GICR.
+ * Arguments:
+ *   - LOC_U8INTx: the external interrupt number (INT0, INT1, INT2)
+ * Return value: void
+ */
+void EXTI_Rearm(uint8_t LOC_U8INTx){
+	if(EXTI_INT_NUM == EXTI_Index(LOC_U8INTx)) return;
+	GIFR = (1<<LOC_U8INTx); // cleared by writing one
+	SET_BIT(GICR, LOC_U8INTx);
 }
 
 /*
@@ -82,3 +172,21 @@ void EXTI_ChooseISC(uint8_t LOC_U8INTx, EN_InterruptSense_t LOC_U8INT_SENSE){
 uint8_t EXTI_IsFired(uint8_t interruptNumber){
 	return GET_BIT(GIFR, interruptNumber);
 }
+
+/************************************************************************/
+/*                       Interrupt Vectors                              */
+/************************************************************************/
+
+ISR(EXTI0){
+	EXTI_Callbacks[0]();
+}
+
+ISR(EXTI1){
+	EXTI_Callbacks[1]();
+}
+
+#if EXTI_INT2_DISPATCH
+ISR(EXTI2){
+	EXTI_Callbacks[2]();
+}
+#endif
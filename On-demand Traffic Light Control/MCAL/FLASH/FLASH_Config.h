@@ -0,0 +1,24 @@
+/*
+ * File: FLASH_Config.h
+ *
+ * Description:
+ * This header file contains the layout of the flash of the ATmega32 used by the bootloader (BOOT).
+ * The flash is written one page at a time, from the boot section only. The boot section is the last
+ * FLASH_SIZE - FLASH_BOOT_START bytes, selected by the BOOTSZ fuses (BOOTSZ1:0 = 01, 1024 words), and BOOTRST
+ * programmed makes the reset start there. The NRWW section (FLASH_NRWW_START to the end) can be read
+ * while the RWW section below it is written, so the bootloader keeps running during a page erase or write.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef FLASH_CONFIG_H_
+#define FLASH_CONFIG_H_
+
+#define FLASH_SIZE       0x8000U // bytes
+#define FLASH_PAGE_SIZE  128U    // bytes (64 words)
+#define FLASH_NRWW_START 0x7000U
+#define FLASH_BOOT_START 0x7800U // BOOTSZ1:0 = 01
+
+#endif
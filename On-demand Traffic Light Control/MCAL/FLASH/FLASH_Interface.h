@@ -0,0 +1,43 @@
+/*
+ * File: FLASH_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to read and write the flash in this project.
+ * They are only used by the bootloader (BOOT): spm only works from the boot section, and the RWW section,
+ * where the application runs, can not be read during a page erase or write.
+ * A page erase and a page write take about 4.5 ms each, the functions wait for them and for the EEPROM writes
+ * in progress (spm can not run during an EEPROM write). The interrupts must be disabled: their vectors
+ * are in the application section.
+ * The functions prototypes defined in this file include:
+ *   - FLASH_ReadByte: function to read one byte
+ *   - FLASH_ErasePage: function to erase one page
+ *   - FLASH_WritePage: function to erase one page and write it
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef FLASH_INTERFACE_H
+#define FLASH_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "FLASH_Private.h"
+#include "FLASH_Config.h"
+
+// SPMCR bits
+#define SPMEN  0 // store program memory enable, cleared when the operation is complete
+#define PGERS  1 // page erase
+#define PGWRT  2 // page write
+#define BLBSET 3 // boot lock bit set
+#define RWWSRE 4 // RWW section read enable
+#define RWWSB  6 // RWW section busy
+#define SPMIE  7 // SPM ready interrupt enable
+
+// Flash function prototypes
+uint8_t FLASH_ReadByte(uint16_t LOC_U16Address);
+void FLASH_ErasePage(uint16_t LOC_U16Address);
+void FLASH_WritePage(uint16_t LOC_U16Address, const uint8_t* LOC_PtrData);
+
+#endif
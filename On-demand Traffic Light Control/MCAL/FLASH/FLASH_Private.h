@@ -0,0 +1,23 @@
+/*
+ * File: FLASH_Private.h
+ *
+ * Description:
+ * This header file contains the address of the register used to write the flash in this project.
+ * SPMCR selects the operation of the next spm instruction (page erase, page write, temporary buffer fill,
+ * RWW section read enable) and tells when it is complete. It is written by CPU_SPM, together with the spm instruction,
+ * so the address is also given as a number.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef FLASH_PRIVATE_H
+#define FLASH_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define FLASH_SPMCR_ADDR 0x57
+#define SPMCR  IO_REG8(FLASH_SPMCR_ADDR) // Store Program Memory Control Register
+
+#endif
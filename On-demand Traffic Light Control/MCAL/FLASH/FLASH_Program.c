@@ -0,0 +1,78 @@
+/*
+ * File: FLASH_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions used to read and write the flash in this project.
+ * A page is written in three steps: the page is erased, the temporary page buffer is filled one word at a time
+ * (the Z address selects the word in the page), then the buffer is written to the page.
+ * The RWW section is read enabled again after each operation, its reads would be wrong otherwise.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "FLASH_Interface.h"
+#include "../EEPROM/EEPROM_Interface.h"
+
+/*
+ * Function: FLASH_Wait()
+ * Description: Waits for the spm operation in progress to complete.
+ */
+static void FLASH_Wait(void){
+	while(GET_BIT(SPMCR, SPMEN)) IO_POLL();
+}
+
+/*
+ * Function: FLASH_EnableRww()
+ * Description: Waits for the end of a page erase or write and read enables the RWW section.
+ */
+static void FLASH_EnableRww(void){
+	FLASH_Wait();
+	CPU_SPM(FLASH_SPMCR_ADDR, (1<<RWWSRE) | (1<<SPMEN), 0, 0);
+	FLASH_Wait();
+}
+
+/*
+ * Function: FLASH_ReadByte()
+ * Description: This function reads one byte of the flash.
+ * Arguments:
+ *   - LOC_U16Address: the byte address
+ * Return value: the byte
+ */
+uint8_t FLASH_ReadByte(uint16_t LOC_U16Address){
+	return CPU_LPM(LOC_U16Address);
+}
+
+/*
+ * Function: FLASH_ErasePage()
+ * Description: This function erases one page (all the bytes read 0xFF) and waits for the end of the erase.
+ * Arguments:
+ *   - LOC_U16Address: a byte address in the page
+ * Return value: void
+ */
+void FLASH_ErasePage(uint16_t LOC_U16Address){
+	while(GET_BIT(EECR, EEWE)) IO_POLL();
+	FLASH_Wait();
+	CPU_SPM(FLASH_SPMCR_ADDR, (1<<PGERS) | (1<<SPMEN), LOC_U16Address & ~(FLASH_PAGE_SIZE - 1), 0);
+	FLASH_EnableRww();
+}
+
+/*
+ * Function: FLASH_WritePage()
+ * Description: This function erases one page and writes it, it waits for the end of the write.
+ * Arguments:
+ *   - LOC_U16Address: a byte address in the page
+ *   - LOC_PtrData: the FLASH_PAGE_SIZE bytes of the page (in RAM)
+ * Return value: void
+ */
+void FLASH_WritePage(uint16_t LOC_U16Address, const uint8_t* LOC_PtrData){
+	uint16_t LOC_U16Page = LOC_U16Address & ~(FLASH_PAGE_SIZE - 1);
+	FLASH_ErasePage(LOC_U16Page);
+	for(uint16_t i=0; i<FLASH_PAGE_SIZE; i+=2){
+		uint16_t LOC_U16Word = LOC_PtrData[i] | ((uint16_t)LOC_PtrData[i + 1] << 8); // little endian, like the instructions
+		CPU_SPM(FLASH_SPMCR_ADDR, (1<<SPMEN), LOC_U16Page + i, LOC_U16Word);
+	}
+	CPU_SPM(FLASH_SPMCR_ADDR, (1<<PGWRT) | (1<<SPMEN), LOC_U16Page, 0);
+	FLASH_EnableRww();
+}
@@ -9,6 +9,7 @@
  *   - GPIO_SetPinVal: function to set the value of a specific pin
  *   - GPIO_SetPortDir: function to set the direction of a specific port
  *   - GPIO_SetPortVal: function to set the value of a specific port
+ *   - GPIO_SetPortBits: function to set the value of some pins of a specific port in one write
  *   - GPIO_ToggPin: function to toggle the value of a specific pin
  *   - GPIO_GetPinVal: function to get the value of a specific pin
  *
@@ -45,6 +46,9 @@
 #define INPUT  0
 #define OUTPUT 1
 
+// SREG bits
+#define SREG_I 7
+
 // PIN value
 #define HIGH 1
 #define LOW  0
@@ -54,6 +58,7 @@ void GPIO_SetPinDir(uint8_t LOC_U8Port, uint8_t LOC_U8Pin, uint8_t LOC_U8dir);
 void GPIO_SetPinVal(uint8_t LOC_U8Port, uint8_t LOC_U8Pin, uint8_t LOC_U8Value);
 void GPIO_SetPortDir(uint8_t LOC_U8Port, uint8_t LOC_U8dir);
 void GPIO_SetPortVal(uint8_t LOC_U8Port, uint8_t LOC_U8Value);
+void GPIO_SetPortBits(uint8_t LOC_U8Port, uint8_t LOC_U8Mask, uint8_t LOC_U8Value);
 void GPIO_ToggPin(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
 uint8_t GPIO_GetPinVal(uint8_t LOC_U8Port, uint8_t LOC_U8Pin);
 
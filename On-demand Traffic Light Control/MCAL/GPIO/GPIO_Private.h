@@ -4,7 +4,8 @@
  * Description:
  * This header file contains the addresses of the registers used to control the General Purpose Input/Output (GPIO) module in this project.
  * It defines pointers to the registers:
- * PORTA_REG, PORTB_REG, PORTC_REG, PORTD_REG, DDRA_REG, DDRB_REG, DDRC_REG, DDRD_REG, PINA_REG, PINB_REG, PINC_REG, and PIND_REG.
+ * PORTA_REG, PORTB_REG, PORTC_REG, PORTD_REG, DDRA_REG, DDRB_REG, DDRC_REG, DDRD_REG, PINA_REG, PINB_REG, PINC_REG, and PIND_REG,
+ * and the status register (SREG) holding the global interrupt enable bit.
  * These registers are used to configure and control the GPIO module in a microcontroller.
  *
  * Created on: Jan 13, 2023
@@ -16,19 +17,23 @@
 #ifndef GPIO_PRIVATE_H
 #define GPIO_PRIVATE_H
 
-#define PORTA_REG *((volatile uint8_t*)(0x3B))
-#define PORTB_REG *((volatile uint8_t*)(0x38))
-#define PORTC_REG *((volatile uint8_t*)(0x35))
-#define PORTD_REG *((volatile uint8_t*)(0x32))
+#include "../../utils/IO_ACCESS.h"
 
-#define DDRA_REG  *((volatile uint8_t*)(0x3A))
-#define DDRB_REG  *((volatile uint8_t*)(0x37))
-#define DDRC_REG  *((volatile uint8_t*)(0x34))
-#define DDRD_REG  *((volatile uint8_t*)(0x31))
+#define PORTA_REG IO_REG8(0x3B)
+#define PORTB_REG IO_REG8(0x38)
+#define PORTC_REG IO_REG8(0x35)
+#define PORTD_REG IO_REG8(0x32)
 
-#define PINA_REG  *((volatile uint8_t*)(0x39))
-#define PINB_REG  *((volatile uint8_t*)(0x36))
-#define PINC_REG  *((volatile uint8_t*)(0x33))
-#define PIND_REG  *((volatile uint8_t*)(0x30))
+#define DDRA_REG  IO_REG8(0x3A)
+#define DDRB_REG  IO_REG8(0x37)
+#define DDRC_REG  IO_REG8(0x34)
+#define DDRD_REG  IO_REG8(0x31)
+
+#define PINA_REG  IO_REG8(0x39)
+#define PINB_REG  IO_REG8(0x36)
+#define PINC_REG  IO_REG8(0x33)
+#define PIND_REG  IO_REG8(0x30)
+
+#define SREG    IO_REG8(0x5F)  // Status Register
 
 #endif
\ No newline at end of file
@@ -71,6 +71,7 @@ void GPIO_SetPinVal(uint8_t LOC_U8Port, uint8_t LOC_U8Pin, uint8_t LOC_U8Value){
 			case PORTD: SET_BIT(PORTD_REG, LOC_U8Pin); break;
 		}
 	}
+	IO_SYNC();
 }
 
 /*
@@ -107,6 +108,32 @@ void GPIO_SetPortVal(uint8_t LOC_U8Port, uint8_t LOC_U8Value){
 		case PORTC: PORTC_REG = LOC_U8Value; break;
 		case PORTD: PORTD_REG = LOC_U8Value; break;
 	}
+	IO_SYNC();
+}
+
+/*
+ * Function: GPIO_SetPortBits()
+ * Description:
+ * This function sets the value of some pins of a specific port in one write, the other pins keep their value.
+ * The interrupts are disabled during the read-modify-write, so an interrupt writing another pin of the port is not lost.
+ * Inputs:
+ *  - uint8_t LOC_U8Port: the port (PORTA, PORTB, PORTC, or PORTD)
+ *  - uint8_t LOC_U8Mask: the pins to set (bit i for pin i)
+ *  - uint8_t LOC_U8Value: the values of the pins (bit i for pin i, the bits outside the mask are ignored)
+ * Outputs: None
+ */
+void GPIO_SetPortBits(uint8_t LOC_U8Port, uint8_t LOC_U8Mask, uint8_t LOC_U8Value){
+	LOC_U8Value &= LOC_U8Mask;
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	switch(LOC_U8Port){
+		case PORTA: PORTA_REG = (PORTA_REG & ~LOC_U8Mask) | LOC_U8Value; break;
+		case PORTB: PORTB_REG = (PORTB_REG & ~LOC_U8Mask) | LOC_U8Value; break;
+		case PORTC: PORTC_REG = (PORTC_REG & ~LOC_U8Mask) | LOC_U8Value; break;
+		case PORTD: PORTD_REG = (PORTD_REG & ~LOC_U8Mask) | LOC_U8Value; break;
+	}
+	if(LOC_U8Interrupts) CPU_SEI();
+	IO_SYNC();
 }
 
 /*
@@ -125,6 +152,7 @@ void GPIO_ToggPin(uint8_t LOC_U8Port, uint8_t LOC_U8Pin){
 		case PORTC: TOGG_BIT(PORTC_REG, LOC_U8Pin); break;
 		case PORTD: TOGG_BIT(PORTD_REG, LOC_U8Pin); break;
 	}
+	IO_SYNC();
 }
 
 /*
@@ -0,0 +1,19 @@
+/*
+ * File: SPI_Config.h
+ *
+ * Description:
+ * This header file contains the configuration macros for the SPI in this project (master, mode 0, MSB first).
+ * It defines the SPI_CLOCK macro, the SCK clock divider.
+ * With F_CPU = 1 MHz and a divider of 16, SCK runs at 62.5 kHz and a byte takes 128 us.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef SPI_CONFIG_H_
+#define SPI_CONFIG_H_
+
+#define SPI_CLOCK SPI_DIV_16
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * File: SPI_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to interact with the SPI module in this project.
+ * It includes the necessary headers and defines the SPI register bits, clock dividers and vector.
+ * The SPI is only used as a master sending bytes (MOSI PB5, SCK PB7, SS PB4 driven as an output).
+ * Each transfer complete interrupt calls a callback registered by the user, which sends the next byte
+ * or stops the interrupt, so a block of bytes is sent without the CPU waiting for the bytes.
+ * The functions prototypes defined in this file include:
+ *   - SPI_Init: function to initialize the SPI master (SPI_Config.h) and its pins
+ *   - SPI_SetCallback: function to register the function called at the end of each transfer
+ *   - SPI_Send: function to start sending one byte, with the transfer complete interrupt enabled
+ *   - SPI_Stop: function to disable the transfer complete interrupt after the last byte
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef SPI_INTERFACE_H
+#define SPI_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "SPI_Private.h"
+#include "SPI_Config.h"
+
+// SPCR bits
+#define SPR0  0
+#define SPR1  1
+#define CPHA  2
+#define CPOL  3
+#define MSTR  4
+#define DORD  5
+#define SPE   6
+#define SPIE  7
+
+// SPSR bits
+#define SPI2X 0
+#define WCOL  6
+#define SPIF  7
+
+// Interrupts vector
+#define SPI_STC __vector_12
+
+// SCK clock dividers, the values are SPI2X << 2 | SPR1 << 1 | SPR0
+#define SPI_DIV_4   0x00
+#define SPI_DIV_16  0x01
+#define SPI_DIV_64  0x02
+#define SPI_DIV_128 0x03
+#define SPI_DIV_2   0x04
+#define SPI_DIV_8   0x05
+#define SPI_DIV_32  0x06
+
+// Transfer complete callback, called from the interrupt
+typedef void (*SPI_Callback_t)(void);
+
+// SPI function prototypes
+void SPI_Init(void);
+void SPI_SetCallback(SPI_Callback_t LOC_PtrCallback);
+void SPI_Send(uint8_t LOC_U8Byte);
+void SPI_Stop(void);
+
+#endif
@@ -0,0 +1,22 @@
+/*
+ * File: SPI_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control the SPI module in this project.
+ * It defines pointers to the registers SPCR, SPSR and SPDR.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef SPI_PRIVATE_H
+#define SPI_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define SPCR  IO_REG8(0x2D) // SPI Control Register
+#define SPSR  IO_REG8(0x2E) // SPI Status Register
+#define SPDR  IO_REG8(0x2F) // SPI Data Register
+
+#endif
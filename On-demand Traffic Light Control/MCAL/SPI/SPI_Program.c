@@ -0,0 +1,83 @@
+/*
+ * File: SPI_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions used to interact with the SPI module in this project.
+ * The functions implemented include:
+ *   - SPI_Init: function to initialize the SPI master and its pins
+ *   - SPI_SetCallback: function to register the transfer complete callback
+ *   - SPI_Send, SPI_Stop: functions to send a byte and to stop the interrupt after the last byte
+ * SPIF is cleared by the hardware when the interrupt is served, so the callback only has to load the next byte.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "SPI_Interface.h"
+#include "../GPIO/GPIO_Interface.h"
+#include "../EXTI/EXTI_Interface.h"
+
+static void SPI_Ignore(void);
+
+static volatile SPI_Callback_t SPI_Callback = SPI_Ignore;
+
+/*
+ * Function: SPI_Ignore()
+ * Description: Transfer complete callback used until one is registered.
+ */
+static void SPI_Ignore(void){
+}
+
+/*
+ * Function: SPI_Init()
+ * Description: This function initializes the SPI as a master: mode 0 (SCK low when idle, data sampled on the rising edge),
+ * MSB first, clock divider from SPI_Config.h, interrupt disabled.
+ * MOSI, SCK and SS are outputs: SS must not be an input in master mode, it is free for the user (latch, chip select).
+ * Return value: void
+ */
+void SPI_Init(void){
+	GPIO_SetPinDir(PORTB, PIN4, OUTPUT); // SS
+	GPIO_SetPinDir(PORTB, PIN5, OUTPUT); // MOSI
+	GPIO_SetPinDir(PORTB, PIN7, OUTPUT); // SCK
+	SPSR = (SPI_CLOCK >> 2) << SPI2X;
+	SPCR = (1<<SPE) | (1<<MSTR) | (SPI_CLOCK & 0x03);
+}
+
+/*
+ * Function: SPI_SetCallback()
+ * Description: This function registers the function called at the end of each transfer, a null pointer removes it.
+ * The callback runs in the interrupt, with the interrupts disabled.
+ * Arguments:
+ *   - LOC_PtrCallback: the function to call
+ * Return value: void
+ */
+void SPI_SetCallback(SPI_Callback_t LOC_PtrCallback){
+	SPI_Callback = LOC_PtrCallback ? LOC_PtrCallback : SPI_Ignore;
+}
+
+/*
+ * Function: SPI_Send()
+ * Description: This function starts sending one byte and enables the transfer complete interrupt.
+ * It must only be called when no transfer is in progress: first byte of a block, or from the callback.
+ * Arguments:
+ *   - LOC_U8Byte: the byte to send
+ * Return value: void
+ */
+void SPI_Send(uint8_t LOC_U8Byte){
+	SPDR = LOC_U8Byte;
+	SET_BIT(SPCR, SPIE);
+}
+
+/*
+ * Function: SPI_Stop()
+ * Description: This function disables the transfer complete interrupt, called from the callback after the last byte.
+ * Return value: void
+ */
+void SPI_Stop(void){
+	CLR_BIT(SPCR, SPIE);
+}
+
+ISR(SPI_STC){
+	SPI_Callback();
+}
@@ -6,7 +6,9 @@
  * It defines the F_CPU macro which represents the frequency of the microcontroller,
  * the TMR_PRESCALER macro which represents the prescaler value used for the timer,
  * the OVERFLOW_NUM_5_SEC macro which represents the number of overflow needed to reach 5 seconds,
- * and the INIT_VALUE_5_SEC macro which represents the initial value to be loaded into the timer to reach 5 seconds
+ * the INIT_VALUE_5_SEC macro which represents the initial value to be loaded into the timer to reach 5 seconds,
+ * and the OVERFLOW_NUM_HALF_SEC / INIT_VALUE_HALF_SEC macros used by the application to generate 0.5 second delays
+ * (1 MHz / 1024 = 976.5 Hz, 0.5 second = 488 counts = (256 - 0x18) + 256, i.e. 2 overflows starting from 0x18)
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -21,5 +23,7 @@
 #define TMR_PRESCALER TMR0_PRE_1024
 #define OVERFLOW_NUM_5_SEC 19
 #define INIT_VALUE_5_SEC 0x00
+#define OVERFLOW_NUM_HALF_SEC 2
+#define INIT_VALUE_HALF_SEC 0x18
 
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
  * It defines macros for waveform generation mode bit (WGM00, WGM01), clock select bit (CS00, CS01, CS02),
  * TIMER0 overflow flag (TOV0), timer prescaler (EN_TimerPrescaler_t), timer mode of operation (EN_TimerMode_t)
  * and timer configuration (ST_TimerConfig_t).
+ * With the external clock "prescalers" the timer counts the edges of the T0 pin (PIN 0 in PORTB) instead of the CPU clock.
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -40,7 +41,9 @@ typedef enum scales{
     TMR0_PRE_8,
     TMR0_PRE_64,
     TMR0_PRE_256,
-    TMR0_PRE_1024
+    TMR0_PRE_1024,
+    TMR0_EXT_FALLING, // external clock on T0, falling edge
+    TMR0_EXT_RISING   // external clock on T0, rising edge
 } EN_TimerPrescaler_t;
 
 // Timer mode of operation
@@ -63,6 +66,7 @@ void TMR0_Init(ST_TimerConfig_t* config);
 void TMR0_Start(ST_TimerConfig_t* config);
 void TMR0_Stop(void);
 uint8_t TMR0_GetState(void);
+uint8_t TMR0_GetCount(void);
 void TMR0_Delay(ST_TimerConfig_t* config);
 
 #endif
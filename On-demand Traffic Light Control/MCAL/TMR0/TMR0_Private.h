@@ -15,10 +15,12 @@
 #ifndef TMR0_PRIVATE_H
 #define TMR0_PRIVATE_H
 
-#define TCCR0  *((volatile uint8_t*)(0x53)) // Timer/Counter0 Control Register
-#define TCNT0  *((volatile uint8_t*)(0x52)) // Timer/Counter0 Register
-#define OCR0   *((volatile uint8_t*)(0x5C)) // Timer/Counter0 Output Compare Register
-#define TIMSK  *((volatile uint8_t*)(0x59)) // Timer/Counter Interrupt Mask Register
-#define TIFR   *((volatile uint8_t*)(0x58)) // Timer/Counter Interrupt Flag Register
+#include "../../utils/IO_ACCESS.h"
+
+#define TCCR0  IO_REG8(0x53) // Timer/Counter0 Control Register
+#define TCNT0  IO_REG8(0x52) // Timer/Counter0 Register
+#define OCR0   IO_REG8(0x5C) // Timer/Counter0 Output Compare Register
+#define TIMSK  IO_REG8(0x59) // Timer/Counter Interrupt Mask Register
+#define TIFR   IO_REG8(0x58) // Timer/Counter Interrupt Flag Register
 
 #endif
\ No newline at end of file
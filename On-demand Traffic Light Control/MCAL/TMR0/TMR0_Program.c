@@ -97,6 +97,18 @@ void TMR0_Start(ST_TimerConfig_t* config){
             CLR_BIT(TCCR0, CS01);
             SET_BIT(TCCR0, CS02);
             break;
+
+        case TMR0_EXT_FALLING: 
+            CLR_BIT(TCCR0, CS00);
+            SET_BIT(TCCR0, CS01);
+            SET_BIT(TCCR0, CS02);
+            break;
+
+        case TMR0_EXT_RISING: 
+            SET_BIT(TCCR0, CS00);
+            SET_BIT(TCCR0, CS01);
+            SET_BIT(TCCR0, CS02);
+            break;
     }
 }
 
@@ -125,9 +137,20 @@ void TMR0_Stop(void){
  *Returns: uint8_t (1 if overflow occurred, 0 if no overflow)
  */
 uint8_t TMR0_GetState(void){
+    IO_POLL(); // lets the host backend advance the virtual time while the flag is polled
     return GET_BIT(TIFR,TOV0);
 }
 
+/*
+ *Function: TMR0_GetCount()
+ *Description: This function is responsible for reading the Timer0 counter (TCNT0),
+ *with an external clock it is the number of edges counted on T0 (modulo 256).
+ *Returns: uint8_t (the counter value)
+ */
+uint8_t TMR0_GetCount(void){
+    return TCNT0;
+}
+
 
 /************************************************************************/
 /*                       Delay Functions                                */
@@ -0,0 +1,23 @@
+/*
+ * File: TMR1_Config.h
+ *
+ * Description:
+ * This header file contains the configuration macros for Timer1 in this project.
+ * Timer1 runs in CTC mode and toggles its output compare pins (OC1A, OC1B) in hardware to flash the yellow LEDs.
+ * It defines the TMR1_PRESCALER macro which represents the prescaler value used for the timer,
+ * and the TOP_VALUE_HALF_SEC macro which represents the compare value needed to toggle the pins every 0.5 second.
+ * With F_CPU = 1 MHz and a prescaler of 8 the timer counts at 125 kHz, so 62500 counts are exactly 0.5 second
+ * and the flash rate is exactly 1 Hz. The same periods are the half seconds of the application (TICK).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TMR1_CONFIG_H_
+#define TMR1_CONFIG_H_
+
+#define TMR1_PRESCALER TMR1_PRE_8
+#define TOP_VALUE_HALF_SEC 62499U
+
+#endif
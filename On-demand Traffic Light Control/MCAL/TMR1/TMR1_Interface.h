@@ -0,0 +1,120 @@
+/*
+ * File: TMR1_Interface.h
+ *
+ * Description:
+ * This header file contains the TMR1_INTERFACE.h, which is responsible for controlling the Timer1 module.
+ * It defines macros for waveform generation mode bits (WGM10..WGM13), compare output mode bits (COM1A0..COM1B1),
+ * clock select bits (CS10, CS11, CS12), force output compare bits (FOC1A, FOC1B), input capture bits (ICES1, ICNC1),
+ * Timer1 interrupt enable bits, flags and vectors,
+ * timer prescaler (EN_Timer1Prescaler_t), timer mode of operation (EN_Timer1Mode_t),
+ * compare output mode (EN_CompareOutput_t) and timer configuration (ST_Timer1Config_t).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TMR1_INTERFACE_H_
+#define TMR1_INTERFACE_H_
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "TMR1_Private.h"
+#include "TMR1_Config.h"
+
+// Waveform Generation Mode Bits
+#define WGM10 0 // TCCR1A
+#define WGM11 1 // TCCR1A
+#define WGM12 3 // TCCR1B
+#define WGM13 4 // TCCR1B
+
+// Compare Output Mode Bits (TCCR1A)
+#define COM1B0 4
+#define COM1B1 5
+#define COM1A0 6
+#define COM1A1 7
+
+// Force Output Compare Bits (TCCR1A)
+#define FOC1B 2
+#define FOC1A 3
+
+// Clock Select Bits (TCCR1B)
+#define CS10 0
+#define CS11 1
+#define CS12 2
+
+// Input Capture Bits (TCCR1B)
+#define ICES1 6 // edge select: 1 rising, 0 falling
+#define ICNC1 7 // noise canceler
+
+// TIMER1 Interrupt Enable Bits (TIMSK)
+#define TOIE1  2
+#define OCIE1B 3
+#define OCIE1A 4
+#define TICIE1 5
+
+// TIMER1 Flags (TIFR)
+#define TOV1  2
+#define OCF1B 3
+#define OCF1A 4
+#define ICF1  5
+
+// SREG bits
+#define SREG_I 7
+
+// Interrupts vector
+#define TMR1_CAPT  __vector_6
+#define TMR1_COMPA __vector_7
+#define TMR1_COMPB __vector_8
+#define TMR1_OVF   __vector_9
+
+// Output compare channels
+#define TMR1_CH_A 0 // OC1A (PD5)
+#define TMR1_CH_B 1 // OC1B (PD4)
+
+// Prescaler
+typedef enum scales1{
+    TMR1_NO_PRE,
+    TMR1_PRE_8,
+    TMR1_PRE_64,
+    TMR1_PRE_256,
+    TMR1_PRE_1024
+} EN_Timer1Prescaler_t;
+
+// Timer mode of operation
+typedef enum modes1{
+	TMR1_NORMAL,
+	TMR1_CTC
+} EN_Timer1Mode_t;
+
+// Compare output mode (non-PWM modes)
+typedef enum compareOutput{
+	OC_DISCONNECTED,
+	OC_TOGGLE,
+	OC_CLEAR,
+	OC_SET
+} EN_CompareOutput_t;
+
+// Timer Configuration
+typedef struct {
+	uint16_t topVal;
+	EN_Timer1Mode_t mode;
+	EN_Timer1Prescaler_t prescaler;
+} ST_Timer1Config_t;
+
+// Timer function prototypes
+void TMR1_Init(ST_Timer1Config_t* config);
+void TMR1_Start(ST_Timer1Config_t* config);
+void TMR1_Stop(void);
+void TMR1_SetTop(uint16_t LOC_U16Top);
+uint16_t TMR1_GetTop(void);
+void TMR1_SetCompareOutput(uint8_t LOC_U8Channel, EN_CompareOutput_t LOC_Output);
+void TMR1_ForcePin(uint8_t LOC_U8Channel, uint8_t LOC_U8Value);
+uint16_t TMR1_GetCount(void);
+void TMR1_SetCaptureEdge(uint8_t LOC_U8Edge);
+uint8_t TMR1_GetCapture(uint16_t* LOC_PtrValue);
+uint8_t TMR1_GetFlag(uint8_t LOC_U8Flag);
+void TMR1_EnableInt(uint8_t LOC_U8Int);
+void TMR1_DisableInt(uint8_t LOC_U8Int);
+
+#endif
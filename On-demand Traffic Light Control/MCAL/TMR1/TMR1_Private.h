@@ -0,0 +1,31 @@
+/*
+ * File: TMR1_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control Timer1 in this project.
+ * It defines pointers to the registers TCCR1A, TCCR1B, TCNT1, OCR1A, OCR1B, ICR1, TIMSK, and TIFR which are used for setting
+ * the timer's mode and compare output mode, the timer's value, the output compare values, the input capture value,
+ * and the timer's interrupt mask and flag respectively.
+ * The 16-bit registers are accessed through a 16-bit pointer so the compiler takes care of the high/low byte order.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TMR1_PRIVATE_H
+#define TMR1_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define TCCR1A IO_REG8(0x4F)  // Timer/Counter1 Control Register A
+#define TCCR1B IO_REG8(0x4E)  // Timer/Counter1 Control Register B
+#define TCNT1  IO_REG16(0x4C) // Timer/Counter1 Register
+#define OCR1A  IO_REG16(0x4A) // Timer/Counter1 Output Compare Register A
+#define OCR1B  IO_REG16(0x48) // Timer/Counter1 Output Compare Register B
+#define ICR1   IO_REG16(0x46) // Timer/Counter1 Input Capture Register
+#define TIMSK  IO_REG8(0x59) // Timer/Counter Interrupt Mask Register
+#define TIFR   IO_REG8(0x58) // Timer/Counter Interrupt Flag Register
+#define SREG   IO_REG8(0x5F) // Status Register
+
+#endif
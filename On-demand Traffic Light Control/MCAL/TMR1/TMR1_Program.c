@@ -0,0 +1,266 @@
+/*
+ * File: TMR1_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions defined in TMR1_Interface.h.
+ * These functions provide an interface for configuring and controlling the Timer1 module in AVR microcontroller.
+ * The functions include initialization, starting, stopping, controlling the output compare pins (OC1A, OC1B),
+ * reading the counter and the input capture unit (ICP1, PD6) and enabling the Timer1 interrupts.
+ * In CTC mode with the compare output set to toggle, the hardware toggles the pins on every compare match,
+ * so a steady flash keeps running without any CPU work even if the main loop is busy or stalled.
+ * The functions use macros defined in BIT_MATH.h for bit manipulation operations.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+*/
+
+#include "TMR1_Interface.h"
+
+/************************************************************************/
+/*                Initialization Functions                              */
+/************************************************************************/
+/*
+ * This section includes functions responsible for initializing and configuring the Timer1 module.
+ */
+
+/*
+ * Function: TMR1_Init()
+ * Description: This function is responsible for initializing the Timer1 module.
+ * It takes a pointer to a struct of type ST_Timer1Config_t, which contains the top value, mode and prescaler.
+ * The function sets the waveform generation mode bits in TCCR1A/TCCR1B registers according to the mode in the config struct,
+ * and loads the top value into OCR1A (CTC mode) and OCR1B so both channels match once per period.
+ * Returns: void
+ */
+void TMR1_Init(ST_Timer1Config_t* config){
+	switch(config->mode){
+		case TMR1_NORMAL:
+			CLR_BIT(TCCR1A, WGM10);
+			CLR_BIT(TCCR1A, WGM11);
+			CLR_BIT(TCCR1B, WGM12);
+			CLR_BIT(TCCR1B, WGM13);
+		break;
+		
+		case TMR1_CTC:
+			CLR_BIT(TCCR1A, WGM10);
+			CLR_BIT(TCCR1A, WGM11);
+			SET_BIT(TCCR1B, WGM12);
+			CLR_BIT(TCCR1B, WGM13);
+		break;
+	}
+	OCR1A = config->topVal;
+	OCR1B = config->topVal;
+}
+
+
+/************************************************************************/
+/*                       Control Functions                              */
+/************************************************************************/
+/*
+ * This section includes functions responsible for controlling the Timer1 module, such as starting and stopping it.
+ */
+
+/*
+ * Function: TMR1_Start()
+ * Description: This function is responsible for starting the Timer1 module.
+ * It clears TCNT1 so the first compare match comes after a full period,
+ * and sets the prescaler bits in TCCR1B register according to the prescaler in the config struct.
+ * Returns: void
+ */
+void TMR1_Start(ST_Timer1Config_t* config){
+	TCNT1 = 0;
+	switch(config->prescaler){
+		case TMR1_NO_PRE:
+			SET_BIT(TCCR1B, CS10);
+			CLR_BIT(TCCR1B, CS11);
+			CLR_BIT(TCCR1B, CS12);
+			break;
+
+		case TMR1_PRE_8:
+			CLR_BIT(TCCR1B, CS10);
+			SET_BIT(TCCR1B, CS11);
+			CLR_BIT(TCCR1B, CS12);
+			break;
+
+		case TMR1_PRE_64:
+			SET_BIT(TCCR1B, CS10);
+			SET_BIT(TCCR1B, CS11);
+			CLR_BIT(TCCR1B, CS12);
+			break;
+
+		case TMR1_PRE_256:
+			CLR_BIT(TCCR1B, CS10);
+			CLR_BIT(TCCR1B, CS11);
+			SET_BIT(TCCR1B, CS12);
+			break;
+
+		case TMR1_PRE_1024:
+			SET_BIT(TCCR1B, CS10);
+			CLR_BIT(TCCR1B, CS11);
+			SET_BIT(TCCR1B, CS12);
+			break;
+	}
+}
+
+/*
+ * Function: TMR1_Stop()
+ * Description: This function is responsible for stopping the Timer1 module.
+ * It clears the clock select bits in TCCR1B register, the mode and compare output settings are kept.
+ * Returns: void
+ */
+void TMR1_Stop(void){
+	TCCR1B &= ~((1<<CS10) | (1<<CS11) | (1<<CS12)); // stop TIMER1
+}
+
+/*
+ * Function: TMR1_SetTop()
+ * Description: This function changes the top value (CTC mode) without restarting the counter, both channels keep matching at the top.
+ * OCR1A is not buffered in CTC mode: a top below the counter is only reached after the counter wraps at 0xFFFF,
+ * so the top is changed right after a compare match (compare A interrupt).
+ * Arguments:
+ *   - LOC_U16Top: the new top value, the period is LOC_U16Top + 1 counts
+ * Returns: void
+ */
+void TMR1_SetTop(uint16_t LOC_U16Top){
+	OCR1A = LOC_U16Top;
+	OCR1B = LOC_U16Top;
+}
+
+/*
+ * Function: TMR1_GetTop()
+ * Description: This function reads the top value (CTC mode), used to measure a time across a compare match.
+ * Returns: the OCR1A value
+ */
+uint16_t TMR1_GetTop(void){
+	return OCR1A;
+}
+
+
+/************************************************************************/
+/*                 Output Compare Functions                             */
+/************************************************************************/
+/*
+ * This section includes functions responsible for controlling the output compare pins of the Timer1 module.
+ */
+
+/*
+ * Function: TMR1_SetCompareOutput()
+ * Description: This function chooses what the hardware does with an output compare pin on a compare match.
+ * Arguments:
+ *   - LOC_U8Channel: the output compare channel (TMR1_CH_A, TMR1_CH_B)
+ *   - LOC_Output: the compare output mode (OC_DISCONNECTED, OC_TOGGLE, OC_CLEAR, OC_SET)
+ * When the pin is disconnected it is driven again by its PORT register bit.
+ * Returns: void
+ */
+void TMR1_SetCompareOutput(uint8_t LOC_U8Channel, EN_CompareOutput_t LOC_Output){
+	uint8_t LOC_U8Shift = (TMR1_CH_A == LOC_U8Channel) ? COM1A0 : COM1B0;
+	TCCR1A = (TCCR1A & ~(0x03 << LOC_U8Shift)) | ((uint8_t)LOC_Output << LOC_U8Shift);
+	IO_SYNC();
+}
+
+/*
+ * Function: TMR1_ForcePin()
+ * Description: This function forces an output compare pin to a known level without waiting for a compare match.
+ * It temporarily switches the channel to set/clear mode, strobes the force output compare bit,
+ * then restores the previous compare output mode, so a toggling flash always starts from the same level.
+ * Arguments:
+ *   - LOC_U8Channel: the output compare channel (TMR1_CH_A, TMR1_CH_B)
+ *   - LOC_U8Value: the level to force (HIGH or LOW)
+ * Returns: void
+ */
+void TMR1_ForcePin(uint8_t LOC_U8Channel, uint8_t LOC_U8Value){
+	uint8_t LOC_U8Shift = (TMR1_CH_A == LOC_U8Channel) ? COM1A0 : COM1B0;
+	uint8_t LOC_U8Force = (TMR1_CH_A == LOC_U8Channel) ? FOC1A : FOC1B;
+	uint8_t LOC_U8Saved = TCCR1A;
+	TMR1_SetCompareOutput(LOC_U8Channel, LOC_U8Value ? OC_SET : OC_CLEAR);
+	SET_BIT(TCCR1A, LOC_U8Force); // strobe, always reads back as zero
+	TCCR1A = (TCCR1A & ~(0x03 << LOC_U8Shift)) | (LOC_U8Saved & (0x03 << LOC_U8Shift));
+}
+
+
+/************************************************************************/
+/*                 Timestamp Functions                                  */
+/************************************************************************/
+/*
+ * This section includes functions responsible for reading the Timer1 counter and its input capture unit,
+ * which timestamps an edge on ICP1 (PD6) in hardware, whatever the CPU is doing.
+ */
+
+/*
+ * Function: TMR1_GetCount()
+ * Description: This function reads the current value of the Timer1 counter.
+ * The high byte goes through the TEMP register shared by all the 16-bit Timer1 registers, so the two bytes are read
+ * with the interrupts disabled: an interrupt using Timer1 between them would change the high byte.
+ * Returns: the TCNT1 value
+ */
+uint16_t TMR1_GetCount(void){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	uint16_t LOC_U16Count = TCNT1;
+	if(LOC_U8Interrupts) CPU_SEI();
+	return LOC_U16Count;
+}
+
+/*
+ * Function: TMR1_SetCaptureEdge()
+ * Description: This function selects the ICP1 edge captured in ICR1 and clears a pending capture.
+ * Arguments:
+ *   - LOC_U8Edge: HIGH for the rising edge, LOW for the falling edge
+ * Returns: void
+ */
+void TMR1_SetCaptureEdge(uint8_t LOC_U8Edge){
+	if(LOC_U8Edge) SET_BIT(TCCR1B, ICES1);
+	else CLR_BIT(TCCR1B, ICES1);
+	TIFR = (1<<ICF1); // changing the edge may set the flag, cleared by writing one
+}
+
+/*
+ * Function: TMR1_GetCapture()
+ * Description: This function gets the counter value captured on the last ICP1 edge, if an edge was captured.
+ * Arguments:
+ *   - LOC_PtrValue: where to store the captured value
+ * Returns: 1 if an edge was captured since the last call (the flag is cleared), 0 otherwise
+ */
+uint8_t TMR1_GetCapture(uint16_t* LOC_PtrValue){
+	if(0 == (GET_BIT(TIFR, ICF1))) return 0;
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	*LOC_PtrValue = ICR1; // through TEMP, as TCNT1
+	if(LOC_U8Interrupts) CPU_SEI();
+	TIFR = (1<<ICF1);
+	return 1;
+}
+
+/*
+ * Function: TMR1_GetFlag()
+ * Description: This function reads a Timer1 flag, for example to see a compare match whose interrupt is still pending.
+ * Arguments:
+ *   - LOC_U8Flag: the flag (TOV1, OCF1B, OCF1A or ICF1)
+ * Returns: the flag value (1 or 0)
+ */
+uint8_t TMR1_GetFlag(uint8_t LOC_U8Flag){
+	return GET_BIT(TIFR, LOC_U8Flag);
+}
+
+/*
+ * Function: TMR1_EnableInt()
+ * Description: This function clears the pending flag of a Timer1 interrupt and enables it.
+ * Arguments:
+ *   - LOC_U8Int: the interrupt (TOIE1, OCIE1B, OCIE1A or TICIE1), the flag bits match the enable bits
+ * Returns: void
+ */
+void TMR1_EnableInt(uint8_t LOC_U8Int){
+	TIFR = (1<<LOC_U8Int);
+	SET_BIT(TIMSK, LOC_U8Int);
+}
+
+/*
+ * Function: TMR1_DisableInt()
+ * Description: This function disables a Timer1 interrupt.
+ * Arguments:
+ *   - LOC_U8Int: the interrupt (TOIE1, OCIE1B, OCIE1A or TICIE1)
+ * Returns: void
+ */
+void TMR1_DisableInt(uint8_t LOC_U8Int){
+	CLR_BIT(TIMSK, LOC_U8Int);
+}
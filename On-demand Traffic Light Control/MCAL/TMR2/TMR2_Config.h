@@ -0,0 +1,20 @@
+/*
+ * File: TMR2_Config.h
+ *
+ * Description:
+ * This header file contains the configuration macros for Timer2 in this project.
+ * Timer2 runs freely in normal mode from the CPU clock, its interrupts are used by the services (profiler).
+ * It defines the TMR2_PRESCALER macro which represents the prescaler value used for the timer.
+ * With F_CPU = 1 MHz and a prescaler of 32 the timer counts at 31.25 kHz and overflows every 8.192 ms.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TMR2_CONFIG_H_
+#define TMR2_CONFIG_H_
+
+#define TMR2_PRESCALER TMR2_PRE_32
+
+#endif
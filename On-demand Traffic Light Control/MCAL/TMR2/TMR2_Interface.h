@@ -0,0 +1,62 @@
+/*
+ * File: TMR2_Interface.h
+ *
+ * Description:
+ * This header file contains the TMR2_INTERFACE.h, which is responsible for controlling the Timer2 module.
+ * It defines macros for the clock select bits (CS20, CS21, CS22), the waveform generation mode bits (WGM20, WGM21),
+ * the Timer2 interrupt enable bits and flags, the Timer2 interrupt vectors and the timer prescaler (EN_Timer2Prescaler_t).
+ * Timer2 is used in normal mode (free running) or in CTC mode (period of OCR2 + 1 counts), clocked by the CPU clock.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TMR2_INTERFACE_H_
+#define TMR2_INTERFACE_H_
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "TMR2_Private.h"
+#include "TMR2_Config.h"
+
+// Clock Select Bits (TCCR2)
+#define CS20 0
+#define CS21 1
+#define CS22 2
+
+// Waveform Generation Mode Bits (TCCR2)
+#define WGM21 3
+#define WGM20 6
+
+// TIMER2 Interrupt Enable Bits (TIMSK)
+#define TOIE2 6
+#define OCIE2 7
+
+// TIMER2 Flags (TIFR)
+#define TOV2 6
+#define OCF2 7
+
+// Interrupts vector
+#define TMR2_COMP __vector_4
+#define TMR2_OVF  __vector_5
+
+// Prescaler, the values are the clock select bits
+typedef enum scales2{
+	TMR2_NO_PRE = 1,
+	TMR2_PRE_8,
+	TMR2_PRE_32,
+	TMR2_PRE_64,
+	TMR2_PRE_128,
+	TMR2_PRE_256,
+	TMR2_PRE_1024
+} EN_Timer2Prescaler_t;
+
+// Timer function prototypes
+void TMR2_Start(EN_Timer2Prescaler_t LOC_Prescaler);
+void TMR2_StartCtc(EN_Timer2Prescaler_t LOC_Prescaler, uint8_t LOC_U8Top);
+void TMR2_Stop(void);
+void TMR2_EnableInt(uint8_t LOC_U8Int);
+void TMR2_DisableInt(uint8_t LOC_U8Int);
+
+#endif
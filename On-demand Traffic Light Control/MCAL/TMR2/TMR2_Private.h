@@ -0,0 +1,27 @@
+/*
+ * File: TMR2_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control Timer2 in this project.
+ * It defines pointers to the registers TCCR2, TCNT2, OCR2, ASSR, TIMSK, and TIFR which are used for setting
+ * the timer's mode and clock, the timer's value, the output compare value, the asynchronous clock status,
+ * and the timer's interrupt mask and flag respectively.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TMR2_PRIVATE_H
+#define TMR2_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define TCCR2  IO_REG8(0x45) // Timer/Counter2 Control Register
+#define TCNT2  IO_REG8(0x44) // Timer/Counter2 Register
+#define OCR2   IO_REG8(0x43) // Timer/Counter2 Output Compare Register
+#define ASSR   IO_REG8(0x42) // Asynchronous Status Register
+#define TIMSK  IO_REG8(0x59) // Timer/Counter Interrupt Mask Register
+#define TIFR   IO_REG8(0x58) // Timer/Counter Interrupt Flag Register
+
+#endif
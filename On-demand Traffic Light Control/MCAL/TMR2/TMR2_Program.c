@@ -0,0 +1,87 @@
+/*
+ * File: TMR2_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions defined in TMR2_Interface.h.
+ * These functions provide an interface for starting and stopping the Timer2 module in normal or CTC mode
+ * and for enabling its interrupts (overflow, output compare).
+ * The functions use macros defined in BIT_MATH.h for bit manipulation operations.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+*/
+
+#include "TMR2_Interface.h"
+
+/************************************************************************/
+/*                       Control Functions                              */
+/************************************************************************/
+
+/*
+ * Function: TMR2_Start()
+ * Description: This function is responsible for starting the Timer2 module in normal mode from the CPU clock.
+ * It clears TCNT2 and sets the clock select bits in TCCR2 register according to the prescaler.
+ * Arguments:
+ *   - LOC_Prescaler: the timer prescaler (TMR2_NO_PRE .. TMR2_PRE_1024)
+ * Returns: void
+ */
+void TMR2_Start(EN_Timer2Prescaler_t LOC_Prescaler){
+	ASSR = 0;  // synchronous mode, clocked by the CPU clock
+	TCNT2 = 0;
+	TCCR2 = (uint8_t)LOC_Prescaler; // normal mode, no compare output
+}
+
+/*
+ * Function: TMR2_StartCtc()
+ * Description: This function is responsible for starting the Timer2 module in CTC mode from the CPU clock:
+ * the counter is cleared at the compare match with OCR2, so the compare interrupt comes every LOC_U8Top + 1 counts.
+ * Arguments:
+ *   - LOC_Prescaler: the timer prescaler (TMR2_NO_PRE .. TMR2_PRE_1024)
+ *   - LOC_U8Top: the last count of the period (OCR2)
+ * Returns: void
+ */
+void TMR2_StartCtc(EN_Timer2Prescaler_t LOC_Prescaler, uint8_t LOC_U8Top){
+	ASSR = 0;  // synchronous mode, clocked by the CPU clock
+	TCNT2 = 0;
+	OCR2 = LOC_U8Top;
+	TCCR2 = (1<<WGM21) | (uint8_t)LOC_Prescaler; // CTC mode, no compare output
+}
+
+/*
+ * Function: TMR2_Stop()
+ * Description: This function is responsible for stopping the Timer2 module.
+ * It clears the clock select bits in TCCR2 register.
+ * Returns: void
+ */
+void TMR2_Stop(void){
+	TCCR2 &= ~((1<<CS20) | (1<<CS21) | (1<<CS22)); // stop TIMER2
+}
+
+
+/************************************************************************/
+/*                       Interrupt Functions                            */
+/************************************************************************/
+
+/*
+ * Function: TMR2_EnableInt()
+ * Description: This function clears the pending flag of a Timer2 interrupt and enables it.
+ * Arguments:
+ *   - LOC_U8Int: the interrupt (TOIE2 for overflow, OCIE2 for output compare)
+ * Returns: void
+ */
+void TMR2_EnableInt(uint8_t LOC_U8Int){
+	TIFR = (1<<LOC_U8Int); // flags are cleared by writing one, the flag bits match the enable bits
+	SET_BIT(TIMSK, LOC_U8Int);
+}
+
+/*
+ * Function: TMR2_DisableInt()
+ * Description: This function disables a Timer2 interrupt.
+ * Arguments:
+ *   - LOC_U8Int: the interrupt (TOIE2 for overflow, OCIE2 for output compare)
+ * Returns: void
+ */
+void TMR2_DisableInt(uint8_t LOC_U8Int){
+	CLR_BIT(TIMSK, LOC_U8Int);
+}
@@ -0,0 +1,27 @@
+/*
+ * File: TWI_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the TWI (I2C) slave.
+ * The slave is only built when TWI_ENABLE is 1 (set it here or pass -DTWI_ENABLE=1 to the compiler).
+ * It uses SCL (PIN 0 in PORTC) and SDA (PIN 1 in PORTC), so it can not be built together with the countdown display,
+ * and the bus needs its pull-up resistors (the master's). The controller is only a slave, the bit rate is the master's:
+ * at 100 kHz a byte takes 90 us, 90 CPU cycles at 1 MHz, and the slave holds SCL low while its interrupt runs.
+ * The register map holds TWI_MAP_SIZE bytes, the master reads 0xFF past its end.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TWI_CONFIG_H_
+#define TWI_CONFIG_H_
+
+#ifndef TWI_ENABLE
+#define TWI_ENABLE 0
+#endif
+
+#define TWI_ADDRESS  0x28 // 7-bit slave address
+#define TWI_MAP_SIZE 24U  // bytes of the register map
+
+#endif
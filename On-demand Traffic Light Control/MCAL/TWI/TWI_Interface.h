@@ -0,0 +1,83 @@
+/*
+ * File: TWI_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to interact with the TWI (I2C) module in this project
+ * (TWI build only). The controller is a slave exposing a read-only register map to a cabinet master:
+ * the master writes the register pointer (one byte after SLA+W), then reads the registers from there
+ * (repeated START and SLA+R), the pointer moving on with each byte. A read without a pointer write goes on
+ * from the last register read.
+ * The map has two buffers: the application fills the back buffer once per half second and publishes it with a single
+ * byte write, and a read is served from the buffer published at its SLA+R until its end, so the master always gets
+ * a consistent snapshot. The interrupt only loads TWDR from the buffer, one byte per interrupt, with no copy.
+ * The functions prototypes defined in this file include:
+ *   - TWI_Init: function to start the slave
+ *   - TWI_Back: function to get the buffer to fill, unless the master is still reading it
+ *   - TWI_Publish: function to serve the buffer filled from the next read on
+ *   - TWI_GetStats: function to get the bus counters and the CPU time of the interrupt
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TWI_INTERFACE_H
+#define TWI_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "TWI_Private.h"
+#include "TWI_Config.h"
+
+// TWCR bits
+#define TWIE  0
+#define TWEN  2
+#define TWWC  3
+#define TWSTO 4
+#define TWSTA 5
+#define TWEA  6
+#define TWINT 7
+
+// SREG bits
+#define SREG_I 7
+
+// Slave states (TWSR with the prescaler bits masked)
+#define TWI_SR_SLA_ACK   0x60 // own SLA+W received, ACK returned
+#define TWI_SR_DATA_ACK  0x80 // data received, ACK returned
+#define TWI_SR_DATA_NACK 0x88 // data received, NACK returned
+#define TWI_SR_STOP      0xA0 // STOP or repeated START received while addressed as receiver
+#define TWI_ST_SLA_ACK   0xA8 // own SLA+R received, ACK returned
+#define TWI_ST_DATA_ACK  0xB8 // data sent, ACK received
+#define TWI_ST_DATA_NACK 0xC0 // data sent, NACK received (end of the read)
+#define TWI_ST_LAST_ACK  0xC8 // last data sent (TWEA cleared), ACK received
+#define TWI_BUS_ERROR    0x00 // illegal START or STOP
+
+// Interrupts vector
+#define TWI_VECT __vector_19
+
+// Bus counters (saturating) and CPU time
+typedef struct {
+	uint16_t reads;    // read transactions ended (NACK of the master)
+	uint16_t bytes;    // register bytes sent
+	uint16_t pointers; // register pointer writes
+	uint16_t busy;     // snapshots skipped: the master was still reading the back buffer
+	uint16_t errors;   // bus errors
+	uint16_t cpuMax;   // largest CPU time of an interrupt in Timer1 counts
+} ST_TwiStats_t;
+
+#if TWI_ENABLE
+
+void TWI_Init(void);
+uint8_t* TWI_Back(void);
+void TWI_Publish(void);
+void TWI_GetStats(ST_TwiStats_t* LOC_PtrStats);
+
+#else
+
+#define TWI_Init()
+#define TWI_Back() ((uint8_t*)0)
+#define TWI_Publish()
+
+#endif
+
+#endif
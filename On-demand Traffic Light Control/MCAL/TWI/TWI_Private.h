@@ -0,0 +1,26 @@
+/*
+ * File: TWI_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control the TWI (I2C) module in this project.
+ * It defines pointers to the registers TWCR, TWSR, TWAR and TWDR which are used for controlling the bus,
+ * reading the bus state, setting the slave address and exchanging the bytes,
+ * and the status register (SREG) holding the global interrupt enable bit.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TWI_PRIVATE_H
+#define TWI_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define TWCR  IO_REG8(0x56) // TWI Control Register
+#define TWDR  IO_REG8(0x23) // TWI Data Register
+#define TWAR  IO_REG8(0x22) // TWI (Slave) Address Register
+#define TWSR  IO_REG8(0x21) // TWI Status Register
+#define SREG  IO_REG8(0x5F) // Status Register
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * File: TWI_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the TWI slave declared in TWI_Interface.h.
+ * The functions implemented include:
+ *   - TWI_Init: function to set the slave address and answer it
+ *   - TWI_Back, TWI_Publish: functions to fill and publish the register map
+ *   - TWI_GetStats: function to copy the bus counters
+ * TWI_Front is the buffer published, only written by TWI_Publish. The interrupt takes it at each SLA+R into TWI_Reading,
+ * and gives it back at the end of the read, so the back buffer is never the one read unless a read started before
+ * the last publish is still in progress: the application then keeps the published snapshot and skips its update.
+ * After the pointer byte the next bytes of the master are not acknowledged (read-only map).
+ * The CPU time of an interrupt is counted from its first statement, the entry and exit (about 30 cycles) are not counted.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "TWI_Interface.h"
+
+#if TWI_ENABLE
+
+#include "../EXTI/EXTI_Interface.h"
+#include "../TMR1/TMR1_Interface.h"
+
+#define TWI_NONE 0xFF // no read in progress
+
+static uint8_t TWI_Map[2][TWI_MAP_SIZE];
+static volatile uint8_t TWI_Front;            // buffer published
+static volatile uint8_t TWI_Reading = TWI_NONE; // buffer of the read in progress
+static uint8_t TWI_Pointer;                   // next register sent
+
+// Counters
+static volatile uint16_t TWI_Reads;
+static volatile uint16_t TWI_Bytes;
+static volatile uint16_t TWI_Pointers;
+static uint16_t TWI_Busy;
+static volatile uint16_t TWI_Errors;
+static volatile uint16_t TWI_CpuMax;
+
+/*
+ * Function: TWI_Count()
+ * Description: Adds one to a saturating counter.
+ */
+static void TWI_Count(volatile uint16_t* LOC_PtrCounter){
+	if(0xFFFF != *LOC_PtrCounter) (*LOC_PtrCounter)++;
+}
+
+/*
+ * Function: TWI_Init()
+ * Description: This function sets the slave address (TWI_ADDRESS, general call ignored) and enables the slave
+ * with its interrupt: from now on the own address is acknowledged. Both buffers start with zeros.
+ * Return value: void
+ */
+void TWI_Init(void){
+	TWAR = (uint8_t)(TWI_ADDRESS << 1);
+	TWCR = (1<<TWEA) | (1<<TWEN) | (1<<TWIE);
+}
+
+/*
+ * Function: TWI_Back()
+ * Description: This function gets the buffer to fill with the next snapshot, all its registers must be written.
+ * Return value: the back buffer (TWI_MAP_SIZE bytes), 0 if a read started before the last publish still uses it
+ */
+uint8_t* TWI_Back(void){
+	uint8_t LOC_U8Back = TWI_Front ^ 1;
+	if(LOC_U8Back == TWI_Reading){
+		TWI_Count(&TWI_Busy);
+		return 0;
+	}
+	return TWI_Map[LOC_U8Back];
+}
+
+/*
+ * Function: TWI_Publish()
+ * Description: This function publishes the buffer filled, the reads starting from now on are served from it.
+ * Return value: void
+ */
+void TWI_Publish(void){
+	TWI_Front ^= 1;
+}
+
+/*
+ * Function: TWI_GetStats()
+ * Description: This function copies the bus counters and the CPU time, written by the interrupt.
+ * Arguments:
+ *   - LOC_PtrStats: where to copy them
+ * Return value: void
+ */
+void TWI_GetStats(ST_TwiStats_t* LOC_PtrStats){
+	LOC_PtrStats->busy = TWI_Busy;
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	LOC_PtrStats->reads = TWI_Reads;
+	LOC_PtrStats->bytes = TWI_Bytes;
+	LOC_PtrStats->pointers = TWI_Pointers;
+	LOC_PtrStats->errors = TWI_Errors;
+	LOC_PtrStats->cpuMax = TWI_CpuMax;
+	if(LOC_U8Interrupts) CPU_SEI();
+}
+
+/*
+ * ISR: TWI, one bus event of the slave. SCL is held low from the event until TWINT is cleared at the end.
+ */
+ISR(TWI_VECT){
+	uint16_t LOC_U16Start = TMR1_GetCount();
+	uint8_t LOC_U8Control = (1<<TWINT) | (1<<TWEA) | (1<<TWEN) | (1<<TWIE);
+	switch(TWSR & 0xF8){
+		case TWI_SR_DATA_ACK:
+			TWI_Pointer = TWDR;
+			TWI_Count(&TWI_Pointers);
+			LOC_U8Control &= ~(1<<TWEA); // the next byte is not acknowledged
+		break;
+		case TWI_ST_SLA_ACK:
+			TWI_Reading = TWI_Front;
+			/* fall through */
+		case TWI_ST_DATA_ACK:
+			TWDR = (TWI_Pointer < TWI_MAP_SIZE) ? TWI_Map[TWI_Reading][TWI_Pointer] : 0xFF;
+			TWI_Pointer++;
+			TWI_Count(&TWI_Bytes);
+		break;
+		case TWI_ST_DATA_NACK:
+		case TWI_ST_LAST_ACK:
+			TWI_Reading = TWI_NONE;
+			TWI_Count(&TWI_Reads);
+		break;
+		case TWI_BUS_ERROR:
+			TWI_Reading = TWI_NONE;
+			TWI_Count(&TWI_Errors);
+			LOC_U8Control |= (1<<TWSTO); // back to the not addressed state, SDA and SCL released
+		break;
+		default: // own SLA+W, data after the pointer (NACK returned, not addressed any more), STOP or repeated START
+		break;
+	}
+	TWCR = LOC_U8Control;
+	uint16_t LOC_U16Now = TMR1_GetCount();
+	if(LOC_U16Now < LOC_U16Start) LOC_U16Now += TMR1_GetTop() + 1;
+	if(LOC_U16Now - LOC_U16Start > TWI_CpuMax) TWI_CpuMax = LOC_U16Now - LOC_U16Start;
+}
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * File: UART_Config.h
+ *
+ * Description:
+ * This header file contains the configuration macros for the USART in this project (asynchronous, 8 data bits,
+ * no parity, 1 stop bit). It defines the UART_UBRR macro, the baud rate register value.
+ * With F_CPU = 1 MHz and double speed (U2X): UBRR = F_CPU / (8 * baud) - 1 = 12 for 9600 baud (9615 baud, +0.2%).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef UART_CONFIG_H_
+#define UART_CONFIG_H_
+
+#define UART_UBRR 12U // 9600 baud with U2X
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * File: UART_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to interact with the USART module in this project.
+ * It includes the necessary headers and defines the USART register bits and vectors.
+ * The received bytes are given to a callback registered by the user, called from the receive complete interrupt,
+ * the bytes are sent by polling the data register empty flag. The bootloader, which runs with the interrupts disabled,
+ * polls the received bytes instead.
+ * The functions prototypes defined in this file include:
+ *   - UART_Init: function to initialize the USART (UART_Config.h) and enable the receive interrupt
+ *   - UART_SetRxCallback: function to register the function called with each received byte
+ *   - UART_SendByte: function to send one byte
+ *   - UART_Send: function to send a block of bytes
+ *   - UART_SendString: function to send a null terminated string
+ *   - UART_ReceiveByte: function to get a received byte without the interrupt
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef UART_INTERFACE_H
+#define UART_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "UART_Private.h"
+#include "UART_Config.h"
+
+// UCSRA bits
+#define U2X   1
+#define PE    2
+#define DOR   3
+#define FE    4
+#define UDRE  5
+#define TXC   6
+#define RXC   7
+
+// UCSRB bits
+#define TXEN  3
+#define RXEN  4
+#define UDRIE 5
+#define TXCIE 6
+#define RXCIE 7
+
+// UCSRC bits
+#define UCSZ0 1
+#define UCSZ1 2
+#define URSEL 7
+
+// Interrupts vector
+#define UART_RXC  __vector_13
+#define UART_UDRE __vector_14
+#define UART_TXC  __vector_15
+
+// Receive callback, called from the interrupt with the received byte
+typedef void (*UART_RxCallback_t)(uint8_t LOC_U8Byte);
+
+// UART function prototypes
+void UART_Init(void);
+void UART_SetRxCallback(UART_RxCallback_t LOC_PtrCallback);
+void UART_SendByte(uint8_t LOC_U8Byte);
+void UART_Send(const uint8_t* LOC_PtrData, uint8_t LOC_U8Len);
+void UART_SendString(const char* LOC_PtrString);
+uint8_t UART_ReceiveByte(uint8_t* LOC_PtrByte);
+
+#endif
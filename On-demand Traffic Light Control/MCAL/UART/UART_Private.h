@@ -0,0 +1,26 @@
+/*
+ * File: UART_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control the USART module in this project.
+ * It defines pointers to the registers UDR, UCSRA, UCSRB, UCSRC and UBRRL.
+ * UCSRC and UBRRH share the same address, UCSRC is selected by writing URSEL to one.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef UART_PRIVATE_H
+#define UART_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define UDR     IO_REG8(0x2C) // USART I/O Data Register
+#define UCSRA   IO_REG8(0x2B) // USART Control and Status Register A
+#define UCSRB   IO_REG8(0x2A) // USART Control and Status Register B
+#define UBRRL   IO_REG8(0x29) // USART Baud Rate Register Low
+#define UCSRC   IO_REG8(0x40) // USART Control and Status Register C (URSEL = 1)
+#define UBRRH   IO_REG8(0x40) // USART Baud Rate Register High (URSEL = 0)
+
+#endif
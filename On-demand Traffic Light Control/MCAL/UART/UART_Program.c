@@ -0,0 +1,117 @@
+/*
+ * File: UART_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions used to interact with the USART module in this project.
+ * The functions implemented include:
+ *   - UART_Init: function to initialize the USART and enable the receive interrupt
+ *   - UART_SetRxCallback: function to register the receive callback
+ *   - UART_SendByte, UART_Send, UART_SendString: functions to send bytes by polling
+ * The received bytes with a framing error are dropped.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "UART_Interface.h"
+#include "../EXTI/EXTI_Interface.h"
+
+static void UART_Ignore(uint8_t LOC_U8Byte);
+
+static volatile UART_RxCallback_t UART_RxCallback = UART_Ignore;
+
+/*
+ * Function: UART_Ignore()
+ * Description: Receive callback used until one is registered.
+ */
+static void UART_Ignore(uint8_t LOC_U8Byte){
+	(void)LOC_U8Byte;
+}
+
+/*
+ * Function: UART_Init()
+ * Description: This function initializes the USART: double speed, baud rate from UART_Config.h,
+ * 8 data bits, no parity, 1 stop bit, receiver and transmitter enabled, receive complete interrupt enabled.
+ * Return value: void
+ */
+void UART_Init(void){
+	SET_BIT(UCSRA, U2X);
+	UBRRH = (uint8_t)(UART_UBRR >> 8); // URSEL = 0
+	UBRRL = (uint8_t)UART_UBRR;
+	UCSRC = (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0);
+	UCSRB = (1<<RXCIE) | (1<<RXEN) | (1<<TXEN);
+}
+
+/*
+ * Function: UART_SetRxCallback()
+ * Description: This function registers the function called with each received byte, a null pointer removes it.
+ * The callback runs in the interrupt, with the interrupts disabled, and must be short (one byte every 1 ms at 9600 baud).
+ * Arguments:
+ *   - LOC_PtrCallback: the function to call
+ * Return value: void
+ */
+void UART_SetRxCallback(UART_RxCallback_t LOC_PtrCallback){
+	UART_RxCallback = LOC_PtrCallback ? LOC_PtrCallback : UART_Ignore;
+}
+
+/*
+ * Function: UART_SendByte()
+ * Description: This function waits for the transmit buffer to be empty and sends one byte.
+ * TXC is cleared (by writing one, the error flags are written zero) before the byte is loaded,
+ * so it tells when the last byte sent has left the shift register.
+ * Arguments:
+ *   - LOC_U8Byte: the byte to send
+ * Return value: void
+ */
+void UART_SendByte(uint8_t LOC_U8Byte){
+	while(!(GET_BIT(UCSRA, UDRE))) IO_POLL();
+	UCSRA = (UCSRA & (1<<U2X)) | (1<<TXC);
+	UDR = LOC_U8Byte;
+	IO_SYNC();
+}
+
+/*
+ * Function: UART_Send()
+ * Description: This function sends a block of bytes, binary data included.
+ * Arguments:
+ *   - LOC_PtrData: the bytes to send
+ *   - LOC_U8Len: the number of bytes
+ * Return value: void
+ */
+void UART_Send(const uint8_t* LOC_PtrData, uint8_t LOC_U8Len){
+	for(uint8_t i=0; i<LOC_U8Len; i++) UART_SendByte(LOC_PtrData[i]);
+}
+
+/*
+ * Function: UART_SendString()
+ * Description: This function sends a null terminated string.
+ * Arguments:
+ *   - LOC_PtrString: the string to send
+ * Return value: void
+ */
+void UART_SendString(const char* LOC_PtrString){
+	while(*LOC_PtrString) UART_SendByte((uint8_t)*LOC_PtrString++);
+}
+
+/*
+ * Function: UART_ReceiveByte()
+ * Description: This function gets the byte received, if any, it does not wait.
+ * It is used with the interrupts disabled, the receive interrupt would take the byte otherwise.
+ * Arguments:
+ *   - LOC_PtrByte: where to store the byte
+ * Return value: 1 if a byte was received without framing error, 0 otherwise
+ */
+uint8_t UART_ReceiveByte(uint8_t* LOC_PtrByte){
+	if(!GET_BIT(UCSRA, RXC)) return 0;
+	uint8_t LOC_U8Error = GET_BIT(UCSRA, FE); // must be read before UDR
+	*LOC_PtrByte = UDR; // clears RXC
+	UCSRA = UCSRA & (1<<U2X); // no effect on the flags (RXC read-only, TXC kept), RXC seen cleared by the host backend
+	return !LOC_U8Error;
+}
+
+ISR(UART_RXC){
+	uint8_t LOC_U8Error = GET_BIT(UCSRA, FE); // must be read before UDR
+	uint8_t LOC_U8Byte = UDR;
+	if(!LOC_U8Error) UART_RxCallback(LOC_U8Byte);
+}
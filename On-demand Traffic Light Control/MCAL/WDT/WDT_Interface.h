@@ -0,0 +1,53 @@
+/*
+ * File: WDT_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the functions used to interact with the Watchdog Timer (WDT) module in this project.
+ * It includes the necessary headers and defines the constants used to represent the watchdog timeouts.
+ * The functions prototypes defined in this file include:
+ *   - WDT_Enable: function to start the watchdog with a specific timeout
+ *   - WDT_Disable: function to stop the watchdog using the timed sequence
+ *   - WDT_Refresh: function to restart the watchdog count before it times out
+ *   - WDT_IsResetCause: function to check (and clear) if the last reset was caused by the watchdog
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef WDT_INTERFACE_H
+#define WDT_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/BIT_MATH.h"
+#include "WDT_Private.h"
+
+// WDTCR bits
+#define WDP0  0
+#define WDP1  1
+#define WDP2  2
+#define WDE   3
+#define WDTOE 4
+
+// MCUCSR bits
+#define WDRF  3
+
+// Watchdog timeout (typical values at VCC = 5V)
+typedef enum timeout{
+	WDT_16MS,
+	WDT_32MS,
+	WDT_65MS,
+	WDT_130MS,
+	WDT_260MS,
+	WDT_520MS,
+	WDT_1000MS,
+	WDT_2100MS
+} EN_WDTTimeout_t;
+
+// WDT function prototypes
+void WDT_Enable(EN_WDTTimeout_t LOC_Timeout);
+void WDT_Disable(void);
+void WDT_Refresh(void);
+uint8_t WDT_IsResetCause(void);
+
+#endif
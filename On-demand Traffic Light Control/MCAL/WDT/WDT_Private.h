@@ -0,0 +1,22 @@
+/*
+ * File: WDT_Private.h
+ *
+ * Description:
+ * This header file contains the addresses of the registers used to control the Watchdog Timer (WDT) module in this project.
+ * It defines pointers to the registers WDTCR and MCUCSR.
+ * WDTCR configures the watchdog timeout and enables it, MCUCSR holds the watchdog reset flag.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef WDT_PRIVATE_H
+#define WDT_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define WDTCR   IO_REG8(0x41)
+#define MCUCSR  IO_REG8(0x54)
+
+#endif
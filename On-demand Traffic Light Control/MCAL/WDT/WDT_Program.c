@@ -0,0 +1,65 @@
+/*
+ * File: WDT_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the functions used to interact with the Watchdog Timer (WDT) module in this project.
+ * The watchdog resets the microcontroller if it is not refreshed within the chosen timeout,
+ * which is used to detect a wedged firmware and bring the controller back in a safe state.
+ * The functions implemented include:
+ *   - WDT_Enable: function to start the watchdog with a specific timeout
+ *   - WDT_Disable: function to stop the watchdog using the timed sequence
+ *   - WDT_Refresh: function to restart the watchdog count before it times out
+ *   - WDT_IsResetCause: function to check (and clear) if the last reset was caused by the watchdog
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "WDT_Interface.h"
+
+/*
+ * Function: WDT_Enable()
+ * Description: This function is used to start the watchdog timer with a specific timeout.
+ * Arguments:
+ *   - LOC_Timeout: the watchdog timeout (WDT_16MS ... WDT_2100MS)
+ * Return value: void
+ */
+void WDT_Enable(EN_WDTTimeout_t LOC_Timeout){
+	WDT_Refresh();
+	WDTCR = (1<<WDE) | (LOC_Timeout & 0x07);
+}
+
+/*
+ * Function: WDT_Disable()
+ * Description: This function is used to stop the watchdog timer.
+ * WDE can only be cleared if WDTOE is written to one in the same operation as WDE,
+ * and then WDE is written to zero within the next four clock cycles.
+ * Return value: void
+ */
+void WDT_Disable(void){
+	WDT_Refresh();
+	WDTCR = (1<<WDTOE) | (1<<WDE);
+	WDTCR = 0x00;
+}
+
+/*
+ * Function: WDT_Refresh()
+ * Description: This function is used to restart the watchdog count, it must be called before the timeout expires.
+ * Return value: void
+ */
+void WDT_Refresh(void){
+	CPU_WDR();
+}
+
+/*
+ * Function: WDT_IsResetCause()
+ * Description: This function is used to check if the last reset was caused by the watchdog.
+ * The flag is cleared after reading so the next reset reports its own cause.
+ * Return value: 1 if the last reset was a watchdog reset, 0 otherwise
+ */
+uint8_t WDT_IsResetCause(void){
+	uint8_t LOC_U8Result = GET_BIT(MCUCSR, WDRF);
+	CLR_BIT(MCUCSR, WDRF);
+	return LOC_U8Result;
+}
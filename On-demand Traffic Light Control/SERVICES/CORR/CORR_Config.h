@@ -0,0 +1,35 @@
+/*
+ * File: CORR_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the corridor coordination: the node number of this controller,
+ * the node it follows and its offset, and the timing of the frames and of the corrections.
+ * The times are in half seconds (one scheduler round, SCHED).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef CORR_CONFIG_H
+#define CORR_CONFIG_H
+
+// Node number of this controller on the bus (0 to 254)
+#define CORR_NODE_ID 0
+
+// Node followed by this controller: CORR_NONE to run alone, CORR_NODE_ID to be the master of the corridor
+#define CORR_MASTER_ID CORR_NONE
+
+// Start of the cycle after the start of the master cycle (green wave offset)
+#define CORR_OFFSET 0
+
+// The master publishes its cycle position every CORR_PUBLISH_TICKS
+#define CORR_PUBLISH_TICKS 2
+
+// A follower runs alone when the master is silent for more than CORR_TIMEOUT_TICKS
+#define CORR_TIMEOUT_TICKS 20
+
+// Largest change of the green time per cycle when following
+#define CORR_MAX_STEP 4
+
+#endif
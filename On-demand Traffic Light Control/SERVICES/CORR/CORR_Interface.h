@@ -0,0 +1,61 @@
+/*
+ * File: CORR_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the corridor coordination, which lets neighbouring controllers
+ * keep a fixed offset between their cycles (green wave) over a shared serial bus (9600 baud, 8N1).
+ * The master publishes its cycle position in a 7-byte frame, the followers adjust their green time
+ * at each cycle start (by at most CORR_MAX_STEP) until their cycle starts CORR_OFFSET after the master cycle.
+ * The coordinated controllers must run plans with the same cycle length (green + yellow + red + yellow),
+ * a pedestrian sequence delays the cycle and is caught up in the next cycles.
+ * Frame:
+ *   - CORR_SYNC, source node, sequence number, phase (EN_PlanPhase_t), cycle position (2 bytes, little endian,
+ *     half seconds since the cycle start), CRC-8 of the 5 bytes after CORR_SYNC
+ * The frames are parsed one byte at a time in the receive interrupt, only the fields of the frame in progress are kept.
+ * CORR_SYNC is not an ASCII character, so the frames can share the serial port with the text commands (PLAN)
+ * of a standalone controller: the bytes that are not part of a frame are left to them.
+ * A controller on the bus (master or follower) drops them, its plan is set before it joins the corridor.
+ * The functions prototypes defined in this file include:
+ *   - CORR_Init: function to set the node, the master and the offset
+ *   - CORR_Receive: function to parse a received byte (receive interrupt)
+ *   - CORR_Tick: function to count the half seconds and publish the position (master)
+ *   - CORR_Phase: function to report the current phase
+ *   - CORR_CycleStart: function to start a cycle and get the green time correction (follower)
+ *   - CORR_GetStats: function to get the frame counters
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef CORR_INTERFACE_H
+#define CORR_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../PLAN/PLAN_Interface.h"
+
+// No node
+#define CORR_NONE 0xFF
+
+#include "CORR_Config.h"
+
+// Frame
+#define CORR_SYNC      0xA5
+#define CORR_FRAME_LEN 7
+
+// Frame counters of a follower (saturating)
+typedef struct {
+	uint16_t frames;     // valid frames of the master
+	uint16_t crcErrors;  // frames dropped because of the CRC
+	uint16_t lost;       // frames of the master missing in the sequence numbers
+} ST_CorrStats_t;
+
+// CORR function prototypes
+void CORR_Init(uint8_t LOC_U8Node, uint8_t LOC_U8Master, uint8_t LOC_U8Offset);
+uint8_t CORR_Receive(uint8_t LOC_U8Byte);
+void CORR_Tick(void);
+void CORR_Phase(EN_PlanPhase_t LOC_Phase);
+int8_t CORR_CycleStart(uint16_t LOC_U16Cycle);
+void CORR_GetStats(ST_CorrStats_t* LOC_PtrStats);
+
+#endif
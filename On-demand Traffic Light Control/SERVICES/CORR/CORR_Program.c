@@ -0,0 +1,228 @@
+/*
+ * File: CORR_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the corridor coordination declared in CORR_Interface.h.
+ * The receive interrupt runs the frame parser: a byte counter, the running CRC-8 and the fields read so far.
+ * A valid frame of the master is handed to the main loop through a one-frame mailbox: the interrupt fills it
+ * only when it is empty, and CORR_Tick empties it, so the 16-bit position is never read half-written.
+ * The master position is then advanced by the half seconds counted since the frame, and at each cycle start
+ * the follower compares its position (zero) with the position it should have: master position minus the offset.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "CORR_Interface.h"
+#include "../CRC/CRC_Interface.h"
+#include "../../MCAL/UART/UART_Interface.h"
+
+static uint8_t CORR_Node;
+static uint8_t CORR_Master;
+static uint8_t CORR_Offset;
+
+// Own cycle
+static uint16_t CORR_Position;      // half seconds since the cycle start
+static uint8_t CORR_CurrentPhase;
+static uint8_t CORR_Sequence;
+static uint8_t CORR_PublishCount;
+
+// Master cycle, as known by a follower
+static uint16_t CORR_MasterPos;     // position in the last frame
+static uint8_t CORR_MasterAge;      // half seconds since that frame, CORR_TIMEOUT_TICKS + 1 = unknown
+
+// Parser, in the receive interrupt
+static uint8_t CORR_RxIndex;        // bytes of the frame received, 0 = waiting for CORR_SYNC
+static uint8_t CORR_RxCrc;
+static uint8_t CORR_RxSrc, CORR_RxSeq, CORR_RxPhase;
+static uint16_t CORR_RxPos;
+static uint8_t CORR_RxLastSeq;
+static uint8_t CORR_RxSeen;         // a frame of the master was received
+
+// Mailbox, written by the interrupt when empty
+static volatile uint8_t CORR_BoxFull;
+static volatile uint16_t CORR_BoxPos;
+static volatile uint8_t CORR_BoxPhase;
+
+static volatile ST_CorrStats_t CORR_Stats;
+
+/*
+ * Function: CORR_Count()
+ * Description: Adds to a saturating counter.
+ */
+static void CORR_Count(volatile uint16_t* LOC_PtrCounter, uint8_t LOC_U8Value){
+	uint16_t LOC_U16Sum = *LOC_PtrCounter + LOC_U8Value;
+	*LOC_PtrCounter = (LOC_U16Sum < *LOC_PtrCounter) ? 0xFFFF : LOC_U16Sum;
+}
+
+/*
+ * Function: CORR_Following()
+ * Description: Tells if this controller follows another one.
+ */
+static uint8_t CORR_Following(void){
+	return CORR_NONE != CORR_Master && CORR_Node != CORR_Master;
+}
+
+/*
+ * Function: CORR_Publish()
+ * Description: Sends a frame with the current phase and cycle position.
+ */
+static void CORR_Publish(void){
+	uint8_t LOC_U8Frame[CORR_FRAME_LEN];
+	LOC_U8Frame[0] = CORR_SYNC;
+	LOC_U8Frame[1] = CORR_Node;
+	LOC_U8Frame[2] = CORR_Sequence++;
+	LOC_U8Frame[3] = CORR_CurrentPhase;
+	LOC_U8Frame[4] = (uint8_t)CORR_Position;
+	LOC_U8Frame[5] = (uint8_t)(CORR_Position >> 8);
+	LOC_U8Frame[6] = CRC_8(&LOC_U8Frame[1], CORR_FRAME_LEN - 2);
+	UART_Send(LOC_U8Frame, CORR_FRAME_LEN);
+}
+
+/*
+ * Function: CORR_Init()
+ * Description: This function sets the role of the controller and clears the counters.
+ * Arguments:
+ *   - LOC_U8Node: the node number of this controller
+ *   - LOC_U8Master: the node followed, LOC_U8Node to be the master, CORR_NONE to run alone
+ *   - LOC_U8Offset: the start of the cycle after the start of the master cycle, in half seconds
+ * Return value: void
+ */
+void CORR_Init(uint8_t LOC_U8Node, uint8_t LOC_U8Master, uint8_t LOC_U8Offset){
+	CORR_Node = LOC_U8Node;
+	CORR_Master = LOC_U8Master;
+	CORR_Offset = LOC_U8Offset;
+	CORR_Position = 0;
+	CORR_CurrentPhase = PLAN_GREEN;
+	CORR_PublishCount = 0;
+	CORR_MasterAge = CORR_TIMEOUT_TICKS + 1;
+	CORR_RxIndex = 0;
+	CORR_RxSeen = 0;
+	CORR_BoxFull = 0;
+	CORR_Stats.frames = 0;
+	CORR_Stats.crcErrors = 0;
+	CORR_Stats.lost = 0;
+}
+
+/*
+ * Function: CORR_Receive()
+ * Description: This function parses one received byte, it is called from the receive interrupt.
+ * A frame with a wrong CRC is dropped, and the parser waits for the next CORR_SYNC.
+ * A controller on the bus drops the bytes outside the frames: a text command garbled from a frame
+ * would otherwise be answered on the bus, and the answers of the controllers would feed each other.
+ * Arguments:
+ *   - LOC_U8Byte: the received byte
+ * Return value: 1 if the byte is used or dropped here, 0 if it is left to the text commands (standalone controller)
+ */
+uint8_t CORR_Receive(uint8_t LOC_U8Byte){
+	switch(CORR_RxIndex){
+		case 0:
+			if(CORR_SYNC != LOC_U8Byte) return CORR_NONE != CORR_Master; // on the bus, no text commands
+			CORR_RxCrc = CRC_8_INIT;
+			CORR_RxIndex = 1;
+			return 1;
+		case 1: CORR_RxSrc = LOC_U8Byte; break;
+		case 2: CORR_RxSeq = LOC_U8Byte; break;
+		case 3: CORR_RxPhase = LOC_U8Byte; break;
+		case 4: CORR_RxPos = LOC_U8Byte; break;
+		case 5: CORR_RxPos |= (uint16_t)LOC_U8Byte << 8; break;
+		default:
+			CORR_RxIndex = 0;
+			if(LOC_U8Byte != CORR_RxCrc){
+				CORR_Count(&CORR_Stats.crcErrors, 1);
+				return 1;
+			}
+			if(!CORR_Following() || CORR_RxSrc != CORR_Master) return 1;
+			if(CORR_RxSeen) CORR_Count(&CORR_Stats.lost, (uint8_t)(CORR_RxSeq - CORR_RxLastSeq - 1));
+			CORR_RxSeen = 1;
+			CORR_RxLastSeq = CORR_RxSeq;
+			CORR_Count(&CORR_Stats.frames, 1);
+			if(!CORR_BoxFull){
+				CORR_BoxPos = CORR_RxPos;
+				CORR_BoxPhase = CORR_RxPhase;
+				CORR_BoxFull = 1;
+			}
+			return 1;
+	}
+	CORR_RxCrc = CRC_8Update(CORR_RxCrc, LOC_U8Byte);
+	CORR_RxIndex++;
+	return 1;
+}
+
+/*
+ * Function: CORR_Tick()
+ * Description: This function counts one half second, it is called by the application every half second.
+ * The master publishes its position every CORR_PUBLISH_TICKS (the frame takes about 7 ms to send),
+ * a follower takes the last frame of the master.
+ * Return value: void
+ */
+void CORR_Tick(void){
+	CORR_Position++;
+	if(CORR_MasterAge <= CORR_TIMEOUT_TICKS) CORR_MasterAge++;
+
+	if(CORR_Following()){
+		if(CORR_BoxFull){
+			// The master position only counts in the normal cycle
+			if(CORR_BoxPhase < PLAN_PED_YELLOW){
+				CORR_MasterPos = CORR_BoxPos;
+				CORR_MasterAge = 0;
+			}
+			CORR_BoxFull = 0;
+		}
+	}
+	else if(CORR_NONE != CORR_Master && ++CORR_PublishCount >= CORR_PUBLISH_TICKS){
+		CORR_PublishCount = 0;
+		CORR_Publish();
+	}
+}
+
+/*
+ * Function: CORR_Phase()
+ * Description: This function records the current phase, sent in the frames of the master.
+ * Arguments:
+ *   - LOC_Phase: the phase starting
+ * Return value: void
+ */
+void CORR_Phase(EN_PlanPhase_t LOC_Phase){
+	CORR_CurrentPhase = (uint8_t)LOC_Phase;
+}
+
+/*
+ * Function: CORR_CycleStart()
+ * Description: This function starts a new normal cycle. A follower that knows the master position gets
+ * the change of its green time that brings its cycle start CORR_OFFSET after the master cycle start:
+ * shorter when it is late, longer when it is early, by at most CORR_MAX_STEP.
+ * Arguments:
+ *   - LOC_U16Cycle: the length of the cycle in half seconds
+ * Return value: the half seconds to add to the green time, 0 if not following
+ */
+int8_t CORR_CycleStart(uint16_t LOC_U16Cycle){
+	CORR_Position = 0;
+	if(!CORR_Following() || CORR_MasterAge > CORR_TIMEOUT_TICKS || !LOC_U16Cycle) return 0;
+
+	// Position this controller should have now, between -cycle/2 and +cycle/2
+	uint16_t LOC_U16Master = (CORR_MasterPos + CORR_MasterAge) % LOC_U16Cycle;
+	int16_t LOC_S16Late = (int16_t)((LOC_U16Master + LOC_U16Cycle - CORR_Offset % LOC_U16Cycle) % LOC_U16Cycle);
+	if(LOC_S16Late > (int16_t)(LOC_U16Cycle / 2)) LOC_S16Late -= (int16_t)LOC_U16Cycle;
+
+	if(LOC_S16Late > CORR_MAX_STEP) LOC_S16Late = CORR_MAX_STEP;
+	if(LOC_S16Late < -CORR_MAX_STEP) LOC_S16Late = -CORR_MAX_STEP;
+	return (int8_t)-LOC_S16Late;
+}
+
+/*
+ * Function: CORR_GetStats()
+ * Description: This function copies the frame counters, they are updated by the receive interrupt.
+ * Arguments:
+ *   - LOC_PtrStats: where to copy the counters
+ * Return value: void
+ */
+void CORR_GetStats(ST_CorrStats_t* LOC_PtrStats){
+	do{
+		LOC_PtrStats->frames = CORR_Stats.frames;
+		LOC_PtrStats->crcErrors = CORR_Stats.crcErrors;
+		LOC_PtrStats->lost = CORR_Stats.lost;
+	} while(LOC_PtrStats->frames != CORR_Stats.frames || LOC_PtrStats->crcErrors != CORR_Stats.crcErrors
+	        || LOC_PtrStats->lost != CORR_Stats.lost); // read again if a frame came meanwhile
+}
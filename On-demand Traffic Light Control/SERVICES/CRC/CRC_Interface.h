@@ -0,0 +1,35 @@
+/*
+ * File: CRC_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the CRC functions used to check the data stored or received by the services.
+ * CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, no reflection, no final xor
+ * (check value 0x29B1 for the ASCII string "123456789").
+ * CRC-8: polynomial 0x07, initial value 0x00, no reflection, no final xor (check value 0xF4),
+ * used for the short messages where a CRC-16 would double the overhead.
+ * The functions prototypes defined in this file include:
+ *   - CRC_16Update: function to add one byte to a CRC-16
+ *   - CRC_16: function to get the CRC-16 of a block of bytes
+ *   - CRC_8Update: function to add one byte to a CRC-8
+ *   - CRC_8: function to get the CRC-8 of a block of bytes
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef CRC_INTERFACE_H
+#define CRC_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+
+#define CRC_16_INIT 0xFFFFU
+#define CRC_8_INIT  0x00U
+
+// CRC function prototypes
+uint16_t CRC_16Update(uint16_t LOC_U16Crc, uint8_t LOC_U8Byte);
+uint16_t CRC_16(const uint8_t* LOC_PtrData, uint16_t LOC_U16Len);
+uint8_t CRC_8Update(uint8_t LOC_U8Crc, uint8_t LOC_U8Byte);
+uint8_t CRC_8(const uint8_t* LOC_PtrData, uint16_t LOC_U16Len);
+
+#endif
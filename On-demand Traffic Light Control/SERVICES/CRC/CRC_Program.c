@@ -0,0 +1,75 @@
+/*
+ * File: CRC_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the CRC functions declared in CRC_Interface.h.
+ * The CRC is computed bit by bit: no table in flash or RAM, about 100 cycles per byte,
+ * which is enough for the few bytes checked at boot or per received message.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "CRC_Interface.h"
+
+/*
+ * Function: CRC_16Update()
+ * Description: This function adds one byte to a CRC-16, start with CRC_16_INIT.
+ * Arguments:
+ *   - LOC_U16Crc: the CRC of the previous bytes
+ *   - LOC_U8Byte: the next byte
+ * Returns: the CRC including the byte
+ */
+uint16_t CRC_16Update(uint16_t LOC_U16Crc, uint8_t LOC_U8Byte){
+	LOC_U16Crc ^= (uint16_t)LOC_U8Byte << 8;
+	for(uint8_t i=0; i<8; i++){
+		LOC_U16Crc = (LOC_U16Crc & 0x8000) ? (LOC_U16Crc << 1) ^ 0x1021 : (LOC_U16Crc << 1);
+	}
+	return LOC_U16Crc;
+}
+
+/*
+ * Function: CRC_16()
+ * Description: This function gets the CRC-16 of a block of bytes.
+ * Arguments:
+ *   - LOC_PtrData: the bytes
+ *   - LOC_U16Len: the number of bytes
+ * Returns: the CRC
+ */
+uint16_t CRC_16(const uint8_t* LOC_PtrData, uint16_t LOC_U16Len){
+	uint16_t LOC_U16Crc = CRC_16_INIT;
+	for(uint16_t i=0; i<LOC_U16Len; i++) LOC_U16Crc = CRC_16Update(LOC_U16Crc, LOC_PtrData[i]);
+	return LOC_U16Crc;
+}
+
+/*
+ * Function: CRC_8Update()
+ * Description: This function adds one byte to a CRC-8, start with CRC_8_INIT.
+ * It is short enough to run in a receive interrupt, one byte at a time.
+ * Arguments:
+ *   - LOC_U8Crc: the CRC of the previous bytes
+ *   - LOC_U8Byte: the next byte
+ * Returns: the CRC including the byte
+ */
+uint8_t CRC_8Update(uint8_t LOC_U8Crc, uint8_t LOC_U8Byte){
+	LOC_U8Crc ^= LOC_U8Byte;
+	for(uint8_t i=0; i<8; i++){
+		LOC_U8Crc = (LOC_U8Crc & 0x80) ? (uint8_t)((LOC_U8Crc << 1) ^ 0x07) : (uint8_t)(LOC_U8Crc << 1);
+	}
+	return LOC_U8Crc;
+}
+
+/*
+ * Function: CRC_8()
+ * Description: This function gets the CRC-8 of a block of bytes.
+ * Arguments:
+ *   - LOC_PtrData: the bytes
+ *   - LOC_U16Len: the number of bytes
+ * Returns: the CRC
+ */
+uint8_t CRC_8(const uint8_t* LOC_PtrData, uint16_t LOC_U16Len){
+	uint8_t LOC_U8Crc = CRC_8_INIT;
+	for(uint16_t i=0; i<LOC_U16Len; i++) LOC_U8Crc = CRC_8Update(LOC_U8Crc, LOC_PtrData[i]);
+	return LOC_U8Crc;
+}
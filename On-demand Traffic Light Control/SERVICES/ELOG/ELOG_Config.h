@@ -0,0 +1,29 @@
+/*
+ * File: ELOG_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the event log: the EEPROM area of the ring
+ * and the size of the RAM queue of the bytes waiting to be written.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef ELOG_CONFIG_H
+#define ELOG_CONFIG_H
+
+#include "../PFAIL/PFAIL_Config.h"
+
+// EEPROM ring, after the phase plan slots (SERVICES/PLAN/PLAN_Config.h), before the power-fail record in its build
+#define ELOG_EE_START 0x020U
+#if PFAIL_ENABLE
+#define ELOG_EE_END   PFAIL_EE_START // first byte after the ring
+#else
+#define ELOG_EE_END   0x400U // first byte after the ring
+#endif
+
+// RAM queue, a power of two (holds at least 5 records of the longest size, 6 bytes)
+#define ELOG_QUEUE_SIZE 32
+
+#endif
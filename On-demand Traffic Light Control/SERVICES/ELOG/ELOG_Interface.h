@@ -0,0 +1,65 @@
+/*
+ * File: ELOG_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the event log, a ring of records in EEPROM that survives the resets
+ * and the power cycles. A record is one event byte followed by the time since the previous record:
+ *   - each byte holds the pass bit (bit 7), the event flag (bit 6) and 6 bits of payload
+ *   - event byte: event flag set, payload = event code (0x3F is never used, it is an erased byte)
+ *   - time bytes: event flag cleared, payload = 6 bits of the delay in half seconds, least significant first,
+ *     as many as needed (none if the delay is zero, one up to 31 seconds, two up to 34 minutes)
+ * The ring is written in order and each byte is written once per pass, so the wear is spread over the whole area
+ * and nothing else (no head pointer) is stored. The pass bit is flipped at each pass: at boot the bytes from
+ * the start of the ring to the head have the pass bit of the first byte and the others do not,
+ * so the head is found by a binary search (about 10 reads).
+ * The records are queued in RAM and written by the EEPROM ready interrupt, the callers never wait for the EEPROM.
+ * The functions prototypes defined in this file include:
+ *   - ELOG_Init: function to find the head of the ring and start the writer
+ *   - ELOG_Tick: function to count the half seconds between the records
+ *   - ELOG_Event: function to log an event
+ *   - ELOG_Flush: function to write the queued records at once (when the interrupts are disabled)
+ *   - ELOG_Dropped: function to get the number of records lost because the queue was full
+ *   - ELOG_Rewind, ELOG_Next: functions to read the records from the oldest one
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef ELOG_INTERFACE_H
+#define ELOG_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "ELOG_Config.h"
+
+// Bytes of the ring
+#define ELOG_SIZE (ELOG_EE_END - ELOG_EE_START)
+
+// Logged events (6-bit codes)
+typedef enum elogEvent{
+	ELOG_BOOT = 1,    // power-up or reset, normal operation
+	ELOG_WATCHDOG,    // reset by the watchdog, fail-safe state
+	ELOG_PEDESTRIAN,  // pedestrian sequence started
+	ELOG_PLAN,        // new phase plan active
+	ELOG_LAMP_OUT,    // sensed lamp lit without current
+	ELOG_UPDATE,      // bootloader entered for a firmware update
+	ELOG_RESTORE,     // state saved at a power failure restored at the boot
+	ELOG_EVENT_NUM
+} EN_ElogEvent_t;
+
+// Record read back from the ring
+typedef struct {
+	uint8_t event;     // EN_ElogEvent_t
+	uint32_t delta;    // half seconds since the previous record
+} ST_ElogRecord_t;
+
+// ELOG function prototypes
+void ELOG_Init(void);
+void ELOG_Tick(void);
+void ELOG_Event(EN_ElogEvent_t LOC_Event);
+void ELOG_Flush(void);
+uint8_t ELOG_Dropped(void);
+void ELOG_Rewind(void);
+uint8_t ELOG_Next(ST_ElogRecord_t* LOC_PtrRecord);
+
+#endif
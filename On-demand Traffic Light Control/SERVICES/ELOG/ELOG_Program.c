@@ -0,0 +1,228 @@
+/*
+ * File: ELOG_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the event log declared in ELOG_Interface.h.
+ * ELOG_Event encodes a record in the RAM queue and enables the EEPROM ready interrupt,
+ * the ready callback writes one queued byte at the head of the ring each time the EEPROM is ready (8.5 ms per byte)
+ * and disables the interrupt when the queue is empty. Only the callback moves the head and the queue tail,
+ * only ELOG_Event moves the queue head, so the queue needs no lock.
+ * A record cut by a reset keeps its event byte with a shorter delay.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "ELOG_Interface.h"
+#include "../../MCAL/EEPROM/EEPROM_Interface.h"
+
+// Byte fields
+#define ELOG_PASS_BIT  0x80
+#define ELOG_EVENT_BIT 0x40
+#define ELOG_PAYLOAD   0x3F
+#define ELOG_ERASED    0xFF
+
+// Longest delay, 5 time bytes (17 years)
+#define ELOG_DELTA_MAX 0x3FFFFFFFUL
+
+static volatile uint16_t ELOG_Head;     // next byte of the ring to write
+static uint8_t ELOG_Pass;               // pass bit of the current pass
+static uint32_t ELOG_Ticks;             // half seconds since the last record
+static uint8_t ELOG_Lost;               // records dropped, saturating
+
+// Bytes waiting to be written, without their pass bit
+static uint8_t ELOG_Queue[ELOG_QUEUE_SIZE];
+static volatile uint8_t ELOG_QueueHead; // next byte to queue
+static volatile uint8_t ELOG_QueueTail; // next byte to write
+
+// Reader
+static uint16_t ELOG_ReadPos;
+static uint16_t ELOG_ReadLeft;
+
+/*
+ * Function: ELOG_Pop()
+ * Description: Takes the next queued byte and advances the head of the ring.
+ * Returns: the address and the value (with its pass bit) of the byte to write
+ */
+static uint16_t ELOG_Pop(uint8_t* LOC_PtrValue){
+	uint16_t LOC_U16Address = ELOG_EE_START + ELOG_Head;
+	*LOC_PtrValue = ELOG_Queue[ELOG_QueueTail] | ELOG_Pass;
+	ELOG_QueueTail = (ELOG_QueueTail + 1) & (ELOG_QUEUE_SIZE - 1);
+	if(++ELOG_Head == ELOG_SIZE){
+		ELOG_Head = 0;
+		ELOG_Pass ^= ELOG_PASS_BIT;
+	}
+	return LOC_U16Address;
+}
+
+/*
+ * Function: ELOG_Write()
+ * Description: EEPROM ready callback, writes the next queued byte or stops the interrupt.
+ */
+static void ELOG_Write(void){
+	if(ELOG_QueueTail == ELOG_QueueHead){
+		EEPROM_DisableReadyInt();
+		return;
+	}
+	uint8_t LOC_U8Value;
+	uint16_t LOC_U16Address = ELOG_Pop(&LOC_U8Value);
+	EEPROM_StartWrite(LOC_U16Address, LOC_U8Value);
+}
+
+/*
+ * Function: ELOG_PassOf()
+ * Description: Reads the pass bit of a byte of the ring.
+ */
+static uint8_t ELOG_PassOf(uint16_t LOC_U16Index){
+	return EEPROM_ReadByte(ELOG_EE_START + LOC_U16Index) & ELOG_PASS_BIT;
+}
+
+/*
+ * Function: ELOG_Init()
+ * Description: This function finds the head of the ring and registers the writer on the EEPROM ready interrupt.
+ * The bytes queued before a reset are lost.
+ * Return value: void
+ */
+void ELOG_Init(void){
+	uint8_t LOC_U8First = EEPROM_ReadByte(ELOG_EE_START);
+	ELOG_QueueHead = 0;
+	ELOG_QueueTail = 0;
+	ELOG_Ticks = 0;
+	ELOG_Lost = 0;
+
+	if(ELOG_ERASED == LOC_U8First){
+		// Blank ring, the first pass is written with the pass bit cleared
+		ELOG_Head = 0;
+		ELOG_Pass = 0;
+	}
+	else{
+		// First byte of another pass than the first byte of the ring
+		uint8_t LOC_U8Pass = LOC_U8First & ELOG_PASS_BIT;
+		uint16_t LOC_U16Low = 1, LOC_U16High = ELOG_SIZE;
+		while(LOC_U16Low < LOC_U16High){
+			uint16_t LOC_U16Mid = LOC_U16Low + (LOC_U16High - LOC_U16Low) / 2;
+			if(ELOG_PassOf(LOC_U16Mid) == LOC_U8Pass) LOC_U16Low = LOC_U16Mid + 1;
+			else LOC_U16High = LOC_U16Mid;
+		}
+		if(ELOG_SIZE == LOC_U16Low){
+			// The pass ended at the end of the ring
+			ELOG_Head = 0;
+			ELOG_Pass = LOC_U8Pass ^ ELOG_PASS_BIT;
+		}
+		else{
+			ELOG_Head = LOC_U16Low;
+			ELOG_Pass = LOC_U8Pass;
+		}
+	}
+	EEPROM_SetReadyCallback(ELOG_Write);
+}
+
+/*
+ * Function: ELOG_Tick()
+ * Description: This function counts one half second, it is called by the application every half second.
+ * Return value: void
+ */
+void ELOG_Tick(void){
+	if(ELOG_Ticks < ELOG_DELTA_MAX) ELOG_Ticks++;
+}
+
+/*
+ * Function: ELOG_Event()
+ * Description: This function queues a record of the event and starts the writer. It must be called from the main loop.
+ * If the queue is full the record is dropped and counted, and its delay goes to the next record.
+ * Arguments:
+ *   - LOC_Event: the event
+ * Return value: void
+ */
+void ELOG_Event(EN_ElogEvent_t LOC_Event){
+	uint8_t LOC_U8Bytes[6];
+	uint8_t LOC_U8Len = 0;
+	uint32_t LOC_U32Delta = ELOG_Ticks;
+
+	LOC_U8Bytes[LOC_U8Len++] = ELOG_EVENT_BIT | ((uint8_t)LOC_Event & ELOG_PAYLOAD);
+	while(LOC_U32Delta){
+		LOC_U8Bytes[LOC_U8Len++] = (uint8_t)LOC_U32Delta & ELOG_PAYLOAD;
+		LOC_U32Delta >>= 6;
+	}
+
+	uint8_t LOC_U8Head = ELOG_QueueHead;
+	uint8_t LOC_U8Free = (ELOG_QueueTail - LOC_U8Head - 1) & (ELOG_QUEUE_SIZE - 1);
+	if(LOC_U8Len > LOC_U8Free){
+		if(ELOG_Lost < 0xFF) ELOG_Lost++;
+		return;
+	}
+	for(uint8_t i=0; i<LOC_U8Len; i++){
+		ELOG_Queue[LOC_U8Head] = LOC_U8Bytes[i];
+		LOC_U8Head = (LOC_U8Head + 1) & (ELOG_QUEUE_SIZE - 1);
+	}
+	ELOG_QueueHead = LOC_U8Head; // publish the complete record
+	ELOG_Ticks = 0;
+	EEPROM_EnableReadyInt();
+}
+
+/*
+ * Function: ELOG_Flush()
+ * Description: This function writes the queued bytes at once, waiting for the EEPROM.
+ * It is used where the ready interrupt cannot run, like the fail-safe state entered with the interrupts disabled.
+ * Return value: void
+ */
+void ELOG_Flush(void){
+	EEPROM_DisableReadyInt();
+	while(ELOG_QueueTail != ELOG_QueueHead){
+		uint8_t LOC_U8Value;
+		uint16_t LOC_U16Address = ELOG_Pop(&LOC_U8Value);
+		EEPROM_WriteByte(LOC_U16Address, LOC_U8Value);
+	}
+}
+
+/*
+ * Function: ELOG_Dropped()
+ * Description: This function gets the number of records dropped since the boot because the queue was full.
+ * Return value: the number of records, 255 means 255 or more
+ */
+uint8_t ELOG_Dropped(void){
+	return ELOG_Lost;
+}
+
+/*
+ * Function: ELOG_Rewind()
+ * Description: This function starts reading the records from the oldest one.
+ * Return value: void
+ */
+void ELOG_Rewind(void){
+	do{
+		ELOG_ReadPos = ELOG_Head; // read again if the writer moved it meanwhile
+	} while(ELOG_ReadPos != ELOG_Head);
+	ELOG_ReadLeft = ELOG_SIZE;
+}
+
+/*
+ * Function: ELOG_Next()
+ * Description: This function reads the next record. The time bytes of a record overwritten by the head
+ * and the erased bytes are skipped.
+ * Arguments:
+ *   - LOC_PtrRecord: where to store the record
+ * Return value: 1 if a record was read, 0 at the end of the log
+ */
+uint8_t ELOG_Next(ST_ElogRecord_t* LOC_PtrRecord){
+	uint8_t LOC_U8Found = 0;
+	uint8_t LOC_U8Shift = 0;
+	while(ELOG_ReadLeft){
+		uint8_t LOC_U8Byte = EEPROM_ReadByte(ELOG_EE_START + ELOG_ReadPos);
+		uint8_t LOC_U8IsEvent = (LOC_U8Byte & ELOG_EVENT_BIT) && ELOG_ERASED != LOC_U8Byte;
+		if(LOC_U8Found && (LOC_U8IsEvent || ELOG_ERASED == LOC_U8Byte)) break; // next record
+		if(++ELOG_ReadPos == ELOG_SIZE) ELOG_ReadPos = 0;
+		ELOG_ReadLeft--;
+		if(LOC_U8IsEvent){
+			LOC_U8Found = 1;
+			LOC_PtrRecord->event = LOC_U8Byte & ELOG_PAYLOAD;
+			LOC_PtrRecord->delta = 0;
+		}
+		else if(LOC_U8Found && LOC_U8Shift < 30){
+			LOC_PtrRecord->delta |= (uint32_t)(LOC_U8Byte & ELOG_PAYLOAD) << LOC_U8Shift;
+			LOC_U8Shift += 6;
+		}
+	}
+	return LOC_U8Found;
+}
@@ -0,0 +1,26 @@
+/*
+ * File: LAT_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the interrupt latency instrumentation.
+ * The instrumentation is only built when LAT_ENABLE is 1 (set it here or pass -DLAT_ENABLE=1 to the compiler).
+ * The timestamps are Timer1 counts (TICK_Stamp): 8 us per count with the Timer1 configuration (1 MHz, prescaler 8).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef LAT_CONFIG_H
+#define LAT_CONFIG_H
+
+#ifndef LAT_ENABLE
+#define LAT_ENABLE 0
+#endif
+
+#define LAT_US_PER_TICK    8U      // microseconds per Timer1 count
+#define LAT_ISR_BUCKETS    16      // edge to ISR: one bucket per count, the last one holds the longer latencies
+#define LAT_ASPECT_BUCKETS 64      // edge to aspect: log2 buckets with 4 sub-buckets, up to 2^17 counts
+#define LAT_ASPECT_LIMIT   250000UL // longer edge to aspect intervals (2 seconds) are dropped as invalid
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * File: LAT_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the interrupt latency instrumentation (latency build only).
+ * The button is also wired to the Timer1 input capture pin (ICP1, PD6), so the capture unit timestamps
+ * the physical edge in hardware. The EXTI0 ISR timestamps its entry and the application timestamps
+ * the first lamp change caused by the press, with the same counter. Two latencies are collected:
+ *   - edge to ISR: interrupt latency (interrupts disabled by other code, ISR prologue)
+ *   - edge to aspect: from the press to the first lamp change of the pedestrian sequence
+ * The histograms (LAT_Data) are read from the running target by the debugger,
+ * LAT_Report gets the p50, p99 and max of each one in microseconds.
+ * The functions prototypes defined in this file include:
+ *   - LAT_Init: function to clear the histograms and start the capture (empty when not built)
+ *   - LAT_IsrEntry: function called first in the EXTI0 ISR, timestamps the ISR entry (empty when not built)
+ *   - LAT_Arm: function called when a press is accepted, the next aspect change is measured (empty when not built)
+ *   - LAT_Aspect: function called after a lamp change, timestamps it if a press is pending (empty when not built)
+ *   - LAT_Report: function to get the percentiles of both histograms
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef LAT_INTERFACE_H
+#define LAT_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "LAT_Config.h"
+
+#if LAT_ENABLE
+
+typedef struct {
+	uint16_t isrHist[LAT_ISR_BUCKETS];       // edge to ISR, in Timer1 counts
+	uint16_t aspectHist[LAT_ASPECT_BUCKETS]; // edge to aspect, log2 buckets of Timer1 counts
+	uint32_t isrMax;                         // longest edge to ISR, in Timer1 counts
+	uint32_t aspectMax;                      // longest edge to aspect, in Timer1 counts
+	uint16_t count;                          // ISR entries with a captured edge
+	uint16_t noCapture;                      // ISR entries without a captured edge (ICP1 not wired)
+} ST_Lat_t;
+
+typedef struct {
+	uint32_t p50, p99, max; // microseconds, p50 and p99 are bucket upper bounds
+	uint32_t samples;
+} ST_LatStat_t;
+
+extern volatile ST_Lat_t LAT_Data;
+
+// LAT function prototypes
+void LAT_Init(void);
+void LAT_IsrEntry(void);
+void LAT_Arm(void);
+void LAT_Aspect(void);
+void LAT_Report(ST_LatStat_t* isr, ST_LatStat_t* aspect);
+
+#else
+
+#define LAT_Init()     ((void)0)
+#define LAT_IsrEntry() ((void)0)
+#define LAT_Arm()      ((void)0)
+#define LAT_Aspect()   ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * File: LAT_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the interrupt latency instrumentation declared in LAT_Interface.h.
+ * Timer1 is shared with the hardware flasher and the timebase (CTC mode, 0.5 second period), so the timestamps
+ * come from the timebase (TICK_Stamp): the counts of the periods ended, counted by the compare A interrupt,
+ * plus the counter value. The captured edge is older than the ISR entry, TICK_Stamp takes
+ * a capture value above the counter in the previous period.
+ * The timestamps wrap every 2^32 counts (about 9.5 hours), the differences are taken in the same modulo.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "LAT_Interface.h"
+
+#if LAT_ENABLE
+
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+#include "../../MCAL/TMR1/TMR1_Interface.h"
+#include "../../MCAL/EXTI/EXTI_Interface.h"
+#include "../TICK/TICK_Interface.h"
+#include "../../utils/IO_ACCESS.h"
+
+volatile ST_Lat_t LAT_Data;
+
+static volatile uint32_t LAT_Edge;   // timestamp of the last captured edge
+static volatile uint8_t LAT_EdgeValid;
+static volatile uint8_t LAT_Armed;   // an accepted press waits for its aspect change
+static volatile uint32_t LAT_ArmedEdge;
+
+/************************************************************************/
+/*                       Helper Functions                               */
+/************************************************************************/
+
+/*
+ * Function: LAT_Count()
+ * Description: Increments a histogram bucket, halving the whole histogram when the bucket is full.
+ */
+static void LAT_Count(volatile uint16_t* LOC_PtrHist, uint8_t LOC_U8Buckets, uint8_t LOC_U8Bucket){
+	if(0xFFFF == LOC_PtrHist[LOC_U8Bucket]){
+		for(uint8_t i=0; i<LOC_U8Buckets; i++) LOC_PtrHist[i] >>= 1;
+	}
+	LOC_PtrHist[LOC_U8Bucket]++;
+}
+
+/*
+ * Function: LAT_AspectBucket()
+ * Description: Gets the log2 bucket of a latency: values below 8 have their own bucket,
+ * then each power of two is split in 4 sub-buckets (2 mantissa bits).
+ */
+static uint8_t LAT_AspectBucket(uint32_t LOC_U32Value){
+	if(LOC_U32Value < 8) return (uint8_t)LOC_U32Value;
+	uint8_t LOC_U8Exp = 3;
+	while((LOC_U32Value >> (LOC_U8Exp + 1)) != 0) LOC_U8Exp++;
+	uint16_t LOC_U16Bucket = 4 * (LOC_U8Exp - 1) + ((LOC_U32Value >> (LOC_U8Exp - 2)) & 3);
+	return (LOC_U16Bucket < LAT_ASPECT_BUCKETS) ? (uint8_t)LOC_U16Bucket : LAT_ASPECT_BUCKETS - 1;
+}
+
+/*
+ * Function: LAT_AspectUpper()
+ * Description: Gets the largest latency counted in a log2 bucket.
+ */
+static uint32_t LAT_AspectUpper(uint8_t LOC_U8Bucket){
+	if(LOC_U8Bucket < 8) return LOC_U8Bucket;
+	uint8_t LOC_U8Exp = LOC_U8Bucket / 4 + 1;
+	return ((uint32_t)(5 + LOC_U8Bucket % 4) << (LOC_U8Exp - 2)) - 1;
+}
+
+/*
+ * Function: LAT_Percentiles()
+ * Description: Gets the p50 and p99 bucket upper bounds of a histogram, the last bucket reports the maximum.
+ */
+static void LAT_Percentiles(volatile uint16_t* LOC_PtrHist, uint8_t LOC_U8Buckets, uint32_t (*LOC_PtrUpper)(uint8_t),
+                            uint32_t LOC_U32Max, ST_LatStat_t* LOC_PtrStat){
+	uint32_t LOC_U32Total = 0, LOC_U32Sum = 0;
+	for(uint8_t i=0; i<LOC_U8Buckets; i++) LOC_U32Total += LOC_PtrHist[i];
+	LOC_PtrStat->samples = LOC_U32Total;
+	LOC_PtrStat->p50 = LOC_PtrStat->p99 = 0;
+	LOC_PtrStat->max = LOC_U32Max * LAT_US_PER_TICK;
+	if(!LOC_U32Total) return;
+	uint32_t LOC_U32Rank50 = (LOC_U32Total + 1) / 2;
+	uint32_t LOC_U32Rank99 = LOC_U32Total - LOC_U32Total / 100; // at least 99% of the samples
+	for(uint8_t i=0; i<LOC_U8Buckets; i++){
+		uint32_t LOC_U32Before = LOC_U32Sum;
+		LOC_U32Sum += LOC_PtrHist[i];
+		uint32_t LOC_U32Upper = (i == LOC_U8Buckets - 1) ? LOC_U32Max : LOC_PtrUpper(i);
+		if(LOC_U32Upper > LOC_U32Max) LOC_U32Upper = LOC_U32Max;
+		if(LOC_U32Before < LOC_U32Rank50 && LOC_U32Sum >= LOC_U32Rank50) LOC_PtrStat->p50 = LOC_U32Upper * LAT_US_PER_TICK;
+		if(LOC_U32Before < LOC_U32Rank99 && LOC_U32Sum >= LOC_U32Rank99) LOC_PtrStat->p99 = LOC_U32Upper * LAT_US_PER_TICK;
+	}
+}
+
+static uint32_t LAT_IsrUpper(uint8_t LOC_U8Bucket){
+	return LOC_U8Bucket;
+}
+
+/************************************************************************/
+/*                       LAT Functions                                  */
+/************************************************************************/
+
+/*
+ * Function: LAT_Init()
+ * Description: This function clears the histograms, selects the rising edge of ICP1 (PD6, wired to the button)
+ * for the timestamps of the timebase. The timebase must be started (TICK_Init).
+ * Returns: void
+ */
+void LAT_Init(void){
+	for(uint8_t i=0; i<LAT_ISR_BUCKETS; i++) LAT_Data.isrHist[i] = 0;
+	for(uint8_t i=0; i<LAT_ASPECT_BUCKETS; i++) LAT_Data.aspectHist[i] = 0;
+	LAT_Data.isrMax = 0;
+	LAT_Data.aspectMax = 0;
+	LAT_Data.count = 0;
+	LAT_Data.noCapture = 0;
+	LAT_EdgeValid = 0;
+	LAT_Armed = 0;
+	GPIO_SetPinDir(PORTD, PIN6, INPUT);
+	TMR1_SetCaptureEdge(HIGH);
+}
+
+/*
+ * Function: LAT_IsrEntry()
+ * Description: This function timestamps the ISR entry and counts the latency from the captured edge.
+ * It must be the first statement of the EXTI0 ISR.
+ * Returns: void
+ */
+void LAT_IsrEntry(void){
+	uint16_t LOC_U16Capture;
+	uint32_t LOC_U32Entry = TICK_Stamp(TMR1_GetCount());
+	if(!TMR1_GetCapture(&LOC_U16Capture)){
+		LAT_EdgeValid = 0;
+		if(0xFFFF != LAT_Data.noCapture) LAT_Data.noCapture++;
+		return;
+	}
+	LAT_Edge = TICK_Stamp(LOC_U16Capture);
+	LAT_EdgeValid = 1;
+	uint32_t LOC_U32Latency = LOC_U32Entry - LAT_Edge;
+	if(LOC_U32Latency > LAT_Data.isrMax) LAT_Data.isrMax = LOC_U32Latency;
+	LAT_Count(LAT_Data.isrHist, LAT_ISR_BUCKETS, (LOC_U32Latency < LAT_ISR_BUCKETS) ? (uint8_t)LOC_U32Latency : LAT_ISR_BUCKETS - 1);
+	if(0xFFFF != LAT_Data.count) LAT_Data.count++;
+}
+
+/*
+ * Function: LAT_Arm()
+ * Description: This function marks the press being served as accepted, the next LAT_Aspect call measures its latency.
+ * It is called from the EXTI0 ISR after LAT_IsrEntry.
+ * Returns: void
+ */
+void LAT_Arm(void){
+	if(!LAT_EdgeValid || LAT_Armed) return; // keep the first press of a pending request
+	LAT_ArmedEdge = LAT_Edge;
+	LAT_Armed = 1;
+}
+
+/*
+ * Function: LAT_Aspect()
+ * Description: This function timestamps a lamp change and counts the latency from the armed press, if any.
+ * Intervals longer than LAT_ASPECT_LIMIT are dropped as invalid.
+ * Returns: void
+ */
+void LAT_Aspect(void){
+	if(!LAT_Armed) return;
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	uint32_t LOC_U32Latency = TICK_Stamp(TMR1_GetCount()) - LAT_ArmedEdge;
+	LAT_Armed = 0;
+	if(LOC_U32Latency <= LAT_ASPECT_LIMIT){
+		if(LOC_U32Latency > LAT_Data.aspectMax) LAT_Data.aspectMax = LOC_U32Latency;
+		LAT_Count(LAT_Data.aspectHist, LAT_ASPECT_BUCKETS, LAT_AspectBucket(LOC_U32Latency));
+	}
+	if(LOC_U8Interrupts) CPU_SEI();
+}
+
+/*
+ * Function: LAT_Report()
+ * Description: This function gets the number of samples, the p50, the p99 and the maximum of both latencies in microseconds.
+ * The percentiles are the upper bounds of their buckets (8 us resolution for edge to ISR, 25% for edge to aspect).
+ * Arguments:
+ *   - isr: where to store the edge to ISR statistics
+ *   - aspect: where to store the edge to aspect statistics
+ * Returns: void
+ */
+void LAT_Report(ST_LatStat_t* isr, ST_LatStat_t* aspect){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	LAT_Percentiles(LAT_Data.isrHist, LAT_ISR_BUCKETS, LAT_IsrUpper, LAT_Data.isrMax, isr);
+	LAT_Percentiles(LAT_Data.aspectHist, LAT_ASPECT_BUCKETS, LAT_AspectUpper, LAT_Data.aspectMax, aspect);
+	if(LOC_U8Interrupts) CPU_SEI();
+}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * File: PFAIL_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the power-fail save.
+ * The save is only built when PFAIL_ENABLE is 1 (set it here or pass -DPFAIL_ENABLE=1 to the compiler).
+ * The record takes the last PFAIL_EE_SIZE bytes of the EEPROM, the event log ring ends before it in this build
+ * (SERVICES/ELOG/ELOG_Config.h). The supply divider on AIN1 sets the droop threshold: with 1.23 V for the bandgap,
+ * 10 k over 3.9 k trips at 4.4 V, well above the 2.7 V brown-out level under which the EEPROM can not be written.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef PFAIL_CONFIG_H
+#define PFAIL_CONFIG_H
+
+#ifndef PFAIL_ENABLE
+#define PFAIL_ENABLE 0
+#endif
+
+#define PFAIL_EE_START  0x3E0U // record, up to the end of the EEPROM
+#define PFAIL_EE_SIZE   0x020U
+#define PFAIL_HEADER    5      // bytes of the record before the state
+#define PFAIL_STATE_MAX 16     // bytes of state saved (PFAIL_EE_SIZE less the header at most)
+#define PFAIL_VALID     0xA5   // flag byte of a record (or of its time) saved and not restored yet
+
+#endif
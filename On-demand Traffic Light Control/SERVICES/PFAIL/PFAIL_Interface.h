@@ -0,0 +1,55 @@
+/*
+ * File: PFAIL_Interface.h
+ *
+ * Description:
+ * This header file contains the function prototypes for the power-fail save (power-fail build only).
+ * The analog comparator sees the supply droop before the hold-up capacitor runs down (MCAL/ACOMP), and its interrupt
+ * writes the few bytes of the controller state and the queued event log records (ELOG) to the EEPROM at once,
+ * so the controller resumes at power-up where it was instead of starting over.
+ * The application hands over its state once per half second, the interrupt saves the last copy:
+ * the controller resumes at the half second of its last copy, at most one half second is shown again.
+ * Record (PFAIL_EE_START): valid flag, state length, save time (2 bytes, little endian), time flag, state bytes.
+ * The state bytes are written first and the valid flag after them, so a record cut by the end of the hold-up
+ * is not taken, the unchanged bytes are skipped. The save time, from the interrupt to the record and the log written,
+ * is measured on Timer1 and written last with its own flag: it is the hold-up the capacitor must give,
+ * plus the three bytes of the time (25.5 ms), and a record whose time was cut is restored without it.
+ * A record is restored once: it is invalidated at the boot that restores it, and when the supply comes back
+ * without a reset (a droop that did not reach the brown-out level), and the save is armed again then.
+ * The functions provided include:
+ *  - Restoring the state saved and arming the save
+ *  - Handing over the state, once per half second
+ *  - Stopping the save (fail-safe state)
+ *  - Getting the time of the last save
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef PFAIL_INTERFACE_H
+#define PFAIL_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "PFAIL_Config.h"
+
+#if PFAIL_ENABLE
+
+#if PFAIL_STATE_MAX + PFAIL_HEADER > PFAIL_EE_SIZE
+#error "the record (PFAIL_STATE_MAX + PFAIL_HEADER bytes) does not fit in PFAIL_EE_SIZE"
+#endif
+
+uint8_t PFAIL_Init(uint8_t* LOC_PtrState, uint8_t LOC_U8Len);
+void PFAIL_Update(const uint8_t* LOC_PtrState);
+void PFAIL_Stop(void);
+uint16_t PFAIL_SaveTime(void);
+
+#else
+
+#define PFAIL_Init(state, len) 0
+#define PFAIL_Update(state)
+#define PFAIL_Stop()
+#define PFAIL_SaveTime() 0
+
+#endif
+
+#endif
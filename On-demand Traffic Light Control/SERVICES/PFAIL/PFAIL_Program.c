@@ -0,0 +1,169 @@
+/*
+ * File: PFAIL_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the power-fail save declared in PFAIL_Interface.h.
+ * The save runs in the comparator interrupt with the interrupts disabled, waiting for the EEPROM:
+ * the supply is going away, nothing else needs to run. It waits for a write in progress first (log writer),
+ * and for its own last write at the end, since the interrupted code may be about to load the EEPROM registers.
+ * The time is accumulated in Timer1 counts after each write (8.5 ms at most, less than a period of the counter),
+ * so the period of the counter (CTC) is added back when the counter went back.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "PFAIL_Interface.h"
+
+#if PFAIL_ENABLE
+
+#include "../../MCAL/ACOMP/ACOMP_Interface.h"
+#include "../../MCAL/EEPROM/EEPROM_Interface.h"
+#include "../../MCAL/TMR1/TMR1_Interface.h"
+#include "../ELOG/ELOG_Interface.h"
+
+// Record fields
+#define PFAIL_EE_VALID  (PFAIL_EE_START)
+#define PFAIL_EE_LEN    (PFAIL_EE_START + 1)
+#define PFAIL_EE_TIME   (PFAIL_EE_START + 2)
+#define PFAIL_EE_TIMED  (PFAIL_EE_START + 4)
+#define PFAIL_EE_STATE  (PFAIL_EE_START + PFAIL_HEADER)
+#define PFAIL_ERASED    0xFF
+
+static uint8_t PFAIL_State[PFAIL_STATE_MAX]; // last state handed over
+static uint8_t PFAIL_Len;
+static volatile uint8_t PFAIL_Armed;         // the comparator interrupt is enabled
+static volatile uint8_t PFAIL_Saved;         // a record was saved since the boot and is still valid
+static volatile uint16_t PFAIL_Time;         // time of the last save, Timer1 counts
+static uint16_t PFAIL_Mark;                  // Timer1 count at the previous lap
+static uint32_t PFAIL_Counts;                // counts since the start of the save
+
+/*
+ * Function: PFAIL_Invalidate()
+ * Description: Invalidates the record and its time, from the main loop (the second write waits for the first one).
+ */
+static void PFAIL_Invalidate(void){
+	EEPROM_WriteByte(PFAIL_EE_VALID, PFAIL_ERASED);
+	EEPROM_WriteByte(PFAIL_EE_TIMED, PFAIL_ERASED);
+}
+
+/*
+ * Function: PFAIL_Lap()
+ * Description: Adds the Timer1 counts since the previous lap to the save time, less than one period.
+ */
+static void PFAIL_Lap(void){
+	uint16_t LOC_U16Now = TMR1_GetCount();
+	uint32_t LOC_U32Now = LOC_U16Now;
+	if(LOC_U16Now < PFAIL_Mark) LOC_U32Now += (uint32_t)TMR1_GetTop() + 1U;
+	PFAIL_Counts += LOC_U32Now - PFAIL_Mark;
+	PFAIL_Mark = LOC_U16Now;
+}
+
+/*
+ * Function: PFAIL_Save()
+ * Description: The comparator callback, the supply is under the threshold: writes the record and the queued log
+ * records, measures the time taken and writes it. The interrupt stays disabled until the supply is back.
+ */
+static void PFAIL_Save(void){
+	ACOMP_DisableInt();
+	PFAIL_Armed = 0;
+	PFAIL_Mark = TMR1_GetCount();
+	PFAIL_Counts = 0;
+	for(uint8_t i=0; i<PFAIL_Len; i++){
+		EEPROM_WriteByte(PFAIL_EE_STATE + i, PFAIL_State[i]);
+		PFAIL_Lap();
+	}
+	EEPROM_WriteByte(PFAIL_EE_LEN, PFAIL_Len);
+	PFAIL_Lap();
+	EEPROM_WriteByte(PFAIL_EE_VALID, PFAIL_VALID); // the record is complete
+	PFAIL_Lap();
+	ELOG_Flush();
+	PFAIL_Lap();
+	(void)EEPROM_ReadByte(PFAIL_EE_VALID); // waits for the last write
+	PFAIL_Lap();
+	
+	uint16_t LOC_U16Time = (PFAIL_Counts > 0xFFFF) ? 0xFFFF : (uint16_t)PFAIL_Counts;
+	PFAIL_Time = LOC_U16Time;
+	EEPROM_WriteByte(PFAIL_EE_TIME, (uint8_t)LOC_U16Time);
+	EEPROM_WriteByte(PFAIL_EE_TIME + 1, (uint8_t)(LOC_U16Time >> 8));
+	EEPROM_WriteByte(PFAIL_EE_TIMED, PFAIL_VALID);
+	(void)EEPROM_ReadByte(PFAIL_EE_TIMED);
+	PFAIL_Saved = 1;
+}
+
+/*
+ * Function: PFAIL_Init()
+ * Description: This function restores the state of a valid record of the same length and invalidates the record,
+ * then turns the comparator on. The save is armed by PFAIL_Update, at the first half second with the supply
+ * above the threshold (the bandgap has settled then). It must be called after ELOG_Init.
+ * Arguments:
+ *   - LOC_PtrState: the state, overwritten by the state saved if there is one, it is the state saved until PFAIL_Update
+ *   - LOC_U8Len: the length of the state (1 to PFAIL_STATE_MAX)
+ * Return value: 1 if the state was restored, 0 otherwise
+ */
+uint8_t PFAIL_Init(uint8_t* LOC_PtrState, uint8_t LOC_U8Len){
+	uint8_t LOC_U8Restored = 0;
+	if(LOC_U8Len > PFAIL_STATE_MAX) LOC_U8Len = PFAIL_STATE_MAX;
+	PFAIL_Len = LOC_U8Len;
+	PFAIL_Armed = 0;
+	PFAIL_Saved = 0;
+	PFAIL_Time = 0;
+	if(PFAIL_VALID == EEPROM_ReadByte(PFAIL_EE_VALID) && LOC_U8Len == EEPROM_ReadByte(PFAIL_EE_LEN)){
+		EEPROM_Read(PFAIL_EE_STATE, LOC_PtrState, LOC_U8Len);
+		if(PFAIL_VALID == EEPROM_ReadByte(PFAIL_EE_TIMED)){
+			PFAIL_Time = EEPROM_ReadByte(PFAIL_EE_TIME) | ((uint16_t)EEPROM_ReadByte(PFAIL_EE_TIME + 1) << 8);
+		}
+		PFAIL_Invalidate(); // restored once
+		LOC_U8Restored = 1;
+	}
+	for(uint8_t i=0; i<LOC_U8Len; i++) PFAIL_State[i] = LOC_PtrState[i];
+	ACOMP_Init();
+	ACOMP_SetCallback(PFAIL_Save);
+	return LOC_U8Restored;
+}
+
+/*
+ * Function: PFAIL_Update()
+ * Description: This function hands over the state, it is called from the main loop once per half second.
+ * The copy is made with the interrupts disabled, so the save never gets half of it. After a save, when the supply
+ * is back above the threshold without a reset, the record is invalidated and the save armed again.
+ * Arguments:
+ *   - LOC_PtrState: the state, of the length given to PFAIL_Init
+ * Return value: void
+ */
+void PFAIL_Update(const uint8_t* LOC_PtrState){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	for(uint8_t i=0; i<PFAIL_Len; i++) PFAIL_State[i] = LOC_PtrState[i];
+	if(LOC_U8Interrupts) CPU_SEI();
+	if(PFAIL_Armed || ACOMP_Output()) return;
+	if(PFAIL_Saved){
+		PFAIL_Invalidate();
+		PFAIL_Saved = 0;
+	}
+	PFAIL_Armed = 1;
+	ACOMP_EnableInt();
+}
+
+/*
+ * Function: PFAIL_Stop()
+ * Description: This function disarms the save, for the fail-safe state. A record saved meanwhile stays valid.
+ * Return value: void
+ */
+void PFAIL_Stop(void){
+	ACOMP_DisableInt();
+	PFAIL_Armed = 0;
+}
+
+/*
+ * Function: PFAIL_SaveTime()
+ * Description: This function gets the time of the last save: the one of this boot, or the one restored.
+ * Return value: the time in Timer1 counts (8 us per count), 0 if there was none or its time was not written,
+ * 0xFFFF for 0.52 s or more
+ */
+uint16_t PFAIL_SaveTime(void){
+	return PFAIL_Time;
+}
+
+#endif
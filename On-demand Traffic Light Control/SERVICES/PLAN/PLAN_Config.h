@@ -0,0 +1,31 @@
+/*
+ * File: PLAN_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the phase plans: the compiled-in default plan,
+ * the limits of a phase duration and the EEPROM addresses of the two plan slots.
+ * The durations are in half seconds (one scheduler round, SCHED).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef PLAN_CONFIG_H
+#define PLAN_CONFIG_H
+
+// Default plan: 5 seconds per phase
+#define PLAN_DEFAULT_HALF_SECS 10U
+
+// Phase duration limits in half seconds
+#define PLAN_MIN_HALF_SECS 2U
+#define PLAN_MAX_HALF_SECS 240U
+
+// EEPROM slots, one holds the active plan and the other receives the next one
+#define PLAN_EE_SLOT0 0x000U
+#define PLAN_EE_SLOT1 0x010U
+
+// Longest serial command line
+#define PLAN_LINE_MAX 40
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * File: PLAN_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the phase plans, the durations of the phases of the normal cycle
+ * and of the pedestrian sequence. The plans are stored in EEPROM and can be replaced in the field over the serial port
+ * (9600 baud, 8N1) without reflashing the controller:
+ *   - at boot the newest valid plan of the two EEPROM slots is loaded once in RAM: the revisions are read first and
+ *     only the newest plan is checked (layout and CRC-16), the other one only if it fails, and the compiled-in
+ *     default plan is used if none is valid
+ *   - a new plan received over the serial port is checked, written to the slot that does not hold the active plan,
+ *     and kept in a shadow buffer; PLAN_Swap makes it active at the next cycle boundary by switching buffers
+ * Serial commands (one line, ended by CR or LF):
+ *   - "P g y r c w f x": new plan, the 7 durations in half seconds (PLAN_GREEN ... PLAN_PED_CLEAR order),
+ *     answered "OK <revision>" or "ERR"
+ *   - "?": answered "PLAN <revision> g y r c w f x" with the active plan
+ *   - "U": firmware update, answered "OK" and the bootloader is entered at the next half second (BOOT_ENABLE build,
+ *     "ERR" otherwise)
+ * The functions prototypes defined in this file include:
+ *   - PLAN_Init: function to load the active plan from EEPROM
+ *   - PLAN_Get: function to get the active plan
+ *   - PLAN_Swap: function to activate the received plan, called at a cycle boundary
+ *   - PLAN_Receive: function to collect the received bytes of a command, called from the UART receive interrupt
+ *   - PLAN_Poll: function to handle a received command, called from the main loop
+ *   - PLAN_BootRequested: function to tell whether the "U" command was received
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef PLAN_INTERFACE_H
+#define PLAN_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "PLAN_Config.h"
+
+// Layout of ST_Plan_t, a stored plan with another layout is not used
+#define PLAN_LAYOUT 1U
+
+// Phases, in the order of APP_Start
+typedef enum planPhase{
+	PLAN_GREEN,      // car green, pedestrian red
+	PLAN_YELLOW,     // yellows flash before the red
+	PLAN_RED,        // car red, pedestrian green
+	PLAN_YELLOW_2,   // yellows flash before the green
+	PLAN_PED_YELLOW, // pedestrian request: yellows flash
+	PLAN_PED_WALK,   // pedestrian request: car red, pedestrian green
+	PLAN_PED_CLEAR,  // pedestrian request: yellows flash, pedestrian green on
+	PLAN_PHASE_NUM
+} EN_PlanPhase_t;
+
+// Stored plan (no padding on the target or on the host), the CRC covers the bytes before it
+typedef struct {
+	uint16_t revision;                 // incremented by each update, the newest slot wins
+	uint8_t layout;                    // PLAN_LAYOUT
+	uint8_t halfSecs[PLAN_PHASE_NUM];  // phase durations in half seconds
+	uint16_t crc;
+} ST_Plan_t;
+
+// PLAN function prototypes
+void PLAN_Init(void);
+const ST_Plan_t* PLAN_Get(void);
+uint8_t PLAN_Swap(void);
+void PLAN_Receive(uint8_t LOC_U8Byte);
+void PLAN_Poll(void);
+uint8_t PLAN_BootRequested(void);
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * File: PLAN_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the phase plans declared in PLAN_Interface.h.
+ * Two RAM buffers hold the active plan and the shadow plan, PLAN_Swap switches them by changing one index,
+ * so the application never sees a half-written plan.
+ * Each of the two EEPROM slots holds a complete plan with its revision and CRC: an update is written to the slot
+ * of the older plan, and a reset during the write leaves the other slot intact (its CRC still matches).
+ * The serial receive interrupt only collects a line (PLAN_Receive), the command is parsed and the EEPROM written by PLAN_Poll
+ * from the main loop (the 12 bytes take about 100 ms to write, well within the watchdog timeout).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "PLAN_Interface.h"
+#include "../CRC/CRC_Interface.h"
+#include "../../MCAL/EEPROM/EEPROM_Interface.h"
+#include "../../MCAL/UART/UART_Interface.h"
+#include "../../BOOT/BOOT_Config.h"
+
+// Bytes covered by the CRC
+#define PLAN_CRC_LEN (sizeof(ST_Plan_t) - sizeof(uint16_t))
+
+static const uint16_t PLAN_Slots[2] = {PLAN_EE_SLOT0, PLAN_EE_SLOT1};
+
+static ST_Plan_t PLAN_Buffers[2];     // active and shadow plans
+static uint8_t PLAN_Active;           // index of the active buffer
+static uint8_t PLAN_Pending;          // the shadow buffer holds a plan to activate
+static uint8_t PLAN_Slot;             // EEPROM slot of the newest stored plan
+static uint8_t PLAN_Boot;             // "U" received
+
+// Serial line, filled by the receive interrupt and emptied by PLAN_Poll
+static volatile char PLAN_Line[PLAN_LINE_MAX];
+static volatile uint8_t PLAN_LineLen;
+static volatile uint8_t PLAN_LineReady;
+
+/*
+ * Function: PLAN_Valid()
+ * Description: Checks the layout, the durations and the CRC of a plan.
+ * Returns: 1 if the plan can be used, 0 otherwise
+ */
+static uint8_t PLAN_Valid(const ST_Plan_t* LOC_PtrPlan){
+	if(PLAN_LAYOUT != LOC_PtrPlan->layout) return 0;
+	for(uint8_t i=0; i<PLAN_PHASE_NUM; i++){
+		if(LOC_PtrPlan->halfSecs[i] < PLAN_MIN_HALF_SECS || LOC_PtrPlan->halfSecs[i] > PLAN_MAX_HALF_SECS) return 0;
+	}
+	return CRC_16((const uint8_t*)LOC_PtrPlan, PLAN_CRC_LEN) == LOC_PtrPlan->crc;
+}
+
+/*
+ * Function: PLAN_SendNumber()
+ * Description: Sends a number in decimal, preceded by a space.
+ */
+static void PLAN_SendNumber(uint16_t LOC_U16Value){
+	char LOC_Digits[7];
+	uint8_t i = sizeof(LOC_Digits) - 1;
+	LOC_Digits[i] = 0;
+	do{
+		LOC_Digits[--i] = (char)('0' + LOC_U16Value % 10);
+		LOC_U16Value /= 10;
+	} while(LOC_U16Value);
+	LOC_Digits[--i] = ' ';
+	UART_SendString(&LOC_Digits[i]);
+}
+
+/*
+ * Function: PLAN_Update()
+ * Description: Parses the 7 durations of a "P" command into the shadow buffer, stores the plan
+ * in the EEPROM slot of the older plan and reads it back.
+ * Returns: 1 if the plan is stored and pending, 0 if the command or the write failed
+ */
+static uint8_t PLAN_Update(const char* LOC_PtrArgs){
+	ST_Plan_t* LOC_PtrShadow = &PLAN_Buffers[PLAN_Active ^ 1];
+	const ST_Plan_t* LOC_PtrNewest = PLAN_Pending ? LOC_PtrShadow : &PLAN_Buffers[PLAN_Active];
+	ST_Plan_t LOC_Plan;
+
+	LOC_Plan.revision = LOC_PtrNewest->revision + 1;
+	LOC_Plan.layout = PLAN_LAYOUT;
+	for(uint8_t i=0; i<PLAN_PHASE_NUM; i++){
+		uint16_t LOC_U16Value = 0;
+		uint8_t LOC_U8Digits = 0;
+		while(' ' == *LOC_PtrArgs) LOC_PtrArgs++;
+		while(*LOC_PtrArgs >= '0' && *LOC_PtrArgs <= '9' && LOC_U8Digits < 4){
+			LOC_U16Value = 10 * LOC_U16Value + (*LOC_PtrArgs++ - '0');
+			LOC_U8Digits++;
+		}
+		if(!LOC_U8Digits || LOC_U16Value > PLAN_MAX_HALF_SECS) return 0;
+		LOC_Plan.halfSecs[i] = (uint8_t)LOC_U16Value;
+	}
+	while(' ' == *LOC_PtrArgs) LOC_PtrArgs++;
+	if(*LOC_PtrArgs) return 0;
+	LOC_Plan.crc = CRC_16((const uint8_t*)&LOC_Plan, PLAN_CRC_LEN);
+	if(!PLAN_Valid(&LOC_Plan)) return 0;
+
+	// The newest stored plan is kept, the other slot is overwritten
+	uint8_t LOC_U8Slot = PLAN_Slot ^ 1;
+	ST_Plan_t LOC_ReadBack;
+	EEPROM_Write(PLAN_Slots[LOC_U8Slot], (const uint8_t*)&LOC_Plan, sizeof(ST_Plan_t));
+	EEPROM_Read(PLAN_Slots[LOC_U8Slot], (uint8_t*)&LOC_ReadBack, sizeof(ST_Plan_t));
+	if(!PLAN_Valid(&LOC_ReadBack) || LOC_ReadBack.revision != LOC_Plan.revision) return 0;
+
+	PLAN_Slot = LOC_U8Slot;
+	*LOC_PtrShadow = LOC_Plan;
+	PLAN_Pending = 1;
+	return 1;
+}
+
+/*
+ * Function: PLAN_Init()
+ * Description: This function loads the newest valid plan of the EEPROM slots in the active buffer,
+ * or the compiled-in default plan (revision 0) if no slot holds a valid plan, and clears the command line.
+ * Return value: void
+ */
+void PLAN_Init(void){
+	ST_Plan_t LOC_Plans[2];
+
+	// Newest slot first, the revisions wrap around
+	EEPROM_Read(PLAN_Slots[0], (uint8_t*)&LOC_Plans[0], sizeof(ST_Plan_t));
+	EEPROM_Read(PLAN_Slots[1], (uint8_t*)&LOC_Plans[1], sizeof(ST_Plan_t));
+	uint8_t LOC_U8Newest = ((int16_t)(LOC_Plans[1].revision - LOC_Plans[0].revision) > 0) ? 1 : 0;
+
+	PLAN_Active = 0;
+	PLAN_Pending = 0;
+	if(PLAN_Valid(&LOC_Plans[LOC_U8Newest])){
+		PLAN_Slot = LOC_U8Newest;
+	}
+	else if(PLAN_Valid(&LOC_Plans[LOC_U8Newest ^ 1])){
+		PLAN_Slot = LOC_U8Newest ^ 1;
+	}
+	else{
+		// Default plan, the next update goes to slot 0
+		PLAN_Slot = 1;
+		LOC_Plans[1].revision = 0;
+		LOC_Plans[1].layout = PLAN_LAYOUT;
+		for(uint8_t i=0; i<PLAN_PHASE_NUM; i++) LOC_Plans[1].halfSecs[i] = PLAN_DEFAULT_HALF_SECS;
+		LOC_Plans[1].crc = CRC_16((const uint8_t*)&LOC_Plans[1], PLAN_CRC_LEN);
+	}
+	PLAN_Buffers[0] = LOC_Plans[PLAN_Slot];
+
+	PLAN_LineLen = 0;
+	PLAN_LineReady = 0;
+	PLAN_Boot = 0;
+}
+
+/*
+ * Function: PLAN_Get()
+ * Description: This function gets the active plan, it does not change before the next PLAN_Swap.
+ * Return value: the active plan
+ */
+const ST_Plan_t* PLAN_Get(void){
+	return &PLAN_Buffers[PLAN_Active];
+}
+
+/*
+ * Function: PLAN_Swap()
+ * Description: This function activates the plan received since the last call, if any.
+ * It must be called at a cycle boundary, where the application reads the plan again.
+ * Return value: 1 if a new plan is active, 0 otherwise
+ */
+uint8_t PLAN_Swap(void){
+	if(!PLAN_Pending) return 0;
+	PLAN_Active ^= 1;
+	PLAN_Pending = 0;
+	return 1;
+}
+
+/*
+ * Function: PLAN_Receive()
+ * Description: This function collects the command line, it is called from the UART receive interrupt
+ * with each byte of the text commands. The bytes received while the previous line is not handled yet are dropped,
+ * and so is a line longer than the buffer.
+ * Arguments:
+ *   - LOC_U8Byte: the received byte
+ * Return value: void
+ */
+void PLAN_Receive(uint8_t LOC_U8Byte){
+	if(PLAN_LineReady) return;
+	if('\r' == LOC_U8Byte || '\n' == LOC_U8Byte){
+		if(PLAN_LineLen <= PLAN_LINE_MAX - 1){
+			PLAN_Line[PLAN_LineLen] = 0;
+			if(PLAN_LineLen) PLAN_LineReady = 1;
+		}
+		PLAN_LineLen = 0;
+	}
+	else if(PLAN_LineLen < PLAN_LINE_MAX) PLAN_Line[PLAN_LineLen++] = (char)LOC_U8Byte;
+}
+
+/*
+ * Function: PLAN_Poll()
+ * Description: This function handles the command line received since the last call, if any.
+ * Return value: void
+ */
+void PLAN_Poll(void){
+	if(!PLAN_LineReady) return;
+
+	char LOC_Line[PLAN_LINE_MAX];
+	for(uint8_t i=0; i<PLAN_LINE_MAX; i++) LOC_Line[i] = PLAN_Line[i];
+	PLAN_LineReady = 0;
+
+	if('P' == LOC_Line[0]){
+		if(PLAN_Update(&LOC_Line[1])){
+			UART_SendString("OK");
+			PLAN_SendNumber(PLAN_Buffers[PLAN_Active ^ 1].revision);
+			UART_SendString("\r\n");
+		}
+		else UART_SendString("ERR\r\n");
+	}
+	else if('?' == LOC_Line[0] && !LOC_Line[1]){
+		const ST_Plan_t* LOC_PtrPlan = PLAN_Get();
+		UART_SendString("PLAN");
+		PLAN_SendNumber(LOC_PtrPlan->revision);
+		for(uint8_t i=0; i<PLAN_PHASE_NUM; i++) PLAN_SendNumber(LOC_PtrPlan->halfSecs[i]);
+		UART_SendString("\r\n");
+	}
+	else if('U' == LOC_Line[0] && !LOC_Line[1] && BOOT_ENABLE){
+		PLAN_Boot = 1;
+		UART_SendString("OK\r\n");
+	}
+	else UART_SendString("ERR\r\n");
+}
+
+/*
+ * Function: PLAN_BootRequested()
+ * Description: This function tells whether the firmware update command was received, the application then enters the bootloader.
+ * Return value: 1 if "U" was received since PLAN_Init, 0 otherwise
+ */
+uint8_t PLAN_BootRequested(void){
+	return PLAN_Boot;
+}
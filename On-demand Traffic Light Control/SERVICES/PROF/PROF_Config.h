@@ -0,0 +1,27 @@
+/*
+ * File: PROF_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the PC-sampling profiler.
+ * The profiler is only built when PROF_ENABLE is 1 (set it here or pass -DPROF_ENABLE=1 to the compiler).
+ * The histogram covers PROF_BUCKETS * 2^PROF_SHIFT program words from PROF_BASE,
+ * the default covers the first 4 KB of flash with 32 bytes per bucket (256 bytes of RAM).
+ * A sample is taken at each Timer2 overflow (122 Hz with the Timer2 configuration).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef PROF_CONFIG_H
+#define PROF_CONFIG_H
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE 0
+#endif
+
+#define PROF_BUCKETS 128     // number of histogram buckets
+#define PROF_SHIFT   4       // 2^4 = 16 program words (32 bytes) per bucket
+#define PROF_BASE    0x0000U // first program word address sampled
+
+#endif
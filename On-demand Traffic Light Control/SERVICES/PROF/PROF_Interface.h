@@ -0,0 +1,47 @@
+/*
+ * File: PROF_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the statistical PC-sampling profiler (profiling build only).
+ * A Timer2 overflow interrupt reads the return address of the interrupted code from the stack
+ * and counts it in a histogram of program addresses (PROF_Data), the code under test is not instrumented.
+ * PROF_Data is read from the running target by the debugger (for example "dump binary value prof.bin PROF_Data" in avr-gdb)
+ * and turned into a per-function flat profile by the host tool HOST/PROF against the .elf or .map file.
+ * Dump layout (little endian, no padding): buckets (1 byte), shift (1 byte), base word address (2 bytes),
+ * samples outside the histogram (2 bytes), then one 2-byte count per bucket.
+ * The functions prototypes defined in this file include:
+ *   - PROF_Init: function to clear the histogram and start sampling (empty when the profiler is not built)
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef PROF_INTERFACE_H
+#define PROF_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "PROF_Config.h"
+
+#if PROF_ENABLE
+
+typedef struct {
+	uint8_t buckets;
+	uint8_t shift;
+	uint16_t base;
+	uint16_t outside;
+	uint16_t hist[PROF_BUCKETS];
+} ST_Prof_t;
+
+extern volatile ST_Prof_t PROF_Data;
+
+// PROF function prototypes
+void PROF_Init(void);
+
+#else
+
+#define PROF_Init()
+
+#endif
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * File: PROF_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the PC-sampling profiler declared in PROF_Interface.h.
+ * The Timer2 overflow vector is naked: it saves the 4 registers it uses, reads the return address pushed by the CPU
+ * (high byte first in memory, just above the saved registers), stores it in PROF_Pc and jumps to the sampling
+ * handler, a normal interrupt handler that saves the registers it needs and returns to the interrupted code.
+ * Timer2 runs from the CPU clock with its own prescaler, so the samples are not phase locked with the Timer0 delays.
+ * When a bucket is full all the counts are halved, so the profile stays proportional however long it runs.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "PROF_Interface.h"
+
+#if PROF_ENABLE
+
+#include "../../MCAL/TMR2/TMR2_Interface.h"
+
+volatile ST_Prof_t PROF_Data;
+volatile uint16_t PROF_Pc; // program word address of the interrupted instruction
+
+/*
+ * Function: PROF_Init()
+ * Description: This function clears the histogram, starts Timer2 and enables its overflow interrupt.
+ * The samples are taken once the global interrupts are enabled.
+ * Returns: void
+ */
+void PROF_Init(void){
+	PROF_Data.buckets = PROF_BUCKETS;
+	PROF_Data.shift = PROF_SHIFT;
+	PROF_Data.base = PROF_BASE;
+	PROF_Data.outside = 0;
+	for(uint8_t i=0; i<PROF_BUCKETS; i++) PROF_Data.hist[i] = 0;
+	TMR2_Start(TMR2_PRESCALER);
+	TMR2_EnableInt(TOIE2);
+}
+
+#ifndef HOST_BUILD
+
+// Named like a vector so that the compiler accepts the signal attribute
+void __vector_prof_sample(void) __attribute__ ((signal,used));
+
+/*
+ * Function: TMR2_OVF (naked)
+ * Description: Gets the interrupted address and continues in the sampling handler.
+ * Stack after the 4 pushes: SP+1..SP+4 = r31, r30, r25, r24, SP+5 = return address high, SP+6 = low.
+ */
+void TMR2_OVF(void) __attribute__ ((signal,naked,used));
+void TMR2_OVF(void){
+	__asm__ __volatile__(
+		"push r24"               "\n\t"
+		"push r25"               "\n\t"
+		"push r30"               "\n\t"
+		"push r31"               "\n\t"
+		"in r30, __SP_L__"       "\n\t"
+		"in r31, __SP_H__"       "\n\t"
+		"ldd r25, Z+5"           "\n\t"
+		"ldd r24, Z+6"           "\n\t"
+		"sts PROF_Pc, r24"       "\n\t"
+		"sts PROF_Pc+1, r25"     "\n\t"
+		"pop r31"                "\n\t"
+		"pop r30"                "\n\t"
+		"pop r25"                "\n\t"
+		"pop r24"                "\n\t"
+		"jmp __vector_prof_sample" "\n\t"
+	);
+}
+
+/*
+ * Function: __vector_prof_sample()
+ * Description: Counts the sample in its bucket, halving all the buckets when one is full.
+ */
+void __vector_prof_sample(void){
+	uint16_t LOC_U16Offset = PROF_Pc - PROF_BASE; // wraps to a large offset below the base
+	if((LOC_U16Offset >> PROF_SHIFT) >= PROF_BUCKETS){
+		if(0xFFFF != PROF_Data.outside) PROF_Data.outside++;
+		return;
+	}
+	volatile uint16_t* LOC_PtrBucket = &PROF_Data.hist[LOC_U16Offset >> PROF_SHIFT];
+	if(0xFFFF == *LOC_PtrBucket){
+		for(uint8_t i=0; i<PROF_BUCKETS; i++) PROF_Data.hist[i] >>= 1;
+		PROF_Data.outside >>= 1;
+	}
+	(*LOC_PtrBucket)++;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,17 @@
+/*
+ * File: SCHED_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the cooperative task scheduler.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef SCHED_CONFIG_H
+#define SCHED_CONFIG_H
+
+#define SCHED_MAX_TASKS 8U // largest task table, the scheduler keeps 8 bytes of RAM per task
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * File: SCHED_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the cooperative task scheduler, which runs the work of the application
+ * as short run-to-completion tasks instead of blocking loops.
+ * The tasks are a constant table given by the application, in priority order (the first task first).
+ * A periodic task is released every period half seconds (TICK), after the offset of its first release,
+ * and a task with a period of 0 only runs when it is posted (SCHED_Post) by another task or by an ISR.
+ * A periodic task can also be posted.
+ * Each call of SCHED_Dispatch is one round: when no task is ready it waits for the next half second
+ * and releases the periodic tasks due, then it runs every ready task once, in the order of the table.
+ * A task posted during a round runs in this round if it comes after the running task in the table,
+ * otherwise in the next round, which then starts at once without waiting.
+ * The scheduler accounts, for each task, the runs, the worst-case execution time (Timer1 counts of 8 us, like SHIFT)
+ * and the overruns: a periodic task overruns when it ends after its next release (the half second waited for ended
+ * its period ago or more, the round was too long), and a task is also counted when it is posted again before it ran.
+ * On the host build the code runs in zero virtual time, so the execution times are 0.
+ * The dispatch cost is measured in CPU cycles on the target by SCHED_DispatchTest (TEST).
+ * The functions prototypes defined in this file include:
+ *   - SCHED_Init: function to set the task table
+ *   - SCHED_Post: function to make a task ready (tasks and ISRs)
+ *   - SCHED_Dispatch: function to run one round
+ *   - SCHED_GetStats: function to get the counters of a task
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef SCHED_INTERFACE_H
+#define SCHED_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "SCHED_Config.h"
+
+typedef struct {
+	void (*run)(void);
+	uint8_t period; // half seconds between two releases, 0 for a task run only when posted
+	uint8_t offset; // half seconds before the first release, after the first one waited for
+} ST_SchedTask_t;
+
+// Task counters (saturating)
+typedef struct {
+	uint16_t runs;
+	uint16_t overruns; // ended after the next release, or posted again before it ran
+	uint16_t wcet;     // longest run in Timer1 counts (8 us)
+} ST_SchedStats_t;
+
+// SCHED function prototypes
+void SCHED_Init(const ST_SchedTask_t* LOC_PtrTasks, uint8_t LOC_U8Num);
+void SCHED_Post(uint8_t LOC_U8Task);
+void SCHED_Dispatch(void);
+void SCHED_GetStats(uint8_t LOC_U8Task, ST_SchedStats_t* LOC_PtrStats);
+
+#endif
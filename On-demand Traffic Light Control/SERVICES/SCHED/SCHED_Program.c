@@ -0,0 +1,145 @@
+/*
+ * File: SCHED_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the cooperative task scheduler declared in SCHED_Interface.h.
+ * A task is ready when its byte in SCHED_Ready is set: a byte is written in one instruction,
+ * so an ISR can post a task while the dispatcher clears another one without disabling the interrupts.
+ * The periodic tasks count down the half seconds until their next release.
+ * The execution time of a task is read on the Timer1 counter around the call, across one wrap of the period at most.
+ * The overruns use the half seconds ended since the one waited for by the round (TICK_Late).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "SCHED_Interface.h"
+#include "../TICK/TICK_Interface.h"
+#include "../../MCAL/TMR1/TMR1_Interface.h"
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+#include "../../utils/IO_ACCESS.h"
+
+static const ST_SchedTask_t* SCHED_Tasks;
+static uint8_t SCHED_Num;
+static volatile uint8_t SCHED_Ready[SCHED_MAX_TASKS]; // set by the releases and SCHED_Post, cleared when the task runs
+static uint8_t SCHED_Countdown[SCHED_MAX_TASKS];      // half seconds until the next release
+static volatile ST_SchedStats_t SCHED_Stats[SCHED_MAX_TASKS]; // the overruns are also counted by the posts of the ISRs
+
+/*
+ * Function: SCHED_Count()
+ * Description: Adds one to a saturating counter.
+ */
+static void SCHED_Count(volatile uint16_t* LOC_PtrCounter){
+	if(0xFFFF != *LOC_PtrCounter) (*LOC_PtrCounter)++;
+}
+
+/*
+ * Function: SCHED_Overrun()
+ * Description: Counts an overrun of a task with the interrupts disabled, since SCHED_Post counts them from the ISRs too.
+ */
+static void SCHED_Overrun(uint8_t LOC_U8Task){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	SCHED_Count(&SCHED_Stats[LOC_U8Task].overruns);
+	if(LOC_U8Interrupts) CPU_SEI();
+}
+
+/*
+ * Function: SCHED_Elapsed()
+ * Description: Gets the Timer1 counts since a counter value read in the current or the previous period.
+ */
+static uint16_t SCHED_Elapsed(uint16_t LOC_U16Start){
+	uint16_t LOC_U16Now = TMR1_GetCount();
+	if(LOC_U16Now < LOC_U16Start) LOC_U16Now += TMR1_GetTop() + 1;
+	return LOC_U16Now - LOC_U16Start;
+}
+
+/*
+ * Function: SCHED_Init()
+ * Description: This function sets the task table and clears the counters, no task is ready.
+ * The first release of a periodic task is at the end of the first half second waited for, plus its offset.
+ * Arguments:
+ *   - LOC_PtrTasks: the tasks in priority order, the table is not copied
+ *   - LOC_U8Num: the number of tasks, SCHED_MAX_TASKS at most (the others are ignored)
+ * Return value: void
+ */
+void SCHED_Init(const ST_SchedTask_t* LOC_PtrTasks, uint8_t LOC_U8Num){
+	SCHED_Tasks = LOC_PtrTasks;
+	SCHED_Num = (LOC_U8Num > SCHED_MAX_TASKS) ? SCHED_MAX_TASKS : LOC_U8Num;
+	for(uint8_t i=0; i<SCHED_Num; i++){
+		SCHED_Ready[i] = 0;
+		SCHED_Countdown[i] = 1 + LOC_PtrTasks[i].offset;
+		SCHED_Stats[i].runs = 0;
+		SCHED_Stats[i].overruns = 0;
+		SCHED_Stats[i].wcet = 0;
+	}
+}
+
+/*
+ * Function: SCHED_Post()
+ * Description: This function makes a task ready, it can be called from an ISR.
+ * A task posted again before it ran runs once, and the post is counted as an overrun.
+ * Arguments:
+ *   - LOC_U8Task: the index of the task in the table
+ * Return value: void
+ */
+void SCHED_Post(uint8_t LOC_U8Task){
+	if(LOC_U8Task >= SCHED_Num) return;
+	if(SCHED_Ready[LOC_U8Task]) SCHED_Overrun(LOC_U8Task);
+	SCHED_Ready[LOC_U8Task] = 1;
+}
+
+/*
+ * Function: SCHED_Dispatch()
+ * Description: This function runs one round: when no task is ready, it waits for the next half second
+ * and releases the periodic tasks due. Then it runs the ready tasks in the order of the table.
+ * It is called by the main loop.
+ * Return value: void
+ */
+void SCHED_Dispatch(void){
+	uint8_t i;
+	for(i=0; i<SCHED_Num && !SCHED_Ready[i]; i++);
+	if(SCHED_Num == i){
+		TICK_Wait();
+		for(i=0; i<SCHED_Num; i++){
+			if(!SCHED_Tasks[i].period || --SCHED_Countdown[i]) continue;
+			SCHED_Countdown[i] = SCHED_Tasks[i].period;
+			SCHED_Ready[i] = 1;
+		}
+	}
+
+	for(i=0; i<SCHED_Num; i++){
+		if(!SCHED_Ready[i]) continue;
+		SCHED_Ready[i] = 0;
+		const ST_SchedTask_t* LOC_PtrTask = &SCHED_Tasks[i];
+		volatile ST_SchedStats_t* LOC_PtrStats = &SCHED_Stats[i];
+		uint16_t LOC_U16Start = TMR1_GetCount();
+		LOC_PtrTask->run();
+		uint16_t LOC_U16Time = SCHED_Elapsed(LOC_U16Start);
+		SCHED_Count(&LOC_PtrStats->runs);
+		if(LOC_U16Time > LOC_PtrStats->wcet) LOC_PtrStats->wcet = LOC_U16Time;
+		if(LOC_PtrTask->period && TICK_Late() >= LOC_PtrTask->period) SCHED_Overrun(i);
+	}
+}
+
+/*
+ * Function: SCHED_GetStats()
+ * Description: This function copies the counters of a task, the overruns of the posts are updated by the ISRs.
+ * Arguments:
+ *   - LOC_U8Task: the index of the task in the table
+ *   - LOC_PtrStats: where to copy them (cleared for a task outside the table)
+ * Return value: void
+ */
+void SCHED_GetStats(uint8_t LOC_U8Task, ST_SchedStats_t* LOC_PtrStats){
+	if(LOC_U8Task >= SCHED_Num){
+		LOC_PtrStats->runs = 0;
+		LOC_PtrStats->overruns = 0;
+		LOC_PtrStats->wcet = 0;
+		return;
+	}
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	*LOC_PtrStats = SCHED_Stats[LOC_U8Task];
+	if(LOC_U8Interrupts) CPU_SEI();
+}
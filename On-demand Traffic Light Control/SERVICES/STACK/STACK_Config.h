@@ -0,0 +1,23 @@
+/*
+ * File: STACK_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the stack monitor.
+ * The free RAM between the end of the variables and the stack is painted with STACK_PAINT at startup,
+ * the first STACK_GUARD bytes above the variables are the guard, they must stay painted.
+ * A high-water mark scan stops after STACK_RUN painted bytes in a row.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef STACK_CONFIG_H
+#define STACK_CONFIG_H
+
+#define STACK_PAINT  0xC5    // value of the unused stack bytes
+#define STACK_GUARD  8       // guard bytes above the variables
+#define STACK_RUN    8       // painted bytes that end a high-water mark scan
+#define STACK_RAMEND 0x085FU // last RAM address of the ATmega32 (top of the stack)
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * File: STACK_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the stack monitor. On the 2 KB ATmega32 an ISR on top of a deep
+ * call chain can grow the stack into the variables without any warning, so the free RAM is painted at startup
+ * (before the variables are initialized) and checked while the controller runs:
+ *   - the guard bytes just above the variables must still be painted, the check is a few compares per tick
+ *   - the high-water mark is the deepest byte that is not painted anymore, each query only scans below
+ *     the previous mark, so it costs a few bytes once the stack stopped growing
+ * The worst case of a build is computed off target by the host tool HOST/STACK from the listing (.lss).
+ * On the host build there is no AVR stack: the guard is always intact and the peak is 0.
+ * The functions prototypes defined in this file include:
+ *   - STACK_Init: function to start the high-water mark from the current stack pointer
+ *   - STACK_Check: function to check the guard bytes
+ *   - STACK_Peak: function to get the stack high-water mark in bytes
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef STACK_INTERFACE_H
+#define STACK_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "STACK_Config.h"
+
+// STACK function prototypes
+void STACK_Init(void);
+uint8_t STACK_Check(void);
+uint16_t STACK_Peak(void);
+
+#endif
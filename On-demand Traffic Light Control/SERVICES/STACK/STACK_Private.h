@@ -0,0 +1,22 @@
+/*
+ * File: STACK_Private.h
+ *
+ * Description:
+ * This header file contains the stack pointer register and the linker symbol used by the stack monitor.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef STACK_PRIVATE_H
+#define STACK_PRIVATE_H
+
+#include "../../utils/IO_ACCESS.h"
+
+#define SP IO_REG16(0x5D) // Stack Pointer (SPH:SPL), points to the next free byte
+
+// First RAM address after the variables (.data, .bss and .noinit), set by the linker
+extern uint8_t __heap_start;
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * File: STACK_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the stack monitor declared in STACK_Interface.h.
+ * The painting runs in the .init3 section of the startup code: the stack pointer is set and nothing is on the stack,
+ * the variables are initialized after it (.init4), so everything from the end of the variables to RAMEND is painted.
+ * It uses no stack and only the call-clobbered registers r24, r25, r30 and r31.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "STACK_Interface.h"
+#include "STACK_Private.h"
+
+#ifndef HOST_BUILD
+
+static uint8_t* STACK_Low; // deepest stack byte seen in use
+
+void STACK_Paint(void) __attribute__ ((naked,used,section(".init3")));
+void STACK_Paint(void){
+	__asm__ __volatile__(
+		"ldi r30, lo8(__heap_start)"     "\n\t"
+		"ldi r31, hi8(__heap_start)"     "\n\t"
+		"ldi r24, %0"                    "\n\t"
+		"ldi r25, hi8(%1)"               "\n\t"
+		"1: st Z+, r24"                  "\n\t"
+		"cpi r30, lo8(%1)"               "\n\t"
+		"cpc r31, r25"                   "\n\t"
+		"brlo 1b"                        "\n\t"
+		"breq 1b"                        "\n\t"
+		:: "M" (STACK_PAINT), "i" (STACK_RAMEND)
+	);
+}
+
+/************************************************************************/
+/*                       STACK Functions                                */
+/************************************************************************/
+
+/*
+ * Function: STACK_Init()
+ * Description: This function starts the high-water mark at the bytes in use now (the call chain of the caller).
+ * Returns: void
+ */
+void STACK_Init(void){
+	STACK_Low = (uint8_t*)SP + 1;
+}
+
+/*
+ * Function: STACK_Check()
+ * Description: This function checks that the guard bytes above the variables are still painted.
+ * A damaged guard means the stack reached the variables, they cannot be trusted anymore.
+ * Returns: 1 if the guard is intact, 0 otherwise
+ */
+uint8_t STACK_Check(void){
+	uint8_t* LOC_PtrGuard = &__heap_start;
+	for(uint8_t i=0; i<STACK_GUARD; i++){
+		if(STACK_PAINT != LOC_PtrGuard[i]) return 0;
+	}
+	return 1;
+}
+
+/*
+ * Function: STACK_Peak()
+ * Description: This function gets the stack high-water mark: it scans down from the previous mark
+ * until STACK_RUN painted bytes in a row (a used byte can hold the paint value by chance).
+ * Returns: the largest number of stack bytes used since startup
+ */
+uint16_t STACK_Peak(void){
+	uint8_t* LOC_PtrByte = STACK_Low;
+	uint8_t LOC_U8Run = 0;
+	while(LOC_U8Run < STACK_RUN && LOC_PtrByte > &__heap_start){
+		LOC_PtrByte--;
+		if(STACK_PAINT == *LOC_PtrByte) LOC_U8Run++;
+		else{
+			LOC_U8Run = 0;
+			STACK_Low = LOC_PtrByte;
+		}
+	}
+	return (uint16_t)(STACK_RAMEND + 1 - (uint16_t)STACK_Low);
+}
+
+#else
+
+void STACK_Init(void){
+}
+
+uint8_t STACK_Check(void){
+	return 1;
+}
+
+uint16_t STACK_Peak(void){
+	return 0;
+}
+
+#endif
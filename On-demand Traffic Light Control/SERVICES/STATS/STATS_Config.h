@@ -0,0 +1,25 @@
+/*
+ * File: STATS_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the statistics module.
+ * The time unit of the statistics is the half second tick of the application (STATS_Tick),
+ * so the durations are fixed-point seconds with one fractional bit.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef STATS_CONFIG_H
+#define STATS_CONFIG_H
+
+// Ticks in one hour (0.5 second ticks)
+#define STATS_TICKS_PER_HOUR 7200U
+
+// Number of buckets of the histograms (see STATS_Interface.h for the bucket bounds)
+#define STATS_PHASE_BUCKETS 8  // phase duration: last bucket 12 ticks (6 s) and more
+#define STATS_WAIT_BUCKETS  12 // press to walk latency: last bucket 48 ticks (24 s) and more
+#define STATS_HOUR_BUCKETS  12 // requests per hour: last bucket 48 requests and more
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * File: STATS_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the statistics module, which answers the operational questions
+ * (how often is the button pressed, how long do pedestrians wait, how many cycles are cut short).
+ * The application reports its state transitions, each report is handled in constant time.
+ * The statistics are saturating 16-bit counters and log-bucketed histograms, all kept in STATS_Data (under 128 bytes)
+ * which can be watched by the debugger or copied by STATS_Read while the controller runs.
+ * Histogram buckets: values 0 to 3 have their own bucket, then each power of two is split in two buckets
+ * (4-5, 6-7, 8-11, 12-15, 16-23, 24-31, 32-47, 48-63, ...), the last bucket counts all the larger values.
+ * The functions prototypes defined in this file include:
+ *   - STATS_Init: function to clear the statistics
+ *   - STATS_Tick: function to account one half second
+ *   - STATS_Press: function to count a button press (called from the button ISR)
+ *   - STATS_Phase: function to report the start of a lamp phase
+ *   - STATS_Cycle: function to report the end of a normal cycle
+ *   - STATS_Vehicles: function to count the vehicles detected in a half second
+ *   - STATS_GreenEnd: function to report the end of an actuated green (gap-out or max-out)
+ *   - STATS_Stack: function to report the stack high-water mark
+ *   - STATS_Read: function to take a consistent copy of the statistics
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef STATS_INTERFACE_H
+#define STATS_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "../../utils/IO_ACCESS.h"
+#include "STATS_Config.h"
+
+// Event counters
+typedef enum statsCounter{
+	STATS_PRESSES,   // button presses
+	STATS_ACCEPTED,  // presses that started the pedestrian mode
+	STATS_ANSWERED,  // walk phases that answered a press
+	STATS_CYCLES,    // normal cycles completed
+	STATS_CUT_SHORT, // normal cycles cut short by a press
+	STATS_VEHICLES,  // vehicles detected
+	STATS_GAP_OUTS,  // actuated greens ended by a gap in the traffic
+	STATS_MAX_OUTS,  // actuated greens ended at the maximum green
+	STATS_COUNTER_NUM
+} EN_StatsCounter_t;
+
+// Lamp phases, named after the car lamp
+typedef enum statsPhase{
+	STATS_GREEN,
+	STATS_YELLOW,
+	STATS_RED,      // pedestrians walk
+	STATS_PHASE_NUM
+} EN_StatsPhase_t;
+
+typedef struct {
+	uint16_t counter[STATS_COUNTER_NUM];
+	uint16_t phaseHist[STATS_PHASE_NUM][STATS_PHASE_BUCKETS]; // actual phase duration in ticks
+	uint16_t waitHist[STATS_WAIT_BUCKETS];                    // first press to walk in ticks
+	uint16_t hourHist[STATS_HOUR_BUCKETS];                    // presses in each hour
+	uint16_t stackPeak;                                       // stack high-water mark in bytes
+} ST_Stats_t;
+
+extern ST_Stats_t STATS_Data;
+
+// STATS function prototypes
+void STATS_Init(void);
+void STATS_Tick(void);
+void STATS_Press(uint8_t LOC_U8Accepted);
+void STATS_Phase(EN_StatsPhase_t LOC_Phase);
+void STATS_Cycle(uint8_t LOC_U8CutShort);
+void STATS_Vehicles(uint8_t LOC_U8Count);
+void STATS_GreenEnd(uint8_t LOC_U8MaxOut);
+void STATS_Stack(uint16_t LOC_U16Bytes);
+void STATS_Read(ST_Stats_t* LOC_PtrCopy);
+
+#endif
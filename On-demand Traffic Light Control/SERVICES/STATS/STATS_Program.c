@@ -0,0 +1,200 @@
+/*
+ * File: STATS_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the statistics module declared in STATS_Interface.h
+ * STATS_Press runs in the button ISR, the other functions run in the main loop: the few variables shared
+ * with the ISR are accessed with the interrupts disabled.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "STATS_Interface.h"
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+
+ST_Stats_t STATS_Data;
+
+static volatile uint16_t STATS_Now;        // ticks since init (wraps, only differences are used), read by STATS_Press
+static uint16_t STATS_HourTicks;           // ticks in the current hour
+static volatile uint16_t STATS_HourPresses; // presses in the current hour
+static volatile uint16_t STATS_PressTick;  // time of the first press not answered yet
+static volatile uint8_t STATS_Pending;     // a press is waiting for the walk phase
+static uint16_t STATS_PhaseStart;
+static uint8_t STATS_CurPhase;
+
+// The statistics and the 12 bytes of state above must fit in 128 bytes of RAM
+typedef char STATS_SizeCheck[(sizeof(ST_Stats_t) + 12 <= 128) ? 1 : -1];
+
+/*
+ * Function: STATS_Inc()
+ * Description: This function increments a counter, the counter stays at its maximum instead of wrapping.
+ */
+static void STATS_Inc(volatile uint16_t* LOC_PtrCounter){
+	if(0xFFFF != *LOC_PtrCounter) (*LOC_PtrCounter)++;
+}
+
+/*
+ * Function: STATS_Bucket()
+ * Description: This function gets the histogram bucket of a value (see STATS_Interface.h).
+ * The bucket is the exponent of the value with one bit of mantissa, found in at most 16 steps.
+ * Arguments:
+ *   - LOC_U16Value: the value
+ *   - LOC_U8Buckets: the number of buckets of the histogram
+ * Returns: the bucket index
+ */
+static uint8_t STATS_Bucket(uint16_t LOC_U16Value, uint8_t LOC_U8Buckets){
+	uint8_t LOC_U8Bucket = (uint8_t)LOC_U16Value;
+	if(LOC_U16Value >= 4){
+		uint8_t LOC_U8Exp = 2;
+		while(LOC_U16Value >> (LOC_U8Exp + 1)) LOC_U8Exp++;
+		LOC_U8Bucket = 2 * LOC_U8Exp + ((LOC_U16Value >> (LOC_U8Exp - 1)) & 1);
+	}
+	return (LOC_U8Bucket < LOC_U8Buckets) ? LOC_U8Bucket : LOC_U8Buckets - 1;
+}
+
+/************************************************************************/
+/*                       STATS Functions                                */
+/************************************************************************/
+
+/*
+ * Function: STATS_Init()
+ * Description: This function clears the statistics and the phase being timed,
+ * it is called before the interrupts are enabled.
+ * Returns: void
+ */
+void STATS_Init(void){
+	uint8_t* LOC_PtrByte = (uint8_t*)&STATS_Data;
+	for(uint8_t i=0; i<sizeof(STATS_Data); i++) LOC_PtrByte[i] = 0;
+	STATS_Now = 0;
+	STATS_HourTicks = 0;
+	STATS_HourPresses = 0;
+	STATS_Pending = 0;
+	STATS_CurPhase = STATS_PHASE_NUM; // no phase yet
+}
+
+/*
+ * Function: STATS_Tick()
+ * Description: This function accounts one half second, and files the number of presses at the end of each hour.
+ * Returns: void
+ */
+void STATS_Tick(void){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	STATS_Now++; // two bytes: the button ISR must not see the low byte wrapped and the high byte not yet carried
+	if(LOC_U8Interrupts) CPU_SEI();
+	if(++STATS_HourTicks < STATS_TICKS_PER_HOUR) return;
+	STATS_HourTicks = 0;
+	CPU_CLI();
+	uint16_t LOC_U16Presses = STATS_HourPresses;
+	STATS_HourPresses = 0;
+	if(LOC_U8Interrupts) CPU_SEI();
+	STATS_Inc(&STATS_Data.hourHist[STATS_Bucket(LOC_U16Presses, STATS_HOUR_BUCKETS)]);
+}
+
+/*
+ * Function: STATS_Press()
+ * Description: This function counts a button press, it is called from the button ISR.
+ * Arguments:
+ *   - LOC_U8Accepted: 1 if the press started the pedestrian mode, 0 if it was ignored
+ * Returns: void
+ */
+void STATS_Press(uint8_t LOC_U8Accepted){
+	STATS_Inc(&STATS_Data.counter[STATS_PRESSES]);
+	if(LOC_U8Accepted) STATS_Inc(&STATS_Data.counter[STATS_ACCEPTED]);
+	STATS_Inc(&STATS_HourPresses);
+	if(!STATS_Pending && STATS_RED != STATS_CurPhase){
+		STATS_Pending = 1;
+		STATS_PressTick = STATS_Now;
+	}
+}
+
+/*
+ * Function: STATS_Phase()
+ * Description: This function reports the start of a lamp phase: the actual duration of the previous phase is filed,
+ * and the start of a walk phase answers the waiting press.
+ * Arguments:
+ *   - LOC_Phase: the phase starting now (STATS_GREEN, STATS_YELLOW, STATS_RED)
+ * Returns: void
+ */
+void STATS_Phase(EN_StatsPhase_t LOC_Phase){
+	if(STATS_CurPhase < STATS_PHASE_NUM){
+		uint16_t LOC_U16Duration = STATS_Now - STATS_PhaseStart;
+		STATS_Inc(&STATS_Data.phaseHist[STATS_CurPhase][STATS_Bucket(LOC_U16Duration, STATS_PHASE_BUCKETS)]);
+	}
+	STATS_PhaseStart = STATS_Now;
+
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	STATS_CurPhase = LOC_Phase;
+	uint8_t LOC_U8Answered = (STATS_RED == LOC_Phase) && STATS_Pending;
+	uint16_t LOC_U16Wait = STATS_Now - STATS_PressTick;
+	if(LOC_U8Answered) STATS_Pending = 0;
+	if(LOC_U8Interrupts) CPU_SEI();
+
+	if(LOC_U8Answered){
+		STATS_Inc(&STATS_Data.counter[STATS_ANSWERED]);
+		STATS_Inc(&STATS_Data.waitHist[STATS_Bucket(LOC_U16Wait, STATS_WAIT_BUCKETS)]);
+	}
+}
+
+/*
+ * Function: STATS_Cycle()
+ * Description: This function reports the end of a normal cycle.
+ * Arguments:
+ *   - LOC_U8CutShort: 1 if a press ended the cycle early
+ * Returns: void
+ */
+void STATS_Cycle(uint8_t LOC_U8CutShort){
+	STATS_Inc(&STATS_Data.counter[LOC_U8CutShort ? STATS_CUT_SHORT : STATS_CYCLES]);
+}
+
+/*
+ * Function: STATS_Vehicles()
+ * Description: This function adds the vehicles detected in a half second, the counter stays at its maximum.
+ * Arguments:
+ *   - LOC_U8Count: the number of vehicles
+ * Returns: void
+ */
+void STATS_Vehicles(uint8_t LOC_U8Count){
+	uint16_t LOC_U16Total = STATS_Data.counter[STATS_VEHICLES] + LOC_U8Count;
+	STATS_Data.counter[STATS_VEHICLES] = (LOC_U16Total < LOC_U8Count) ? 0xFFFF : LOC_U16Total;
+}
+
+/*
+ * Function: STATS_GreenEnd()
+ * Description: This function reports the end of an actuated green that was not cut short by a press.
+ * Arguments:
+ *   - LOC_U8MaxOut: 1 if the green reached its maximum, 0 if it ended on a gap in the traffic
+ * Returns: void
+ */
+void STATS_GreenEnd(uint8_t LOC_U8MaxOut){
+	STATS_Inc(&STATS_Data.counter[LOC_U8MaxOut ? STATS_MAX_OUTS : STATS_GAP_OUTS]);
+}
+
+/*
+ * Function: STATS_Stack()
+ * Description: This function keeps the largest stack high-water mark reported.
+ * Arguments:
+ *   - LOC_U16Bytes: the stack bytes used (STACK_Peak)
+ * Returns: void
+ */
+void STATS_Stack(uint16_t LOC_U16Bytes){
+	if(LOC_U16Bytes > STATS_Data.stackPeak) STATS_Data.stackPeak = LOC_U16Bytes;
+}
+
+/*
+ * Function: STATS_Read()
+ * Description: This function copies the statistics with the interrupts disabled,
+ * so the copy is consistent even if the button is pressed meanwhile.
+ * Arguments:
+ *   - LOC_PtrCopy: where to copy the statistics
+ * Returns: void
+ */
+void STATS_Read(ST_Stats_t* LOC_PtrCopy){
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	*LOC_PtrCopy = STATS_Data;
+	if(LOC_U8Interrupts) CPU_SEI();
+}
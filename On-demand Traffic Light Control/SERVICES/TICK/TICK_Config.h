@@ -0,0 +1,24 @@
+/*
+ * File: TICK_Config.h
+ *
+ * Description:
+ * This header file contains the configuration of the half-second timebase.
+ * The 1PPS discipline is only built when TICK_PPS_ENABLE is 1 (set it here or pass -DTICK_PPS_ENABLE=1 to the compiler),
+ * the pulse goes to INT1 (PIN 3 in PORTD).
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TICK_CONFIG_H
+#define TICK_CONFIG_H
+
+#ifndef TICK_PPS_ENABLE
+#define TICK_PPS_ENABLE 0
+#endif
+
+#define TICK_WINDOW        64U    // seconds per rate measurement (power of two), the half second is kept in 1/(2 * TICK_WINDOW) counts
+#define TICK_PPS_TOLERANCE 3750U  // largest error of one second between two pulses, in Timer1 counts (3 %)
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * File: TICK_Interface.h
+ *
+ * Description:
+ * This header file contains the interfaces of the half-second timebase of the application.
+ * The half seconds are the Timer1 periods (CTC mode, the hardware flasher period), counted by the compare A interrupt:
+ * the timer never stops nor restarts, so the time spent between two waits is not added to the cycle
+ * and the phases stay on a fixed grid.
+ * The period is kept as a number of counts per TICK_WINDOW seconds, 8000000 at 1 MHz: a half second is this number
+ * divided by 2 * TICK_WINDOW, and the remainder is carried from one half second to the next (Bresenham),
+ * so the half seconds last the quotient or one count more and the long-run error is zero.
+ * With the 1PPS discipline (1PPS build only), a pulse per second (GPS receiver) on INT1 measures the actual
+ * Timer1 counts per TICK_WINDOW seconds, which replace the nominal value: the half seconds then follow the pulses,
+ * whatever the error of the CPU clock. The flasher follows the same periods.
+ * The counts since TICK_Init also timestamp events for the other services (TICK_Stamp).
+ * The functions prototypes defined in this file include:
+ *   - TICK_Init: function to start counting the half seconds (and the 1PPS input)
+ *   - TICK_Wait: function to wait for the next half second
+ *   - TICK_Late: function to get the half seconds ended since the one waited for
+ *   - TICK_Stamp: function to timestamp a Timer1 counter value
+ *   - TICK_GetStats: function to get the rate in use and the counters
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef TICK_INTERFACE_H
+#define TICK_INTERFACE_H
+
+#include "../../utils/STD_TYPES.h"
+#include "TICK_Config.h"
+
+// Timebase counters (saturating)
+typedef struct {
+	uint32_t period;   // Timer1 counts per TICK_WINDOW seconds in use
+	uint16_t pulses;   // 1PPS pulses accepted
+	uint16_t rejected; // 1PPS pulses out of tolerance, the first pulse only starts the measurement
+	uint16_t windows;  // rate measurements taken into account
+	uint16_t slips;    // waits that dropped half seconds (main loop blocked for more than a half second)
+} ST_TickStats_t;
+
+// TICK function prototypes
+void TICK_Init(void);
+void TICK_Wait(void);
+uint8_t TICK_Late(void);
+uint32_t TICK_Stamp(uint16_t LOC_U16Count);
+void TICK_GetStats(ST_TickStats_t* LOC_PtrStats);
+
+#endif
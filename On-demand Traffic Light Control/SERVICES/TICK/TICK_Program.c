@@ -0,0 +1,212 @@
+/*
+ * File: TICK_Program.c
+ *
+ * Description:
+ * This file contains the implementation of the half-second timebase declared in TICK_Interface.h.
+ * The Timer1 compare A interrupt ends each half second: it adds the length of the period that ended
+ * to the count of its start (TICK_Base), counts the half second and programs the length of the next one:
+ * the rate divided by 2 * TICK_WINDOW, plus one count each time the carried remainder reaches a whole count.
+ * The new top is written right after the match, while the counter is still far below it.
+ * The 1PPS interrupt timestamps each pulse. The pulses one second apart (within TICK_PPS_TOLERANCE) are counted,
+ * and every TICK_WINDOW of them the counts since the start of the window become the new rate.
+ * The windows follow each other without a gap, so the error of each timestamp (one count)
+ * is not added up from one window to the next.
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#include "TICK_Interface.h"
+#include "../../MCAL/TMR1/TMR1_Interface.h"
+#include "../../MCAL/EXTI/EXTI_Interface.h"
+#include "../../MCAL/GPIO/GPIO_Interface.h"
+#include "../../utils/IO_ACCESS.h"
+
+#define TICK_DIV     (2U * TICK_WINDOW)                          // half seconds per window
+#define TICK_HALF    (TOP_VALUE_HALF_SEC + 1UL)                  // counts per half second at F_CPU
+#define TICK_NOMINAL (TICK_HALF * TICK_DIV)                      // counts per window at F_CPU
+#define TICK_SECOND  (2 * TICK_HALF)                             // counts per second at F_CPU
+
+// Updated by the compare A interrupt
+static volatile uint32_t TICK_Base;     // count at the start of the current period
+static volatile uint16_t TICK_Length;   // counts in the current period
+static volatile uint16_t TICK_Previous; // counts in the previous period
+static volatile uint8_t TICK_Ticks;     // half seconds ended
+static volatile uint32_t TICK_Period;   // counts per window in use, also written by the 1PPS interrupt
+static uint8_t TICK_Fraction;           // fraction of a count carried, in 1/TICK_DIV counts
+
+static uint8_t TICK_Seen;               // half seconds waited for by the main loop
+static uint16_t TICK_Slips;
+
+#if TICK_PPS_ENABLE
+// 1PPS measurement, in the INT1 interrupt
+static uint32_t TICK_PpsLast;    // count of the last pulse
+static uint32_t TICK_PpsStart;   // count of the pulse starting the window
+static uint8_t TICK_PpsStarted;  // a pulse came since TICK_Init, TICK_PpsLast is valid
+static uint8_t TICK_PpsSeconds;  // seconds in the window so far
+static volatile uint16_t TICK_Pulses;
+static volatile uint16_t TICK_Rejected;
+static volatile uint16_t TICK_Windows;
+#endif
+
+/*
+ * Function: TICK_Count()
+ * Description: Adds one to a saturating counter.
+ */
+static void TICK_Count(volatile uint16_t* LOC_PtrCounter){
+	if(0xFFFF != *LOC_PtrCounter) (*LOC_PtrCounter)++;
+}
+
+#if TICK_PPS_ENABLE
+/*
+ * Function: TICK_Pps()
+ * Description: The INT1 callback, called on the rising edge of the 1PPS input.
+ * A pulse that does not come one second after the previous one (glitch, missing pulse, first pulse)
+ * starts a new window.
+ */
+static void TICK_Pps(void){
+	uint32_t LOC_U32Now = TICK_Stamp(TMR1_GetCount());
+	uint32_t LOC_U32Second = LOC_U32Now - TICK_PpsLast;
+	TICK_PpsLast = LOC_U32Now;
+
+	if(!TICK_PpsStarted || LOC_U32Second < TICK_SECOND - TICK_PPS_TOLERANCE || LOC_U32Second > TICK_SECOND + TICK_PPS_TOLERANCE){
+		TICK_PpsStarted = 1;
+		TICK_Count(&TICK_Rejected);
+		TICK_PpsStart = LOC_U32Now;
+		TICK_PpsSeconds = 0;
+		return;
+	}
+	TICK_Count(&TICK_Pulses);
+	if(++TICK_PpsSeconds < TICK_WINDOW) return;
+
+	// End of the window, the next one starts at this pulse
+	TICK_Period = LOC_U32Now - TICK_PpsStart;
+	TICK_Count(&TICK_Windows);
+	TICK_PpsStart = LOC_U32Now;
+	TICK_PpsSeconds = 0;
+}
+#endif
+
+/*
+ * Function: TICK_Init()
+ * Description: This function starts counting the half seconds at the nominal rate, the current Timer1 period
+ * is the first one. Timer1 must be running in CTC mode (LED_FlashInit), the interrupts are enabled later (EXTI_Init).
+ * In the 1PPS build it also enables the 1PPS input (INT1, rising edge).
+ * Return value: void
+ */
+void TICK_Init(void){
+	TICK_Base = 0;
+	TICK_Length = TICK_HALF;
+	TICK_Previous = TICK_HALF;
+	TICK_Ticks = 0;
+	TICK_Period = TICK_NOMINAL;
+	TICK_Fraction = 0;
+	TICK_Seen = 0;
+	TICK_Slips = 0;
+	TMR1_EnableInt(OCIE1A);
+#if TICK_PPS_ENABLE
+	TICK_PpsStarted = 0;
+	TICK_PpsSeconds = 0;
+	TICK_Pulses = 0;
+	TICK_Rejected = 0;
+	TICK_Windows = 0;
+	GPIO_SetPinDir(PORTD, PIN3, INPUT);
+	EXTI_SetCallback(INT1, TICK_Pps);
+	EXTI_ChooseISC(INT1, RISING_EDGE);
+	EXTI_Enable(INT1);
+#endif
+}
+
+/*
+ * Function: TICK_Wait()
+ * Description: This function waits for the end of the half second following the one of the previous call,
+ * it returns at once if that half second already ended while the main loop was busy.
+ * If the main loop was blocked for more than a half second, the half seconds missed are dropped.
+ * Return value: void
+ */
+void TICK_Wait(void){
+	uint8_t LOC_U8Ticks = TICK_Ticks;
+	if((uint8_t)(LOC_U8Ticks - TICK_Seen) > 1){
+		TICK_Seen = LOC_U8Ticks - 1;
+		TICK_Count(&TICK_Slips);
+	}
+	while(TICK_Seen == TICK_Ticks) IO_POLL();
+	TICK_Seen++;
+}
+
+/*
+ * Function: TICK_Late()
+ * Description: This function gets the number of half seconds that ended since the one waited for last,
+ * 0 while the main loop is still in the half second following its last wait.
+ * Return value: the number of half seconds
+ */
+uint8_t TICK_Late(void){
+	return (uint8_t)(TICK_Ticks - TICK_Seen);
+}
+
+/*
+ * Function: TICK_Stamp()
+ * Description: This function gets the counts since TICK_Init at a Timer1 counter value read in the current period,
+ * or in the previous one when it is above the counter now (input capture). The interrupts must be disabled.
+ * A compare match not served yet is detected by its flag while the counter is low.
+ * The timestamps wrap every 2^32 counts (about 9.5 hours at 8 us per count).
+ * Arguments:
+ *   - LOC_U16Count: the counter value
+ * Return value: the timestamp in Timer1 counts
+ */
+uint32_t TICK_Stamp(uint16_t LOC_U16Count){
+	uint16_t LOC_U16Now = TMR1_GetCount();
+	uint32_t LOC_U32Base = TICK_Base;
+	uint16_t LOC_U16Previous = TICK_Previous;
+	if(TMR1_GetFlag(OCF1A) && LOC_U16Now < TICK_Length / 2){
+		LOC_U32Base += TICK_Length;
+		LOC_U16Previous = TICK_Length;
+	}
+	if(LOC_U16Count > LOC_U16Now) LOC_U32Base -= LOC_U16Previous;
+	return LOC_U32Base + LOC_U16Count;
+}
+
+/*
+ * Function: TICK_GetStats()
+ * Description: This function copies the rate in use and the counters, the 1PPS counters are updated by the INT1 interrupt.
+ * Arguments:
+ *   - LOC_PtrStats: where to copy them
+ * Return value: void
+ */
+void TICK_GetStats(ST_TickStats_t* LOC_PtrStats){
+	LOC_PtrStats->slips = TICK_Slips;
+	uint8_t LOC_U8Interrupts = GET_BIT(SREG, SREG_I);
+	CPU_CLI();
+	LOC_PtrStats->period = TICK_Period;
+#if TICK_PPS_ENABLE
+	LOC_PtrStats->pulses = TICK_Pulses;
+	LOC_PtrStats->rejected = TICK_Rejected;
+	LOC_PtrStats->windows = TICK_Windows;
+#else
+	LOC_PtrStats->pulses = 0;
+	LOC_PtrStats->rejected = 0;
+	LOC_PtrStats->windows = 0;
+#endif
+	if(LOC_U8Interrupts) CPU_SEI();
+}
+
+/*
+ * ISR: Timer1 compare A, ends the half second and programs the length of the next one.
+ */
+ISR(TMR1_COMPA){
+	uint32_t LOC_U32Period = TICK_Period;
+	uint16_t LOC_U16Length = (uint16_t)(LOC_U32Period / TICK_DIV);
+	uint8_t LOC_U8Fraction = TICK_Fraction + (uint8_t)(LOC_U32Period % TICK_DIV);
+	if(LOC_U8Fraction >= TICK_DIV){
+		LOC_U8Fraction -= TICK_DIV;
+		LOC_U16Length++;
+	}
+	TICK_Fraction = LOC_U8Fraction;
+	TMR1_SetTop(LOC_U16Length - 1);
+
+	TICK_Base += TICK_Length;
+	TICK_Previous = TICK_Length;
+	TICK_Length = LOC_U16Length;
+	TICK_Ticks++;
+}
@@ -8,6 +8,13 @@
  *   - TMR0_Test: function to test timer0 driver
  *   - LED_Test: function to test LED driver
  *   - EXTI_Test: function to text external interrupt and button driver
+ *   - EXTI_DispatchTest: function to measure the external interrupt dispatch cost
+ *   - SCHED_DispatchTest: function to measure the task scheduler dispatch cost
+ *   - ADC_ScanTest: function to measure the CPU cost of the free running ADC scan
+ *   - TMR1_Test: function to test timer1 driver (hardware LED flash)
+ *   - TMR2_Test: function to test timer2 driver
+ *   - EEPROM_Test: function to test EEPROM driver
+ *   - UART_Test: function to test UART driver
  *
  * Created on: Jan 13, 2023
  * Author: Maged Magdy Asaad
@@ -24,16 +31,31 @@
 #include "../MCAL/GPIO/GPIO_Interface.h"
 #include "../MCAL/TMR0/TMR0_Interface.h"
 #include "../MCAL/EXTI/EXTI_Interface.h"
+#include "../MCAL/TMR1/TMR1_Interface.h"
+#include "../MCAL/TMR2/TMR2_Interface.h"
+#include "../MCAL/EEPROM/EEPROM_Interface.h"
+#include "../MCAL/UART/UART_Interface.h"
+#include "../MCAL/ADC/ADC_Interface.h"
 
 // ECUAL
 #include "../ECUAL/LED/LED_Interface.h"
 #include "../ECUAL/BUTTON/BUTTON_Interface.h"
 
+// SERVICES
+#include "../SERVICES/SCHED/SCHED_Interface.h"
+
 // #include "util/delay.h"
 
 void GPIO_Test(void);
 void TMR0_Test(void);
 void LED_Test(void);
 void EXTI_Test(void);
+void EXTI_DispatchTest(void);
+void SCHED_DispatchTest(void);
+void ADC_ScanTest(void);
+void TMR1_Test(void);
+void TMR2_Test(void);
+void EEPROM_Test(void);
+void UART_Test(void);
 
 #endif
\ No newline at end of file
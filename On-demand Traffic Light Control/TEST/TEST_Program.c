@@ -13,7 +13,49 @@
 
 #include "TEST_Interface.h"
 
-uint8_t flag = 0;
+volatile uint8_t flag = 0;
+volatile uint16_t dispatchCycles; // INT2 edge written to flag seen, through the EXTI callback table
+volatile uint16_t handCycles;     // the same edge through a hand-written INT2 ISR (EXTI_INT2_DISPATCH set to 0)
+volatile uint16_t callCycles;     // same pin write and callback called directly, INT2 disabled
+volatile uint16_t schedCycles;     // one SCHED_Dispatch round of SCHED_MAX_TASKS posted empty tasks
+volatile uint16_t schedCallCycles; // the same tasks called directly from the table
+volatile uint16_t schedTaskCycles; // execution time of an empty task measured by the scheduler (its WCET)
+volatile uint16_t adcIdleOff;      // idle loop passes in the window, ADC off
+volatile uint16_t adcIdleOn;       // idle loop passes in the window, channels scanned
+volatile uint16_t adcLoad;         // CPU time taken by the scan, in 1/1000
+volatile uint16_t adcIsrCycles;    // CPU cycles taken per conversion (interrupt response, ISR and reti)
+
+#define TEST_ADC_WINDOW 50000U // Timer1 counts (CPU cycles) of each idle measurement
+
+static const uint8_t TEST_AdcChannels[7] = {1, 2, 3, 4, 5, 6, 7};
+
+static void TEST_Empty(void){
+}
+
+static const ST_SchedTask_t TEST_Tasks[SCHED_MAX_TASKS] = {
+	{TEST_Empty, 0, 0}, {TEST_Empty, 0, 0}, {TEST_Empty, 0, 0}, {TEST_Empty, 0, 0},
+	{TEST_Empty, 0, 0}, {TEST_Empty, 0, 0}, {TEST_Empty, 0, 0}, {TEST_Empty, 0, 0},
+};
+
+/*
+ * Function: TEST_SetFlag()
+ * This function is the external interrupt callback of the tests, it records that the interrupt fired.
+ * Arguments: void
+ * Return value: void
+ */
+static void TEST_SetFlag(void){
+	flag = 1;
+}
+
+/*
+ * Function: TEST_Echo()
+ * This function is the UART receive callback of the tests, it sends the received byte back.
+ * Arguments: the received byte
+ * Return value: void
+ */
+static void TEST_Echo(uint8_t LOC_U8Byte){
+	UART_SendByte(LOC_U8Byte);
+}
 
 /*
  * Function: GPIO_Test()
@@ -71,7 +113,7 @@ void LED_Test(void){
 	LED_Init(PORTA, PIN1); // LED1
 	while(1){
 		LED_On(PORTA, PIN1); 
-		if(LED_IsOn(PORTA, PIN1)) LED_Blink(PORTA, PIN0); //
+		if(LED_IsOn(PORTA, PIN1)) LED_Blink(PORTA, PIN0, &timerConfig_5sec); //
 		LED_Off(PORTA, PIN0);
 		LED_Off(PORTA, PIN1);
 	}
@@ -90,6 +132,7 @@ void EXTI_Test(void){
 	ST_TimerConfig_t timerConfig_5sec = {INIT_VALUE_5_SEC, OVERFLOW_NUM_5_SEC, TMR_NORMAL, TMR_PRESCALER};
 	TMR0_Init(&timerConfig_5sec);
 	GPIO_SetPinDir(PORTA, PIN0, OUTPUT);
+	EXTI_SetCallback(INT1, TEST_SetFlag);
 	EXTI_Init(INT1, LOW_LEVEL);
 	BUTTON_Init(PORTD, PIN3);
 	while(1){
@@ -100,6 +143,242 @@ void EXTI_Test(void){
 	}
 }
 
-ISR(EXTI1){
+#if !EXTI_INT2_DISPATCH
+/*
+ * ISR: INT2 written by hand as the ISRs were before the callback table, its work (TEST_SetFlag) inline.
+ */
+ISR(EXTI2){
 	flag = 1;
 }
+#endif
+
+/*
+ * Function: EXTI_DispatchTest()
+ * This function is used to measure the cost of the EXTI callback dispatch in CPU cycles.
+ * INT2 (PIN2 in PORTB) is set as output, so writing it high triggers the interrupt from software.
+ * Timer1 counts the CPU cycles: dispatchCycles is the time from the write to the flag set by the callback,
+ * callCycles is the same write with INT2 disabled followed by a direct call of the callback.
+ * The difference is the interrupt cost (response, vector, saved registers, table dispatch, reti).
+ * Built with EXTI_INT2_DISPATCH set to 0, the edge goes to the hand-written ISR above and its time is handCycles:
+ * dispatchCycles - handCycles is the cost of the callback table.
+ * The results are read in the debugger, the LED connected to PIN0 in PORTA blinks after each measurement.
+ * Arguments: void
+ * Return value: void
+ */
+void EXTI_DispatchTest(void){
+	ST_TimerConfig_t timerConfig_Halfsec = {INIT_VALUE_HALF_SEC, OVERFLOW_NUM_HALF_SEC, TMR_NORMAL, TMR_PRESCALER};
+	ST_Timer1Config_t timer1Config_Cycles = {0xFFFF, TMR1_NORMAL, TMR1_NO_PRE};
+	uint16_t LOC_U16Start;
+	TMR0_Init(&timerConfig_Halfsec);
+	TMR1_Init(&timer1Config_Cycles);
+	TMR1_Start(&timer1Config_Cycles);
+	GPIO_SetPinDir(PORTA, PIN0, OUTPUT);
+	GPIO_SetPinDir(PORTB, PIN2, OUTPUT);
+	GPIO_SetPinVal(PORTB, PIN2, LOW);
+	EXTI_SetCallback(INT2, TEST_SetFlag);
+	EXTI_Init(INT2, RISING_EDGE);
+	while(1){
+		// through the interrupt
+		flag = 0;
+		LOC_U16Start = TMR1_GetCount();
+		GPIO_SetPinVal(PORTB, PIN2, HIGH);
+		while(!flag);
+#if EXTI_INT2_DISPATCH
+		dispatchCycles = TMR1_GetCount() - LOC_U16Start;
+#else
+		handCycles = TMR1_GetCount() - LOC_U16Start;
+#endif
+		GPIO_SetPinVal(PORTB, PIN2, LOW);
+
+		// direct call
+		EXTI_Disable(INT2);
+		flag = 0;
+		LOC_U16Start = TMR1_GetCount();
+		GPIO_SetPinVal(PORTB, PIN2, HIGH);
+		TEST_SetFlag();
+		while(!flag);
+		callCycles = TMR1_GetCount() - LOC_U16Start;
+		GPIO_SetPinVal(PORTB, PIN2, LOW);
+		EXTI_Rearm(INT2);
+
+		GPIO_ToggPin(PORTA, PIN0);
+		TMR0_Delay(&timerConfig_Halfsec);
+	}
+}
+
+/*
+ * Function: SCHED_DispatchTest()
+ * This function is used to measure the cost of the scheduler dispatch in CPU cycles.
+ * The SCHED_MAX_TASKS tasks of the table are event tasks doing nothing, all posted before each round,
+ * so the round runs them without waiting for a half second. Timer1 counts the CPU cycles:
+ * schedCycles is the round, schedCallCycles is the same tasks called directly from the table.
+ * The difference divided by SCHED_MAX_TASKS is the dispatch cost per task (ready flags, timing and counters),
+ * schedTaskCycles is the execution time the scheduler measures for an empty task (its own timing cost).
+ * The results are read in the debugger, the LED connected to PIN0 in PORTA blinks after each measurement.
+ * Arguments: void
+ * Return value: void
+ */
+void SCHED_DispatchTest(void){
+	ST_TimerConfig_t timerConfig_Halfsec = {INIT_VALUE_HALF_SEC, OVERFLOW_NUM_HALF_SEC, TMR_NORMAL, TMR_PRESCALER};
+	ST_Timer1Config_t timer1Config_Cycles = {0xFFFF, TMR1_NORMAL, TMR1_NO_PRE};
+	ST_SchedStats_t LOC_Stats;
+	uint16_t LOC_U16Start;
+	TMR0_Init(&timerConfig_Halfsec);
+	TMR1_Init(&timer1Config_Cycles);
+	TMR1_Start(&timer1Config_Cycles);
+	GPIO_SetPinDir(PORTA, PIN0, OUTPUT);
+	SCHED_Init(TEST_Tasks, SCHED_MAX_TASKS);
+	while(1){
+		// through the scheduler
+		for(uint8_t i=0; i<SCHED_MAX_TASKS; i++) SCHED_Post(i);
+		LOC_U16Start = TMR1_GetCount();
+		SCHED_Dispatch();
+		schedCycles = TMR1_GetCount() - LOC_U16Start;
+		
+		// direct calls
+		LOC_U16Start = TMR1_GetCount();
+		for(uint8_t i=0; i<SCHED_MAX_TASKS; i++) TEST_Tasks[i].run();
+		schedCallCycles = TMR1_GetCount() - LOC_U16Start;
+		
+		SCHED_GetStats(0, &LOC_Stats);
+		schedTaskCycles = LOC_Stats.wcet;
+		
+		GPIO_ToggPin(PORTA, PIN0);
+		TMR0_Delay(&timerConfig_Halfsec);
+	}
+}
+
+/*
+ * Function: TEST_Idle()
+ * This function counts the passes of an idle loop during TEST_ADC_WINDOW CPU cycles (Timer1 counts).
+ * Arguments: void
+ * Return value: the number of passes
+ */
+static uint16_t TEST_Idle(void){
+	uint16_t LOC_U16Passes = 0;
+	uint16_t LOC_U16Start = TMR1_GetCount();
+	while((uint16_t)(TMR1_GetCount() - LOC_U16Start) < TEST_ADC_WINDOW) LOC_U16Passes++;
+	return LOC_U16Passes;
+}
+
+/*
+ * Function: ADC_ScanTest()
+ * This function is used to measure the CPU cost of the free running ADC scan (MCAL/ADC).
+ * An idle loop is counted during the same window with the ADC off and while the channels 1 to 7 of PORTA are scanned:
+ * the passes lost are the time taken by the conversion complete interrupt. adcLoad is that time in 1/1000 of the CPU,
+ * adcIsrCycles the cycles per conversion (the window holds one conversion every 13 ADC clocks), the same for any
+ * number of channels. The results are read in the debugger, the LED connected to PIN0 in PORTA blinks after each measurement.
+ * Arguments: void
+ * Return value: void
+ */
+void ADC_ScanTest(void){
+	ST_TimerConfig_t timerConfig_Halfsec = {INIT_VALUE_HALF_SEC, OVERFLOW_NUM_HALF_SEC, TMR_NORMAL, TMR_PRESCALER};
+	ST_Timer1Config_t timer1Config_Cycles = {0xFFFF, TMR1_NORMAL, TMR1_NO_PRE};
+	TMR0_Init(&timerConfig_Halfsec);
+	TMR1_Init(&timer1Config_Cycles);
+	TMR1_Start(&timer1Config_Cycles);
+	GPIO_SetPinDir(PORTA, PIN0, OUTPUT);
+	CPU_SEI();
+	while(1){
+		// ADC off
+		ADC_StopScan();
+		adcIdleOff = TEST_Idle();
+		
+		// channels scanned, from the second conversion (the first one is longer)
+		ADC_StartScan(TEST_AdcChannels, sizeof(TEST_AdcChannels));
+		TMR0_Delay(&timerConfig_Halfsec);
+		adcIdleOn = TEST_Idle();
+		
+		uint32_t LOC_U32Lost = (uint32_t)(adcIdleOff - adcIdleOn);
+		adcLoad = (uint16_t)(LOC_U32Lost * 1000U / adcIdleOff);
+		adcIsrCycles = (uint16_t)(LOC_U32Lost * (13UL << ADC_PRESCALER) / adcIdleOff);
+		
+		GPIO_ToggPin(PORTA, PIN0);
+		TMR0_Delay(&timerConfig_Halfsec);
+	}
+}
+
+/*
+ * Function: TMR1_Test()
+ * This function is used to test timer1 driver functions.
+ * The test is using 2 LEDs connected to PIN5 (OC1A) and PIN4 (OC1B) in PORTD,
+ * both LEDs flash at 1 Hz by the timer hardware for 5 seconds while the CPU is busy waiting,
+ * then the flash is stopped and both LEDs stay off for 5 seconds.
+ * Arguments: void
+ * Return value: void
+ */
+void TMR1_Test(void){
+	ST_TimerConfig_t timerConfig_5sec = {INIT_VALUE_5_SEC, OVERFLOW_NUM_5_SEC, TMR_NORMAL, TMR_PRESCALER};
+	TMR0_Init(&timerConfig_5sec);
+	LED_Init(PORTD, PIN5);
+	LED_Init(PORTD, PIN4);
+	LED_FlashInit();
+	while(1){
+		LED_FlashStart(PORTD, PIN5);
+		LED_FlashStart(PORTD, PIN4);
+		TMR0_Delay(&timerConfig_5sec);
+		LED_FlashStop(PORTD, PIN5);
+		LED_FlashStop(PORTD, PIN4);
+		TMR0_Delay(&timerConfig_5sec);
+	}
+}
+
+/*
+ * Function: TMR2_Test()
+ * This function is used to test timer2 driver functions.
+ * The test is using a LED connected to PIN0 in PORTA and toggles it every 61 overflows of timer2 (about 0.5 second),
+ * the overflow flag is polled so the test does not take the timer2 vectors used by the services.
+ * Arguments: void
+ * Return value: void
+ */
+void TMR2_Test(void){
+	GPIO_SetPinDir(PORTA, PIN0, OUTPUT);
+	TMR2_Start(TMR2_PRESCALER);
+	while(1){
+		for(uint8_t i=0; i<61; i++){
+			while(!GET_BIT(TIFR, TOV2)) IO_POLL();
+			TIFR = (1<<TOV2); // clear the flag by writing one
+		}
+		GPIO_ToggPin(PORTA, PIN0);
+	}
+}
+
+/*
+ * Function: EEPROM_Test()
+ * This function is used to test EEPROM driver functions.
+ * The test writes a pattern to the last 16 bytes of the EEPROM, reads it back
+ * and turns on a LED connected to PIN0 in PORTA if it matches, or a LED connected to PIN2 in PORTA if not.
+ * Arguments: void
+ * Return value: void
+ */
+void EEPROM_Test(void){
+	uint8_t LOC_U8Data[16];
+	uint8_t LOC_U8Ok = 1;
+	LED_Init(PORTA, PIN0);
+	LED_Init(PORTA, PIN2);
+	for(uint8_t i=0; i<16; i++) LOC_U8Data[i] = 0xA5 ^ i;
+	EEPROM_Write(EEPROM_SIZE - 16, LOC_U8Data, 16);
+	for(uint8_t i=0; i<16; i++) LOC_U8Data[i] = 0;
+	EEPROM_Read(EEPROM_SIZE - 16, LOC_U8Data, 16);
+	for(uint8_t i=0; i<16; i++){
+		if(LOC_U8Data[i] != (0xA5 ^ i)) LOC_U8Ok = 0;
+	}
+	if(LOC_U8Ok) LED_On(PORTA, PIN0);
+	else LED_On(PORTA, PIN2);
+	while(1);
+}
+
+/*
+ * Function: UART_Test()
+ * This function is used to test UART driver functions.
+ * The test sends a greeting, then sends back every byte received (9600 baud, 8N1).
+ * Arguments: void
+ * Return value: void
+ */
+void UART_Test(void){
+	UART_Init();
+	UART_SetRxCallback(TEST_Echo);
+	CPU_SEI();
+	UART_SendString("UART test\r\n");
+	while(1);
+}
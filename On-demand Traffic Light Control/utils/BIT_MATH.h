@@ -15,9 +15,9 @@
 #ifndef BIT_MATH_H
 #define BIT_MATH_H
 
-#define SET_BIT(var, bitNo)  var |= (1<<bitNo)	// Set a specific bit in a variable
-#define CLR_BIT(var, bitNo)  var &= ~(1<<bitNo)	// Clear a specific bit in a variable
-#define GET_BIT(var, bitNo)  (var>>bitNo)&1		// Get the value of a specific bit in a variable
-#define TOGG_BIT(var, bitNo) var ^= (1<<bitNo)	// Toggle the value of a specific bit in a variable
+#define SET_BIT(var, bitNo)  (var) |= (1<<(bitNo))	// Set a specific bit in a variable
+#define CLR_BIT(var, bitNo)  (var) &= ~(1<<(bitNo))	// Clear a specific bit in a variable
+#define GET_BIT(var, bitNo)  (((var)>>(bitNo))&1)	// Get the value of a specific bit in a variable
+#define TOGG_BIT(var, bitNo) (var) ^= (1<<(bitNo))	// Toggle the value of a specific bit in a variable
 
 #endif
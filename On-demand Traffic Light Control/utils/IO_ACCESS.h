@@ -0,0 +1,73 @@
+/*
+ * File: IO_ACCESS.h
+ *
+ * Description:
+ * This header file contains the macros used by the *_Private.h files to access the microcontroller registers,
+ * and the few CPU instructions used by the drivers (sei, cli, wdr, spm, lpm) and the bootloader (ijmp).
+ * On the target the registers are accessed at their fixed I/O addresses.
+ * When the project is compiled for the host (HOST_BUILD defined) the same drivers and application run on a PC:
+ * the registers live in the simulated register file of the host backend (HOST/HOST_Interface.h),
+ * the CPU instructions call the backend, IO_POLL() lets the backend advance the virtual time
+ * wherever the firmware busy-waits for a hardware flag, and IO_SYNC() lets it see each output write
+ * as it happens (an interrupt can then be delivered between two writes, like on the target).
+ * It defines:
+ *   - IO_REG8, IO_REG16: access an 8-bit or 16-bit register by its data memory address
+ *   - IO_POLL: hook placed in the polling loops, empty on the target
+ *   - IO_SYNC: hook placed after the output register writes, empty on the target
+ *   - CPU_SEI, CPU_CLI, CPU_WDR: enable/disable global interrupts and refresh the watchdog
+ *   - CPU_SPM: write the store program memory control register and execute spm at once (Z = address, r1:r0 = word),
+ *     the write and spm must be less than 4 cycles apart
+ *   - CPU_LPM: read a byte of the flash at a byte address
+ *   - CPU_JUMP: jump to a byte address of the flash (the application or the bootloader), without return
+ *
+ * Created on: Oct 19, 2026
+ * Author: Maged Magdy Asaad
+ * Copyright (c) 2026 Maged Magdy. All rights reserved.
+ */
+
+#ifndef IO_ACCESS_H
+#define IO_ACCESS_H
+
+#include "STD_TYPES.h"
+
+#ifdef HOST_BUILD
+
+// Simulated register file and CPU hooks implemented in HOST/HOST_Program.c
+extern volatile uint8_t* HOST_IoSpace;
+void HOST_Poll(void);
+void HOST_Write(void);
+void HOST_Sei(void);
+void HOST_Cli(void);
+void HOST_Wdr(void);
+void HOST_Spm(uint16_t LOC_U16Address, uint16_t LOC_U16Word);
+uint8_t HOST_Lpm(uint16_t LOC_U16Address);
+void HOST_Jump(uint16_t LOC_U16Address);
+
+#define IO_REG8(addr)  (*((volatile uint8_t*)(HOST_IoSpace + (addr))))
+#define IO_REG16(addr) (*((volatile uint16_t*)(HOST_IoSpace + (addr))))
+#define IO_POLL()      HOST_Poll()
+#define IO_SYNC()      HOST_Write()
+#define CPU_SEI()      HOST_Sei()
+#define CPU_CLI()      HOST_Cli()
+#define CPU_WDR()      HOST_Wdr()
+#define CPU_SPM(reg, cmd, addr, word) do{ IO_REG8(reg) = (cmd); HOST_Spm((addr), (word)); }while(0)
+#define CPU_LPM(addr)  HOST_Lpm(addr)
+#define CPU_JUMP(addr) HOST_Jump(addr)
+
+#else
+
+#define IO_REG8(addr)  (*((volatile uint8_t*)(addr)))
+#define IO_REG16(addr) (*((volatile uint16_t*)(addr)))
+#define IO_POLL()
+#define IO_SYNC()
+#define CPU_SEI()      __asm__ __volatile__ ("sei" ::: "memory")
+#define CPU_CLI()      __asm__ __volatile__ ("cli" ::: "memory")
+#define CPU_WDR()      __asm__ __volatile__ ("wdr")
+#define CPU_SPM(reg, cmd, addr, word) __asm__ __volatile__ ("movw r0, %3" "\n\t" "sts %0, %1" "\n\t" "spm" "\n\t" "clr r1"\
+                       :: "i" (reg), "r" ((uint8_t)(cmd)), "z" ((uint16_t)(addr)), "r" ((uint16_t)(word)) : "r0", "memory")
+#define CPU_LPM(addr)  (__extension__({ uint8_t __b; __asm__ __volatile__ ("lpm %0, Z" : "=r" (__b) : "z" ((uint16_t)(addr))); __b; }))
+#define CPU_JUMP(addr) __asm__ __volatile__ ("ijmp" :: "z" ((uint16_t)(addr) >> 1))
+
+#endif
+
+#endif
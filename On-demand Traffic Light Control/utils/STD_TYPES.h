@@ -5,6 +5,7 @@
  * This header file contains the standard data types used in this project.
  * It defines the standard integer types (e.g. uint8_t, int16_t) and floating-point types (e.g. float32_t, float64_t).
  * These types are defined using the typedef keyword to make them more readable and portable across different platforms.
+ * When the project is compiled for the host backend (HOST_BUILD defined) the integer types are taken from <stdint.h>.
  * The standard integer types are:
  *		- uint8_t: Unsigned 8-bit integer
  *		- int8_t: Signed 8-bit integer
@@ -27,6 +28,13 @@
 
 #ifndef STD_TYPES_H
 #define STD_TYPES_H
+
+#ifdef HOST_BUILD
+
+// On the host (HOST_BUILD) the C library already defines the integer types, use them so the sizes match the target
+#include <stdint.h>
+
+#else
   
 typedef unsigned            char   uint8_t;
 typedef signed              char   int8_t;
@@ -40,6 +48,8 @@ typedef signed   long       int    int32_t;
 typedef unsigned long long  int    uint64_t;
 typedef signed   long long  int    int64_t;
 
+#endif
+
 typedef                     float  float32_t;
 typedef                     double float64_t;
 typedef          long       double float128_t;